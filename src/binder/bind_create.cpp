@@ -129,7 +129,16 @@ auto Binder::BindIndex(duckdb_libpgquery::PGIndexStmt *stmt) -> std::unique_ptr<
     }
   }
 
-  return std::make_unique<IndexStatement>(stmt->idxname, std::move(table), std::move(cols));
+  // Without `USING`, the parser names its own default access method; B+ trees are ours.
+  auto index_type = IndexType::BPlusTreeIndex;
+  auto access_method = StringUtil::Lower(stmt->accessMethod == nullptr ? "" : stmt->accessMethod);
+  if (access_method == "hash") {
+    index_type = IndexType::HashTableIndex;
+  } else if (!access_method.empty() && access_method != DEFAULT_INDEX_TYPE && access_method != "btree") {
+    throw NotImplementedException(fmt::format("index type {} is not supported", access_method));
+  }
+
+  return std::make_unique<IndexStatement>(stmt->idxname, std::move(table), std::move(cols), index_type);
 }
 
 }  // namespace bustub
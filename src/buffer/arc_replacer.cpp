@@ -0,0 +1,186 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arc_replacer.cpp
+//
+// Identification: src/buffer/arc_replacer.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/arc_replacer.h"
+
+#include <algorithm>
+
+#include "common/exception.h"
+
+namespace bustub {
+
+ARCReplacer::ARCReplacer(size_t num_frames)
+    : t1_(num_frames),
+      t2_(num_frames),
+      page_ids_(num_frames, INVALID_PAGE_ID),
+      evictable_(num_frames, false),
+      capacity_(num_frames) {}
+
+void ARCReplacer::CheckFrameId(frame_id_t frame_id) const {
+  BUSTUB_ASSERT(frame_id >= 0 && static_cast<size_t>(frame_id) < evictable_.size(), "invalid frame id");
+}
+
+auto ARCReplacer::EvictFrom(FrameList *list, frame_id_t *frame_id) -> bool {
+  for (auto fid = list->Front(); fid != INVALID_PAGE_ID; fid = list->Next(fid)) {
+    if (evictable_[fid]) {
+      list->Erase(fid);
+      *frame_id = fid;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ARCReplacer::TrimGhosts() {
+  while (t1_.Size() + b1_.Size() > capacity_ && b1_.Size() > 0) {
+    b1_.PopFront();
+  }
+  while (t1_.Size() + t2_.Size() + b1_.Size() + b2_.Size() > 2 * capacity_ && b2_.Size() > 0) {
+    b2_.PopFront();
+  }
+}
+
+auto ARCReplacer::Evict(frame_id_t *frame_id) -> bool {
+  std::scoped_lock lock(latch_);
+  if (curr_size_ == 0) {
+    return false;
+  }
+  // Take from T1 while it is over its target, falling back to the other list if every frame in one is pinned.
+  FrameList *first = !t1_.Empty() && t1_.Size() > target_t1_ ? &t1_ : &t2_;
+  FrameList *second = first == &t1_ ? &t2_ : &t1_;
+  FrameList *from = first;
+  if (!EvictFrom(first, frame_id)) {
+    if (!EvictFrom(second, frame_id)) {
+      UNREACHABLE("curr_size_ is positive but no evictable frame was found");
+    }
+    from = second;
+  }
+  (from == &t1_ ? b1_ : b2_).PushBack(page_ids_[*frame_id]);
+  TrimGhosts();
+  page_ids_[*frame_id] = INVALID_PAGE_ID;
+  evictable_[*frame_id] = false;
+  curr_size_--;
+  return true;
+}
+
+void ARCReplacer::RecordAccess(frame_id_t frame_id, AccessType access_type) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  if (t1_.Contains(frame_id)) {
+    // A scan coming back to the page it is reading does not make the page frequently used.
+    if (access_type == AccessType::Scan) {
+      t1_.MoveToBack(frame_id);
+    } else {
+      t1_.Erase(frame_id);
+      t2_.PushBack(frame_id);
+    }
+    return;
+  }
+  if (t2_.Contains(frame_id)) {
+    t2_.MoveToBack(frame_id);
+    return;
+  }
+
+  // The frame was just loaded. A page coming back from a ghost list tells us which of T1 and T2 should be larger.
+  auto page_id = page_ids_[frame_id];
+  if (b1_.Contains(page_id)) {
+    target_t1_ = std::min(capacity_, target_t1_ + std::max<size_t>(b2_.Size() / b1_.Size(), 1));
+    b1_.Erase(page_id);
+    t2_.PushBack(frame_id);
+  } else if (b2_.Contains(page_id)) {
+    auto delta = std::max<size_t>(b1_.Size() / b2_.Size(), 1);
+    target_t1_ = target_t1_ > delta ? target_t1_ - delta : 0;
+    b2_.Erase(page_id);
+    t2_.PushBack(frame_id);
+  } else {
+    t1_.PushBack(frame_id);
+  }
+  TrimGhosts();
+}
+
+void ARCReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  if (!IsTracked(frame_id) || evictable_[frame_id] == set_evictable) {
+    return;
+  }
+  evictable_[frame_id] = set_evictable;
+  if (set_evictable) {
+    curr_size_++;
+  } else {
+    curr_size_--;
+  }
+}
+
+auto ARCReplacer::IsEvictable(frame_id_t frame_id) -> bool {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  return evictable_[frame_id];
+}
+
+void ARCReplacer::Remove(frame_id_t frame_id) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  if (!IsTracked(frame_id)) {
+    return;
+  }
+  if (!evictable_[frame_id]) {
+    throw Exception(ExceptionType::INVALID, "cannot remove a non-evictable frame");
+  }
+  if (t1_.Contains(frame_id)) {
+    t1_.Erase(frame_id);
+  } else {
+    t2_.Erase(frame_id);
+  }
+  page_ids_[frame_id] = INVALID_PAGE_ID;
+  evictable_[frame_id] = false;
+  curr_size_--;
+}
+
+void ARCReplacer::SetPageId(frame_id_t frame_id, page_id_t page_id) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  page_ids_[frame_id] = page_id;
+}
+
+auto ARCReplacer::EvictionCandidates(size_t max_candidates) -> std::vector<frame_id_t> {
+  std::scoped_lock lock(latch_);
+  auto next_evictable = [this](const FrameList &list, frame_id_t fid) {
+    while (fid != INVALID_PAGE_ID && !evictable_[fid]) {
+      fid = list.Next(fid);
+    }
+    return fid;
+  };
+  // Replay the choice Evict makes between T1 and T2, with T1 shrinking as frames are taken from it.
+  std::vector<frame_id_t> candidates;
+  auto t1 = next_evictable(t1_, t1_.Front());
+  auto t2 = next_evictable(t2_, t2_.Front());
+  auto t1_size = t1_.Size();
+  while (candidates.size() < max_candidates && (t1 != INVALID_PAGE_ID || t2 != INVALID_PAGE_ID)) {
+    if (t2 == INVALID_PAGE_ID || (t1 != INVALID_PAGE_ID && t1_size > target_t1_)) {
+      candidates.push_back(t1);
+      t1 = next_evictable(t1_, t1_.Next(t1));
+      t1_size--;
+    } else {
+      candidates.push_back(t2);
+      t2 = next_evictable(t2_, t2_.Next(t2));
+    }
+  }
+  return candidates;
+}
+
+auto ARCReplacer::Size() -> size_t {
+  std::scoped_lock lock(latch_);
+  return curr_size_;
+}
+
+}  // namespace bustub
@@ -12,56 +12,652 @@
 
 #include "buffer/buffer_pool_manager.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "common/exception.h"
+#include "common/logger.h"
 #include "common/macros.h"
 #include "storage/page/page_guard.h"
 
 namespace bustub {
 
 BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager, size_t replacer_k,
-                                     LogManager *log_manager)
-    : pool_size_(pool_size), disk_manager_(disk_manager), log_manager_(log_manager) {
-  // TODO(students): remove this line after you have implemented the buffer pool manager
-  throw NotImplementedException(
-      "BufferPoolManager is not implemented yet. If you have finished implementing BPM, please remove the throw "
-      "exception line in `buffer_pool_manager.cpp`.");
+                                     LogManager *log_manager, size_t num_instances, ReplacerPolicy replacer_policy,
+                                     const FrameArenaOptions &frame_options)
+    : pool_size_(pool_size),
+      replacer_policy_(replacer_policy),
+      frames_(std::make_unique<FrameArena>(pool_size, frame_options)),
+      disk_manager_(disk_manager),
+      log_manager_(log_manager) {
+  BUSTUB_ENSURE(num_instances > 0, "invalid number of buffer pool instances");
 
   // we allocate a consecutive memory space for the buffer pool
   pages_ = new Page[pool_size_];
-  replacer_ = std::make_unique<LRUKReplacer>(pool_size, replacer_k);
+  for (size_t i = 0; i < pool_size_; i++) {
+    pages_[i].data_ = frames_->GetFrame(i);
+  }
 
-  // Initially, every page is in the free list.
-  for (size_t i = 0; i < pool_size_; ++i) {
-    free_list_.emplace_back(static_cast<int>(i));
+  // Frames are split as evenly as possible; the first `pool_size % num_instances` instances get one extra frame.
+  size_t frame_offset = 0;
+  for (size_t i = 0; i < num_instances; i++) {
+    size_t num_frames = pool_size_ / num_instances + (i < pool_size_ % num_instances ? 1 : 0);
+    auto inst = std::make_unique<BufferPoolInstance>(frame_offset, num_frames, replacer_policy, replacer_k,
+                                                     static_cast<page_id_t>(i));
+    // Initially, every page is in the free list.
+    for (size_t j = 0; j < num_frames; j++) {
+      inst->free_list_.emplace_back(static_cast<frame_id_t>(frame_offset + j));
+    }
+    frame_offset += num_frames;
+    instances_.emplace_back(std::move(inst));
   }
+  // Scans should never be able to claim more than a quarter of the pool.
+  SetScanRingSize(std::min<size_t>(SCAN_RING_SIZE, pool_size_ / 4));
+  disk_scheduler_ = std::make_unique<DiskScheduler>(disk_manager_);
+  read_ahead_thread_.emplace([this] { ReadAheadWorker(); });
+  bg_writer_thread_.emplace([this] { BackgroundWriterWorker(); });
 }
 
-BufferPoolManager::~BufferPoolManager() { delete[] pages_; }
+BufferPoolManager::~BufferPoolManager() {
+  read_ahead_queue_.Put(std::nullopt);
+  read_ahead_thread_->join();
+  {
+    std::scoped_lock lock(bg_writer_latch_);
+    bg_writer_stop_ = true;
+  }
+  bg_writer_cv_.notify_one();
+  bg_writer_thread_->join();
+  // Drain outstanding I/O before the frames go away.
+  disk_scheduler_.reset();
+  delete[] pages_;
+}
 
-auto BufferPoolManager::NewPage(page_id_t *page_id) -> Page * { return nullptr; }
+auto BufferPoolManager::AcquireFrame(BufferPoolInstance &inst, frame_id_t *frame_id, std::future<bool> *write_back)
+    -> bool {
+  if (!inst.free_list_.empty()) {
+    *frame_id = inst.free_list_.front();
+    inst.free_list_.pop_front();
+    return true;
+  }
 
-auto BufferPoolManager::FetchPage(page_id_t page_id, [[maybe_unused]] AccessType access_type) -> Page * {
+  frame_id_t local_frame_id;
+  if (!inst.replacer_->Evict(&local_frame_id)) {
+    return false;
+  }
+  *frame_id = static_cast<frame_id_t>(inst.frame_offset_) + local_frame_id;
+  LeaveScanRing(inst, *frame_id);
+  DetachFrame(inst, *frame_id, write_back);
+  return true;
+}
+
+auto BufferPoolManager::AcquireScanFrame(BufferPoolInstance &inst, frame_id_t *frame_id,
+                                         std::future<bool> *write_back) -> bool {
+  if (inst.scan_ring_.size() < inst.scan_ring_capacity_) {
+    if (!AcquireFrame(inst, frame_id, write_back)) {
+      return false;
+    }
+    inst.scan_ring_.push_back(*frame_id);
+    inst.in_scan_ring_[LocalFrameId(inst, *frame_id)] = true;
+    return true;
+  }
+
+  for (size_t i = 0; i < inst.scan_ring_.size(); i++) {
+    frame_id_t candidate = inst.scan_ring_[inst.scan_ring_cursor_];
+    inst.scan_ring_cursor_ = (inst.scan_ring_cursor_ + 1) % inst.scan_ring_.size();
+    if (pages_[candidate].pin_count_ > 0) {
+      continue;
+    }
+    // The frame is unpinned, hence evictable: take it away from the replacer and reuse it for this scan.
+    inst.replacer_->Remove(LocalFrameId(inst, candidate));
+    DetachFrame(inst, candidate, write_back);
+    *frame_id = candidate;
+    return true;
+  }
+
+  // Every frame of the ring is in use; borrow one from the rest of the pool.
+  return AcquireFrame(inst, frame_id, write_back);
+}
+
+void BufferPoolManager::DetachFrame(BufferPoolInstance &inst, frame_id_t frame_id, std::future<bool> *write_back) {
+  auto local_frame_id = LocalFrameId(inst, frame_id);
+  if (inst.read_ahead_[local_frame_id]) {
+    inst.read_ahead_[local_frame_id] = false;
+    read_ahead_wasted_++;
+  }
+
+  Page *page = &pages_[frame_id];
+  // A page the background writer is cleaning is written again from the frame, behind its write: should that write
+  // fail, the frame is the only copy of the page left.
+  if (page->is_dirty_ || inst.writing_back_.count(page->page_id_) > 0) {
+    *write_back = disk_scheduler_->ScheduleWrite(page->page_id_, page->GetData());
+    inst.writing_back_.insert(page->page_id_);
+    page->is_dirty_ = false;
+    dirty_victims_++;
+    // The background writer is falling behind; have it run a round now rather than at the end of its interval. A
+    // wake-up lost to a race only delays the round to the end of the interval.
+    bg_writer_kicked_ = true;
+    bg_writer_cv_.notify_one();
+  } else {
+    clean_victims_++;
+  }
+  inst.page_table_.erase(page->page_id_);
+}
+
+void BufferPoolManager::LeaveScanRing(BufferPoolInstance &inst, frame_id_t frame_id) {
+  auto local_frame_id = LocalFrameId(inst, frame_id);
+  if (!inst.in_scan_ring_[local_frame_id]) {
+    return;
+  }
+  inst.in_scan_ring_[local_frame_id] = false;
+  inst.scan_ring_.erase(std::find(inst.scan_ring_.begin(), inst.scan_ring_.end(), frame_id));
+  if (inst.scan_ring_cursor_ >= inst.scan_ring_.size()) {
+    inst.scan_ring_cursor_ = 0;
+  }
+}
+
+auto BufferPoolManager::FinishWriteBack(BufferPoolInstance &inst, frame_id_t frame_id, page_id_t victim_page_id,
+                                        bool written) -> bool {
+  inst.writing_back_.erase(inst.writing_back_.find(victim_page_id));
+  if (written) {
+    return true;
+  }
+  // The frame still holds the victim, newer than its copy on disk: put it back instead of the page it was taken for.
+  // Fetches of that page that pinned the frame meanwhile see it hold another page and fail.
+  LOG_WARN("failed to write back page %d, keeping it dirty", victim_page_id);
+  Page *page = &pages_[frame_id];
+  inst.page_table_.erase(page->page_id_);
+  inst.page_table_[victim_page_id] = frame_id;
+  page->page_id_ = victim_page_id;
+  page->BumpVersion();
+  page->is_dirty_ = true;
+  auto local_frame_id = LocalFrameId(inst, frame_id);
+  inst.read_ahead_[local_frame_id] = false;
+  inst.replacer_->SetPageId(local_frame_id, victim_page_id);
+  UnpinFrame(inst, frame_id);
+  return false;
+}
+
+void BufferPoolManager::WaitForWriteBack(BufferPoolInstance &inst, page_id_t page_id,
+                                         std::unique_lock<std::mutex> &lock) {
+  inst.io_cv_.wait(lock, [&] { return inst.writing_back_.count(page_id) == 0; });
+}
+
+void BufferPoolManager::SetScanRingSize(size_t scan_ring_size) {
+  scan_ring_size_ = scan_ring_size;
+  size_t capacity = scan_ring_size == 0 ? 0 : std::max<size_t>(1, scan_ring_size / instances_.size());
+  for (auto &inst : instances_) {
+    std::scoped_lock lock(inst->latch_);
+    inst->scan_ring_capacity_ = std::min(capacity, inst->num_frames_);
+    while (inst->scan_ring_.size() > inst->scan_ring_capacity_) {
+      LeaveScanRing(*inst, inst->scan_ring_.back());
+    }
+  }
+}
+
+void BufferPoolManager::WaitForIO(BufferPoolInstance &inst, frame_id_t frame_id, std::unique_lock<std::mutex> &lock) {
+  auto local_frame_id = LocalFrameId(inst, frame_id);
+  inst.io_cv_.wait(lock, [&] { return !inst.io_pending_[local_frame_id]; });
+}
+
+void BufferPoolManager::UnpinFrame(BufferPoolInstance &inst, frame_id_t frame_id) {
+  if (--pages_[frame_id].pin_count_ == 0) {
+    inst.replacer_->SetEvictable(LocalFrameId(inst, frame_id), true);
+  }
+}
+
+auto BufferPoolManager::NewPageIn(BufferPoolInstance &inst, page_id_t *page_id) -> Page * {
+  std::unique_lock lock(inst.latch_);
+  frame_id_t frame_id;
+  std::future<bool> write_back;
+  if (!AcquireFrame(inst, &frame_id, &write_back)) {
+    return nullptr;
+  }
+
+  *page_id = AllocatePage(inst);
+  Page *page = &pages_[frame_id];
+  page_id_t victim_page_id = page->page_id_;
+  page->page_id_ = *page_id;
+  page->BumpVersion();
+  page->pin_count_ = 1;
+  page->is_dirty_ = false;
+  inst.page_table_[*page_id] = frame_id;
+
+  auto local_frame_id = LocalFrameId(inst, frame_id);
+  inst.replacer_->SetPageId(local_frame_id, *page_id);
+  inst.replacer_->RecordAccess(local_frame_id);
+  inst.replacer_->SetEvictable(local_frame_id, false);
+
+  if (write_back.valid()) {
+    // The old content is still being written out of this frame; wait for it outside of the latch.
+    inst.io_pending_[local_frame_id] = true;
+    lock.unlock();
+    bool written = write_back.get();
+    lock.lock();
+    inst.io_pending_[local_frame_id] = false;
+    inst.io_cv_.notify_all();
+    if (!FinishWriteBack(inst, frame_id, victim_page_id, written)) {
+      return nullptr;
+    }
+  }
+  page->ResetMemory();
+  return page;
+}
+
+auto BufferPoolManager::NewPage(page_id_t *page_id) -> Page * {
+  // Start from a different instance each time so that new pages are spread over the pool, and fall back to the
+  // other instances when the preferred one has every frame pinned.
+  size_t start = next_instance_.fetch_add(1) % instances_.size();
+  for (size_t i = 0; i < instances_.size(); i++) {
+    Page *page = NewPageIn(*instances_[(start + i) % instances_.size()], page_id);
+    if (page != nullptr) {
+      return page;
+    }
+  }
   return nullptr;
 }
 
+auto BufferPoolManager::FetchPage(page_id_t page_id, [[maybe_unused]] AccessType access_type) -> Page * {
+  return FetchPageImpl(page_id, access_type, false);
+}
+
+auto BufferPoolManager::FetchPageImpl(page_id_t page_id, AccessType access_type, bool read_ahead) -> Page * {
+  if (page_id == INVALID_PAGE_ID) {
+    return nullptr;
+  }
+  auto &inst = InstanceOf(page_id);
+  std::unique_lock lock(inst.latch_);
+  auto it = inst.page_table_.find(page_id);
+  if (it == inst.page_table_.end() && inst.writing_back_.count(page_id) > 0) {
+    // An evicted page whose write-back is in flight is not on disk yet, and may come back to the page table.
+    WaitForWriteBack(inst, page_id, lock);
+    it = inst.page_table_.find(page_id);
+  }
+  if (it != inst.page_table_.end()) {
+    frame_id_t frame_id = it->second;
+    Page *page = &pages_[frame_id];
+    page->pin_count_++;
+    auto local_frame_id = LocalFrameId(inst, frame_id);
+    // Pin the frame in the replacer first, so that recording the access does not have to re-order its eviction heap.
+    inst.replacer_->SetEvictable(local_frame_id, false);
+    if (!read_ahead) {
+      inst.replacer_->RecordAccess(local_frame_id, access_type);
+      access_stats_[static_cast<size_t>(access_type)].first++;
+      if (inst.read_ahead_[local_frame_id]) {
+        inst.read_ahead_[local_frame_id] = false;
+        read_ahead_hits_++;
+      }
+      if (access_type != AccessType::Scan) {
+        // The page turned out to be useful beyond the scan that brought it in.
+        LeaveScanRing(inst, frame_id);
+      }
+    }
+    // Another thread may still be reading the page in; our pin keeps the frame in place while we wait.
+    WaitForIO(inst, frame_id, lock);
+    if (page->page_id_ != page_id) {
+      // The read failed, or the write-back of the victim the frame was taken from.
+      UnpinFrame(inst, frame_id);
+      return nullptr;
+    }
+    return page;
+  }
+
+  frame_id_t frame_id;
+  std::future<bool> write_back;
+  bool acquired = access_type == AccessType::Scan ? AcquireScanFrame(inst, &frame_id, &write_back)
+                                                  : AcquireFrame(inst, &frame_id, &write_back);
+  if (!acquired) {
+    return nullptr;
+  }
+  if (!read_ahead) {
+    access_stats_[static_cast<size_t>(access_type)].second++;
+  }
+  Page *page = &pages_[frame_id];
+  page_id_t victim_page_id = page->page_id_;
+  page->page_id_ = page_id;
+  page->BumpVersion();
+  page->pin_count_ = 1;
+  page->is_dirty_ = false;
+  inst.page_table_[page_id] = frame_id;
+
+  auto local_frame_id = LocalFrameId(inst, frame_id);
+  inst.replacer_->SetPageId(local_frame_id, page_id);
+  inst.replacer_->RecordAccess(local_frame_id, access_type);
+  inst.replacer_->SetEvictable(local_frame_id, false);
+  if (read_ahead) {
+    inst.read_ahead_[local_frame_id] = true;
+    read_ahead_issued_++;
+  }
+
+  // Perform the write-back of the victim and the read of the requested page without holding the instance latch.
+  inst.io_pending_[local_frame_id] = true;
+  lock.unlock();
+  bool wrote_back = write_back.valid();
+  bool written = !wrote_back || write_back.get();
+  bool read = written && disk_scheduler_->ScheduleRead(page_id, page->GetData()).get();
+  lock.lock();
+  inst.io_pending_[local_frame_id] = false;
+  inst.io_cv_.notify_all();
+  if (wrote_back && !FinishWriteBack(inst, frame_id, victim_page_id, written)) {
+    return nullptr;
+  }
+  if (!read) {
+    LOG_WARN("failed to read page %d", page_id);
+    inst.page_table_.erase(page_id);
+    page->page_id_ = INVALID_PAGE_ID;
+    page->BumpVersion();
+    inst.read_ahead_[local_frame_id] = false;
+    UnpinFrame(inst, frame_id);
+    return nullptr;
+  }
+  return page;
+}
+
 auto BufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty, [[maybe_unused]] AccessType access_type) -> bool {
-  return false;
+  if (page_id == INVALID_PAGE_ID) {
+    return false;
+  }
+  auto &inst = InstanceOf(page_id);
+  std::scoped_lock lock(inst.latch_);
+  auto it = inst.page_table_.find(page_id);
+  if (it == inst.page_table_.end()) {
+    return false;
+  }
+  Page *page = &pages_[it->second];
+  if (page->pin_count_ <= 0) {
+    return false;
+  }
+  page->is_dirty_ = page->is_dirty_ || is_dirty;
+  UnpinFrame(inst, it->second);
+  return true;
+}
+
+auto BufferPoolManager::FlushPage(page_id_t page_id) -> bool {
+  if (page_id == INVALID_PAGE_ID) {
+    return false;
+  }
+  auto &inst = InstanceOf(page_id);
+  std::unique_lock lock(inst.latch_);
+  WaitForWriteBack(inst, page_id, lock);
+  auto it = inst.page_table_.find(page_id);
+  if (it == inst.page_table_.end()) {
+    return false;
+  }
+
+  // Pin the frame so that it cannot be evicted while the write is in flight.
+  frame_id_t frame_id = it->second;
+  Page *page = &pages_[frame_id];
+  page->pin_count_++;
+  inst.replacer_->SetEvictable(LocalFrameId(inst, frame_id), false);
+  WaitForIO(inst, frame_id, lock);
+  page->is_dirty_ = false;
+  lock.unlock();
+
+  bool written = disk_scheduler_->ScheduleWrite(page_id, page->GetData()).get();
+
+  lock.lock();
+  if (!written) {
+    page->is_dirty_ = true;
+  }
+  UnpinFrame(inst, frame_id);
+  return written;
+}
+
+void BufferPoolManager::FlushAllPages() {
+  for (auto &inst : instances_) {
+    std::unique_lock lock(inst->latch_);
+    std::vector<frame_id_t> frames;
+    frames.reserve(inst->page_table_.size());
+    for (const auto &[page_id, frame_id] : inst->page_table_) {
+      pages_[frame_id].pin_count_++;
+      inst->replacer_->SetEvictable(LocalFrameId(*inst, frame_id), false);
+      frames.push_back(frame_id);
+    }
+
+    std::vector<DiskRequest> requests;
+    std::vector<std::future<bool>> futures;
+    for (auto frame_id : frames) {
+      WaitForIO(*inst, frame_id, lock);
+      Page *page = &pages_[frame_id];
+      page->is_dirty_ = false;
+      auto promise = disk_scheduler_->CreatePromise();
+      futures.emplace_back(promise.get_future());
+      requests.push_back({/*is_write=*/true, page->GetData(), page->page_id_, std::move(promise)});
+    }
+
+    // Issue the whole instance as one batch and wait for it without holding the latch.
+    lock.unlock();
+    disk_scheduler_->ScheduleBatch(std::move(requests));
+    std::vector<bool> written;
+    written.reserve(futures.size());
+    for (auto &future : futures) {
+      written.push_back(future.get());
+    }
+
+    lock.lock();
+    for (size_t i = 0; i < frames.size(); i++) {
+      if (!written[i]) {
+        pages_[frames[i]].is_dirty_ = true;
+      }
+      UnpinFrame(*inst, frames[i]);
+    }
+  }
+}
+
+auto BufferPoolManager::DeletePage(page_id_t page_id) -> bool {
+  if (page_id == INVALID_PAGE_ID) {
+    return true;
+  }
+  auto &inst = InstanceOf(page_id);
+  std::unique_lock lock(inst.latch_);
+  WaitForWriteBack(inst, page_id, lock);
+  auto it = inst.page_table_.find(page_id);
+  if (it == inst.page_table_.end()) {
+    return true;
+  }
+  frame_id_t frame_id = it->second;
+  Page *page = &pages_[frame_id];
+  if (page->pin_count_ > 0) {
+    return false;
+  }
+
+  inst.page_table_.erase(it);
+  inst.replacer_->Remove(LocalFrameId(inst, frame_id));
+  LeaveScanRing(inst, frame_id);
+  if (inst.read_ahead_[LocalFrameId(inst, frame_id)]) {
+    inst.read_ahead_[LocalFrameId(inst, frame_id)] = false;
+    read_ahead_wasted_++;
+  }
+  inst.free_list_.push_back(frame_id);
+  page->ResetMemory();
+  page->page_id_ = INVALID_PAGE_ID;
+  page->BumpVersion();
+  page->pin_count_ = 0;
+  page->is_dirty_ = false;
+  DeallocatePage(page_id);
+  return true;
 }
 
-auto BufferPoolManager::FlushPage(page_id_t page_id) -> bool { return false; }
+auto BufferPoolManager::AllocatePage(BufferPoolInstance &inst) -> page_id_t {
+  page_id_t page_id = inst.next_page_id_;
+  inst.next_page_id_ += static_cast<page_id_t>(instances_.size());
+  return page_id;
+}
 
-void BufferPoolManager::FlushAllPages() {}
+void BufferPoolManager::ReadAhead(page_id_t page_id, size_t count, NextPageIdFn next_page_id) {
+  // Reading further ahead than the scan ring can hold would make the scan recycle its own read-ahead pages.
+  if (scan_ring_size_ > 0) {
+    count = std::min<size_t>(count, scan_ring_size_);
+  }
+  if (page_id == INVALID_PAGE_ID || count == 0) {
+    return;
+  }
+  read_ahead_queue_.Put(ReadAheadRequest{page_id, count, std::move(next_page_id)});
+}
 
-auto BufferPoolManager::DeletePage(page_id_t page_id) -> bool { return false; }
+void BufferPoolManager::ReadAheadWorker() {
+  while (true) {
+    auto request = read_ahead_queue_.Get();
+    if (!request.has_value()) {
+      return;
+    }
+    // Walking a chain is inherently sequential: the next page id is only known once the current page is in memory.
+    page_id_t page_id = request->page_id_;
+    for (size_t i = 0; i < request->count_ && page_id != INVALID_PAGE_ID; i++) {
+      Page *page = FetchPageImpl(page_id, AccessType::Scan, true);
+      if (page == nullptr) {
+        break;
+      }
+      page->RLatch();
+      page_id_t next_page_id = request->next_page_id_(page->GetData());
+      page->RUnlatch();
+      UnpinPage(page_id, false, AccessType::Scan);
+      page_id = next_page_id;
+    }
+  }
+}
 
-auto BufferPoolManager::AllocatePage() -> page_id_t { return next_page_id_++; }
+auto BufferPoolManager::GetBackgroundWriterOptions() -> BackgroundWriterOptions {
+  std::scoped_lock lock(bg_writer_latch_);
+  return bg_writer_options_;
+}
 
-auto BufferPoolManager::FetchPageBasic(page_id_t page_id) -> BasicPageGuard { return {this, nullptr}; }
+void BufferPoolManager::SetBackgroundWriterOptions(const BackgroundWriterOptions &options) {
+  BUSTUB_ENSURE(options.low_watermark_ <= options.high_watermark_, "low watermark above high watermark");
+  {
+    std::scoped_lock lock(bg_writer_latch_);
+    bg_writer_options_ = options;
+    bg_writer_kicked_ = true;
+  }
+  bg_writer_cv_.notify_one();
+}
+
+void BufferPoolManager::BackgroundWriterWorker() {
+  std::unique_lock lock(bg_writer_latch_);
+  bool catching_up = false;
+  while (!bg_writer_stop_) {
+    if (bg_writer_options_.interval_.count() == 0) {
+      catching_up = false;
+      bg_writer_cv_.wait(lock, [&] { return bg_writer_stop_ || bg_writer_options_.interval_.count() > 0; });
+      continue;
+    }
+    if (!catching_up) {
+      bg_writer_cv_.wait_for(lock, bg_writer_options_.interval_,
+                             [&] { return bg_writer_stop_ || bg_writer_kicked_.load(); });
+      bg_writer_kicked_ = false;
+      if (bg_writer_stop_ || bg_writer_options_.interval_.count() == 0) {
+        continue;
+      }
+    }
+    auto options = bg_writer_options_;
+    lock.unlock();
 
-auto BufferPoolManager::FetchPageRead(page_id_t page_id) -> ReadPageGuard { return {this, nullptr}; }
+    auto dirty_fraction = CountDirtyFrames() / static_cast<double>(std::max<size_t>(pool_size_, 1));
+    catching_up = dirty_fraction > options.high_watermark_ || (catching_up && dirty_fraction > options.low_watermark_);
+    size_t share = (options.max_pages_per_round_ + instances_.size() - 1) / instances_.size();
+    size_t written = 0;
+    for (auto &inst : instances_) {
+      written += catching_up ? CleanEvictionCandidates(*inst, inst->num_frames_, inst->num_frames_)
+                             : CleanEvictionCandidates(*inst, share, share);
+    }
+    bg_writer_rounds_++;
+    bg_writer_pages_written_ += written;
+    if (written == 0) {
+      // Whatever is dirty is pinned or not covered by the log yet; retrying right away would only spin.
+      catching_up = false;
+    }
+    lock.lock();
+  }
+}
 
-auto BufferPoolManager::FetchPageWrite(page_id_t page_id) -> WritePageGuard { return {this, nullptr}; }
+auto BufferPoolManager::CleanEvictionCandidates(BufferPoolInstance &inst, size_t lookahead, size_t max_pages)
+    -> size_t {
+  std::vector<std::unique_ptr<char[]>> copies;
+  std::vector<std::future<bool>> writes;
+  std::vector<page_id_t> written_pages;
+  {
+    std::scoped_lock lock(inst.latch_);
+    bool wal = enable_logging && log_manager_ != nullptr;
+    for (auto local_frame_id : inst.replacer_->EvictionCandidates(lookahead)) {
+      if (writes.size() >= max_pages) {
+        break;
+      }
+      // An unpinned page cannot be modified without first taking the latch we hold, so the copy is consistent.
+      Page *page = &pages_[inst.frame_offset_ + local_frame_id];
+      if (!page->is_dirty_ || page->pin_count_ > 0) {
+        continue;
+      }
+      if (wal && page->GetLSN() > log_manager_->GetPersistentLSN()) {
+        continue;
+      }
+      copies.push_back(std::make_unique<char[]>(BUSTUB_PAGE_SIZE));
+      memcpy(copies.back().get(), page->GetData(), BUSTUB_PAGE_SIZE);
+      page->is_dirty_ = false;
+      writes.push_back(disk_scheduler_->ScheduleWrite(page->page_id_, copies.back().get()));
+      written_pages.push_back(page->page_id_);
+      inst.writing_back_.insert(page->page_id_);
+    }
+  }
+  if (writes.empty()) {
+    return 0;
+  }
+  std::vector<bool> written;
+  written.reserve(writes.size());
+  for (auto &write : writes) {
+    written.push_back(write.get());
+  }
+
+  size_t num_written = 0;
+  std::scoped_lock lock(inst.latch_);
+  for (size_t i = 0; i < written_pages.size(); i++) {
+    page_id_t page_id = written_pages[i];
+    inst.writing_back_.erase(inst.writing_back_.find(page_id));
+    if (written[i]) {
+      num_written++;
+      continue;
+    }
+    // A page evicted meanwhile was written again from its frame, and is back in the page table, dirty, if that failed
+    // too; one still resident is dirtied again.
+    LOG_WARN("failed to write back page %d, keeping it dirty", page_id);
+    auto it = inst.page_table_.find(page_id);
+    if (it != inst.page_table_.end()) {
+      pages_[it->second].is_dirty_ = true;
+    }
+  }
+  inst.io_cv_.notify_all();
+  return num_written;
+}
+
+auto BufferPoolManager::CountDirtyFrames() -> size_t {
+  size_t dirty = 0;
+  for (auto &inst : instances_) {
+    std::scoped_lock lock(inst->latch_);
+    for (const auto &[page_id, frame_id] : inst->page_table_) {
+      dirty += pages_[frame_id].is_dirty_ ? 1 : 0;
+    }
+  }
+  return dirty;
+}
+
+auto BufferPoolManager::FetchPageBasic(page_id_t page_id, AccessType access_type) -> BasicPageGuard {
+  return {this, FetchPage(page_id, access_type)};
+}
+
+auto BufferPoolManager::FetchPageRead(page_id_t page_id, AccessType access_type) -> ReadPageGuard {
+  Page *page = FetchPage(page_id, access_type);
+  if (page != nullptr) {
+    page->RLatch();
+  }
+  return {this, page};
+}
+
+auto BufferPoolManager::FetchPageWrite(page_id_t page_id, AccessType access_type) -> WritePageGuard {
+  Page *page = FetchPage(page_id, access_type);
+  if (page != nullptr) {
+    page->WLatch();
+  }
+  return {this, page};
+}
 
-auto BufferPoolManager::NewPageGuarded(page_id_t *page_id) -> BasicPageGuard { return {this, nullptr}; }
+auto BufferPoolManager::NewPageGuarded(page_id_t *page_id) -> BasicPageGuard { return {this, NewPage(page_id)}; }
 
 }  // namespace bustub
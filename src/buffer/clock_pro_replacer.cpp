@@ -0,0 +1,262 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// clock_pro_replacer.cpp
+//
+// Identification: src/buffer/clock_pro_replacer.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/clock_pro_replacer.h"
+
+#include <algorithm>
+
+#include "common/exception.h"
+
+namespace bustub {
+
+ClockProReplacer::ClockProReplacer(size_t num_frames)
+    : hand_hot_(clock_.end()),
+      hand_cold_(clock_.end()),
+      hand_test_(clock_.end()),
+      resident_(num_frames),
+      tracked_(num_frames, false),
+      evictable_(num_frames, false),
+      page_ids_(num_frames, INVALID_PAGE_ID),
+      capacity_(num_frames),
+      cold_target_(std::max<size_t>(num_frames / 4, 1)) {}
+
+void ClockProReplacer::CheckFrameId(frame_id_t frame_id) const {
+  BUSTUB_ASSERT(frame_id >= 0 && static_cast<size_t>(frame_id) < tracked_.size(), "invalid frame id");
+}
+
+auto ClockProReplacer::Next(EntryIter it) -> EntryIter {
+  ++it;
+  return it == clock_.end() ? clock_.begin() : it;
+}
+
+auto ClockProReplacer::InsertAtHead(Entry entry) -> EntryIter {
+  if (clock_.empty()) {
+    auto it = clock_.insert(clock_.end(), entry);
+    hand_hot_ = hand_cold_ = hand_test_ = it;
+    return it;
+  }
+  return clock_.insert(hand_hot_, entry);
+}
+
+void ClockProReplacer::MoveToHead(EntryIter it) {
+  if (clock_.size() == 1) {
+    return;
+  }
+  for (auto *hand : {&hand_hot_, &hand_cold_, &hand_test_}) {
+    if (*hand == it) {
+      *hand = Next(it);
+    }
+  }
+  clock_.splice(hand_hot_, clock_, it);
+}
+
+void ClockProReplacer::EraseEntry(EntryIter it) {
+  if (it->frame_id_ == INVALID_PAGE_ID) {
+    non_resident_.erase(it->page_id_);
+  }
+  if (clock_.size() == 1) {
+    clock_.clear();
+    hand_hot_ = hand_cold_ = hand_test_ = clock_.end();
+    return;
+  }
+  for (auto *hand : {&hand_hot_, &hand_cold_, &hand_test_}) {
+    if (*hand == it) {
+      *hand = Next(it);
+    }
+  }
+  clock_.erase(it);
+}
+
+void ClockProReplacer::EndTest(EntryIter it) {
+  it->in_test_ = false;
+  cold_target_ = std::max<size_t>(cold_target_ - 1, 1);
+  if (it->frame_id_ == INVALID_PAGE_ID) {
+    EraseEntry(it);
+  }
+}
+
+void ClockProReplacer::RunHandHot(size_t min_demotions) {
+  size_t demoted = 0;
+  while (num_hot_ > 0 && (demoted < min_demotions || num_hot_ > capacity_ - cold_target_)) {
+    auto it = hand_hot_;
+    hand_hot_ = Next(hand_hot_);
+    if (it->hot_) {
+      if (it->referenced_) {
+        it->referenced_ = false;
+      } else {
+        it->hot_ = false;
+        num_hot_--;
+        demoted++;
+      }
+    } else if (it->in_test_) {
+      EndTest(it);
+    }
+  }
+}
+
+void ClockProReplacer::RunHandTest() {
+  while (non_resident_.size() > capacity_) {
+    auto it = hand_test_;
+    hand_test_ = Next(hand_test_);
+    if (!it->hot_ && it->in_test_) {
+      EndTest(it);
+    }
+  }
+}
+
+void ClockProReplacer::Promote(EntryIter it) {
+  it->hot_ = true;
+  it->referenced_ = false;
+  it->in_test_ = false;
+  num_hot_++;
+  cold_target_ = std::min(cold_target_ + 1, capacity_);
+  MoveToHead(it);
+  RunHandHot(0);
+}
+
+auto ClockProReplacer::Evict(frame_id_t *frame_id) -> bool {
+  std::scoped_lock lock(latch_);
+  if (curr_size_ == 0) {
+    return false;
+  }
+  size_t steps = 0;
+  while (true) {
+    if (steps++ > clock_.size()) {
+      // A whole revolution found no evictable cold page, so the evictable frames must all be hot.
+      RunHandHot(1);
+      steps = 0;
+    }
+    auto it = hand_cold_;
+    hand_cold_ = Next(hand_cold_);
+    if (it->hot_ || it->frame_id_ == INVALID_PAGE_ID || !evictable_[it->frame_id_]) {
+      continue;
+    }
+    if (it->referenced_) {
+      if (it->in_test_) {
+        Promote(it);
+      } else {
+        it->referenced_ = false;
+        it->in_test_ = true;
+        MoveToHead(it);
+      }
+      continue;
+    }
+
+    auto fid = it->frame_id_;
+    if (it->in_test_ && it->page_id_ != INVALID_PAGE_ID && non_resident_.count(it->page_id_) == 0) {
+      // Keep the page on the clock until its test period ends, in case it is loaded again.
+      it->frame_id_ = INVALID_PAGE_ID;
+      non_resident_[it->page_id_] = it;
+      RunHandTest();
+    } else {
+      EraseEntry(it);
+    }
+    tracked_[fid] = false;
+    evictable_[fid] = false;
+    page_ids_[fid] = INVALID_PAGE_ID;
+    curr_size_--;
+    *frame_id = fid;
+    return true;
+  }
+}
+
+void ClockProReplacer::RecordAccess(frame_id_t frame_id, AccessType access_type) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  if (tracked_[frame_id]) {
+    auto it = resident_[frame_id];
+    if (it->hot_ || access_type != AccessType::Scan) {
+      it->referenced_ = true;
+    }
+    return;
+  }
+
+  tracked_[frame_id] = true;
+  auto page_id = page_ids_[frame_id];
+  auto non_resident = page_id == INVALID_PAGE_ID ? non_resident_.end() : non_resident_.find(page_id);
+  if (non_resident != non_resident_.end()) {
+    // The page is back within its test period: its reuse distance is short enough for it to be hot.
+    auto it = non_resident->second;
+    non_resident_.erase(non_resident);
+    it->frame_id_ = frame_id;
+    resident_[frame_id] = it;
+    Promote(it);
+    return;
+  }
+  resident_[frame_id] = InsertAtHead(Entry{frame_id, page_id, false, false, true});
+}
+
+void ClockProReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  if (!tracked_[frame_id] || evictable_[frame_id] == set_evictable) {
+    return;
+  }
+  evictable_[frame_id] = set_evictable;
+  if (set_evictable) {
+    curr_size_++;
+  } else {
+    curr_size_--;
+  }
+}
+
+auto ClockProReplacer::IsEvictable(frame_id_t frame_id) -> bool {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  return evictable_[frame_id];
+}
+
+void ClockProReplacer::Remove(frame_id_t frame_id) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  if (!tracked_[frame_id]) {
+    return;
+  }
+  if (!evictable_[frame_id]) {
+    throw Exception(ExceptionType::INVALID, "cannot remove a non-evictable frame");
+  }
+  auto it = resident_[frame_id];
+  if (it->hot_) {
+    num_hot_--;
+  }
+  EraseEntry(it);
+  tracked_[frame_id] = false;
+  evictable_[frame_id] = false;
+  page_ids_[frame_id] = INVALID_PAGE_ID;
+  curr_size_--;
+}
+
+void ClockProReplacer::SetPageId(frame_id_t frame_id, page_id_t page_id) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  page_ids_[frame_id] = page_id;
+}
+
+auto ClockProReplacer::EvictionCandidates(size_t max_candidates) -> std::vector<frame_id_t> {
+  std::scoped_lock lock(latch_);
+  // HAND_cold evicts the unreferenced cold pages it meets; referenced ones get another test period or turn hot.
+  std::vector<frame_id_t> candidates;
+  auto it = hand_cold_;
+  for (size_t i = 0; i < clock_.size() && candidates.size() < max_candidates; i++, it = Next(it)) {
+    if (!it->hot_ && !it->referenced_ && it->frame_id_ != INVALID_PAGE_ID && evictable_[it->frame_id_]) {
+      candidates.push_back(it->frame_id_);
+    }
+  }
+  return candidates;
+}
+
+auto ClockProReplacer::Size() -> size_t {
+  std::scoped_lock lock(latch_);
+  return curr_size_;
+}
+
+}  // namespace bustub
@@ -11,19 +11,104 @@
 //===----------------------------------------------------------------------===//
 
 #include "buffer/clock_replacer.h"
+#include "common/exception.h"
 
 namespace bustub {
 
-ClockReplacer::ClockReplacer(size_t num_pages) {}
+ClockReplacer::ClockReplacer(size_t num_pages)
+    : tracked_(num_pages, false), evictable_(num_pages, false), referenced_(num_pages, false) {}
 
 ClockReplacer::~ClockReplacer() = default;
 
-auto ClockReplacer::Victim(frame_id_t *frame_id) -> bool { return false; }
+void ClockReplacer::CheckFrameId(frame_id_t frame_id) const {
+  BUSTUB_ASSERT(frame_id >= 0 && static_cast<size_t>(frame_id) < tracked_.size(), "invalid frame id");
+}
 
-void ClockReplacer::Pin(frame_id_t frame_id) {}
+auto ClockReplacer::Evict(frame_id_t *frame_id) -> bool {
+  std::scoped_lock lock(latch_);
+  if (curr_size_ == 0) {
+    return false;
+  }
+  // Every evictable frame has its reference bit cleared within one revolution, so two are always enough.
+  for (size_t step = 0; step < 2 * tracked_.size(); step++) {
+    auto fid = hand_;
+    hand_ = (hand_ + 1) % tracked_.size();
+    if (!evictable_[fid]) {
+      continue;
+    }
+    if (referenced_[fid]) {
+      referenced_[fid] = false;
+      continue;
+    }
+    tracked_[fid] = false;
+    evictable_[fid] = false;
+    curr_size_--;
+    *frame_id = static_cast<frame_id_t>(fid);
+    return true;
+  }
+  UNREACHABLE("curr_size_ is positive but no evictable frame was found");
+}
 
-void ClockReplacer::Unpin(frame_id_t frame_id) {}
+void ClockReplacer::RecordAccess(frame_id_t frame_id, [[maybe_unused]] AccessType access_type) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  tracked_[frame_id] = true;
+  referenced_[frame_id] = true;
+}
 
-auto ClockReplacer::Size() -> size_t { return 0; }
+void ClockReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  if (!tracked_[frame_id] || evictable_[frame_id] == set_evictable) {
+    return;
+  }
+  evictable_[frame_id] = set_evictable;
+  if (set_evictable) {
+    curr_size_++;
+  } else {
+    curr_size_--;
+  }
+}
+
+auto ClockReplacer::IsEvictable(frame_id_t frame_id) -> bool {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  return evictable_[frame_id];
+}
+
+void ClockReplacer::Remove(frame_id_t frame_id) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  if (!tracked_[frame_id]) {
+    return;
+  }
+  if (!evictable_[frame_id]) {
+    throw Exception(ExceptionType::INVALID, "cannot remove a non-evictable frame");
+  }
+  tracked_[frame_id] = false;
+  evictable_[frame_id] = false;
+  referenced_[frame_id] = false;
+  curr_size_--;
+}
+
+auto ClockReplacer::EvictionCandidates(size_t max_candidates) -> std::vector<frame_id_t> {
+  std::scoped_lock lock(latch_);
+  // The hand takes the unreferenced frames on its first revolution and the referenced ones on its second.
+  std::vector<frame_id_t> candidates;
+  for (bool referenced : {false, true}) {
+    for (size_t i = 0; i < tracked_.size() && candidates.size() < max_candidates; i++) {
+      auto fid = (hand_ + i) % tracked_.size();
+      if (evictable_[fid] && referenced_[fid] == referenced) {
+        candidates.push_back(static_cast<frame_id_t>(fid));
+      }
+    }
+  }
+  return candidates;
+}
+
+auto ClockReplacer::Size() -> size_t {
+  std::scoped_lock lock(latch_);
+  return curr_size_;
+}
 
 }  // namespace bustub
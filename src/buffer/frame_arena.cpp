@@ -0,0 +1,174 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// frame_arena.cpp
+//
+// Identification: src/buffer/frame_arena.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/frame_arena.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+
+#include "common/exception.h"
+#include "common/util/string_util.h"
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+namespace bustub {
+
+namespace {
+
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+/** @return the nodes the kernel may ever report, as listed in sysfs; empty if the machine is not NUMA-aware */
+auto PossibleNumaNodes() -> std::vector<int> {
+  std::ifstream in("/sys/devices/system/node/possible");
+  std::string ranges;
+  std::vector<int> nodes;
+  if (!std::getline(in, ranges)) {
+    return nodes;
+  }
+  // The list looks like "0-3,8,10-11".
+  for (const auto &range : StringUtil::Split(ranges, ',')) {
+    auto bounds = StringUtil::Split(range, '-');
+    int first = std::stoi(bounds[0]);
+    int last = bounds.size() > 1 ? std::stoi(bounds[1]) : first;
+    for (int node = first; node <= last; node++) {
+      nodes.push_back(node);
+    }
+  }
+  return nodes;
+}
+
+}  // namespace
+
+FrameArena::FrameArena(size_t num_frames, const FrameArenaOptions &options) : options_(options) {
+  if (options_.allocation_ == FrameAllocation::Heap) {
+    heap_frames_.reserve(num_frames);
+    for (size_t i = 0; i < num_frames; i++) {
+      heap_frames_.emplace_back(new char[BUSTUB_PAGE_SIZE]());
+    }
+    return;
+  }
+
+  region_size_ = std::max<size_t>(num_frames, 1) * BUSTUB_PAGE_SIZE;
+  if (options_.allocation_ == FrameAllocation::HugePages) {
+    region_size_ = (region_size_ + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+#ifdef MAP_HUGETLB
+    // Reserved huge pages are guaranteed to stay huge, but only exist if the administrator set some aside.
+    void *region =
+        mmap(nullptr, region_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (region != MAP_FAILED) {
+      region_ = static_cast<char *>(region);
+      huge_pages_ = true;
+    }
+#endif
+    if (region_ == nullptr) {
+      region_ = MapAligned(region_size_, HUGE_PAGE_SIZE);
+#ifdef MADV_HUGEPAGE
+      huge_pages_ = region_ != nullptr && madvise(region_, region_size_, MADV_HUGEPAGE) == 0;
+#endif
+    }
+  } else {
+    region_ = MapAligned(region_size_, BUSTUB_PAGE_SIZE);
+  }
+  if (region_ == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot map the buffer pool frames");
+  }
+
+  // The policy has to be in place before the frames are first touched, which is when the kernel picks their node.
+  if (options_.numa_policy_ != NumaPolicy::Default && ApplyNumaPolicy()) {
+    numa_policy_ = options_.numa_policy_;
+  }
+}
+
+FrameArena::~FrameArena() {
+  if (region_ != nullptr) {
+    munmap(region_, region_size_);
+  }
+}
+
+auto FrameArena::MapAligned(size_t size, size_t alignment) -> char * {
+  // Over-map by the alignment, then give back the unaligned head and the tail.
+  size_t mapped_size = size + alignment;
+  void *mapped = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapped == MAP_FAILED) {
+    return nullptr;
+  }
+  auto start = reinterpret_cast<uintptr_t>(mapped);
+  auto aligned = (start + alignment - 1) / alignment * alignment;
+  if (aligned > start) {
+    munmap(mapped, aligned - start);
+  }
+  size_t tail = start + mapped_size - (aligned + size);
+  if (tail > 0) {
+    munmap(reinterpret_cast<void *>(aligned + size), tail);
+  }
+  return reinterpret_cast<char *>(aligned);
+}
+
+auto FrameArena::ApplyNumaPolicy() -> bool {
+#if defined(__linux__) && defined(SYS_mbind)
+  // Values of MPOL_BIND and MPOL_INTERLEAVE in linux/mempolicy.h; calling mbind directly avoids depending on libnuma.
+  constexpr int mpol_bind = 2;
+  constexpr int mpol_interleave = 3;
+  constexpr size_t bits_per_word = 8 * sizeof(unsigned long);  // NOLINT
+
+  auto nodes = PossibleNumaNodes();
+  if (options_.numa_policy_ == NumaPolicy::Bind) {
+    if (options_.numa_node_ < 0) {
+      return false;
+    }
+    nodes = {options_.numa_node_};
+  }
+  if (nodes.empty()) {
+    return false;
+  }
+  int max_node = *std::max_element(nodes.begin(), nodes.end());
+  std::vector<unsigned long> mask(max_node / bits_per_word + 1, 0);  // NOLINT
+  for (auto node : nodes) {
+    mask[node / bits_per_word] |= 1UL << (node % bits_per_word);
+  }
+  int mode = options_.numa_policy_ == NumaPolicy::Bind ? mpol_bind : mpol_interleave;
+  // The kernel ignores the last bit of maxnode, hence the + 2.
+  return syscall(SYS_mbind, region_, region_size_, mode, mask.data(), max_node + 2, 0) == 0;
+#else
+  return false;
+#endif
+}
+
+auto FrameAllocationFromString(const std::string &name) -> FrameAllocation {
+  auto lower = StringUtil::Lower(name);
+  for (auto allocation : {FrameAllocation::Heap, FrameAllocation::Contiguous, FrameAllocation::HugePages}) {
+    if (lower == FrameAllocationToString(allocation)) {
+      return allocation;
+    }
+  }
+  throw Exception(ExceptionType::INVALID, "unknown frame allocation: " + name);
+}
+
+auto FrameAllocationToString(FrameAllocation allocation) -> std::string {
+  switch (allocation) {
+    case FrameAllocation::Heap:
+      return "heap";
+    case FrameAllocation::Contiguous:
+      return "contiguous";
+    case FrameAllocation::HugePages:
+      return "huge_pages";
+  }
+  UNREACHABLE("unknown frame allocation");
+}
+
+}  // namespace bustub
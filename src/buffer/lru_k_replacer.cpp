@@ -11,20 +11,191 @@
 //===----------------------------------------------------------------------===//
 
 #include "buffer/lru_k_replacer.h"
+
+#include <algorithm>
+
 #include "common/exception.h"
 
 namespace bustub {
 
-LRUKReplacer::LRUKReplacer(size_t num_frames, size_t k) : replacer_size_(num_frames), k_(k) {}
+LRUKReplacer::FrameHeap::FrameHeap(size_t num_frames) : pos_(num_frames, NPOS) { heap_.reserve(num_frames); }
+
+void LRUKReplacer::FrameHeap::Push(frame_id_t frame_id, size_t key) {
+  pos_[frame_id] = heap_.size();
+  heap_.emplace_back(key, frame_id);
+  SiftUp(heap_.size() - 1);
+}
+
+void LRUKReplacer::FrameHeap::Erase(frame_id_t frame_id) {
+  auto i = pos_[frame_id];
+  auto last = heap_.size() - 1;
+  if (i != last) {
+    Swap(i, last);
+  }
+  heap_.pop_back();
+  pos_[frame_id] = NPOS;
+  if (i != last) {
+    SiftUp(i);
+    SiftDown(i);
+  }
+}
+
+void LRUKReplacer::FrameHeap::AppendSmallest(size_t n, std::vector<frame_id_t> *out) const {
+  n = std::min(n, heap_.size());
+  std::vector<std::pair<size_t, frame_id_t>> smallest(n);
+  std::partial_sort_copy(heap_.begin(), heap_.end(), smallest.begin(), smallest.end());
+  for (const auto &[key, frame_id] : smallest) {
+    out->push_back(frame_id);
+  }
+}
+
+void LRUKReplacer::FrameHeap::Swap(size_t i, size_t j) {
+  std::swap(heap_[i], heap_[j]);
+  pos_[heap_[i].second] = i;
+  pos_[heap_[j].second] = j;
+}
+
+void LRUKReplacer::FrameHeap::SiftUp(size_t i) {
+  while (i > 0) {
+    auto parent = (i - 1) / 2;
+    if (heap_[parent].first <= heap_[i].first) {
+      return;
+    }
+    Swap(i, parent);
+    i = parent;
+  }
+}
+
+void LRUKReplacer::FrameHeap::SiftDown(size_t i) {
+  while (true) {
+    auto smallest = i;
+    for (auto child : {2 * i + 1, 2 * i + 2}) {
+      if (child < heap_.size() && heap_[child].first < heap_[smallest].first) {
+        smallest = child;
+      }
+    }
+    if (smallest == i) {
+      return;
+    }
+    Swap(i, smallest);
+    i = smallest;
+  }
+}
+
+LRUKReplacer::LRUKReplacer(size_t num_frames, size_t k)
+    : history_(std::make_unique<std::atomic<size_t>[]>(num_frames * k)),
+      access_count_(std::make_unique<std::atomic<size_t>[]>(num_frames)),
+      evictable_(std::make_unique<std::atomic<bool>[]>(num_frames)),
+      cold_(num_frames),
+      hot_(num_frames),
+      replacer_size_(num_frames),
+      k_(k) {
+  BUSTUB_ASSERT(k > 0, "k must be positive");
+}
+
+auto LRUKReplacer::Key(frame_id_t frame_id) const -> size_t {
+  auto count = access_count_[frame_id].load();
+  // The k-th most recent access sits in the slot the next access will overwrite.
+  auto slot = count < k_ ? 0 : count % k_;
+  return history_[frame_id * k_ + slot].load();
+}
+
+void LRUKReplacer::Track(frame_id_t frame_id) {
+  if (access_count_[frame_id].load() < k_) {
+    cold_.Push(frame_id, Key(frame_id));
+  } else {
+    hot_.Push(frame_id, Key(frame_id));
+  }
+}
+
+void LRUKReplacer::Untrack(frame_id_t frame_id) {
+  if (cold_.Contains(frame_id)) {
+    cold_.Erase(frame_id);
+  } else if (hot_.Contains(frame_id)) {
+    hot_.Erase(frame_id);
+  }
+}
+
+auto LRUKReplacer::Evict(frame_id_t *frame_id) -> bool {
+  std::scoped_lock lock(latch_);
+  // Frames with +inf backward k-distance go first, earliest first access first; otherwise the earliest k-th most
+  // recent access has the largest backward k-distance.
+  auto &heap = cold_.Empty() ? hot_ : cold_;
+  if (heap.Empty()) {
+    return false;
+  }
+  *frame_id = heap.Top();
+  heap.Erase(*frame_id);
+  evictable_[*frame_id].store(false);
+  access_count_[*frame_id].store(0);
+  curr_size_--;
+  return true;
+}
+
+void LRUKReplacer::RecordAccess(frame_id_t frame_id, [[maybe_unused]] AccessType access_type) {
+  BUSTUB_ASSERT(frame_id >= 0 && static_cast<size_t>(frame_id) < replacer_size_, "invalid frame id");
+  auto timestamp = current_timestamp_.fetch_add(1);
+  auto count = access_count_[frame_id].fetch_add(1);
+  history_[frame_id * k_ + count % k_].store(timestamp);
+
+  // SetEvictable publishes the flag before reading the history, and we read the flag after writing the history, so
+  // either it sees this access or we see the flag and re-key the frame here.
+  if (!evictable_[frame_id].load()) {
+    return;
+  }
+  std::scoped_lock lock(latch_);
+  if (evictable_[frame_id].load()) {
+    Untrack(frame_id);
+    Track(frame_id);
+  }
+}
 
-auto LRUKReplacer::Evict(frame_id_t *frame_id) -> bool { return false; }
+void LRUKReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {
+  BUSTUB_ASSERT(frame_id >= 0 && static_cast<size_t>(frame_id) < replacer_size_, "invalid frame id");
+  std::scoped_lock lock(latch_);
+  if (access_count_[frame_id].load() == 0 || evictable_[frame_id].load() == set_evictable) {
+    return;
+  }
+  evictable_[frame_id].store(set_evictable);
+  if (set_evictable) {
+    Track(frame_id);
+    curr_size_++;
+  } else {
+    Untrack(frame_id);
+    curr_size_--;
+  }
+}
 
-void LRUKReplacer::RecordAccess(frame_id_t frame_id, [[maybe_unused]] AccessType access_type) {}
+auto LRUKReplacer::IsEvictable(frame_id_t frame_id) -> bool {
+  BUSTUB_ASSERT(frame_id >= 0 && static_cast<size_t>(frame_id) < replacer_size_, "invalid frame id");
+  return evictable_[frame_id].load();
+}
 
-void LRUKReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {}
+void LRUKReplacer::Remove(frame_id_t frame_id) {
+  std::scoped_lock lock(latch_);
+  if (frame_id < 0 || static_cast<size_t>(frame_id) >= replacer_size_ || access_count_[frame_id].load() == 0) {
+    return;
+  }
+  if (!evictable_[frame_id].load()) {
+    throw Exception(ExceptionType::INVALID, "cannot remove a non-evictable frame");
+  }
+  Untrack(frame_id);
+  evictable_[frame_id].store(false);
+  access_count_[frame_id].store(0);
+  curr_size_--;
+}
 
-void LRUKReplacer::Remove(frame_id_t frame_id) {}
+auto LRUKReplacer::EvictionCandidates(size_t max_candidates) -> std::vector<frame_id_t> {
+  std::scoped_lock lock(latch_);
+  std::vector<frame_id_t> candidates;
+  cold_.AppendSmallest(max_candidates, &candidates);
+  hot_.AppendSmallest(max_candidates - candidates.size(), &candidates);
+  return candidates;
+}
 
-auto LRUKReplacer::Size() -> size_t { return 0; }
+auto LRUKReplacer::Size() -> size_t {
+  std::scoped_lock lock(latch_);
+  return curr_size_;
+}
 
 }  // namespace bustub
@@ -11,19 +11,89 @@
 //===----------------------------------------------------------------------===//
 
 #include "buffer/lru_replacer.h"
+#include "common/exception.h"
 
 namespace bustub {
 
-LRUReplacer::LRUReplacer(size_t num_pages) {}
+LRUReplacer::LRUReplacer(size_t num_pages) : lru_(num_pages), evictable_(num_pages, false) {}
 
 LRUReplacer::~LRUReplacer() = default;
 
-auto LRUReplacer::Victim(frame_id_t *frame_id) -> bool { return false; }
+void LRUReplacer::CheckFrameId(frame_id_t frame_id) const {
+  BUSTUB_ASSERT(frame_id >= 0 && static_cast<size_t>(frame_id) < evictable_.size(), "invalid frame id");
+}
 
-void LRUReplacer::Pin(frame_id_t frame_id) {}
+auto LRUReplacer::Evict(frame_id_t *frame_id) -> bool {
+  std::scoped_lock lock(latch_);
+  if (curr_size_ == 0) {
+    return false;
+  }
+  for (auto fid = lru_.Front(); fid != INVALID_PAGE_ID; fid = lru_.Next(fid)) {
+    if (evictable_[fid]) {
+      lru_.Erase(fid);
+      evictable_[fid] = false;
+      curr_size_--;
+      *frame_id = fid;
+      return true;
+    }
+  }
+  UNREACHABLE("curr_size_ is positive but no evictable frame was found");
+}
 
-void LRUReplacer::Unpin(frame_id_t frame_id) {}
+void LRUReplacer::RecordAccess(frame_id_t frame_id, [[maybe_unused]] AccessType access_type) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  lru_.MoveToBack(frame_id);
+}
 
-auto LRUReplacer::Size() -> size_t { return 0; }
+void LRUReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  if (!lru_.Contains(frame_id) || evictable_[frame_id] == set_evictable) {
+    return;
+  }
+  evictable_[frame_id] = set_evictable;
+  if (set_evictable) {
+    curr_size_++;
+  } else {
+    curr_size_--;
+  }
+}
+
+auto LRUReplacer::IsEvictable(frame_id_t frame_id) -> bool {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  return evictable_[frame_id];
+}
+
+void LRUReplacer::Remove(frame_id_t frame_id) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  if (!lru_.Contains(frame_id)) {
+    return;
+  }
+  if (!evictable_[frame_id]) {
+    throw Exception(ExceptionType::INVALID, "cannot remove a non-evictable frame");
+  }
+  lru_.Erase(frame_id);
+  evictable_[frame_id] = false;
+  curr_size_--;
+}
+
+auto LRUReplacer::EvictionCandidates(size_t max_candidates) -> std::vector<frame_id_t> {
+  std::scoped_lock lock(latch_);
+  std::vector<frame_id_t> candidates;
+  for (auto fid = lru_.Front(); fid != INVALID_PAGE_ID && candidates.size() < max_candidates; fid = lru_.Next(fid)) {
+    if (evictable_[fid]) {
+      candidates.push_back(fid);
+    }
+  }
+  return candidates;
+}
+
+auto LRUReplacer::Size() -> size_t {
+  std::scoped_lock lock(latch_);
+  return curr_size_;
+}
 
 }  // namespace bustub
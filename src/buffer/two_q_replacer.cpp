@@ -0,0 +1,167 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// two_q_replacer.cpp
+//
+// Identification: src/buffer/two_q_replacer.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/two_q_replacer.h"
+
+#include <algorithm>
+
+#include "common/exception.h"
+
+namespace bustub {
+
+TwoQReplacer::TwoQReplacer(size_t num_frames)
+    : a1in_(num_frames),
+      am_(num_frames),
+      page_ids_(num_frames, INVALID_PAGE_ID),
+      evictable_(num_frames, false),
+      kin_(std::max<size_t>(num_frames / 4, 1)),
+      kout_(std::max<size_t>(num_frames / 2, 1)) {}
+
+void TwoQReplacer::CheckFrameId(frame_id_t frame_id) const {
+  BUSTUB_ASSERT(frame_id >= 0 && static_cast<size_t>(frame_id) < evictable_.size(), "invalid frame id");
+}
+
+auto TwoQReplacer::EvictFrom(FrameList *list, frame_id_t *frame_id) -> bool {
+  for (auto fid = list->Front(); fid != INVALID_PAGE_ID; fid = list->Next(fid)) {
+    if (evictable_[fid]) {
+      list->Erase(fid);
+      *frame_id = fid;
+      return true;
+    }
+  }
+  return false;
+}
+
+auto TwoQReplacer::Evict(frame_id_t *frame_id) -> bool {
+  std::scoped_lock lock(latch_);
+  if (curr_size_ == 0) {
+    return false;
+  }
+  // Take from A1in while it is over its share, falling back to the other list if every frame in one is pinned.
+  FrameList *first = a1in_.Size() > kin_ ? &a1in_ : &am_;
+  FrameList *second = first == &a1in_ ? &am_ : &a1in_;
+  FrameList *from = first;
+  if (!EvictFrom(first, frame_id)) {
+    if (!EvictFrom(second, frame_id)) {
+      UNREACHABLE("curr_size_ is positive but no evictable frame was found");
+    }
+    from = second;
+  }
+  if (from == &a1in_) {
+    a1out_.PushBack(page_ids_[*frame_id]);
+    if (a1out_.Size() > kout_) {
+      a1out_.PopFront();
+    }
+  }
+  page_ids_[*frame_id] = INVALID_PAGE_ID;
+  evictable_[*frame_id] = false;
+  curr_size_--;
+  return true;
+}
+
+void TwoQReplacer::RecordAccess(frame_id_t frame_id, [[maybe_unused]] AccessType access_type) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  if (am_.Contains(frame_id)) {
+    am_.MoveToBack(frame_id);
+    return;
+  }
+  if (a1in_.Contains(frame_id)) {
+    // Re-references while in A1in are assumed to be correlated with the load and say nothing about the page.
+    return;
+  }
+  auto page_id = page_ids_[frame_id];
+  if (a1out_.Contains(page_id)) {
+    a1out_.Erase(page_id);
+    am_.PushBack(frame_id);
+  } else {
+    a1in_.PushBack(frame_id);
+  }
+}
+
+void TwoQReplacer::SetEvictable(frame_id_t frame_id, bool set_evictable) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  if (!IsTracked(frame_id) || evictable_[frame_id] == set_evictable) {
+    return;
+  }
+  evictable_[frame_id] = set_evictable;
+  if (set_evictable) {
+    curr_size_++;
+  } else {
+    curr_size_--;
+  }
+}
+
+auto TwoQReplacer::IsEvictable(frame_id_t frame_id) -> bool {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  return evictable_[frame_id];
+}
+
+void TwoQReplacer::Remove(frame_id_t frame_id) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  if (!IsTracked(frame_id)) {
+    return;
+  }
+  if (!evictable_[frame_id]) {
+    throw Exception(ExceptionType::INVALID, "cannot remove a non-evictable frame");
+  }
+  if (a1in_.Contains(frame_id)) {
+    a1in_.Erase(frame_id);
+  } else {
+    am_.Erase(frame_id);
+  }
+  page_ids_[frame_id] = INVALID_PAGE_ID;
+  evictable_[frame_id] = false;
+  curr_size_--;
+}
+
+void TwoQReplacer::SetPageId(frame_id_t frame_id, page_id_t page_id) {
+  CheckFrameId(frame_id);
+  std::scoped_lock lock(latch_);
+  page_ids_[frame_id] = page_id;
+}
+
+auto TwoQReplacer::EvictionCandidates(size_t max_candidates) -> std::vector<frame_id_t> {
+  std::scoped_lock lock(latch_);
+  auto next_evictable = [this](const FrameList &list, frame_id_t fid) {
+    while (fid != INVALID_PAGE_ID && !evictable_[fid]) {
+      fid = list.Next(fid);
+    }
+    return fid;
+  };
+  // Replay the choice Evict makes between the two lists, with A1in shrinking as frames are taken from it.
+  std::vector<frame_id_t> candidates;
+  auto a1in = next_evictable(a1in_, a1in_.Front());
+  auto am = next_evictable(am_, am_.Front());
+  auto a1in_size = a1in_.Size();
+  while (candidates.size() < max_candidates && (a1in != INVALID_PAGE_ID || am != INVALID_PAGE_ID)) {
+    if (am == INVALID_PAGE_ID || (a1in != INVALID_PAGE_ID && a1in_size > kin_)) {
+      candidates.push_back(a1in);
+      a1in = next_evictable(a1in_, a1in_.Next(a1in));
+      a1in_size--;
+    } else {
+      candidates.push_back(am);
+      am = next_evictable(am_, am_.Next(am));
+    }
+  }
+  return candidates;
+}
+
+auto TwoQReplacer::Size() -> size_t {
+  std::scoped_lock lock(latch_);
+  return curr_size_;
+}
+
+}  // namespace bustub
@@ -51,30 +51,53 @@ void BustubInstance::HandleCreateStatement(Transaction *txn, const CreateStateme
   WriteOneCell(fmt::format("Table created with id = {}", info->oid_), writer);
 }
 
+/** Create an index of the kind the statement asks for over keys of the given size in bytes. */
+template <size_t KeySize>
+static auto CreateGenericIndex(Catalog *catalog, Transaction *txn, const IndexStatement &stmt,
+                               const Schema &key_schema, const std::vector<uint32_t> &col_ids) -> IndexInfo * {
+  return catalog->CreateIndex<GenericKey<KeySize>, RID, GenericComparator<KeySize>>(
+      txn, stmt.index_name_, stmt.table_->table_, stmt.table_->schema_, key_schema, col_ids, KeySize,
+      HashFunction<GenericKey<KeySize>>{}, stmt.index_type_);
+}
+
 void BustubInstance::HandleIndexStatement(Transaction *txn, const IndexStatement &stmt, ResultWriter &writer) {
   std::vector<uint32_t> col_ids;
   for (const auto &col : stmt.cols_) {
     auto idx = stmt.table_->schema_.GetColIdx(col->col_name_.back());
     col_ids.push_back(idx);
-    if (stmt.table_->schema_.GetColumn(idx).GetType() != TypeId::INTEGER) {
-      throw NotImplementedException("only support creating index on integer column");
-    }
   }
   auto key_schema = Schema::CopySchema(&stmt.table_->schema_, col_ids);
 
-  // TODO(spring2023): If you want to support composite index key for leaderboard optimization, remove this assertion
-  // and create index with different key type that can hold multiple keys based on number of index columns.
-  //
-  // You can also create clustered index that directly stores value inside the index by modifying the value type.
+  // TODO(spring2023): You can also create clustered index that directly stores value inside the index by modifying the
+  // value type.
+
+  if (col_ids.empty()) {
+    throw NotImplementedException("only support creating index with at least one column");
+  }
 
-  if (col_ids.empty() || col_ids.size() > 2) {
-    throw NotImplementedException("only support creating index with exactly one or two columns");
+  // Keys get the narrowest key type that holds the longest of them: the inlined columns, then the length and the
+  // characters of each VARCHAR column, terminating zero included. B+ tree pages do not store the zero bytes that pad
+  // the shorter ones.
+  size_t key_size = key_schema.GetLength();
+  for (auto idx : key_schema.GetUnlinedColumns()) {
+    key_size += sizeof(uint32_t) + key_schema.GetColumn(idx).GetVariableLength() + 1;
   }
 
   std::unique_lock<std::shared_mutex> l(catalog_lock_);
-  auto info = catalog_->CreateIndex<IntegerKeyType, IntegerValueType, IntegerComparatorType>(
-      txn, stmt.index_name_, stmt.table_->table_, stmt.table_->schema_, key_schema, col_ids, TWO_INTEGER_SIZE,
-      IntegerHashFunctionType{});
+  IndexInfo *info;
+  if (key_size <= TWO_INTEGER_SIZE) {
+    info = catalog_->CreateIndex<IntegerKeyType, IntegerValueType, IntegerComparatorType>(
+        txn, stmt.index_name_, stmt.table_->table_, stmt.table_->schema_, key_schema, col_ids, TWO_INTEGER_SIZE,
+        IntegerHashFunctionType{}, stmt.index_type_);
+  } else if (key_size <= 16) {
+    info = CreateGenericIndex<16>(catalog_, txn, stmt, key_schema, col_ids);
+  } else if (key_size <= 32) {
+    info = CreateGenericIndex<32>(catalog_, txn, stmt, key_schema, col_ids);
+  } else if (key_size <= 64) {
+    info = CreateGenericIndex<64>(catalog_, txn, stmt, key_schema, col_ids);
+  } else {
+    throw NotImplementedException(fmt::format("index keys of up to {} bytes are longer than 64 bytes", key_size));
+  }
   l.unlock();
 
   if (info == nullptr) {
@@ -133,6 +156,21 @@ void BustubInstance::HandleVariableShowStatement(Transaction *txn, const Variabl
 
 void BustubInstance::HandleVariableSetStatement(Transaction *txn, const VariableSetStatement &stmt,
                                                 ResultWriter &writer) {
+  if (stmt.variable_ == "hash_join_mem" || stmt.variable_ == "sort_mem" || stmt.variable_ == "agg_mem") {
+    // Memory budgets are a positive number of bytes.
+    if (stmt.value_.empty() || stmt.value_.size() > 18 ||
+        stmt.value_.find_first_not_of("0123456789") != std::string::npos || std::stoull(stmt.value_) == 0) {
+      throw Exception(fmt::format("{} must be a positive number of bytes", stmt.variable_));
+    }
+  }
+  if (stmt.variable_ == "parallelism" &&
+      (stmt.value_.empty() || stmt.value_.size() > 4 ||
+       stmt.value_.find_first_not_of("0123456789") != std::string::npos || std::stoul(stmt.value_) == 0)) {
+    throw Exception("parallelism must be a number of threads, from 1 to 9999");
+  }
+  if (stmt.variable_ == "execution_mode" && stmt.value_ != "batch" && stmt.value_ != "tuple") {
+    throw Exception("execution_mode must be batch or tuple");
+  }
   session_variables_[stmt.variable_] = stmt.value_;
 }
 
@@ -39,10 +39,18 @@
 namespace bustub {
 
 auto BustubInstance::MakeExecutorContext(Transaction *txn, bool is_modify) -> std::unique_ptr<ExecutorContext> {
-  return std::make_unique<ExecutorContext>(txn, catalog_, buffer_pool_manager_, txn_manager_, lock_manager_, is_modify);
+  auto exec_ctx =
+      std::make_unique<ExecutorContext>(txn, catalog_, buffer_pool_manager_, txn_manager_, lock_manager_, is_modify);
+  exec_ctx->SetHashJoinMemory(GetNumberVariable("hash_join_mem", HASH_JOIN_MEMORY));
+  exec_ctx->SetSortMemory(GetNumberVariable("sort_mem", SORT_MEMORY));
+  exec_ctx->SetAggregationMemory(GetNumberVariable("agg_mem", AGGREGATION_MEMORY));
+  exec_ctx->SetVectorized(GetSessionVariable("execution_mode") != "tuple");
+  exec_ctx->SetParallelism(GetNumberVariable("parallelism", exec_ctx->GetParallelism()));
+  return exec_ctx;
 }
 
-BustubInstance::BustubInstance(const std::string &db_file_name) {
+BustubInstance::BustubInstance(const std::string &db_file_name, ReplacerPolicy replacer_policy,
+                               const FrameArenaOptions &frame_options) {
   enable_logging = false;
 
   // Storage related.
@@ -54,7 +62,8 @@ BustubInstance::BustubInstance(const std::string &db_file_name) {
   // We need more frames for GenerateTestTable to work. Therefore, we use 128 instead of the default
   // buffer pool size specified in `config.h`.
   try {
-    buffer_pool_manager_ = new BufferPoolManager(128, disk_manager_, LRUK_REPLACER_K, log_manager_);
+    buffer_pool_manager_ =
+        new BufferPoolManager(128, disk_manager_, LRUK_REPLACER_K, log_manager_, 1, replacer_policy, frame_options);
   } catch (NotImplementedException &e) {
     std::cerr << "BufferPoolManager is not implemented, only mock tables are supported." << std::endl;
     buffer_pool_manager_ = nullptr;
@@ -82,7 +91,7 @@ BustubInstance::BustubInstance(const std::string &db_file_name) {
   execution_engine_ = new ExecutionEngine(buffer_pool_manager_, txn_manager_, catalog_);
 }
 
-BustubInstance::BustubInstance() {
+BustubInstance::BustubInstance(ReplacerPolicy replacer_policy, const FrameArenaOptions &frame_options) {
   enable_logging = false;
 
   // Storage related.
@@ -94,7 +103,8 @@ BustubInstance::BustubInstance() {
   // We need more frames for GenerateTestTable to work. Therefore, we use 128 instead of the default
   // buffer pool size specified in `config.h`.
   try {
-    buffer_pool_manager_ = new BufferPoolManager(128, disk_manager_, LRUK_REPLACER_K, log_manager_);
+    buffer_pool_manager_ =
+        new BufferPoolManager(128, disk_manager_, LRUK_REPLACER_K, log_manager_, 1, replacer_policy, frame_options);
   } catch (NotImplementedException &e) {
     std::cerr << "BufferPoolManager is not implemented, only mock tables are supported." << std::endl;
     buffer_pool_manager_ = nullptr;
@@ -357,8 +367,8 @@ BustubInstance::~BustubInstance() {
   delete execution_engine_;
   delete catalog_;
   delete checkpoint_manager_;
-  delete log_manager_;
   delete buffer_pool_manager_;
+  delete log_manager_;
   delete lock_manager_;
   delete txn_manager_;
   delete disk_manager_;
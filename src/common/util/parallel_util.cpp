@@ -0,0 +1,88 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parallel_util.cpp
+//
+// Identification: src/common/util/parallel_util.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/util/parallel_util.h"
+
+#include <algorithm>
+
+namespace bustub {
+
+WorkerPool::WorkerPool(size_t num_workers) {
+  for (size_t i = 0; i < num_workers; i++) {
+    workers_.emplace_back(&WorkerPool::WorkerLoop, this);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::scoped_lock lock(latch_);
+    stop_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void WorkerPool::Run(size_t num_tasks, const std::function<void(size_t)> &task) {
+  Batch batch{&task, num_tasks, 0, 0, std::vector<std::exception_ptr>(num_tasks)};
+  std::unique_lock lock(latch_);
+  batches_.push_back(&batch);
+  work_cv_.notify_all();
+  while (batch.next_ < num_tasks) {
+    RunTask(&batch, batch.next_++, &lock);
+  }
+  // Workers drop the batches they find with no task left, but this one must not outlive the call either way.
+  auto iter = std::find(batches_.begin(), batches_.end(), &batch);
+  if (iter != batches_.end()) {
+    batches_.erase(iter);
+  }
+  done_cv_.wait(lock, [&] { return batch.done_ == num_tasks; });
+  lock.unlock();
+  for (const auto &error : batch.errors_) {
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+void WorkerPool::RunTask(Batch *batch, size_t task, std::unique_lock<std::mutex> *lock) {
+  lock->unlock();
+  try {
+    (*batch->task_)(task);
+  } catch (...) {
+    batch->errors_[task] = std::current_exception();
+  }
+  lock->lock();
+  // The batch may be gone once the last task is done, it is not touched after.
+  if (++batch->done_ == batch->num_tasks_) {
+    done_cv_.notify_all();
+  }
+}
+
+void WorkerPool::WorkerLoop() {
+  std::unique_lock lock(latch_);
+  while (true) {
+    work_cv_.wait(lock, [&] { return stop_ || !batches_.empty(); });
+    if (stop_) {
+      return;
+    }
+    Batch *batch = batches_.front();
+    if (batch->next_ == batch->num_tasks_) {
+      batches_.pop_front();
+      continue;
+    }
+    RunTask(batch, batch->next_++, &lock);
+  }
+}
+
+}  // namespace bustub
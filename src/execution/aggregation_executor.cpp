@@ -1,29 +1,369 @@
-//===----------------------------------------------------------------------===//
-//
-//                         BusTub
-//
-// aggregation_executor.cpp
-//
-// Identification: src/execution/aggregation_executor.cpp
-//
-// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
-//
-//===----------------------------------------------------------------------===//
-#include <memory>
-#include <vector>
-
-#include "execution/executors/aggregation_executor.h"
-
-namespace bustub {
-
-AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
-                                         std::unique_ptr<AbstractExecutor> &&child)
-    : AbstractExecutor(exec_ctx) {}
-
-void AggregationExecutor::Init() {}
-
-auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
-
-auto AggregationExecutor::GetChildExecutor() const -> const AbstractExecutor * { return child_.get(); }
-
-}  // namespace bustub
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_executor.cpp
+//
+// Identification: src/execution/aggregation_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "common/util/parallel_util.h"
+#include "execution/executors/aggregation_executor.h"
+#include "execution/executors/gather_executor.h"
+
+namespace bustub {
+
+AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
+                                         std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_(std::move(child)) {}
+
+void AggregationExecutor::Init() {
+  // A parallel pipeline below is driven here, each of its workers pre-aggregating what it reads on its own thread,
+  // rather than gathered into one stream first.
+  auto *gather = dynamic_cast<GatherExecutor *>(child_.get());
+  MorselPipeline *pipeline = gather != nullptr ? gather->GetPipeline() : nullptr;
+  if (pipeline != nullptr) {
+    pipeline->Init();
+  } else {
+    child_->Init();
+  }
+  results_.clear();
+  partition_index_ = 0;
+  result_index_ = 0;
+  pending_.clear();
+  size_t max_threads = std::max(exec_ctx_->GetParallelism(), pipeline != nullptr ? pipeline->NumWorkers() : 0);
+  locals_ = MakeLocals(max_threads);
+  std::vector<char> exhausted(locals_.size());
+
+  // The child is read on this thread, executors are not thread-safe, a chunk of tuples at a time.
+  std::vector<std::unique_ptr<TmpTupleFile>> spill_files;
+  size_t chunk_rows = max_threads * AGGREGATION_ROWS_PER_THREAD;
+  std::vector<Tuple> chunk;
+  std::vector<TupleBatch> batches;
+  Tuple tuple;
+  RID rid;
+  for (bool more = true; more;) {
+    if (pipeline != nullptr) {
+      more = PreAggregate(pipeline, &exhausted);
+    } else if (exec_ctx_->IsVectorized()) {
+      size_t num_batches = 0;
+      size_t num_rows = 0;
+      while (num_rows < chunk_rows) {
+        if (num_batches == batches.size()) {
+          batches.emplace_back();
+        }
+        if (!(more = child_->NextBatch(&batches[num_batches]))) {
+          break;
+        }
+        num_rows += batches[num_batches++].Size();
+      }
+      batches.resize(num_batches);
+      PreAggregate(batches, num_rows);
+    } else {
+      chunk.clear();
+      while (chunk.size() < chunk_rows && (more = child_->Next(&tuple, &rid))) {
+        chunk.push_back(std::move(tuple));
+      }
+      PreAggregate(chunk);
+    }
+    size_t num_entries = 0;
+    for (const auto &local : locals_) {
+      num_entries += local.num_entries_;
+    }
+    if (!plan_->GetGroupBys().empty() && num_entries * EntryBytes() > exec_ctx_->GetAggregationMemory()) {
+      if (spill_files.empty()) {
+        spill_files = MakeSpillFiles();
+      }
+      SpillLocals(&spill_files);
+    }
+  }
+  if (!spill_files.empty()) {
+    SpillLocals(&spill_files);
+    AddSpilledPartitions(std::move(spill_files), 1);
+    return;
+  }
+
+  Merge();
+  if (plan_->GetGroupBys().empty() &&
+      std::all_of(results_.begin(), results_.end(), [](const auto &partition) { return partition.empty(); })) {
+    // Without GROUP BY, no tuples still make one group.
+    SimpleAggregationHashTable table(plan_->GetAggregates(), plan_->GetAggregateTypes());
+    results_[0].push_back(MakeOutputTuple({}, table.GenerateInitialAggregateValue()));
+  }
+}
+
+auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (true) {
+    while (partition_index_ < results_.size()) {
+      auto &partition = results_[partition_index_];
+      if (result_index_ < partition.size()) {
+        *tuple = std::move(partition[result_index_++]);
+        return true;
+      }
+      partition.clear();
+      partition.shrink_to_fit();
+      partition_index_++;
+      result_index_ = 0;
+    }
+    if (pending_.empty()) {
+      return false;
+    }
+    MergeSpilledPartition();
+  }
+}
+
+auto AggregationExecutor::GetChildExecutor() const -> const AbstractExecutor * { return child_.get(); }
+
+auto AggregationExecutor::EntryBytes() const -> size_t {
+  return sizeof(AggregateKey) + sizeof(AggregateValue) + 2 * sizeof(void *) +
+         (plan_->GetGroupBys().size() + plan_->GetAggregates().size()) * sizeof(Value);
+}
+
+auto AggregationExecutor::MakeLocals(size_t num_threads) const -> std::vector<LocalAggregation> {
+  std::vector<LocalAggregation> locals(num_threads);
+  for (auto &local : locals) {
+    for (size_t partition = 0; partition < AGGREGATION_PARTITIONS; partition++) {
+      local.tables_.emplace_back(plan_->GetAggregates(), plan_->GetAggregateTypes());
+    }
+    local.passed_.resize(AGGREGATION_PARTITIONS);
+  }
+  return locals;
+}
+
+void AggregationExecutor::PreAggregate(const std::vector<Tuple> &tuples) {
+  if (tuples.empty()) {
+    return;
+  }
+  size_t num_threads = std::clamp<size_t>(tuples.size() / AGGREGATION_ROWS_PER_THREAD, 1, locals_.size());
+  size_t chunk = (tuples.size() + num_threads - 1) / num_threads;
+  RunParallel(exec_ctx_->GetWorkerPool(), num_threads, [&](size_t thread) {
+    auto &local = locals_[thread];
+    size_t end = std::min(tuples.size(), (thread + 1) * chunk);
+    for (size_t i = thread * chunk; i < end; i++) {
+      Accumulate(&local, MakeAggregateKey(&tuples[i]), MakeAggregateValue(&tuples[i]));
+    }
+  });
+}
+
+void AggregationExecutor::PreAggregate(const std::vector<TupleBatch> &batches, size_t num_rows) {
+  if (batches.empty()) {
+    return;
+  }
+  size_t num_threads = std::clamp<size_t>(num_rows / AGGREGATION_ROWS_PER_THREAD, 1, locals_.size());
+  size_t chunk = (batches.size() + num_threads - 1) / num_threads;
+  RunParallel(exec_ctx_->GetWorkerPool(), num_threads, [&](size_t thread) {
+    size_t end = std::min(batches.size(), (thread + 1) * chunk);
+    for (size_t i = thread * chunk; i < end; i++) {
+      AccumulateBatch(&locals_[thread], batches[i]);
+    }
+  });
+}
+
+auto AggregationExecutor::PreAggregate(MorselPipeline *pipeline, std::vector<char> *exhausted) -> bool {
+  RunParallel(exec_ctx_->GetWorkerPool(), pipeline->NumWorkers(), [&](size_t worker) {
+    auto &local = locals_[worker];
+    size_t num_rows = 0;
+    if (exec_ctx_->IsVectorized()) {
+      TupleBatch batch;
+      while (num_rows < static_cast<size_t>(AGGREGATION_ROWS_PER_THREAD) && (*exhausted)[worker] == 0) {
+        if (pipeline->NextBatch(worker, &batch)) {
+          AccumulateBatch(&local, batch);
+          num_rows += batch.Size();
+        } else {
+          (*exhausted)[worker] = 1;
+        }
+      }
+    } else {
+      Tuple tuple;
+      RID rid;
+      while (num_rows < static_cast<size_t>(AGGREGATION_ROWS_PER_THREAD) && (*exhausted)[worker] == 0) {
+        if (pipeline->Next(worker, &tuple, &rid)) {
+          Accumulate(&local, MakeAggregateKey(&tuple), MakeAggregateValue(&tuple));
+          num_rows++;
+        } else {
+          (*exhausted)[worker] = 1;
+        }
+      }
+    }
+  });
+  return std::any_of(exhausted->begin(), exhausted->begin() + pipeline->NumWorkers(), [](char e) { return e == 0; });
+}
+
+void AggregationExecutor::AccumulateBatch(LocalAggregation *local, const TupleBatch &batch) const {
+  const auto &schema = child_->GetOutputSchema();
+  std::vector<std::vector<Value>> keys(plan_->GetGroupBys().size());
+  std::vector<std::vector<Value>> values(plan_->GetAggregates().size());
+  for (size_t k = 0; k < keys.size(); k++) {
+    plan_->GetGroupBys()[k]->EvaluateBatch(batch, schema, &keys[k]);
+  }
+  for (size_t v = 0; v < values.size(); v++) {
+    plan_->GetAggregates()[v]->EvaluateBatch(batch, schema, &values[v]);
+  }
+  for (auto row : batch.GetSelection()) {
+    AggregateKey key;
+    key.group_bys_.reserve(keys.size());
+    for (const auto &column : keys) {
+      key.group_bys_.push_back(column[row]);
+    }
+    AggregateValue value;
+    value.aggregates_.reserve(values.size());
+    for (const auto &column : values) {
+      value.aggregates_.push_back(column[row]);
+    }
+    Accumulate(local, std::move(key), value);
+  }
+}
+
+void AggregationExecutor::Accumulate(LocalAggregation *local, AggregateKey key, const AggregateValue &value) {
+  size_t partition = HashKey(key) % AGGREGATION_PARTITIONS;
+  auto &table = local->tables_[partition];
+  if (local->pass_through_) {
+    local->passed_[partition].emplace_back(std::move(key), table.MakePartialAggregateValue(value));
+    local->num_entries_++;
+    return;
+  }
+  size_t num_groups = table.Size();
+  table.InsertCombine(key, value);
+  size_t new_groups = table.Size() - num_groups;
+  local->num_entries_ += new_groups;
+  if (local->sampled_rows_ < static_cast<size_t>(AGGREGATION_SAMPLE_ROWS)) {
+    local->sampled_groups_ += new_groups;
+    if (++local->sampled_rows_ == static_cast<size_t>(AGGREGATION_SAMPLE_ROWS)) {
+      local->pass_through_ = local->sampled_groups_ > AGGREGATION_SAMPLE_ROWS * AGGREGATION_PASS_THROUGH_RATIO;
+    }
+  }
+}
+
+auto AggregationExecutor::MakeSpillFiles() -> std::vector<std::unique_ptr<TmpTupleFile>> {
+  std::vector<std::unique_ptr<TmpTupleFile>> files;
+  for (size_t i = 0; i < (size_t{1} << AGGREGATION_SPILL_BITS); i++) {
+    files.push_back(std::make_unique<TmpTupleFile>(exec_ctx_->GetBufferPoolManager()));
+  }
+  return files;
+}
+
+void AggregationExecutor::SpillLocals(std::vector<std::unique_ptr<TmpTupleFile>> *files) {
+  auto spill = [&](const AggregateKey &key, const AggregateValue &value) {
+    (*files)[HashKey(key) >> (64 - AGGREGATION_SPILL_BITS)]->Append(MakeOutputTuple(key, value));
+  };
+  for (auto &local : locals_) {
+    for (size_t partition = 0; partition < AGGREGATION_PARTITIONS; partition++) {
+      auto &table = local.tables_[partition];
+      for (auto iter = table.Begin(); iter != table.End(); ++iter) {
+        spill(iter.Key(), iter.Val());
+      }
+      table.Clear();
+      for (const auto &[key, value] : local.passed_[partition]) {
+        spill(key, value);
+      }
+      local.passed_[partition] = {};
+    }
+    local.num_entries_ = 0;
+  }
+}
+
+void AggregationExecutor::AddSpilledPartitions(std::vector<std::unique_ptr<TmpTupleFile>> files, uint32_t depth) {
+  for (auto &file : files) {
+    file->Finish();
+    if (file->GetNumTuples() != 0) {
+      pending_.push_back({std::move(file), depth});
+    }
+  }
+}
+
+void AggregationExecutor::Merge() {
+  size_t num_entries = 0;
+  for (const auto &local : locals_) {
+    num_entries += local.num_entries_;
+  }
+  size_t max_threads = std::min<size_t>(exec_ctx_->GetParallelism(), AGGREGATION_PARTITIONS);
+  size_t num_threads = std::clamp<size_t>(num_entries / AGGREGATION_ROWS_PER_THREAD, 1, max_threads);
+  results_.clear();
+  results_.resize(AGGREGATION_PARTITIONS);
+  partition_index_ = 0;
+  result_index_ = 0;
+
+  // Threads own the partitions they merge, and read the partial aggregates of that partition only.
+  std::atomic<size_t> next_partition{0};
+  RunParallel(exec_ctx_->GetWorkerPool(), num_threads, [&](size_t) {
+    for (size_t partition = next_partition++; partition < AGGREGATION_PARTITIONS; partition = next_partition++) {
+      SimpleAggregationHashTable table(plan_->GetAggregates(), plan_->GetAggregateTypes());
+      for (auto &local : locals_) {
+        auto &local_table = local.tables_[partition];
+        for (auto iter = local_table.Begin(); iter != local_table.End(); ++iter) {
+          table.InsertMerge(iter.Key(), iter.Val());
+        }
+        local_table.Clear();
+        for (const auto &[key, value] : local.passed_[partition]) {
+          table.InsertMerge(key, value);
+        }
+        local.passed_[partition] = {};
+      }
+      auto &results = results_[partition];
+      results.reserve(table.Size());
+      for (auto iter = table.Begin(); iter != table.End(); ++iter) {
+        results.push_back(MakeOutputTuple(iter.Key(), iter.Val()));
+      }
+    }
+  });
+  locals_.clear();
+}
+
+void AggregationExecutor::MergeSpilledPartition() {
+  auto partition = std::move(pending_.back());
+  pending_.pop_back();
+  size_t bytes = partition.file_->GetNumTuples() * EntryBytes();
+  if (bytes <= exec_ctx_->GetAggregationMemory() || partition.depth_ >= AGGREGATION_MAX_SPILL_DEPTH) {
+    // The spilled partial aggregates are merged as if a thread had passed them through.
+    locals_ = MakeLocals(1);
+    auto &local = locals_[0];
+    auto reader = partition.file_->Read();
+    Tuple tuple;
+    while (reader.Next(&tuple)) {
+      auto [key, value] = SplitOutputTuple(tuple);
+      local.passed_[HashKey(key) % AGGREGATION_PARTITIONS].emplace_back(std::move(key), std::move(value));
+      local.num_entries_++;
+    }
+    partition.file_.reset();
+    Merge();
+    return;
+  }
+
+  // Split the partition by the next bits of the hashes, below the ones its groups share.
+  uint32_t shift = 64 - (partition.depth_ + 1) * AGGREGATION_SPILL_BITS;
+  hash_t mask = (hash_t{1} << AGGREGATION_SPILL_BITS) - 1;
+  auto files = MakeSpillFiles();
+  auto reader = partition.file_->Read();
+  Tuple tuple;
+  while (reader.Next(&tuple)) {
+    files[(HashKey(SplitOutputTuple(tuple).first) >> shift) & mask]->Append(tuple);
+  }
+  partition.file_.reset();
+  AddSpilledPartitions(std::move(files), partition.depth_ + 1);
+}
+
+auto AggregationExecutor::MakeOutputTuple(const AggregateKey &key, const AggregateValue &value) const -> Tuple {
+  std::vector<Value> values;
+  values.reserve(key.group_bys_.size() + value.aggregates_.size());
+  values.insert(values.end(), key.group_bys_.begin(), key.group_bys_.end());
+  values.insert(values.end(), value.aggregates_.begin(), value.aggregates_.end());
+  return {values, &GetOutputSchema()};
+}
+
+auto AggregationExecutor::SplitOutputTuple(const Tuple &tuple) const -> std::pair<AggregateKey, AggregateValue> {
+  std::pair<AggregateKey, AggregateValue> group;
+  for (uint32_t i = 0; i < GetOutputSchema().GetColumnCount(); i++) {
+    auto &values = i < plan_->GetGroupBys().size() ? group.first.group_bys_ : group.second.aggregates_;
+    values.push_back(tuple.GetValue(&GetOutputSchema(), i));
+  }
+  return group;
+}
+
+}  // namespace bustub
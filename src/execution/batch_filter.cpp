@@ -0,0 +1,270 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// batch_filter.cpp
+//
+// Identification: src/execution/batch_filter.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/batch_filter.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "common/macros.h"
+#include "execution/expressions/arithmetic_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "type/limits.h"
+
+namespace bustub {
+
+namespace {
+
+auto IsKernelType(TypeId type) -> bool {
+  return type == TypeId::BOOLEAN || type == TypeId::INTEGER || type == TypeId::BIGINT || type == TypeId::DECIMAL;
+}
+
+auto IsIntegral(TypeId type) -> bool {
+  return type == TypeId::TINYINT || type == TypeId::SMALLINT || type == TypeId::INTEGER || type == TypeId::BIGINT;
+}
+
+}  // namespace
+
+auto BatchFilter::Create(const AbstractExpressionRef &predicate, const Schema &schema)
+    -> std::unique_ptr<BatchFilter> {
+  std::unique_ptr<BatchFilter> filter(new BatchFilter());
+  filter->schema_ = &schema;
+  filter->root_ = filter->BuildNode(*predicate);
+  if (filter->root_ == nullptr) {
+    return nullptr;
+  }
+  return filter;
+}
+
+auto BatchFilter::BuildNode(const AbstractExpression &expr) -> std::unique_ptr<Node> {
+  if (const auto *logic = dynamic_cast<const LogicExpression *>(&expr); logic != nullptr) {
+    auto node = std::make_unique<Node>();
+    node->kind_ = logic->logic_type_ == LogicType::And ? Node::Kind::And : Node::Kind::Or;
+    node->left_ = BuildNode(*logic->GetChildAt(0));
+    node->right_ = node->left_ == nullptr ? nullptr : BuildNode(*logic->GetChildAt(1));
+    return node->right_ == nullptr ? nullptr : std::move(node);
+  }
+
+  const auto *comparison = dynamic_cast<const ComparisonExpression *>(&expr);
+  if (comparison == nullptr) {
+    return nullptr;
+  }
+  auto node = std::make_unique<Node>();
+  node->kind_ = Node::Kind::Compare;
+  node->op_ = comparison->comp_type_;
+  node->lhs_ = BuildOperand(*comparison->GetChildAt(0));
+  node->rhs_ = BuildOperand(*comparison->GetChildAt(1));
+  if (node->lhs_ == nullptr || node->rhs_ == nullptr) {
+    return nullptr;
+  }
+  // Kernels compare a column with a column or a constant, of the type of the column.
+  if (node->lhs_->kind_ == Operand::Kind::Constant) {
+    std::swap(node->lhs_, node->rhs_);
+    node->op_ = FlipComparison(node->op_);
+  }
+  if (node->lhs_->kind_ == Operand::Kind::Constant) {
+    return nullptr;
+  }
+  if (node->rhs_->kind_ == Operand::Kind::Constant) {
+    return ConvertConstant(node->rhs_.get(), node->lhs_->type_) ? std::move(node) : nullptr;
+  }
+  return node->lhs_->type_ == node->rhs_->type_ ? std::move(node) : nullptr;
+}
+
+auto BatchFilter::BuildOperand(const AbstractExpression &expr) -> std::unique_ptr<Operand> {
+  auto operand = std::make_unique<Operand>();
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(&expr); column != nullptr) {
+    if (column->GetColIdx() >= schema_->GetColumnCount() ||
+        !IsKernelType(schema_->GetColumn(column->GetColIdx()).GetType())) {
+      return nullptr;
+    }
+    operand->kind_ = Operand::Kind::Column;
+    operand->type_ = schema_->GetColumn(column->GetColIdx()).GetType();
+    operand->col_ = column->GetColIdx();
+    return operand;
+  }
+
+  if (const auto *constant = dynamic_cast<const ConstantValueExpression *>(&expr); constant != nullptr) {
+    operand->kind_ = Operand::Kind::Constant;
+    operand->type_ = constant->val_.GetTypeId();
+    operand->constant_ = constant->val_;
+    return operand;
+  }
+
+  if (const auto *arithmetic = dynamic_cast<const ArithmeticExpression *>(&expr); arithmetic != nullptr) {
+    operand->kind_ = arithmetic->compute_type_ == ArithmeticType::Plus ? Operand::Kind::Add : Operand::Kind::Subtract;
+    operand->type_ = TypeId::INTEGER;
+    operand->lhs_ = BuildOperand(*arithmetic->GetChildAt(0));
+    operand->rhs_ = BuildOperand(*arithmetic->GetChildAt(1));
+    for (auto *side : {operand->lhs_.get(), operand->rhs_.get()}) {
+      if (side == nullptr) {
+        return nullptr;
+      }
+      if (side->kind_ == Operand::Kind::Constant ? !ConvertConstant(side, TypeId::INTEGER)
+                                                  : side->type_ != TypeId::INTEGER) {
+        return nullptr;
+      }
+    }
+    return operand;
+  }
+  return nullptr;
+}
+
+auto BatchFilter::ConvertConstant(Operand *operand, TypeId type) -> bool {
+  const auto &value = operand->constant_;
+  operand->type_ = type;
+  if (value.IsNull()) {
+    // A comparison with null is never true: compare with the null value of the type.
+    operand->int_ = type == TypeId::INTEGER  ? BUSTUB_INT32_NULL
+                    : type == TypeId::BIGINT ? BUSTUB_INT64_NULL
+                                             : BUSTUB_BOOLEAN_NULL;
+    operand->decimal_ = BUSTUB_DECIMAL_NULL;
+    return true;
+  }
+  switch (type) {
+    case TypeId::INTEGER:
+    case TypeId::BIGINT: {
+      if (!IsIntegral(value.GetTypeId())) {
+        return false;
+      }
+      operand->int_ = value.CastAs(TypeId::BIGINT).GetAs<int64_t>();
+      // INT32_MIN is the null integer, not a value of a column of integers.
+      return type == TypeId::BIGINT || (operand->int_ > BUSTUB_INT32_NULL && operand->int_ <= BUSTUB_INT32_MAX);
+    }
+    case TypeId::DECIMAL:
+      if (!IsIntegral(value.GetTypeId()) && value.GetTypeId() != TypeId::DECIMAL) {
+        return false;
+      }
+      operand->decimal_ = value.CastAs(TypeId::DECIMAL).GetAs<double>();
+      return true;
+    case TypeId::BOOLEAN:
+      if (value.GetTypeId() != TypeId::BOOLEAN) {
+        return false;
+      }
+      operand->int_ = value.GetAs<int8_t>();
+      return true;
+    default:
+      return false;
+  }
+}
+
+void BatchFilter::Select(TupleBatch *batch) {
+  scratch_integers_used_ = 0;
+  scratch_bitmaps_used_ = 0;
+  Evaluate(*root_, *batch, &result_);
+  batch->Select(result_);
+}
+
+void BatchFilter::Evaluate(const Node &node, const TupleBatch &batch, SelectionBitmap *bitmap) {
+  size_t num_rows = batch.NumRows();
+  bitmap->resize(SelectionBitmapWords(num_rows));
+  if (node.kind_ != Node::Kind::Compare) {
+    auto *right = ScratchBitmap(num_rows);
+    Evaluate(*node.left_, batch, bitmap);
+    Evaluate(*node.right_, batch, right);
+    // A row is selected if the predicate is true: neither false nor null, so AND and OR are those of the bitmaps.
+    for (size_t i = 0; i < bitmap->size(); i++) {
+      (*bitmap)[i] = node.kind_ == Node::Kind::And ? (*bitmap)[i] & (*right)[i] : (*bitmap)[i] | (*right)[i];
+    }
+    return;
+  }
+
+  switch (node.lhs_->type_) {
+    case TypeId::BOOLEAN:
+      Compare<TypeId::BOOLEAN>(node, batch.GetColumn(node.lhs_->col_).GetData<int8_t>(), batch, bitmap);
+      break;
+    case TypeId::INTEGER:
+      Compare<TypeId::INTEGER>(node, EvaluateIntegers(*node.lhs_, batch), batch, bitmap);
+      break;
+    case TypeId::BIGINT:
+      Compare<TypeId::BIGINT>(node, batch.GetColumn(node.lhs_->col_).GetData<int64_t>(), batch, bitmap);
+      break;
+    case TypeId::DECIMAL:
+      Compare<TypeId::DECIMAL>(node, batch.GetColumn(node.lhs_->col_).GetData<double>(), batch, bitmap);
+      break;
+    default:
+      UNREACHABLE("filter kernels do not compare values of this type");
+  }
+}
+
+template <TypeId type>
+void BatchFilter::Compare(const Node &node, const typename FilterKernelType<type>::Type *lhs,
+                          const TupleBatch &batch, SelectionBitmap *bitmap) {
+  using T = typename FilterKernelType<type>::Type;
+  const auto &rhs = *node.rhs_;
+  if (rhs.kind_ == Operand::Kind::Constant) {
+    T value;
+    if constexpr (type == TypeId::DECIMAL) {
+      value = rhs.decimal_;
+    } else {
+      value = static_cast<T>(rhs.int_);
+    }
+    CompareColumnConstant<type>(node.op_, lhs, value, batch.NumRows(), bitmap->data());
+    return;
+  }
+  const T *rhs_values;
+  if constexpr (type == TypeId::INTEGER) {
+    rhs_values = EvaluateIntegers(rhs, batch);
+  } else {
+    rhs_values = batch.GetColumn(rhs.col_).template GetData<T>();
+  }
+  CompareColumns<type>(node.op_, lhs, rhs_values, batch.NumRows(), bitmap->data());
+}
+
+auto BatchFilter::EvaluateIntegers(const Operand &operand, const TupleBatch &batch) -> const int32_t * {
+  size_t num_rows = batch.NumRows();
+  switch (operand.kind_) {
+    case Operand::Kind::Column:
+      return batch.GetColumn(operand.col_).GetData<int32_t>();
+    case Operand::Kind::Constant: {
+      auto *values = ScratchIntegers(num_rows);
+      std::fill(values, values + num_rows, static_cast<int32_t>(operand.int_));
+      return values;
+    }
+    case Operand::Kind::Add:
+    case Operand::Kind::Subtract: {
+      const auto *lhs = EvaluateIntegers(*operand.lhs_, batch);
+      const auto *rhs = EvaluateIntegers(*operand.rhs_, batch);
+      auto *values = ScratchIntegers(num_rows);
+      if (operand.kind_ == Operand::Kind::Add) {
+        AddIntegers(lhs, rhs, num_rows, values);
+      } else {
+        SubtractIntegers(lhs, rhs, num_rows, values);
+      }
+      return values;
+    }
+  }
+  UNREACHABLE("unknown operand");
+}
+
+auto BatchFilter::ScratchIntegers(size_t num_rows) -> int32_t * {
+  if (scratch_integers_used_ == scratch_integers_.size()) {
+    scratch_integers_.push_back(std::make_unique<std::vector<int32_t>>());
+  }
+  auto &scratch = *scratch_integers_[scratch_integers_used_++];
+  scratch.resize(num_rows);
+  return scratch.data();
+}
+
+auto BatchFilter::ScratchBitmap(size_t num_rows) -> SelectionBitmap * {
+  if (scratch_bitmaps_used_ == scratch_bitmaps_.size()) {
+    scratch_bitmaps_.push_back(std::make_unique<SelectionBitmap>());
+  }
+  auto *scratch = scratch_bitmaps_[scratch_bitmaps_used_++].get();
+  scratch->resize(SelectionBitmapWords(num_rows));
+  return scratch;
+}
+
+}  // namespace bustub
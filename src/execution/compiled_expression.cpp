@@ -0,0 +1,389 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// compiled_expression.cpp
+//
+// Identification: src/execution/compiled_expression.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/compiled_expression.h"
+
+#include <optional>
+#include <utility>
+
+#include "common/macros.h"
+#include "execution/expressions/arithmetic_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "type/type_util.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+auto IsIntegral(TypeId type) -> bool {
+  return type == TypeId::TINYINT || type == TypeId::SMALLINT || type == TypeId::INTEGER || type == TypeId::BIGINT;
+}
+
+/** @return -1, 0 or 1 as a varchar compares with another, both not null, as VarlenType compares them */
+auto CompareVarchars(const char *lhs, uint32_t lhs_len, const char *rhs, uint32_t rhs_len) -> int {
+  if (lhs_len == BUSTUB_VARCHAR_MAX_LEN || rhs_len == BUSTUB_VARCHAR_MAX_LEN) {
+    return lhs_len < rhs_len ? -1 : (lhs_len > rhs_len ? 1 : 0);
+  }
+  int cmp = TypeUtil::CompareStrings(lhs, lhs_len - 1, rhs, rhs_len - 1);
+  return cmp < 0 ? -1 : (cmp > 0 ? 1 : 0);
+}
+
+}  // namespace
+
+CompiledExpression::CompiledExpression(AbstractExpressionRef expr, const Schema &schema)
+    : expr_(std::move(expr)), schema_(&schema) {
+  result_ = Compile(expr_);
+  tree_only_ = program_.size() == 1 && program_.front().op_ == Opcode::Evaluate;
+  registers_.resize(types_.size());
+  for (const auto &[reg, value] : constants_) {
+    LoadValue(&registers_[reg], value);
+  }
+  subtree_values_.resize(subtrees_.size());
+  subtree_batch_values_.resize(subtrees_.size());
+  if (expr_->GetReturnType() == TypeId::BOOLEAN) {
+    batch_filter_ = BatchFilter::Create(expr_, *schema_);
+  }
+}
+
+auto CompiledExpression::StaticType(const AbstractExpression &expr) const -> TypeId {
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(&expr);
+      column != nullptr && column->GetColIdx() < schema_->GetColumnCount()) {
+    return schema_->GetColumn(column->GetColIdx()).GetType();
+  }
+  return expr.GetReturnType();
+}
+
+auto CompiledExpression::NewRegister(TypeId type) -> uint32_t {
+  types_.push_back(type);
+  return types_.size() - 1;
+}
+
+auto CompiledExpression::Emit(Opcode op, TypeId type, uint32_t lhs, uint32_t rhs, uint32_t col, uint32_t offset)
+    -> uint32_t {
+  uint32_t dst = NewRegister(type);
+  program_.push_back({op, dst, lhs, rhs, col, offset});
+  return dst;
+}
+
+auto CompiledExpression::Compile(const AbstractExpressionRef &expr) -> uint32_t {
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      column != nullptr && column->GetColIdx() < schema_->GetColumnCount()) {
+    const auto &schema_column = schema_->GetColumn(column->GetColIdx());
+    auto type = schema_column.GetType();
+    Opcode op;
+    switch (type) {
+      case TypeId::BOOLEAN:
+        op = Opcode::LoadBoolean;
+        break;
+      case TypeId::TINYINT:
+        op = Opcode::LoadTinyInt;
+        break;
+      case TypeId::SMALLINT:
+        op = Opcode::LoadSmallInt;
+        break;
+      case TypeId::INTEGER:
+        op = Opcode::LoadInteger;
+        break;
+      case TypeId::BIGINT:
+        op = Opcode::LoadBigInt;
+        break;
+      case TypeId::DECIMAL:
+        op = Opcode::LoadDecimal;
+        break;
+      case TypeId::VARCHAR:
+        op = Opcode::LoadVarchar;
+        break;
+      default:
+        op = Opcode::Evaluate;
+        break;
+    }
+    if (op != Opcode::Evaluate) {
+      return Emit(op, type, 0, 0, column->GetColIdx(), schema_column.GetOffset());
+    }
+  }
+
+  if (const auto *constant = dynamic_cast<const ConstantValueExpression *>(expr.get()); constant != nullptr) {
+    uint32_t reg = NewRegister(constant->val_.GetTypeId());
+    constants_.emplace_back(reg, constant->val_);
+    return reg;
+  }
+
+  if (const auto *comparison = dynamic_cast<const ComparisonExpression *>(expr.get()); comparison != nullptr) {
+    auto lhs_type = StaticType(*comparison->GetChildAt(0));
+    auto rhs_type = StaticType(*comparison->GetChildAt(1));
+    // Opcodes are laid out comparison by comparison, in the order of ComparisonType, from the first of each type.
+    std::optional<Opcode> first;
+    if ((IsIntegral(lhs_type) && IsIntegral(rhs_type)) ||
+        (lhs_type == TypeId::BOOLEAN && rhs_type == TypeId::BOOLEAN)) {
+      first = Opcode::EqualInt;
+    } else if (lhs_type == TypeId::DECIMAL && rhs_type == TypeId::DECIMAL) {
+      first = Opcode::EqualDecimal;
+    } else if (lhs_type == TypeId::VARCHAR && rhs_type == TypeId::VARCHAR) {
+      first = Opcode::EqualVarchar;
+    }
+    if (first.has_value()) {
+      uint32_t lhs = Compile(comparison->GetChildAt(0));
+      uint32_t rhs = Compile(comparison->GetChildAt(1));
+      auto op = static_cast<Opcode>(static_cast<uint8_t>(*first) + static_cast<uint8_t>(comparison->comp_type_));
+      return Emit(op, TypeId::BOOLEAN, lhs, rhs);
+    }
+  }
+
+  if (const auto *arithmetic = dynamic_cast<const ArithmeticExpression *>(expr.get());
+      arithmetic != nullptr && IsIntegral(StaticType(*arithmetic->GetChildAt(0))) &&
+      IsIntegral(StaticType(*arithmetic->GetChildAt(1)))) {
+    uint32_t lhs = Compile(arithmetic->GetChildAt(0));
+    uint32_t rhs = Compile(arithmetic->GetChildAt(1));
+    switch (arithmetic->compute_type_) {
+      case ArithmeticType::Plus:
+        return Emit(Opcode::AddInteger, TypeId::INTEGER, lhs, rhs);
+      case ArithmeticType::Minus:
+        return Emit(Opcode::SubtractInteger, TypeId::INTEGER, lhs, rhs);
+    }
+  }
+
+  if (const auto *logic = dynamic_cast<const LogicExpression *>(expr.get());
+      logic != nullptr && StaticType(*logic->GetChildAt(0)) == TypeId::BOOLEAN &&
+      StaticType(*logic->GetChildAt(1)) == TypeId::BOOLEAN) {
+    uint32_t lhs = Compile(logic->GetChildAt(0));
+    uint32_t rhs = Compile(logic->GetChildAt(1));
+    return Emit(logic->logic_type_ == LogicType::And ? Opcode::And : Opcode::Or, TypeId::BOOLEAN, lhs, rhs);
+  }
+
+  subtrees_.push_back(expr);
+  return Emit(Opcode::Evaluate, expr->GetReturnType(), 0, 0, subtrees_.size() - 1);
+}
+
+// NOLINTNEXTLINE
+#define BUSTUB_COMPARE_CASES(TYPE, LHS, RHS) \
+  case Opcode::Equal##TYPE:                  \
+    dst.null_ = lhs.null_ || rhs.null_;      \
+    dst.int_ = !dst.null_ && (LHS) == (RHS); \
+    break;                                   \
+  case Opcode::NotEqual##TYPE:               \
+    dst.null_ = lhs.null_ || rhs.null_;      \
+    dst.int_ = !dst.null_ && (LHS) != (RHS); \
+    break;                                   \
+  case Opcode::LessThan##TYPE:               \
+    dst.null_ = lhs.null_ || rhs.null_;      \
+    dst.int_ = !dst.null_ && (LHS) < (RHS);  \
+    break;                                   \
+  case Opcode::LessThanOrEqual##TYPE:        \
+    dst.null_ = lhs.null_ || rhs.null_;      \
+    dst.int_ = !dst.null_ && (LHS) <= (RHS); \
+    break;                                   \
+  case Opcode::GreaterThan##TYPE:            \
+    dst.null_ = lhs.null_ || rhs.null_;      \
+    dst.int_ = !dst.null_ && (LHS) > (RHS);  \
+    break;                                   \
+  case Opcode::GreaterThanOrEqual##TYPE:     \
+    dst.null_ = lhs.null_ || rhs.null_;      \
+    dst.int_ = !dst.null_ && (LHS) >= (RHS); \
+    break;
+
+template <typename DataOf, typename EvaluateFn>
+void CompiledExpression::Run(const DataOf &data_of, const EvaluateFn &evaluate) {
+  Register *registers = registers_.data();
+  for (const auto &inst : program_) {
+    auto &dst = registers[inst.dst_];
+    const auto &lhs = registers[inst.lhs_];
+    const auto &rhs = registers[inst.rhs_];
+    switch (inst.op_) {
+      case Opcode::LoadBoolean:
+        dst.int_ = *reinterpret_cast<const int8_t *>(data_of(inst));
+        dst.null_ = dst.int_ == BUSTUB_BOOLEAN_NULL;
+        break;
+      case Opcode::LoadTinyInt:
+        dst.int_ = *reinterpret_cast<const int8_t *>(data_of(inst));
+        dst.null_ = dst.int_ == BUSTUB_INT8_NULL;
+        break;
+      case Opcode::LoadSmallInt:
+        dst.int_ = *reinterpret_cast<const int16_t *>(data_of(inst));
+        dst.null_ = dst.int_ == BUSTUB_INT16_NULL;
+        break;
+      case Opcode::LoadInteger:
+        dst.int_ = *reinterpret_cast<const int32_t *>(data_of(inst));
+        dst.null_ = dst.int_ == BUSTUB_INT32_NULL;
+        break;
+      case Opcode::LoadBigInt:
+        dst.int_ = *reinterpret_cast<const int64_t *>(data_of(inst));
+        dst.null_ = dst.int_ == BUSTUB_INT64_NULL;
+        break;
+      case Opcode::LoadDecimal:
+        dst.decimal_ = *reinterpret_cast<const double *>(data_of(inst));
+        dst.null_ = dst.decimal_ == BUSTUB_DECIMAL_NULL;
+        break;
+      case Opcode::LoadVarchar: {
+        const char *data = data_of(inst);
+        dst.len_ = *reinterpret_cast<const uint32_t *>(data);
+        dst.str_ = data + sizeof(uint32_t);
+        dst.null_ = dst.len_ == BUSTUB_VALUE_NULL;
+        break;
+      }
+      case Opcode::Evaluate:
+        LoadValue(&dst, evaluate(inst));
+        break;
+        BUSTUB_COMPARE_CASES(Int, lhs.int_, rhs.int_)
+        BUSTUB_COMPARE_CASES(Decimal, lhs.decimal_, rhs.decimal_)
+        BUSTUB_COMPARE_CASES(Varchar, CompareVarchars(lhs.str_, lhs.len_, rhs.str_, rhs.len_), 0)
+      case Opcode::AddInteger:
+      case Opcode::SubtractInteger: {
+        // Wrap around as 32-bit integers do, to the null integer included.
+        auto l = static_cast<uint32_t>(lhs.int_);
+        auto r = static_cast<uint32_t>(rhs.int_);
+        dst.int_ = static_cast<int32_t>(inst.op_ == Opcode::AddInteger ? l + r : l - r);
+        dst.null_ = lhs.null_ || rhs.null_ || dst.int_ == BUSTUB_INT32_NULL;
+        break;
+      }
+      case Opcode::And: {
+        bool lhs_false = !lhs.null_ && lhs.int_ == 0;
+        bool rhs_false = !rhs.null_ && rhs.int_ == 0;
+        dst.null_ = !lhs_false && !rhs_false && (lhs.null_ || rhs.null_);
+        dst.int_ = !lhs_false && !rhs_false ? 1 : 0;
+        break;
+      }
+      case Opcode::Or: {
+        bool lhs_true = !lhs.null_ && lhs.int_ != 0;
+        bool rhs_true = !rhs.null_ && rhs.int_ != 0;
+        dst.null_ = !lhs_true && !rhs_true && (lhs.null_ || rhs.null_);
+        dst.int_ = lhs_true || rhs_true ? 1 : 0;
+        break;
+      }
+    }
+  }
+}
+
+#undef BUSTUB_COMPARE_CASES
+
+void CompiledExpression::RunOnTuple(const char *data, const Tuple *tuple) {
+  Run(
+      [&](const Instruction &inst) {
+        const char *value = data + inst.offset_;
+        return inst.op_ == Opcode::LoadVarchar ? data + *reinterpret_cast<const uint32_t *>(value) : value;
+      },
+      [&](const Instruction &inst) -> const Value & {
+        subtree_values_[inst.col_] = subtrees_[inst.col_]->Evaluate(tuple, *schema_);
+        return subtree_values_[inst.col_];
+      });
+}
+
+auto CompiledExpression::Evaluate(const Tuple &tuple) -> Value {
+  if (tree_only_) {
+    return expr_->Evaluate(&tuple, *schema_);
+  }
+  RunOnTuple(tuple.GetData(), &tuple);
+  return ToValue(registers_[result_], types_[result_]);
+}
+
+auto CompiledExpression::EvaluatePredicate(const Tuple &tuple) -> bool {
+  if (tree_only_ || types_[result_] != TypeId::BOOLEAN) {
+    auto value = Evaluate(tuple);
+    return !value.IsNull() && value.GetAs<bool>();
+  }
+  RunOnTuple(tuple.GetData(), &tuple);
+  return !registers_[result_].null_ && registers_[result_].int_ != 0;
+}
+
+auto CompiledExpression::EvaluatePredicate(const TupleRef &tuple) -> bool {
+  // The tree interpreter only reads Tuples.
+  if (tree_only_ || !subtrees_.empty() || types_[result_] != TypeId::BOOLEAN) {
+    return EvaluatePredicate(tuple.ToTuple());
+  }
+  RunOnTuple(tuple.GetData(), nullptr);
+  return !registers_[result_].null_ && registers_[result_].int_ != 0;
+}
+
+void CompiledExpression::EvaluateBatch(const TupleBatch &batch, std::vector<Value> *result) {
+  if (tree_only_) {
+    expr_->EvaluateBatch(batch, *schema_, result);
+    return;
+  }
+  for (size_t i = 0; i < subtrees_.size(); i++) {
+    subtrees_[i]->EvaluateBatch(batch, *schema_, &subtree_batch_values_[i]);
+  }
+  result->resize(batch.NumRows());
+  for (auto row : batch.GetSelection()) {
+    Run([&](const Instruction &inst) { return batch.GetColumn(inst.col_).GetDataPtr(row); },
+        [&](const Instruction &inst) -> const Value & { return subtree_batch_values_[inst.col_][row]; });
+    (*result)[row] = ToValue(registers_[result_], types_[result_]);
+  }
+}
+
+void CompiledExpression::SelectBatch(TupleBatch *batch) {
+  if (batch_filter_ != nullptr) {
+    batch_filter_->Select(batch);
+    return;
+  }
+  EvaluateBatch(*batch, &predicate_values_);
+  batch->Select(predicate_values_);
+}
+
+void CompiledExpression::LoadValue(Register *reg, const Value &value) {
+  reg->null_ = value.IsNull();
+  if (reg->null_) {
+    return;
+  }
+  switch (value.GetTypeId()) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      reg->int_ = value.GetAs<int8_t>();
+      break;
+    case TypeId::SMALLINT:
+      reg->int_ = value.GetAs<int16_t>();
+      break;
+    case TypeId::INTEGER:
+      reg->int_ = value.GetAs<int32_t>();
+      break;
+    case TypeId::BIGINT:
+      reg->int_ = value.GetAs<int64_t>();
+      break;
+    case TypeId::DECIMAL:
+      reg->decimal_ = value.GetAs<double>();
+      break;
+    case TypeId::VARCHAR:
+      reg->str_ = value.GetData();
+      reg->len_ = value.GetLength();
+      break;
+    default:
+      UNREACHABLE("a register does not hold values of this type");
+  }
+}
+
+auto CompiledExpression::ToValue(const Register &reg, TypeId type) -> Value {
+  if (reg.null_) {
+    return ValueFactory::GetNullValueByType(type);
+  }
+  switch (type) {
+    case TypeId::BOOLEAN:
+      return ValueFactory::GetBooleanValue(reg.int_ != 0);
+    case TypeId::TINYINT:
+      return ValueFactory::GetTinyIntValue(static_cast<int8_t>(reg.int_));
+    case TypeId::SMALLINT:
+      return ValueFactory::GetSmallIntValue(static_cast<int16_t>(reg.int_));
+    case TypeId::INTEGER:
+      return ValueFactory::GetIntegerValue(static_cast<int32_t>(reg.int_));
+    case TypeId::BIGINT:
+      return ValueFactory::GetBigIntValue(reg.int_);
+    case TypeId::DECIMAL:
+      return ValueFactory::GetDecimalValue(reg.decimal_);
+    case TypeId::VARCHAR:
+      return ValueFactory::GetVarcharValue(reg.str_, reg.len_, true);
+    default:
+      UNREACHABLE("a register does not hold values of this type");
+  }
+}
+
+}  // namespace bustub
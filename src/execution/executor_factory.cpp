@@ -19,6 +19,7 @@
 #include "execution/executors/aggregation_executor.h"
 #include "execution/executors/delete_executor.h"
 #include "execution/executors/filter_executor.h"
+#include "execution/executors/gather_executor.h"
 #include "execution/executors/hash_join_executor.h"
 #include "execution/executors/index_scan_executor.h"
 #include "execution/executors/init_check_executor.h"
@@ -34,6 +35,7 @@
 #include "execution/executors/topn_executor.h"
 #include "execution/executors/update_executor.h"
 #include "execution/executors/values_executor.h"
+#include "execution/morsel_pipeline.h"
 #include "execution/plans/filter_plan.h"
 #include "execution/plans/mock_scan_plan.h"
 #include "execution/plans/projection_plan.h"
@@ -47,6 +49,11 @@ namespace bustub {
 auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPlanNodeRef &plan)
     -> std::unique_ptr<AbstractExecutor> {
   auto check_options_set = exec_ctx->GetCheckOptions()->check_options_set_;
+  // Pipelines of projections and filters over a sequential scan run on several threads, morsel by morsel, and are
+  // gathered back in the order of the table.
+  if (auto pipeline = MorselPipeline::Make(exec_ctx, plan, exec_ctx->GetParallelism()); pipeline != nullptr) {
+    return std::make_unique<GatherExecutor>(exec_ctx, plan.get(), std::move(pipeline));
+  }
   switch (plan->GetType()) {
     // Create a new sequential scan executor
     case PlanType::SeqScan: {
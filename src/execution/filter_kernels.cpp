@@ -0,0 +1,359 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// filter_kernels.cpp
+//
+// Identification: src/execution/filter_kernels.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/filter_kernels.h"
+
+#include <cstring>
+
+#include "type/limits.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace bustub {
+
+namespace {
+
+template <typename T>
+constexpr auto NullOf() -> T;
+template <>
+constexpr auto NullOf<int8_t>() -> int8_t {
+  return BUSTUB_BOOLEAN_NULL;
+}
+template <>
+constexpr auto NullOf<int32_t>() -> int32_t {
+  return BUSTUB_INT32_NULL;
+}
+template <>
+constexpr auto NullOf<int64_t>() -> int64_t {
+  return BUSTUB_INT64_NULL;
+}
+template <>
+constexpr auto NullOf<double>() -> double {
+  return BUSTUB_DECIMAL_NULL;
+}
+
+/** Compare rows [begin, num_rows), setting the bits of those the comparison holds for. */
+template <typename T, bool CONSTANT>
+void CompareScalar(ComparisonType op, const T *lhs, const T *rhs, T rhs_value, size_t begin, size_t num_rows,
+                   uint64_t *bitmap) {
+  for (size_t i = begin; i < num_rows; i++) {
+    T l = lhs[i];
+    T r = CONSTANT ? rhs_value : rhs[i];
+    bool holds;
+    switch (op) {
+      case ComparisonType::Equal:
+        holds = l == r;
+        break;
+      case ComparisonType::NotEqual:
+        holds = l != r;
+        break;
+      case ComparisonType::LessThan:
+        holds = l < r;
+        break;
+      case ComparisonType::LessThanOrEqual:
+        holds = l <= r;
+        break;
+      case ComparisonType::GreaterThan:
+        holds = l > r;
+        break;
+      case ComparisonType::GreaterThanOrEqual:
+        holds = l >= r;
+        break;
+      default:
+        holds = false;
+        break;
+    }
+    holds = holds && l != NullOf<T>() && r != NullOf<T>();
+    bitmap[i / 64] |= static_cast<uint64_t>(holds) << (i % 64);
+  }
+}
+
+template <bool ADD>
+void ArithmeticScalar(const int32_t *lhs, const int32_t *rhs, size_t begin, size_t num_rows, int32_t *result) {
+  for (size_t i = begin; i < num_rows; i++) {
+    auto l = static_cast<uint32_t>(lhs[i]);
+    auto r = static_cast<uint32_t>(rhs[i]);
+    bool null = lhs[i] == BUSTUB_INT32_NULL || rhs[i] == BUSTUB_INT32_NULL;
+    result[i] = null ? BUSTUB_INT32_NULL : static_cast<int32_t>(ADD ? l + r : l - r);
+  }
+}
+
+#if defined(__x86_64__)
+/*
+ * The AVX2 kernels are compiled for AVX2 whatever the build targets, and filters pick them at run time, see
+ * DefaultFilterKernel.
+ *
+ * Each lane type says how to load and broadcast its values, and gives the masks of lanes that are equal and greater,
+ * one bit per lane. Lanes divide 64, so that the bits of a vector never straddle two words of a bitmap.
+ */
+#define BUSTUB_AVX2 __attribute__((target("avx2")))  // NOLINT
+
+struct Int8Lanes {
+  using T = int8_t;
+  using Vector = __m256i;
+  static constexpr size_t LANES = 32;
+  BUSTUB_AVX2 static auto Load(const T *data) -> Vector {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+  }
+  BUSTUB_AVX2 static auto Broadcast(T value) -> Vector { return _mm256_set1_epi8(value); }
+  BUSTUB_AVX2 static auto Equal(Vector lhs, Vector rhs) -> uint64_t {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs, rhs)));
+  }
+  BUSTUB_AVX2 static auto Greater(Vector lhs, Vector rhs) -> uint64_t {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(lhs, rhs)));
+  }
+};
+
+struct Int32Lanes {
+  using T = int32_t;
+  using Vector = __m256i;
+  static constexpr size_t LANES = 8;
+  BUSTUB_AVX2 static auto Load(const T *data) -> Vector {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+  }
+  BUSTUB_AVX2 static auto Broadcast(T value) -> Vector { return _mm256_set1_epi32(value); }
+  BUSTUB_AVX2 static auto Equal(Vector lhs, Vector rhs) -> uint64_t {
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(lhs, rhs)));
+  }
+  BUSTUB_AVX2 static auto Greater(Vector lhs, Vector rhs) -> uint64_t {
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(lhs, rhs)));
+  }
+};
+
+struct Int64Lanes {
+  using T = int64_t;
+  using Vector = __m256i;
+  static constexpr size_t LANES = 4;
+  BUSTUB_AVX2 static auto Load(const T *data) -> Vector {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+  }
+  BUSTUB_AVX2 static auto Broadcast(T value) -> Vector { return _mm256_set1_epi64x(value); }
+  BUSTUB_AVX2 static auto Equal(Vector lhs, Vector rhs) -> uint64_t {
+    return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(lhs, rhs)));
+  }
+  BUSTUB_AVX2 static auto Greater(Vector lhs, Vector rhs) -> uint64_t {
+    return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(lhs, rhs)));
+  }
+};
+
+struct DoubleLanes {
+  using T = double;
+  using Vector = __m256d;
+  static constexpr size_t LANES = 4;
+  BUSTUB_AVX2 static auto Load(const T *data) -> Vector { return _mm256_loadu_pd(data); }
+  BUSTUB_AVX2 static auto Broadcast(T value) -> Vector { return _mm256_set1_pd(value); }
+  BUSTUB_AVX2 static auto Equal(Vector lhs, Vector rhs) -> uint64_t {
+    return _mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, _CMP_EQ_OQ));
+  }
+  BUSTUB_AVX2 static auto Greater(Vector lhs, Vector rhs) -> uint64_t {
+    return _mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, _CMP_GT_OQ));
+  }
+};
+
+template <typename Lanes, bool CONSTANT>
+BUSTUB_AVX2 void CompareAvx2(ComparisonType op, const typename Lanes::T *lhs, const typename Lanes::T *rhs,
+                             typename Lanes::T rhs_value, size_t num_rows, uint64_t *bitmap) {
+  using T = typename Lanes::T;
+  constexpr uint64_t all_lanes = Lanes::LANES == 64 ? ~uint64_t{0} : (uint64_t{1} << Lanes::LANES) - 1;
+  auto null = Lanes::Broadcast(NullOf<T>());
+  auto r = Lanes::Broadcast(rhs_value);
+  uint64_t r_nulls = CONSTANT && rhs_value == NullOf<T>() ? all_lanes : 0;
+  size_t i = 0;
+  for (; i + Lanes::LANES <= num_rows; i += Lanes::LANES) {
+    auto l = Lanes::Load(lhs + i);
+    uint64_t nulls = Lanes::Equal(l, null) | r_nulls;
+    if constexpr (!CONSTANT) {
+      r = Lanes::Load(rhs + i);
+      nulls |= Lanes::Equal(r, null);
+    }
+    uint64_t holds;
+    switch (op) {
+      case ComparisonType::Equal:
+        holds = Lanes::Equal(l, r);
+        break;
+      case ComparisonType::NotEqual:
+        holds = ~Lanes::Equal(l, r);
+        break;
+      case ComparisonType::LessThan:
+        holds = Lanes::Greater(r, l);
+        break;
+      case ComparisonType::LessThanOrEqual:
+        holds = Lanes::Greater(r, l) | Lanes::Equal(l, r);
+        break;
+      case ComparisonType::GreaterThan:
+        holds = Lanes::Greater(l, r);
+        break;
+      case ComparisonType::GreaterThanOrEqual:
+        holds = Lanes::Greater(l, r) | Lanes::Equal(l, r);
+        break;
+      default:
+        holds = 0;
+        break;
+    }
+    bitmap[i / 64] |= (holds & ~nulls & all_lanes) << (i % 64);
+  }
+  CompareScalar<T, CONSTANT>(op, lhs, rhs, rhs_value, i, num_rows, bitmap);
+}
+
+template <bool ADD>
+BUSTUB_AVX2 void ArithmeticAvx2(const int32_t *lhs, const int32_t *rhs, size_t num_rows, int32_t *result) {
+  auto null = _mm256_set1_epi32(BUSTUB_INT32_NULL);
+  size_t i = 0;
+  for (; i + 8 <= num_rows; i += 8) {
+    auto l = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + i));
+    auto r = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rhs + i));
+    auto nulls = _mm256_or_si256(_mm256_cmpeq_epi32(l, null), _mm256_cmpeq_epi32(r, null));
+    auto value = ADD ? _mm256_add_epi32(l, r) : _mm256_sub_epi32(l, r);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(result + i), _mm256_blendv_epi8(value, null, nulls));
+  }
+  ArithmeticScalar<ADD>(lhs, rhs, i, num_rows, result);
+}
+
+#undef BUSTUB_AVX2
+
+/** The lanes of the AVX2 kernels of a type */
+template <typename T>
+struct LanesOf;
+template <>
+struct LanesOf<int8_t> {
+  using Type = Int8Lanes;
+};
+template <>
+struct LanesOf<int32_t> {
+  using Type = Int32Lanes;
+};
+template <>
+struct LanesOf<int64_t> {
+  using Type = Int64Lanes;
+};
+template <>
+struct LanesOf<double> {
+  using Type = DoubleLanes;
+};
+#endif
+
+template <typename T, bool CONSTANT>
+void Compare(ComparisonType op, const T *lhs, const T *rhs, T rhs_value, size_t num_rows, uint64_t *bitmap,
+             FilterKernel kernel) {
+  memset(bitmap, 0, SelectionBitmapWords(num_rows) * sizeof(uint64_t));
+  switch (kernel) {
+#if defined(__x86_64__)
+    case FilterKernel::AVX2:
+      CompareAvx2<typename LanesOf<T>::Type, CONSTANT>(op, lhs, rhs, rhs_value, num_rows, bitmap);
+      break;
+#endif
+    default:
+      CompareScalar<T, CONSTANT>(op, lhs, rhs, rhs_value, 0, num_rows, bitmap);
+      break;
+  }
+}
+
+template <bool ADD>
+void Arithmetic(const int32_t *lhs, const int32_t *rhs, size_t num_rows, int32_t *result, FilterKernel kernel) {
+  switch (kernel) {
+#if defined(__x86_64__)
+    case FilterKernel::AVX2:
+      ArithmeticAvx2<ADD>(lhs, rhs, num_rows, result);
+      break;
+#endif
+    default:
+      ArithmeticScalar<ADD>(lhs, rhs, 0, num_rows, result);
+      break;
+  }
+}
+
+}  // namespace
+
+auto FilterKernelToString(FilterKernel kernel) -> std::string {
+  switch (kernel) {
+    case FilterKernel::Scalar:
+      return "scalar";
+    case FilterKernel::AVX2:
+      return "avx2";
+  }
+  return "unknown";
+}
+
+auto FilterKernelSupported(FilterKernel kernel) -> bool {
+  switch (kernel) {
+    case FilterKernel::Scalar:
+      return true;
+#if defined(__x86_64__)
+    case FilterKernel::AVX2:
+      return __builtin_cpu_supports("avx2");
+#endif
+    default:
+      return false;
+  }
+}
+
+auto DefaultFilterKernel() -> FilterKernel {
+  static const FilterKernel KERNEL =
+      FilterKernelSupported(FilterKernel::AVX2) ? FilterKernel::AVX2 : FilterKernel::Scalar;
+  return KERNEL;
+}
+
+template <TypeId type>
+void CompareColumns(ComparisonType op, const typename FilterKernelType<type>::Type *lhs,
+                    const typename FilterKernelType<type>::Type *rhs, size_t num_rows, uint64_t *bitmap,
+                    FilterKernel kernel) {
+  using T = typename FilterKernelType<type>::Type;
+  Compare<T, false>(op, lhs, rhs, T{}, num_rows, bitmap, kernel);
+}
+
+template <TypeId type>
+void CompareColumnConstant(ComparisonType op, const typename FilterKernelType<type>::Type *lhs,
+                           typename FilterKernelType<type>::Type rhs, size_t num_rows, uint64_t *bitmap,
+                           FilterKernel kernel) {
+  Compare<typename FilterKernelType<type>::Type, true>(op, lhs, nullptr, rhs, num_rows, bitmap, kernel);
+}
+
+void AddIntegers(const int32_t *lhs, const int32_t *rhs, size_t num_rows, int32_t *result, FilterKernel kernel) {
+  Arithmetic<true>(lhs, rhs, num_rows, result, kernel);
+}
+
+void SubtractIntegers(const int32_t *lhs, const int32_t *rhs, size_t num_rows, int32_t *result, FilterKernel kernel) {
+  Arithmetic<false>(lhs, rhs, num_rows, result, kernel);
+}
+
+auto FlipComparison(ComparisonType op) -> ComparisonType {
+  switch (op) {
+    case ComparisonType::LessThan:
+      return ComparisonType::GreaterThan;
+    case ComparisonType::LessThanOrEqual:
+      return ComparisonType::GreaterThanOrEqual;
+    case ComparisonType::GreaterThan:
+      return ComparisonType::LessThan;
+    case ComparisonType::GreaterThanOrEqual:
+      return ComparisonType::LessThanOrEqual;
+    default:
+      return op;
+  }
+}
+
+// NOLINTNEXTLINE
+#define BUSTUB_INSTANTIATE_FILTER_KERNELS(TYPE)                                                                      \
+  template void CompareColumns<TYPE>(ComparisonType, const FilterKernelType<TYPE>::Type *,                           \
+                                     const FilterKernelType<TYPE>::Type *, size_t, uint64_t *, FilterKernel);       \
+  template void CompareColumnConstant<TYPE>(ComparisonType, const FilterKernelType<TYPE>::Type *,                    \
+                                            FilterKernelType<TYPE>::Type, size_t, uint64_t *, FilterKernel);
+
+BUSTUB_INSTANTIATE_FILTER_KERNELS(TypeId::BOOLEAN)
+BUSTUB_INSTANTIATE_FILTER_KERNELS(TypeId::INTEGER)
+BUSTUB_INSTANTIATE_FILTER_KERNELS(TypeId::BIGINT)
+BUSTUB_INSTANTIATE_FILTER_KERNELS(TypeId::DECIMAL)
+
+#undef BUSTUB_INSTANTIATE_FILTER_KERNELS
+
+}  // namespace bustub
@@ -0,0 +1,153 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// gather_executor.cpp
+//
+// Identification: src/execution/gather_executor.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/gather_executor.h"
+
+namespace bustub {
+
+GatherExecutor::GatherExecutor(ExecutorContext *exec_ctx, const AbstractPlanNode *plan,
+                               std::unique_ptr<MorselPipeline> pipeline)
+    : AbstractExecutor(exec_ctx), plan_(plan), pipeline_(std::move(pipeline)) {}
+
+GatherExecutor::~GatherExecutor() { StopWorkers(); }
+
+void GatherExecutor::Init() {
+  StopWorkers();
+  outputs_.clear();
+  next_morsel_ = 0;
+  num_batches_ = 0;
+  finished_workers_ = 0;
+  stopping_ = false;
+  error_ = nullptr;
+  batch_ = TupleBatch{};
+  next_row_ = 0;
+
+  pipeline_->Init();
+  for (size_t i = 0; i < pipeline_->NumWorkers(); i++) {
+    threads_.emplace_back(&GatherExecutor::RunWorker, this, i);
+  }
+}
+
+auto GatherExecutor::GetPipeline() -> MorselPipeline * {
+  StopWorkers();
+  return pipeline_.get();
+}
+
+void GatherExecutor::RunWorker(size_t worker) {
+  const auto &schema = GetOutputSchema();
+  auto *executor = pipeline_->GetWorker(worker);
+  try {
+    size_t morsel;
+    while (pipeline_->NextMorsel(worker, &morsel)) {
+      while (true) {
+        TupleBatch batch;
+        if (exec_ctx_->IsVectorized()) {
+          if (!executor->NextBatch(&batch)) {
+            break;
+          }
+        } else {
+          // Tuples travel in batches too, but the pipeline runs a tuple at a time.
+          batch.Reset(schema);
+          Tuple tuple;
+          RID rid;
+          while (batch.NumRows() < static_cast<size_t>(BATCH_SIZE) && executor->Next(&tuple, &rid)) {
+            batch.AppendTuple(tuple, schema, rid);
+          }
+          if (batch.NumRows() == 0) {
+            break;
+          }
+        }
+        std::unique_lock guard(latch_);
+        cv_.wait(guard, [&] {
+          return stopping_ || morsel == next_morsel_ ||
+                 num_batches_ < pipeline_->NumWorkers() * GATHER_BATCHES_PER_WORKER;
+        });
+        if (stopping_) {
+          return;
+        }
+        outputs_[morsel].batches_.push_back(std::move(batch));
+        num_batches_++;
+        cv_.notify_all();
+      }
+      std::scoped_lock guard(latch_);
+      if (stopping_) {
+        return;
+      }
+      outputs_[morsel].finished_ = true;
+      cv_.notify_all();
+    }
+  } catch (...) {
+    std::scoped_lock guard(latch_);
+    if (error_ == nullptr) {
+      error_ = std::current_exception();
+    }
+  }
+  std::scoped_lock guard(latch_);
+  finished_workers_++;
+  cv_.notify_all();
+}
+
+void GatherExecutor::StopWorkers() {
+  {
+    std::scoped_lock guard(latch_);
+    stopping_ = true;
+    cv_.notify_all();
+  }
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+  threads_.clear();
+}
+
+auto GatherExecutor::PopBatch(TupleBatch *batch) -> bool {
+  std::unique_lock guard(latch_);
+  while (true) {
+    if (error_ != nullptr) {
+      std::rethrow_exception(error_);
+    }
+    auto output = outputs_.find(next_morsel_);
+    if (output != outputs_.end() && !output->second.batches_.empty()) {
+      *batch = std::move(output->second.batches_.front());
+      output->second.batches_.pop_front();
+      num_batches_--;
+      cv_.notify_all();
+      return true;
+    }
+    if (output != outputs_.end() && output->second.finished_) {
+      outputs_.erase(output);
+      next_morsel_++;
+      cv_.notify_all();
+      continue;
+    }
+    // Morsels are numbered as they are taken: once every worker is done, the ones left were never taken.
+    if (finished_workers_ == threads_.size()) {
+      return false;
+    }
+    cv_.wait(guard);
+  }
+}
+
+auto GatherExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (next_row_ == batch_.Size()) {
+    if (!PopBatch(&batch_)) {
+      return false;
+    }
+    next_row_ = 0;
+  }
+  *tuple = batch_.GetTuple(batch_.GetSelection()[next_row_++], GetOutputSchema());
+  *rid = tuple->GetRid();
+  return true;
+}
+
+auto GatherExecutor::NextBatch(TupleBatch *batch) -> bool { return PopBatch(batch); }
+
+}  // namespace bustub
@@ -12,20 +12,493 @@
 
 #include "execution/executors/hash_join_executor.h"
 
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <mutex>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "common/util/parallel_util.h"
+#include "execution/executors/gather_executor.h"
+#include "type/value_factory.h"
+
 namespace bustub {
 
 HashJoinExecutor::HashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlanNode *plan,
                                    std::unique_ptr<AbstractExecutor> &&left_child,
                                    std::unique_ptr<AbstractExecutor> &&right_child)
-    : AbstractExecutor(exec_ctx) {
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_child)),
+      right_executor_(std::move(right_child)) {
   if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
     // Note for 2023 Spring: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
-void HashJoinExecutor::Init() { throw NotImplementedException("HashJoinExecutor is not implemented"); }
+void HashJoinExecutor::Init() {
+  left_executor_->Init();
+  results_.clear();
+  partition_index_ = 0;
+  result_index_ = 0;
+  pending_.clear();
+  probe_file_reader_.reset();
+  probe_file_.reset();
+  left_reader_ = std::make_unique<ChildReader>(left_executor_.get(), plan_->LeftJoinKeyExpressions());
+  std::vector<JoinRow> right_rows;
+  std::vector<std::unique_ptr<TmpTupleFile>> right_files;
+
+  // A parallel pipeline on the right is read by its workers, each on a thread of its own.
+  auto *right_gather = dynamic_cast<GatherExecutor *>(right_executor_.get());
+  if (right_gather != nullptr) {
+    if (BuildInParallel(right_gather->GetPipeline(), &right_rows, &right_files)) {
+      Build(std::move(right_rows));
+      return;
+    }
+  } else {
+    // Otherwise children are read on this thread, executors are not thread-safe. The right side is read until it is
+    // all in memory or does not fit, and the rest of it spilled after the tuples already read.
+    right_executor_->Init();
+    ChildReader right_reader(right_executor_.get(), plan_->RightJoinKeyExpressions());
+    size_t right_bytes = 0;
+    JoinRow row;
+    while (right_bytes <= exec_ctx_->GetHashJoinMemory() && right_reader.Next(&row)) {
+      right_bytes += RowBytes(row.tuple_.GetLength());
+      right_rows.push_back(std::move(row));
+    }
+    if (right_bytes <= exec_ctx_->GetHashJoinMemory()) {
+      Build(std::move(right_rows));
+      return;
+    }
+    right_files = MakeSpillFiles();
+    for (const auto &row : right_rows) {
+      SpillFileOf(row, right_files)->Append(row.tuple_);
+    }
+    right_rows = {};
+    while (right_reader.Next(&row)) {
+      SpillFileOf(row, right_files)->Append(row.tuple_);
+    }
+  }
+
+  for (auto &file : right_files) {
+    file->Finish();
+  }
+  auto left_files = MakeSpillFiles();
+  JoinRow row;
+  while (left_reader_->Next(&row)) {
+    SpillFileOf(row, left_files)->Append(row.tuple_);
+  }
+  left_reader_.reset();
+  AddSpilledPartitions(std::move(left_files), std::move(right_files), 1);
+}
+
+auto HashJoinExecutor::BuildInParallel(MorselPipeline *pipeline, std::vector<JoinRow> *right_rows,
+                                       std::vector<std::unique_ptr<TmpTupleFile>> *right_files) -> bool {
+  pipeline->Init();
+  // Rows are kept by morsel, to be laid out in the order of the table as if read on one thread. Once they do not fit,
+  // workers spill the rest of their rows instead, a file at a time.
+  *right_files = MakeSpillFiles();
+  std::vector<std::mutex> file_latches(right_files->size());
+  std::vector<std::vector<std::pair<size_t, std::vector<JoinRow>>>> morsels(pipeline->NumWorkers());
+  std::atomic<size_t> right_bytes{0};
+  RunParallel(exec_ctx_->GetWorkerPool(), pipeline->NumWorkers(), [&](size_t worker) {
+    ChildReader reader(pipeline->GetWorker(worker), plan_->RightJoinKeyExpressions());
+    size_t morsel;
+    while (pipeline->NextMorsel(worker, &morsel)) {
+      auto &rows = morsels[worker].emplace_back(morsel, std::vector<JoinRow>{}).second;
+      JoinRow row;
+      while (reader.Next(&row)) {
+        if (right_bytes <= exec_ctx_->GetHashJoinMemory()) {
+          right_bytes += RowBytes(row.tuple_.GetLength());
+          rows.push_back(std::move(row));
+          continue;
+        }
+        auto partition = row.hash_ >> (64 - HASH_JOIN_SPILL_BITS);
+        std::scoped_lock lock(file_latches[partition]);
+        (*right_files)[partition]->Append(row.tuple_);
+      }
+    }
+  });
+  if (right_bytes > exec_ctx_->GetHashJoinMemory()) {
+    // The rows read before the budget ran out are spilled too, rather than read again.
+    for (auto &worker_morsels : morsels) {
+      for (auto &[morsel, rows] : worker_morsels) {
+        for (const auto &row : rows) {
+          SpillFileOf(row, *right_files)->Append(row.tuple_);
+        }
+        rows = {};
+      }
+    }
+    return false;
+  }
+  right_files->clear();
+
+  std::vector<std::pair<size_t, std::vector<JoinRow>>> all_morsels;
+  for (auto &worker_morsels : morsels) {
+    std::move(worker_morsels.begin(), worker_morsels.end(), std::back_inserter(all_morsels));
+  }
+  std::sort(all_morsels.begin(), all_morsels.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+  right_rows->clear();
+  for (auto &[morsel, rows] : all_morsels) {
+    std::move(rows.begin(), rows.end(), std::back_inserter(*right_rows));
+  }
+  return true;
+}
+
+auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (true) {
+    while (partition_index_ < results_.size()) {
+      auto &partition = results_[partition_index_];
+      if (result_index_ < partition.size()) {
+        *tuple = std::move(partition[result_index_++]);
+        return true;
+      }
+      partition.clear();
+      partition_index_++;
+      result_index_ = 0;
+    }
+    if (ProbeNextBatch()) {
+      continue;
+    }
+    if (pending_.empty()) {
+      return false;
+    }
+    JoinSpilledPartition();
+  }
+}
+
+HashJoinExecutor::ChildReader::ChildReader(AbstractExecutor *child, const std::vector<AbstractExpressionRef> &key_exprs)
+    : child_(child),
+      key_exprs_(key_exprs),
+      vectorized_(child->GetExecutorContext()->IsVectorized()),
+      keys_(key_exprs.size()) {}
+
+auto HashJoinExecutor::ChildReader::Next(JoinRow *row) -> bool {
+  const auto &schema = child_->GetOutputSchema();
+  if (!vectorized_) {
+    Tuple tuple;
+    RID rid;
+    if (!child_->Next(&tuple, &rid)) {
+      return false;
+    }
+    *row = MakeRow(std::move(tuple), key_exprs_, schema);
+    return true;
+  }
+  while (next_ == batch_.Size()) {
+    if (!child_->NextBatch(&batch_)) {
+      batch_.Reset(schema);
+      next_ = 0;
+      return false;
+    }
+    next_ = 0;
+    for (size_t k = 0; k < key_exprs_.size(); k++) {
+      key_exprs_[k]->EvaluateBatch(batch_, schema, &keys_[k]);
+    }
+  }
+  auto batch_row = batch_.GetSelection()[next_++];
+  std::vector<Value> keys;
+  keys.reserve(keys_.size());
+  for (const auto &column : keys_) {
+    keys.push_back(column[batch_row]);
+  }
+  *row = MakeRow(batch_.GetTuple(batch_row, schema), std::move(keys));
+  return true;
+}
+
+auto HashJoinExecutor::MakeRow(Tuple &&tuple, const std::vector<AbstractExpressionRef> &key_exprs,
+                               const Schema &schema) -> JoinRow {
+  std::vector<Value> keys;
+  keys.reserve(key_exprs.size());
+  for (const auto &expr : key_exprs) {
+    keys.push_back(expr->Evaluate(&tuple, schema));
+  }
+  return MakeRow(std::move(tuple), std::move(keys));
+}
+
+auto HashJoinExecutor::MakeRow(Tuple &&tuple, std::vector<Value> keys) -> JoinRow {
+  JoinRow row{std::move(tuple), std::move(keys), 0, false};
+  hash_t hash = 0;
+  for (const auto &key : row.keys_) {
+    if (key.IsNull()) {
+      row.null_key_ = true;
+    } else {
+      hash = HashUtil::CombineHashes(hash, HashUtil::HashValue(&key));
+    }
+  }
+  row.hash_ = HashUtil::MixHash(hash);
+  return row;
+}
+
+auto HashJoinExecutor::RowBytes(size_t tuple_length) const -> size_t {
+  return sizeof(JoinRow) + tuple_length + plan_->RightJoinKeyExpressions().size() * sizeof(Value);
+}
+
+auto HashJoinExecutor::ReadRightRows(TmpTupleFile *file) -> std::vector<JoinRow> {
+  const auto &key_exprs = plan_->RightJoinKeyExpressions();
+  const auto &schema = right_executor_->GetOutputSchema();
+  std::vector<JoinRow> rows;
+  rows.reserve(file->GetNumTuples());
+  auto reader = file->Read();
+  Tuple tuple;
+  while (reader.Next(&tuple)) {
+    rows.push_back(MakeRow(std::move(tuple), key_exprs, schema));
+  }
+  return rows;
+}
+
+void HashJoinExecutor::Build(std::vector<JoinRow> right_rows) {
+  right_rows_ = std::move(right_rows);
+  radix_bits_ = 0;
+  while (radix_bits_ < HASH_JOIN_MAX_RADIX_BITS &&
+         (right_rows_.size() >> radix_bits_) > static_cast<size_t>(HASH_JOIN_PARTITION_ROWS)) {
+    radix_bits_++;
+  }
+  size_t num_threads = std::clamp<size_t>(right_rows_.size() / HASH_JOIN_ROWS_PER_THREAD, 1,
+                                          exec_ctx_->GetParallelism());
+  right_ = Partition(right_rows_, radix_bits_, num_threads);
+
+  size_t num_partitions = size_t{1} << radix_bits_;
+  tables_.assign(num_partitions, {});
+  std::atomic<size_t> next_partition{0};
+  RunParallel(exec_ctx_->GetWorkerPool(), std::min(num_threads, num_partitions), [&](size_t) {
+    for (size_t partition = next_partition++; partition < num_partitions; partition = next_partition++) {
+      BuildPartition(partition);
+    }
+  });
+}
+
+auto HashJoinExecutor::ProbeNextBatch() -> bool {
+  // Nothing comes of probing an empty build side but the padded tuples of a left join.
+  if (right_rows_.empty() && plan_->GetJoinType() == JoinType::INNER) {
+    left_reader_.reset();
+    probe_file_reader_.reset();
+    probe_file_.reset();
+  }
+  probe_rows_.clear();
+  size_t batch_rows = HASH_JOIN_ROWS_PER_THREAD * exec_ctx_->GetParallelism();
+  JoinRow row;
+  while (probe_rows_.size() < batch_rows && NextProbeRow(&row)) {
+    probe_rows_.push_back(std::move(row));
+  }
+  if (probe_rows_.empty()) {
+    return false;
+  }
+  Probe();
+  return true;
+}
+
+auto HashJoinExecutor::NextProbeRow(JoinRow *row) -> bool {
+  if (left_reader_ != nullptr) {
+    if (left_reader_->Next(row)) {
+      return true;
+    }
+    left_reader_.reset();
+    return false;
+  }
+  if (probe_file_reader_.has_value()) {
+    Tuple tuple;
+    if (probe_file_reader_->Next(&tuple)) {
+      *row = MakeRow(std::move(tuple), plan_->LeftJoinKeyExpressions(), left_executor_->GetOutputSchema());
+      return true;
+    }
+    probe_file_reader_.reset();
+    probe_file_.reset();
+  }
+  return false;
+}
+
+void HashJoinExecutor::Probe() {
+  size_t num_threads = std::clamp<size_t>(probe_rows_.size() / HASH_JOIN_ROWS_PER_THREAD, 1,
+                                          exec_ctx_->GetParallelism());
+  auto left = Partition(probe_rows_, radix_bits_, num_threads);
+
+  // Partitions are probed by whichever thread is free next, they may be of very different sizes.
+  size_t num_partitions = size_t{1} << radix_bits_;
+  results_.resize(num_partitions);
+  for (auto &results : results_) {
+    results.clear();
+  }
+  partition_index_ = 0;
+  result_index_ = 0;
+  std::atomic<size_t> next_partition{0};
+  RunParallel(exec_ctx_->GetWorkerPool(), std::min(num_threads, num_partitions), [&](size_t) {
+    for (size_t partition = next_partition++; partition < num_partitions; partition = next_partition++) {
+      ProbePartition(partition, left);
+    }
+  });
+}
+
+auto HashJoinExecutor::MakeSpillFiles() -> std::vector<std::unique_ptr<TmpTupleFile>> {
+  std::vector<std::unique_ptr<TmpTupleFile>> files;
+  for (size_t i = 0; i < (size_t{1} << HASH_JOIN_SPILL_BITS); i++) {
+    files.push_back(std::make_unique<TmpTupleFile>(exec_ctx_->GetBufferPoolManager()));
+  }
+  return files;
+}
+
+void HashJoinExecutor::AddSpilledPartitions(std::vector<std::unique_ptr<TmpTupleFile>> left_files,
+                                            std::vector<std::unique_ptr<TmpTupleFile>> right_files, uint32_t depth) {
+  for (size_t i = 0; i < left_files.size(); i++) {
+    left_files[i]->Finish();
+    right_files[i]->Finish();
+    // Left tuples without a partner are padded by a left join, nothing else comes of a partition missing a side.
+    bool inner = plan_->GetJoinType() == JoinType::INNER;
+    if (left_files[i]->GetNumTuples() == 0 || (inner && right_files[i]->GetNumTuples() == 0)) {
+      continue;
+    }
+    pending_.push_back({std::move(left_files[i]), std::move(right_files[i]), depth});
+  }
+}
+
+void HashJoinExecutor::JoinSpilledPartition() {
+  auto partition = std::move(pending_.back());
+  pending_.pop_back();
+  size_t right_bytes = partition.right_->GetTupleBytes() + partition.right_->GetNumTuples() * RowBytes(0);
+  if (right_bytes <= exec_ctx_->GetHashJoinMemory() || partition.depth_ >= HASH_JOIN_MAX_SPILL_DEPTH) {
+    Build(ReadRightRows(partition.right_.get()));
+    partition.right_.reset();
+    probe_file_ = std::move(partition.left_);
+    probe_file_reader_.emplace(probe_file_->Read());
+    return;
+  }
+
+  // Split both sides by the next bits of the hashes, below the ones the partition shares.
+  uint32_t shift = 64 - (partition.depth_ + 1) * HASH_JOIN_SPILL_BITS;
+  hash_t mask = (hash_t{1} << HASH_JOIN_SPILL_BITS) - 1;
+  auto split = [&](TmpTupleFile *file, bool left_side) {
+    const auto &key_exprs = left_side ? plan_->LeftJoinKeyExpressions() : plan_->RightJoinKeyExpressions();
+    const auto &schema = left_side ? left_executor_->GetOutputSchema() : right_executor_->GetOutputSchema();
+    auto files = MakeSpillFiles();
+    auto reader = file->Read();
+    Tuple tuple;
+    while (reader.Next(&tuple)) {
+      auto row = MakeRow(std::move(tuple), key_exprs, schema);
+      files[(row.hash_ >> shift) & mask]->Append(row.tuple_);
+    }
+    for (auto &split_file : files) {
+      split_file->Finish();
+    }
+    return files;
+  };
+  auto right_files = split(partition.right_.get(), false);
+  partition.right_.reset();
+  auto left_files = split(partition.left_.get(), true);
+  partition.left_.reset();
+  AddSpilledPartitions(std::move(left_files), std::move(right_files), partition.depth_ + 1);
+}
+
+auto HashJoinExecutor::Partition(const std::vector<JoinRow> &rows, uint32_t radix_bits, size_t num_threads)
+    -> PartitionedRows {
+  size_t num_partitions = size_t{1} << radix_bits;
+  hash_t mask = num_partitions - 1;
+  size_t chunk = (rows.size() + num_threads - 1) / num_threads;
+  auto chunk_of = [&](size_t thread) {
+    return std::make_pair(std::min(rows.size(), thread * chunk), std::min(rows.size(), (thread + 1) * chunk));
+  };
+
+  // Each thread counts the rows of its chunk in each partition, then scatters them to its own slice of each partition:
+  // slices are laid out partition by partition, thread by thread within a partition.
+  std::vector<std::vector<size_t>> positions(num_threads, std::vector<size_t>(num_partitions, 0));
+  RunParallel(exec_ctx_->GetWorkerPool(), num_threads, [&](size_t thread) {
+    auto [begin, end] = chunk_of(thread);
+    for (size_t i = begin; i < end; i++) {
+      positions[thread][rows[i].hash_ & mask]++;
+    }
+  });
+  PartitionedRows result;
+  result.offsets_.resize(num_partitions + 1);
+  size_t offset = 0;
+  for (size_t partition = 0; partition < num_partitions; partition++) {
+    result.offsets_[partition] = offset;
+    for (size_t thread = 0; thread < num_threads; thread++) {
+      size_t count = positions[thread][partition];
+      positions[thread][partition] = offset;
+      offset += count;
+    }
+  }
+  result.offsets_[num_partitions] = offset;
+  result.entries_.resize(rows.size());
+  RunParallel(exec_ctx_->GetWorkerPool(), num_threads, [&](size_t thread) {
+    auto [begin, end] = chunk_of(thread);
+    for (size_t i = begin; i < end; i++) {
+      result.entries_[positions[thread][rows[i].hash_ & mask]++] = {rows[i].hash_, static_cast<uint32_t>(i)};
+    }
+  });
+  return result;
+}
+
+void HashJoinExecutor::BuildPartition(size_t partition) {
+  // Entries of a partition share their low radix_bits_ bits, slots are chosen by the bits above them.
+  size_t begin = right_.offsets_[partition];
+  size_t end = right_.offsets_[partition + 1];
+  size_t capacity = 2;
+  while (capacity < 2 * (end - begin)) {
+    capacity *= 2;
+  }
+  size_t slot_mask = capacity - 1;
+  auto &slots = tables_[partition];
+  slots.assign(capacity, 0);
+  for (size_t i = begin; i < end; i++) {
+    const auto &entry = right_.entries_[i];
+    if (right_rows_[entry.row_].null_key_) {
+      continue;
+    }
+    size_t slot = (entry.hash_ >> radix_bits_) & slot_mask;
+    while (slots[slot] != 0) {
+      slot = (slot + 1) & slot_mask;
+    }
+    slots[slot] = static_cast<uint32_t>(i - begin + 1);
+  }
+}
+
+void HashJoinExecutor::ProbePartition(size_t partition, const PartitionedRows &left) {
+  const auto &left_schema = left_executor_->GetOutputSchema();
+  const auto &right_schema = right_executor_->GetOutputSchema();
+  auto &results = results_[partition];
+  auto join = [&](const JoinRow &left_row, const JoinRow *right_row) {
+    std::vector<Value> values;
+    values.reserve(GetOutputSchema().GetColumnCount());
+    for (uint32_t col = 0; col < left_schema.GetColumnCount(); col++) {
+      values.push_back(left_row.tuple_.GetValue(&left_schema, col));
+    }
+    for (uint32_t col = 0; col < right_schema.GetColumnCount(); col++) {
+      values.push_back(right_row == nullptr ? ValueFactory::GetNullValueByType(right_schema.GetColumn(col).GetType())
+                                            : right_row->tuple_.GetValue(&right_schema, col));
+    }
+    results.emplace_back(values, &GetOutputSchema());
+  };
 
-auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+  // Every right entry of the same hash is compared by its keys.
+  size_t right_begin = right_.offsets_[partition];
+  const auto &slots = tables_[partition];
+  size_t slot_mask = slots.size() - 1;
+  for (size_t i = left.offsets_[partition]; i < left.offsets_[partition + 1]; i++) {
+    const auto &entry = left.entries_[i];
+    const auto &left_row = probe_rows_[entry.row_];
+    bool matched = false;
+    if (!left_row.null_key_) {
+      for (size_t slot = (entry.hash_ >> radix_bits_) & slot_mask; slots[slot] != 0; slot = (slot + 1) & slot_mask) {
+        const auto &right_entry = right_.entries_[right_begin + slots[slot] - 1];
+        if (right_entry.hash_ != entry.hash_) {
+          continue;
+        }
+        const auto &right_row = right_rows_[right_entry.row_];
+        bool equal = true;
+        for (size_t k = 0; k < left_row.keys_.size() && equal; k++) {
+          equal = left_row.keys_[k].CompareEquals(right_row.keys_[k]) == CmpBool::CmpTrue;
+        }
+        if (equal) {
+          join(left_row, &right_row);
+          matched = true;
+        }
+      }
+    }
+    if (!matched && plan_->GetJoinType() == JoinType::LEFT) {
+      join(left_row, nullptr);
+    }
+  }
+}
 
 }  // namespace bustub
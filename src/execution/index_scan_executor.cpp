@@ -13,10 +13,45 @@
 
 namespace bustub {
 IndexScanExecutor::IndexScanExecutor(ExecutorContext *exec_ctx, const IndexScanPlanNode *plan)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
 
-void IndexScanExecutor::Init() { throw NotImplementedException("IndexScanExecutor is not implemented"); }
+void IndexScanExecutor::Init() {
+  auto *catalog = exec_ctx_->GetCatalog();
+  index_info_ = catalog->GetIndex(plan_->GetIndexOid());
+  table_info_ = catalog->GetTable(index_info_->table_name_);
 
-auto IndexScanExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+  const auto *key_schema = index_info_->index_->GetKeySchema();
+  IndexScanRange range;
+  if (plan_->low_.has_value()) {
+    range.low_ = Tuple({plan_->low_->value_}, key_schema);
+    range.low_inclusive_ = plan_->low_->inclusive_;
+  }
+  if (plan_->high_.has_value()) {
+    range.high_ = Tuple({plan_->high_->value_}, key_schema);
+    range.high_inclusive_ = plan_->high_->inclusive_;
+  }
+  range.reverse_ = plan_->reverse_;
+  cursor_ = index_info_->index_->ScanRange(range, exec_ctx_->GetTransaction());
+}
+
+auto IndexScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  RID index_rid;
+  while (cursor_->Next(&index_rid)) {
+    auto [meta, table_tuple] = table_info_->table_->GetTuple(index_rid);
+    if (meta.is_deleted_) {
+      continue;
+    }
+    if (plan_->filter_predicate_ != nullptr) {
+      auto value = plan_->filter_predicate_->Evaluate(&table_tuple, GetOutputSchema());
+      if (value.IsNull() || !value.GetAs<bool>()) {
+        continue;
+      }
+    }
+    *tuple = std::move(table_tuple);
+    *rid = index_rid;
+    return true;
+  }
+  return false;
+}
 
 }  // namespace bustub
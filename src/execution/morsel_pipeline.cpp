@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// morsel_pipeline.cpp
+//
+// Identification: src/execution/morsel_pipeline.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/morsel_pipeline.h"
+
+#include "execution/executors/filter_executor.h"
+#include "execution/executors/projection_executor.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/projection_plan.h"
+
+namespace bustub {
+
+auto MorselPipeline::Make(ExecutorContext *exec_ctx, const AbstractPlanNodeRef &plan, size_t num_workers)
+    -> std::unique_ptr<MorselPipeline> {
+  if (num_workers <= 1) {
+    return nullptr;
+  }
+  const AbstractPlanNode *leaf = plan.get();
+  while (leaf->GetType() == PlanType::Projection || leaf->GetType() == PlanType::Filter) {
+    leaf = leaf->GetChildAt(0).get();
+  }
+  if (leaf->GetType() != PlanType::SeqScan) {
+    return nullptr;
+  }
+
+  std::unique_ptr<MorselPipeline> pipeline(new MorselPipeline());
+  const auto *scan_plan = dynamic_cast<const SeqScanPlanNode *>(leaf);
+  pipeline->morsels_ =
+      std::make_unique<MorselQueue>(exec_ctx->GetCatalog()->GetTable(scan_plan->GetTableOid())->table_.get());
+  pipeline->scans_.resize(num_workers);
+  for (size_t i = 0; i < num_workers; i++) {
+    pipeline->workers_.push_back(MakeWorker(exec_ctx, plan, &pipeline->scans_[i]));
+  }
+  return pipeline;
+}
+
+auto MorselPipeline::MakeWorker(ExecutorContext *exec_ctx, const AbstractPlanNodeRef &plan, SeqScanExecutor **scan)
+    -> std::unique_ptr<AbstractExecutor> {
+  switch (plan->GetType()) {
+    case PlanType::Projection: {
+      const auto *projection_plan = dynamic_cast<const ProjectionPlanNode *>(plan.get());
+      auto child = MakeWorker(exec_ctx, projection_plan->GetChildPlan(), scan);
+      return std::make_unique<ProjectionExecutor>(exec_ctx, projection_plan, std::move(child));
+    }
+    case PlanType::Filter: {
+      const auto *filter_plan = dynamic_cast<const FilterPlanNode *>(plan.get());
+      auto child = MakeWorker(exec_ctx, filter_plan->GetChildPlan(), scan);
+      return std::make_unique<FilterExecutor>(exec_ctx, filter_plan, std::move(child));
+    }
+    default: {
+      auto executor =
+          std::make_unique<SeqScanExecutor>(exec_ctx, dynamic_cast<const SeqScanPlanNode *>(plan.get()), true);
+      *scan = executor.get();
+      return executor;
+    }
+  }
+}
+
+void MorselPipeline::Init() {
+  morsels_->Reset();
+  for (auto &worker : workers_) {
+    worker->Init();
+  }
+}
+
+auto MorselPipeline::NextMorsel(size_t worker, size_t *morsel) -> bool {
+  auto iter = morsels_->Next(morsel);
+  if (iter == nullptr) {
+    return false;
+  }
+  scans_[worker]->SetMorsel(std::move(iter));
+  return true;
+}
+
+auto MorselPipeline::Next(size_t worker, Tuple *tuple, RID *rid) -> bool {
+  size_t morsel;
+  while (!workers_[worker]->Next(tuple, rid)) {
+    if (!NextMorsel(worker, &morsel)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto MorselPipeline::NextBatch(size_t worker, TupleBatch *batch) -> bool {
+  size_t morsel;
+  while (!workers_[worker]->NextBatch(batch)) {
+    if (!NextMorsel(worker, &morsel)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace bustub
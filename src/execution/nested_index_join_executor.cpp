@@ -11,20 +11,98 @@
 //===----------------------------------------------------------------------===//
 
 #include "execution/executors/nested_index_join_executor.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 
 NestIndexJoinExecutor::NestIndexJoinExecutor(ExecutorContext *exec_ctx, const NestedIndexJoinPlanNode *plan,
                                              std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {
   if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
     // Note for 2023 Spring: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
-void NestIndexJoinExecutor::Init() { throw NotImplementedException("NestIndexJoinExecutor is not implemented"); }
+void NestIndexJoinExecutor::Init() {
+  child_executor_->Init();
+  index_info_ = exec_ctx_->GetCatalog()->GetIndex(plan_->GetIndexOid());
+  table_info_ = exec_ctx_->GetCatalog()->GetTable(plan_->GetInnerTableOid());
+  batch_.clear();
+  batch_index_ = 0;
+  child_exhausted_ = false;
+}
+
+auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (batch_index_ == batch_.size()) {
+    if (child_exhausted_) {
+      return false;
+    }
+    JoinBatch();
+  }
+  *tuple = std::move(batch_[batch_index_++]);
+  return true;
+}
+
+void NestIndexJoinExecutor::JoinBatch() {
+  const auto &outer_schema = child_executor_->GetOutputSchema();
+  const auto &inner_schema = plan_->InnerTableSchema();
+  const auto *key_schema = index_info_->index_->GetKeySchema();
 
-auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+  std::vector<Tuple> outer_tuples;
+  std::vector<Tuple> keys;
+  // Outer tuples whose key is null match nothing, and are not looked up.
+  std::vector<bool> null_keys;
+  Tuple outer_tuple;
+  RID outer_rid;
+  while (outer_tuples.size() < static_cast<size_t>(INDEX_JOIN_BATCH_SIZE)) {
+    if (!child_executor_->Next(&outer_tuple, &outer_rid)) {
+      child_exhausted_ = true;
+      break;
+    }
+    Value key = plan_->KeyPredicate()->Evaluate(&outer_tuple, outer_schema);
+    null_keys.push_back(key.IsNull());
+    if (!key.IsNull()) {
+      keys.emplace_back(std::vector<Value>{key}, key_schema);
+    }
+    outer_tuples.push_back(std::move(outer_tuple));
+  }
+
+  std::vector<std::vector<RID>> matches;
+  index_info_->index_->ScanKeys(keys, &matches, exec_ctx_->GetTransaction());
+
+  batch_.clear();
+  batch_index_ = 0;
+  size_t key_index = 0;
+  for (size_t i = 0; i < outer_tuples.size(); i++) {
+    std::vector<Value> values;
+    values.reserve(GetOutputSchema().GetColumnCount());
+    for (uint32_t col = 0; col < outer_schema.GetColumnCount(); col++) {
+      values.push_back(outer_tuples[i].GetValue(&outer_schema, col));
+    }
+    bool matched = false;
+    if (!null_keys[i]) {
+      for (const auto &inner_rid : matches[key_index]) {
+        auto [meta, inner_tuple] = table_info_->table_->GetTuple(inner_rid);
+        if (meta.is_deleted_) {
+          continue;
+        }
+        auto joined = values;
+        for (uint32_t col = 0; col < inner_schema.GetColumnCount(); col++) {
+          joined.push_back(inner_tuple.GetValue(&inner_schema, col));
+        }
+        batch_.emplace_back(joined, &GetOutputSchema());
+        matched = true;
+      }
+      key_index++;
+    }
+    if (!matched && plan_->GetJoinType() == JoinType::LEFT) {
+      for (uint32_t col = 0; col < inner_schema.GetColumnCount(); col++) {
+        values.push_back(ValueFactory::GetNullValueByType(inner_schema.GetColumn(col).GetType()));
+      }
+      batch_.emplace_back(values, &GetOutputSchema());
+    }
+  }
+}
 
 }  // namespace bustub
@@ -5,7 +5,12 @@ namespace bustub {
 
 ProjectionExecutor::ProjectionExecutor(ExecutorContext *exec_ctx, const ProjectionPlanNode *plan,
                                        std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {
+  expressions_.reserve(plan_->GetExpressions().size());
+  for (const auto &expr : plan_->GetExpressions()) {
+    expressions_.emplace_back(expr, plan_->GetChildPlan()->OutputSchema());
+  }
+}
 
 void ProjectionExecutor::Init() {
   // Initialize the child executor
@@ -25,12 +30,36 @@ auto ProjectionExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   // Compute expressions
   std::vector<Value> values{};
   values.reserve(GetOutputSchema().GetColumnCount());
-  for (const auto &expr : plan_->GetExpressions()) {
-    values.push_back(expr->Evaluate(&child_tuple, child_executor_->GetOutputSchema()));
+  for (auto &expr : expressions_) {
+    values.push_back(expr.Evaluate(child_tuple));
   }
 
   *tuple = Tuple{values, &GetOutputSchema()};
 
   return true;
 }
+
+auto ProjectionExecutor::NextBatch(TupleBatch *batch) -> bool {
+  if (!child_executor_->NextBatch(&child_batch_)) {
+    return false;
+  }
+
+  // The selected rows of the child are packed into the rows of the output batch.
+  const auto &selection = child_batch_.GetSelection();
+  batch->Reset(GetOutputSchema());
+  batch->Resize(selection.size());
+  for (size_t i = 0; i < selection.size(); i++) {
+    batch->SetRid(i, child_batch_.GetRid(selection[i]));
+  }
+  std::vector<Value> values;
+  for (uint32_t col = 0; col < expressions_.size(); col++) {
+    expressions_[col].EvaluateBatch(child_batch_, &values);
+    auto &column = batch->GetColumn(col);
+    for (size_t i = 0; i < selection.size(); i++) {
+      column.SetValue(i, values[selection[i]]);
+    }
+  }
+  return true;
+}
+
 }  // namespace bustub
@@ -1,23 +1,77 @@
-//===----------------------------------------------------------------------===//
-//
-//                         BusTub
-//
-// seq_scan_executor.cpp
-//
-// Identification: src/execution/seq_scan_executor.cpp
-//
-// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
-//
-//===----------------------------------------------------------------------===//
-
-#include "execution/executors/seq_scan_executor.h"
-
-namespace bustub {
-
-SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan) : AbstractExecutor(exec_ctx) {}
-
-void SeqScanExecutor::Init() { throw NotImplementedException("SeqScanExecutor is not implemented"); }
-
-auto SeqScanExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
-
-}  // namespace bustub
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// seq_scan_executor.cpp
+//
+// Identification: src/execution/seq_scan_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/seq_scan_executor.h"
+
+namespace bustub {
+
+SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan, bool morsel_driven)
+    : AbstractExecutor(exec_ctx), plan_(plan), morsel_driven_(morsel_driven) {
+  if (plan_->filter_predicate_ != nullptr) {
+    predicate_ = std::make_unique<CompiledExpression>(plan_->filter_predicate_, GetOutputSchema());
+  }
+}
+
+void SeqScanExecutor::Init() {
+  if (morsel_driven_) {
+    iter_.reset();
+    return;
+  }
+  auto *table_info = exec_ctx_->GetCatalog()->GetTable(plan_->GetTableOid());
+  iter_ = std::make_unique<TableIterator>(table_info->table_->MakeIterator());
+}
+
+auto SeqScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (iter_ == nullptr) {
+    return false;
+  }
+  // Tuples are read in place and only copied if they pass the predicate. The page is dropped before a tuple is
+  // yielded, as the parent may write to the table (a delete or an update scans the table it writes).
+  for (; !iter_->IsEnd(); ++(*iter_)) {
+    auto [meta, next_tuple] = iter_->GetTupleRef();
+    if (meta.is_deleted_) {
+      continue;
+    }
+    if (predicate_ != nullptr && !predicate_->EvaluatePredicate(next_tuple)) {
+      continue;
+    }
+    *rid = iter_->GetRID();
+    *tuple = next_tuple.ToTuple();
+    ++(*iter_);
+    iter_->DropPage();
+    return true;
+  }
+  iter_->DropPage();
+  return false;
+}
+
+auto SeqScanExecutor::NextBatch(TupleBatch *batch) -> bool {
+  while (iter_ != nullptr && !iter_->IsEnd()) {
+    batch->Reset(GetOutputSchema());
+    for (; !iter_->IsEnd() && batch->NumRows() < static_cast<size_t>(BATCH_SIZE); ++(*iter_)) {
+      auto [meta, tuple] = iter_->GetTupleRef();
+      if (!meta.is_deleted_) {
+        batch->AppendTuple(tuple, GetOutputSchema(), iter_->GetRID());
+      }
+    }
+    iter_->DropPage();
+    if (predicate_ != nullptr) {
+      predicate_->SelectBatch(batch);
+    }
+    if (batch->Size() > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace bustub
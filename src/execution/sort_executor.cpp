@@ -1,13 +1,139 @@
 #include "execution/executors/sort_executor.h"
 
+#include <algorithm>
+
 namespace bustub {
 
 SortExecutor::SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan,
                            std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_executor_(std::move(child_executor)),
+      encoder_(plan->GetOrderBy()) {}
+
+void SortExecutor::Init() {
+  child_executor_->Init();
+  runs_.clear();
+  inputs_.clear();
+  tree_.reset();
+
+  std::vector<SortRow> rows;
+  size_t bytes = 0;
+  Tuple tuple;
+  RID rid;
+  while (child_executor_->Next(&tuple, &rid)) {
+    rows.push_back(MakeRow(std::move(tuple)));
+    bytes += sizeof(SortRow) + rows.back().tuple_.GetLength() + rows.back().key_.size();
+    if (bytes > exec_ctx_->GetSortMemory()) {
+      SpillRun(&rows);
+      bytes = 0;
+    }
+  }
+
+  // Merge runs until the last merge reads few enough of them at once, each pinning a page, along the rows left in
+  // memory.
+  while (runs_.size() >= static_cast<size_t>(SORT_MERGE_FANIN)) {
+    std::vector<std::unique_ptr<TmpTupleFile>> merged;
+    for (size_t begin = 0; begin < runs_.size(); begin += SORT_MERGE_FANIN) {
+      merged.push_back(MergeRuns(begin, std::min(runs_.size(), begin + SORT_MERGE_FANIN)));
+    }
+    runs_ = std::move(merged);
+  }
+  std::vector<MergeInput> inputs(runs_.size() + 1);
+  for (size_t i = 0; i < runs_.size(); i++) {
+    inputs[i].reader_ = std::make_unique<TmpTupleFile::Reader>(runs_[i]->Read());
+    inputs[i].file_ = std::move(runs_[i]);
+  }
+  runs_.clear();
+  // The rows in memory come last, after every run spilled before them, which keeps equal rows in input order.
+  std::stable_sort(rows.begin(), rows.end(), [](const SortRow &a, const SortRow &b) { return a.key_ < b.key_; });
+  inputs.back().rows_ = std::move(rows);
+  StartMerge(std::move(inputs));
+}
+
+auto SortExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  size_t top = tree_->Top();
+  if (top == inputs_.size()) {
+    return false;
+  }
+  auto &input = inputs_[top];
+  *tuple = std::move(input.head_.tuple_);
+  *rid = tuple->GetRid();
+  if (!Advance(&input)) {
+    tree_->SetExhausted(top);
+  }
+  tree_->Replay();
+  return true;
+}
+
+auto SortExecutor::MakeRow(Tuple &&tuple) const -> SortRow {
+  auto key = encoder_.Encode(tuple, child_executor_->GetOutputSchema());
+  return {std::move(tuple), std::move(key)};
+}
+
+void SortExecutor::SpillRun(std::vector<SortRow> *rows) {
+  std::stable_sort(rows->begin(), rows->end(), [](const SortRow &a, const SortRow &b) { return a.key_ < b.key_; });
+  auto run = std::make_unique<TmpTupleFile>(exec_ctx_->GetBufferPoolManager());
+  for (const auto &row : *rows) {
+    run->Append(row.tuple_);
+  }
+  run->Finish();
+  runs_.push_back(std::move(run));
+  rows->clear();
+  rows->shrink_to_fit();
+}
+
+auto SortExecutor::Advance(MergeInput *input) const -> bool {
+  if (input->reader_ != nullptr) {
+    Tuple tuple;
+    if (!input->reader_->Next(&tuple)) {
+      input->reader_.reset();
+      input->file_.reset();
+      return false;
+    }
+    input->head_ = MakeRow(std::move(tuple));
+    return true;
+  }
+  if (input->next_row_ == input->rows_.size()) {
+    input->rows_ = {};
+    return false;
+  }
+  input->head_ = std::move(input->rows_[input->next_row_++]);
+  return true;
+}
 
-void SortExecutor::Init() { throw NotImplementedException("SortExecutor is not implemented"); }
+void SortExecutor::StartMerge(std::vector<MergeInput> inputs) {
+  inputs_ = std::move(inputs);
+  tree_ = std::make_unique<LoserTree<HeadLess>>(inputs_.size(), HeadLess{&inputs_});
+  for (size_t i = 0; i < inputs_.size(); i++) {
+    if (!Advance(&inputs_[i])) {
+      tree_->SetExhausted(i);
+    }
+  }
+  tree_->Build();
+}
 
-auto SortExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto SortExecutor::MergeRuns(size_t begin, size_t end) -> std::unique_ptr<TmpTupleFile> {
+  std::vector<MergeInput> inputs(end - begin);
+  LoserTree<HeadLess> tree(inputs.size(), HeadLess{&inputs});
+  for (size_t i = 0; i < inputs.size(); i++) {
+    inputs[i].reader_ = std::make_unique<TmpTupleFile::Reader>(runs_[begin + i]->Read());
+    inputs[i].file_ = std::move(runs_[begin + i]);
+    if (!Advance(&inputs[i])) {
+      tree.SetExhausted(i);
+    }
+  }
+  tree.Build();
+  auto merged = std::make_unique<TmpTupleFile>(exec_ctx_->GetBufferPoolManager());
+  for (size_t top = tree.Top(); top < inputs.size(); top = tree.Top()) {
+    merged->Append(inputs[top].head_.tuple_);
+    if (!Advance(&inputs[top])) {
+      tree.SetExhausted(top);
+    }
+    tree.Replay();
+  }
+  merged->Finish();
+  return merged;
+}
 
 }  // namespace bustub
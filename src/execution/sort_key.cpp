@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key.cpp
+//
+// Identification: src/execution/sort_key.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/sort_key.h"
+
+#include <cstring>
+
+#include "common/exception.h"
+#include "fmt/format.h"
+#include "type/type.h"
+
+namespace bustub {
+
+namespace {
+
+/** Append the lowest `bytes` bytes of an unsigned integer, most significant first. */
+void AppendBigEndian(uint64_t bits, size_t bytes, std::string *key) {
+  for (size_t i = bytes; i > 0; i--) {
+    key->push_back(static_cast<char>((bits >> (8 * (i - 1))) & 0xff));
+  }
+}
+
+/** Append a signed integer of `bytes` bytes, with its sign bit flipped so that negative ones sort first. */
+void AppendSigned(int64_t value, size_t bytes, std::string *key) {
+  uint64_t bits = static_cast<uint64_t>(value) ^ (uint64_t{1} << (8 * bytes - 1));
+  AppendBigEndian(bits, bytes, key);
+}
+
+}  // namespace
+
+auto SortKeyEncoder::Encode(const Tuple &tuple, const Schema &schema) const -> std::string {
+  std::string key;
+  for (const auto &[order_by_type, expr] : order_bys_) {
+    EncodeValue(expr->Evaluate(&tuple, schema), order_by_type == OrderByType::DESC, &key);
+  }
+  return key;
+}
+
+void SortKeyEncoder::EncodeValue(const Value &value, bool descending, std::string *key) {
+  size_t begin = key->size();
+  if (value.IsNull()) {
+    key->push_back('\0');
+  } else {
+    key->push_back('\1');
+    switch (value.GetTypeId()) {
+      case TypeId::BOOLEAN:
+        key->push_back(static_cast<char>(value.GetAs<int8_t>()));
+        break;
+      case TypeId::TINYINT:
+        AppendSigned(value.GetAs<int8_t>(), sizeof(int8_t), key);
+        break;
+      case TypeId::SMALLINT:
+        AppendSigned(value.GetAs<int16_t>(), sizeof(int16_t), key);
+        break;
+      case TypeId::INTEGER:
+        AppendSigned(value.GetAs<int32_t>(), sizeof(int32_t), key);
+        break;
+      case TypeId::BIGINT:
+        AppendSigned(value.GetAs<int64_t>(), sizeof(int64_t), key);
+        break;
+      case TypeId::DECIMAL: {
+        // -0.0 equals 0.0, and encodes the same.
+        double decimal = value.GetAs<double>() == 0 ? 0.0 : value.GetAs<double>();
+        uint64_t bits;
+        memcpy(&bits, &decimal, sizeof(double));
+        bits = (bits >> 63) != 0 ? ~bits : bits | (uint64_t{1} << 63);
+        AppendBigEndian(bits, sizeof(uint64_t), key);
+        break;
+      }
+      case TypeId::VARCHAR: {
+        // The data of a varchar ends with a '\0' that is not part of the string.
+        const char *data = value.GetData();
+        for (uint32_t i = 0; i + 1 < value.GetLength(); i++) {
+          key->push_back(data[i]);
+          if (data[i] == '\0') {
+            key->push_back('\xff');
+          }
+        }
+        key->append(2, '\0');
+        break;
+      }
+      default:
+        throw NotImplementedException(
+            fmt::format("cannot sort by values of type {}", Type::TypeIdToString(value.GetTypeId())));
+    }
+  }
+  if (descending) {
+    for (size_t i = begin; i < key->size(); i++) {
+      (*key)[i] = static_cast<char>(~(*key)[i]);
+    }
+  }
+}
+
+}  // namespace bustub
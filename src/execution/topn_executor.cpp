@@ -1,15 +1,50 @@
 #include "execution/executors/topn_executor.h"
 
+#include <algorithm>
+
 namespace bustub {
 
 TopNExecutor::TopNExecutor(ExecutorContext *exec_ctx, const TopNPlanNode *plan,
                            std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_executor_(std::move(child_executor)),
+      encoder_(plan->GetOrderBy()) {}
+
+void TopNExecutor::Init() {
+  child_executor_->Init();
+  top_entries_.clear();
+  next_entry_ = 0;
 
-void TopNExecutor::Init() { throw NotImplementedException("TopNExecutor is not implemented"); }
+  Tuple tuple;
+  RID rid;
+  size_t seq = 0;
+  while (child_executor_->Next(&tuple, &rid)) {
+    TopEntry entry{encoder_.Encode(tuple, child_executor_->GetOutputSchema()), seq++, {}};
+    if (top_entries_.size() == plan_->GetN()) {
+      // Nothing sorts after the last of the first N, which is what a tuple has to beat.
+      if (top_entries_.empty() || !(entry < top_entries_.front())) {
+        continue;
+      }
+      std::pop_heap(top_entries_.begin(), top_entries_.end());
+      top_entries_.pop_back();
+    }
+    entry.tuple_ = std::move(tuple);
+    top_entries_.push_back(std::move(entry));
+    std::push_heap(top_entries_.begin(), top_entries_.end());
+  }
+  std::sort_heap(top_entries_.begin(), top_entries_.end());
+}
 
-auto TopNExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto TopNExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (next_entry_ == top_entries_.size()) {
+    return false;
+  }
+  *tuple = std::move(top_entries_[next_entry_++].tuple_);
+  *rid = tuple->GetRid();
+  return true;
+}
 
-auto TopNExecutor::GetNumInHeap() -> size_t { throw NotImplementedException("TopNExecutor is not implemented"); };
+auto TopNExecutor::GetNumInHeap() -> size_t { return top_entries_.size(); };
 
 }  // namespace bustub
@@ -0,0 +1,169 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_batch.cpp
+//
+// Identification: src/execution/tuple_batch.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/tuple_batch.h"
+
+#include <cstring>
+
+#include "type/type.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** @return a value as one of a column of the given type */
+auto ConvertValue(const Value &value, TypeId type) -> Value {
+  if (value.GetTypeId() == type) {
+    return value;
+  }
+  return value.IsNull() ? ValueFactory::GetNullValueByType(type) : value.CastAs(type);
+}
+
+}  // namespace
+
+ColumnVector::ColumnVector(TypeId type) : type_(type), width_(Type::GetTypeSize(type)) {}
+
+auto ColumnVector::GetValue(size_t row) const -> Value { return Value::DeserializeFrom(GetDataPtr(row), type_); }
+
+void ColumnVector::SetValue(size_t row, const Value &value) {
+  auto converted = ConvertValue(value, type_);
+  if (width_ == 0) {
+    uint32_t len = converted.GetLength();
+    offsets_[row] = data_.size();
+    data_.resize(data_.size() + sizeof(uint32_t) + (len == BUSTUB_VALUE_NULL ? 0 : len));
+  }
+  converted.SerializeTo(data_.data() + (width_ == 0 ? offsets_[row] : row * width_));
+}
+
+void ColumnVector::Clear() {
+  data_.clear();
+  offsets_.clear();
+  size_ = 0;
+}
+
+void ColumnVector::Append(const Value &value) {
+  Resize(size_ + 1);
+  SetValue(size_ - 1, value);
+}
+
+void ColumnVector::Resize(size_t size) {
+  if (width_ == 0) {
+    offsets_.resize(size);
+  } else {
+    data_.resize(size * width_);
+  }
+  size_ = size;
+}
+
+auto ColumnVector::SerializedLength(const char *data) const -> uint32_t {
+  if (width_ != 0) {
+    return width_;
+  }
+  uint32_t len = *reinterpret_cast<const uint32_t *>(data);
+  return sizeof(uint32_t) + (len == BUSTUB_VALUE_NULL ? 0 : len);
+}
+
+void ColumnVector::AppendData(const char *data) {
+  if (width_ == 0) {
+    offsets_.push_back(data_.size());
+  }
+  data_.insert(data_.end(), data, data + SerializedLength(data));
+  size_++;
+}
+
+void TupleBatch::Reset(const Schema &schema) {
+  // A batch is usually refilled with tuples of the same schema, into the buffers of its columns.
+  bool same_types = columns_.size() == schema.GetColumnCount();
+  for (uint32_t col = 0; same_types && col < columns_.size(); col++) {
+    same_types = columns_[col].GetType() == schema.GetColumn(col).GetType();
+  }
+  if (same_types) {
+    for (auto &column : columns_) {
+      column.Clear();
+    }
+  } else {
+    columns_.clear();
+    columns_.reserve(schema.GetColumnCount());
+    for (const auto &column : schema.GetColumns()) {
+      columns_.emplace_back(column.GetType());
+    }
+  }
+  rids_.clear();
+  selection_.clear();
+}
+
+void TupleBatch::Select(const std::vector<Value> &predicate) {
+  size_t kept = 0;
+  for (auto row : selection_) {
+    if (!predicate[row].IsNull() && predicate[row].GetAs<bool>()) {
+      selection_[kept++] = row;
+    }
+  }
+  selection_.resize(kept);
+}
+
+void TupleBatch::Select(const std::vector<uint64_t> &bitmap) {
+  size_t kept = 0;
+  for (auto row : selection_) {
+    if (((bitmap[row / 64] >> (row % 64)) & 1) != 0) {
+      selection_[kept++] = row;
+    }
+  }
+  selection_.resize(kept);
+}
+
+void TupleBatch::AppendTuple(const TupleRef &tuple, const Schema &schema, RID rid) {
+  for (uint32_t col = 0; col < columns_.size(); col++) {
+    columns_[col].AppendData(tuple.GetDataPtr(&schema, col));
+  }
+  selection_.push_back(rids_.size());
+  rids_.push_back(rid);
+}
+
+void TupleBatch::Resize(size_t num_rows) {
+  for (auto &column : columns_) {
+    column.Resize(num_rows);
+  }
+  rids_.resize(num_rows);
+  selection_.resize(num_rows);
+  for (size_t row = 0; row < num_rows; row++) {
+    selection_[row] = row;
+  }
+}
+
+auto TupleBatch::GetTuple(uint32_t row, const Schema &schema) const -> Tuple {
+  // Lay the row out as Tuple(values, schema) would: fixed-length values in place, varchars after them.
+  uint32_t length = schema.GetLength();
+  for (auto col : schema.GetUnlinedColumns()) {
+    const auto &column = columns_[col];
+    length += column.SerializedLength(column.GetDataPtr(row));
+  }
+  Tuple tuple{rids_[row]};
+  tuple.data_.resize(length);
+  uint32_t offset = schema.GetLength();
+  for (uint32_t col = 0; col < columns_.size(); col++) {
+    const auto &column = columns_[col];
+    const char *data = column.GetDataPtr(row);
+    uint32_t len = column.SerializedLength(data);
+    if (schema.GetColumn(col).IsInlined()) {
+      memcpy(tuple.data_.data() + schema.GetColumn(col).GetOffset(), data, len);
+    } else {
+      memcpy(tuple.data_.data() + schema.GetColumn(col).GetOffset(), &offset, sizeof(uint32_t));
+      memcpy(tuple.data_.data() + offset, data, len);
+      offset += len;
+    }
+  }
+  return tuple;
+}
+
+}  // namespace bustub
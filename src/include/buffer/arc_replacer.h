@@ -0,0 +1,86 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arc_replacer.h
+//
+// Identification: src/include/buffer/arc_replacer.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "buffer/frame_list.h"
+#include "buffer/replacer.h"
+#include "common/config.h"
+
+namespace bustub {
+
+/**
+ * ARCReplacer implements Adaptive Replacement Cache (Megiddo and Modha, FAST '03).
+ *
+ * Resident frames are split between T1, frames accessed once since they were loaded, and T2, frames accessed more
+ * than once; both are LRU lists. The ids of pages evicted from T1 and T2 are remembered in B1 and B2. A page that
+ * comes back while in B1 means T1 was too small, so the target size of T1 grows; one that comes back while in B2
+ * shrinks it. Evict takes from T1 while it is larger than its target, and from T2 otherwise.
+ *
+ * Evict is called before the incoming page is known, so unlike the paper it does not break the tie at exactly the
+ * target size in favour of pages coming back from B2. A Scan access to a T1 frame keeps it in T1, since a scan
+ * touching the same page for each of its tuples does not make the page frequently used.
+ */
+class ARCReplacer : public Replacer {
+ public:
+  /**
+   * Create a new ARCReplacer.
+   * @param num_frames the maximum number of frames the ARCReplacer will be required to store
+   */
+  explicit ARCReplacer(size_t num_frames);
+
+  ~ARCReplacer() override = default;
+
+  auto Evict(frame_id_t *frame_id) -> bool override;
+
+  void RecordAccess(frame_id_t frame_id, AccessType access_type = AccessType::Unknown) override;
+
+  void SetEvictable(frame_id_t frame_id, bool set_evictable) override;
+
+  auto IsEvictable(frame_id_t frame_id) -> bool override;
+
+  void Remove(frame_id_t frame_id) override;
+
+  void SetPageId(frame_id_t frame_id, page_id_t page_id) override;
+
+  auto EvictionCandidates(size_t max_candidates) -> std::vector<frame_id_t> override;
+
+  auto Size() -> size_t override;
+
+ private:
+  void CheckFrameId(frame_id_t frame_id) const;
+  auto IsTracked(frame_id_t frame_id) const -> bool { return t1_.Contains(frame_id) || t2_.Contains(frame_id); }
+  /** Remove the first evictable frame of `list`, if any. */
+  auto EvictFrom(FrameList *list, frame_id_t *frame_id) -> bool;
+  /** Forget the oldest ghosts so that |T1| + |B1| <= c and |T1| + |T2| + |B1| + |B2| <= 2c. */
+  void TrimGhosts();
+
+  FrameList t1_;
+  FrameList t2_;
+  GhostList b1_;
+  GhostList b2_;
+  /** Page held by each frame, as told by SetPageId. */
+  std::vector<page_id_t> page_ids_;
+  std::vector<bool> evictable_;
+  /** Number of frames, c in the paper. */
+  size_t capacity_;
+  /** Target size of T1, p in the paper. */
+  size_t target_t1_{0};
+  /** Number of evictable frames. */
+  size_t curr_size_{0};
+  std::mutex latch_;
+};
+
+}  // namespace bustub
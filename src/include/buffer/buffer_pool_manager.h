@@ -12,15 +12,28 @@
 
 #pragma once
 
+#include <array>
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <functional>
+#include <future>  // NOLINT
 #include <list>
 #include <memory>
 #include <mutex>  // NOLINT
+#include <optional>
+#include <thread>  // NOLINT
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
-#include "buffer/lru_k_replacer.h"
+#include "buffer/frame_arena.h"
+#include "buffer/replacer.h"
+#include "common/channel.h"
 #include "common/config.h"
 #include "recovery/log_manager.h"
 #include "storage/disk/disk_manager.h"
+#include "storage/disk/disk_scheduler.h"
 #include "storage/page/page.h"
 #include "storage/page/page_guard.h"
 
@@ -28,18 +41,87 @@ namespace bustub {
 
 /**
  * BufferPoolManager reads disk pages to and from its internal buffer pool.
+ *
+ * The pool may be split into several instances (shards). Each instance owns a disjoint slice of the frames together
+ * with its own page table, free list, replacer and latch, so operations on pages that hash to different instances
+ * never contend with each other. A page always lives in instance `page_id % num_instances`; instance i only ever
+ * allocates page ids congruent to i. With a single instance this degenerates to the classic one-latch pool.
+ *
+ * Fetches tagged AccessType::Scan that miss do not compete with the rest of the pool: like PostgreSQL's BULKREAD
+ * strategy, they cycle through a small ring of frames per instance, so a large sequential scan replaces its own
+ * pages instead of flushing the working set of point accesses out of the replacer. A frame leaves the ring as soon
+ * as a non-scan access touches it.
+ *
+ * Disk I/O goes through a DiskScheduler and is never performed while an instance latch is held: a frame whose content
+ * is being read in is pinned and marked as having I/O in flight, and anyone else fetching that page waits for the read
+ * to finish without blocking the rest of the instance.
+ *
+ * A background writer keeps the frames the replacers are about to evict clean, so that a miss rarely has to wait for
+ * the write-back of a dirty victim. It never writes a page whose changes are not covered by the persistent part of
+ * the log yet.
  */
 class BufferPoolManager {
  public:
+  /** Reads the id of the next page of a page chain (e.g. a table heap) out of a page's content. */
+  using NextPageIdFn = std::function<page_id_t(const char *page_data)>;
+
+  /** Counters describing how useful read-ahead has been. */
+  struct ReadAheadStats {
+    /** Pages read from disk on behalf of read-ahead. */
+    uint64_t issued_{0};
+    /** Read-ahead pages that were later fetched by a regular request before being evicted. */
+    uint64_t hits_{0};
+    /** Read-ahead pages that were evicted or deleted without ever being fetched. */
+    uint64_t wasted_{0};
+  };
+
+  /** Hit/miss counters of FetchPage for one access type. */
+  struct AccessStats {
+    uint64_t hits_{0};
+    uint64_t misses_{0};
+  };
+
+  /** Tuning knobs of the background writer. */
+  struct BackgroundWriterOptions {
+    /** Time between two rounds; zero pauses the writer. */
+    std::chrono::milliseconds interval_{BACKGROUND_WRITER_INTERVAL_MS};
+    /** Maximum number of pages written per round, over all instances. */
+    size_t max_pages_per_round_{BACKGROUND_WRITER_MAX_PAGES};
+    /** Once catching up, the writer keeps going until at most this fraction of the frames is dirty. */
+    double low_watermark_{0.1};
+    /**
+     * Above this fraction of dirty frames the writer catches up: it cleans every evictable frame it can, round after
+     * round, without waiting for the interval.
+     */
+    double high_watermark_{0.5};
+  };
+
+  /** Counters describing how much work the background writer takes off the foreground. */
+  struct BackgroundWriterStats {
+    uint64_t rounds_{0};
+    /** Pages written by the background writer. */
+    uint64_t pages_written_{0};
+    /** Evictions that found the victim clean. */
+    uint64_t clean_victims_{0};
+    /** Evictions that had to write the victim back first. */
+    uint64_t dirty_victims_{0};
+  };
+
   /**
    * @brief Creates a new BufferPoolManager.
    * @param pool_size the size of the buffer pool
    * @param disk_manager the disk manager
    * @param replacer_k the lookback constant k for the LRU-K replacer
-   * @param log_manager the log manager (for testing only: nullptr = disable logging). Please ignore this for P1.
+   * @param log_manager the log manager (for testing only: nullptr = disable logging). When logging is enabled, the
+   * background writer only writes pages whose LSN is persistent.
+   * @param num_instances the number of instances the frames and the page table are partitioned into
+   * @param replacer_policy the replacement policy of every instance
+   * @param frame_options how the memory of the frames is allocated and placed
    */
   BufferPoolManager(size_t pool_size, DiskManager *disk_manager, size_t replacer_k = LRUK_REPLACER_K,
-                    LogManager *log_manager = nullptr);
+                    LogManager *log_manager = nullptr, size_t num_instances = 1,
+                    ReplacerPolicy replacer_policy = ReplacerPolicy::LRUK,
+                    const FrameArenaOptions &frame_options = {});
 
   /**
    * @brief Destroy an existing BufferPoolManager.
@@ -52,19 +134,24 @@ class BufferPoolManager {
   /** @brief Return the pointer to all the pages in the buffer pool. */
   auto GetPages() -> Page * { return pages_; }
 
+  /** @brief Return the number of instances the buffer pool is partitioned into. */
+  auto GetNumInstances() -> size_t { return instances_.size(); }
+
+  /** @brief Return the memory holding the frames of the buffer pool. */
+  auto GetFrameArena() -> const FrameArena & { return *frames_; }
+
+  /** @brief Return the replacement policy of the buffer pool. */
+  auto GetReplacerPolicy() -> ReplacerPolicy { return replacer_policy_; }
+
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Create a new page in the buffer pool. Set page_id to the new page's id, or nullptr if all frames
    * are currently in use and not evictable (in another word, pinned).
    *
-   * You should pick the replacement frame from either the free list or the replacer (always find from the free list
-   * first), and then call the AllocatePage() method to get a new page id. If the replacement frame has a dirty page,
-   * you should write it back to the disk first. You also need to reset the memory and metadata for the new page.
-   *
-   * Remember to "Pin" the frame by calling replacer.SetEvictable(frame_id, false)
-   * so that the replacer wouldn't evict the frame before the buffer pool manager "Unpin"s it.
-   * Also, remember to record the access history of the frame in the replacer for the lru-k algorithm to work.
+   * Instances are tried round-robin, starting from a different one on every call, so that new pages spread over the
+   * pool; the next instance is tried when every frame of one is pinned. The new page id is allocated by the instance
+   * that holds the page, hence congruent to its index. Its frame comes from the free list of the instance if any,
+   * otherwise from its replacer. A dirty victim is written back through the disk scheduler with the latch released,
+   * and the new page is zeroed once that write has completed. The page is returned pinned, with its access recorded.
    *
    * @param[out] page_id id of created page
    * @return nullptr if no new pages could be created, otherwise pointer to new page
@@ -72,8 +159,6 @@ class BufferPoolManager {
   auto NewPage(page_id_t *page_id) -> Page *;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief PageGuard wrapper for NewPage
    *
    * Functionality should be the same as NewPage, except that
@@ -86,27 +171,21 @@ class BufferPoolManager {
   auto NewPageGuarded(page_id_t *page_id) -> BasicPageGuard;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Fetch the requested page from the buffer pool. Return nullptr if page_id needs to be fetched from the disk
    * but all frames are currently in use and not evictable (in another word, pinned).
    *
-   * First search for page_id in the buffer pool. If not found, pick a replacement frame from either the free list or
-   * the replacer (always find from the free list first), read the page from disk by calling disk_manager_->ReadPage(),
-   * and replace the old page in the frame. Similar to NewPage(), if the old page is dirty, you need to write it back
-   * to disk and update the metadata of the new page
-   *
-   * In addition, remember to disable eviction and record the access history of the frame like you did for NewPage().
+   * The page is looked up in the page table of its instance, `page_id % num_instances`. On a miss the frame is taken
+   * as NewPage() takes it, or from the scan ring for AccessType::Scan, and the page is read through the disk scheduler
+   * with the latch released. Concurrent fetches of a page being read in pin the frame and wait for that read.
    *
    * @param page_id id of page to be fetched
    * @param access_type type of access to the page, only needed for leaderboard tests.
-   * @return nullptr if page_id cannot be fetched, otherwise pointer to the requested page
+   * @return nullptr if page_id cannot be fetched, or could not be read, or the dirty victim of its frame could not be
+   * written back, otherwise pointer to the requested page
    */
   auto FetchPage(page_id_t page_id, AccessType access_type = AccessType::Unknown) -> Page *;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief PageGuard wrappers for FetchPage
    *
    * Functionality should be the same as FetchPage, except
@@ -117,13 +196,11 @@ class BufferPoolManager {
    * @param page_id, the id of the page to fetch
    * @return PageGuard holding the fetched page
    */
-  auto FetchPageBasic(page_id_t page_id) -> BasicPageGuard;
-  auto FetchPageRead(page_id_t page_id) -> ReadPageGuard;
-  auto FetchPageWrite(page_id_t page_id) -> WritePageGuard;
+  auto FetchPageBasic(page_id_t page_id, AccessType access_type = AccessType::Unknown) -> BasicPageGuard;
+  auto FetchPageRead(page_id_t page_id, AccessType access_type = AccessType::Unknown) -> ReadPageGuard;
+  auto FetchPageWrite(page_id_t page_id, AccessType access_type = AccessType::Unknown) -> WritePageGuard;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Unpin the target page from the buffer pool. If page_id is not in the buffer pool or its pin count is already
    * 0, return false.
    *
@@ -138,66 +215,273 @@ class BufferPoolManager {
   auto UnpinPage(page_id_t page_id, bool is_dirty, AccessType access_type = AccessType::Unknown) -> bool;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Flush the target page to disk.
    *
-   * Use the DiskManager::WritePage() method to flush a page to disk, REGARDLESS of the dirty flag.
-   * Unset the dirty flag of the page after flushing.
+   * The page is written REGARDLESS of the dirty flag, which is cleared unless the write fails.
    *
    * @param page_id id of page to be flushed, cannot be INVALID_PAGE_ID
-   * @return false if the page could not be found in the page table, true otherwise
+   * @return false if the page could not be found in the page table or written, true otherwise
    */
   auto FlushPage(page_id_t page_id) -> bool;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Flush all the pages in the buffer pool to disk.
    */
   void FlushAllPages();
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Delete a page from the buffer pool. If page_id is not in the buffer pool, do nothing and return true. If the
    * page is pinned and cannot be deleted, return false immediately.
    *
-   * After deleting the page from the page table, stop tracking the frame in the replacer and add the frame
-   * back to the free list. Also, reset the page's memory and metadata. Finally, you should call DeallocatePage() to
-   * imitate freeing the page on the disk.
+   * Only the instance that holds the page is latched. Its frame leaves the replacer and the scan ring, counts as
+   * wasted read-ahead if it was never fetched, and goes back to the free list of the instance with its memory reset.
+   * The content is dropped without being written back, and the page id is deallocated.
    *
    * @param page_id id of page to be deleted
    * @return false if the page exists but could not be deleted, true if the page didn't exist or deletion succeeded
    */
   auto DeletePage(page_id_t page_id) -> bool;
 
+  /**
+   * @brief Asynchronously bring up to `count` pages of a page chain into the buffer pool, starting at page_id and
+   * following the chain with next_page_id. Pages are loaded by a background thread and left unpinned; a later
+   * FetchPage of such a page finds it resident (or waits for the in-flight read) instead of issuing its own I/O.
+   *
+   * This is meant to be called by sequential scans (see TableIterator) once they detect that they are walking a chain.
+   * Read-ahead stops early at INVALID_PAGE_ID or if no frame can be found for the next page, and never reads more
+   * pages than the scan ring can hold.
+   */
+  void ReadAhead(page_id_t page_id, size_t count, NextPageIdFn next_page_id);
+
+  /** @brief Return the number of pages sequential scans should read ahead; 0 means read-ahead is disabled. */
+  auto GetReadAheadWindow() const -> size_t { return read_ahead_window_; }
+
+  /** @brief Set the number of pages sequential scans should read ahead; 0 disables read-ahead. */
+  void SetReadAheadWindow(size_t window) { read_ahead_window_ = window; }
+
+  /** @brief Return the total number of frames scans may cycle through; 0 means scans use the whole pool. */
+  auto GetScanRingSize() const -> size_t { return scan_ring_size_; }
+
+  /**
+   * @brief Set the total number of frames scans may cycle through. The frames are split among the instances, with at
+   * least one frame per instance unless the size is 0, which disables the scan ring.
+   */
+  void SetScanRingSize(size_t scan_ring_size);
+
+  /** @brief Return the hit/miss counters of fetches with the given access type. */
+  auto GetAccessStats(AccessType access_type) const -> AccessStats {
+    const auto &counters = access_stats_[static_cast<size_t>(access_type)];
+    return {counters.first.load(), counters.second.load()};
+  }
+
+  /** @brief Return the current background writer options. */
+  auto GetBackgroundWriterOptions() -> BackgroundWriterOptions;
+
+  /** @brief Change the background writer options; they take effect at the next round. */
+  void SetBackgroundWriterOptions(const BackgroundWriterOptions &options);
+
+  /** @brief Return a snapshot of the background writer counters. */
+  auto GetBackgroundWriterStats() const -> BackgroundWriterStats {
+    return {bg_writer_rounds_.load(), bg_writer_pages_written_.load(), clean_victims_.load(), dirty_victims_.load()};
+  }
+
+  /** @brief Return a snapshot of the read-ahead counters. */
+  auto GetReadAheadStats() const -> ReadAheadStats {
+    return {read_ahead_issued_.load(), read_ahead_hits_.load(), read_ahead_wasted_.load()};
+  }
+
  private:
+  /**
+   * One partition of the buffer pool. Frames [frame_offset_, frame_offset_ + num_frames_) belong to this instance;
+   * the replacer is indexed by frame id relative to frame_offset_.
+   */
+  struct BufferPoolInstance {
+    BufferPoolInstance(size_t frame_offset, size_t num_frames, ReplacerPolicy replacer_policy, size_t replacer_k,
+                       page_id_t first_page_id)
+        : frame_offset_(frame_offset),
+          num_frames_(num_frames),
+          replacer_(MakeReplacer(replacer_policy, num_frames, replacer_k)),
+          next_page_id_(first_page_id),
+          io_pending_(num_frames, false),
+          read_ahead_(num_frames, false),
+          in_scan_ring_(num_frames, false) {}
+
+    /** Index of the first frame owned by this instance. */
+    const size_t frame_offset_;
+    /** Number of frames owned by this instance. */
+    const size_t num_frames_;
+    /** Page table for keeping track of the pages cached in this instance. */
+    std::unordered_map<page_id_t, frame_id_t> page_table_;
+    /** Replacer to find unpinned frames of this instance for replacement. */
+    std::unique_ptr<Replacer> replacer_;
+    /** List of free frames (global frame ids) that don't have any pages on them. */
+    std::list<frame_id_t> free_list_;
+    /** The next page id to be allocated by this instance. */
+    page_id_t next_page_id_;
+    /** Per (local) frame: true while the frame's content is being read from disk or written back as a victim's. */
+    std::vector<bool> io_pending_;
+    /** Per (local) frame: true if the frame was filled by read-ahead and has not been fetched since. */
+    std::vector<bool> read_ahead_;
+    /** Frames (global ids) that scans currently cycle through, at most scan_ring_capacity_ of them. */
+    std::vector<frame_id_t> scan_ring_;
+    /** Next position of scan_ring_ to consider for recycling. */
+    size_t scan_ring_cursor_{0};
+    /** Maximum size of scan_ring_. */
+    size_t scan_ring_capacity_{0};
+    /** Per (local) frame: true if the frame is part of scan_ring_. */
+    std::vector<bool> in_scan_ring_;
+    /**
+     * Pages whose write-back is in flight, once per write: victims, out of the page table and back in it, dirty, if
+     * the write fails, and pages the background writer is cleaning. A miss on one of them waits for its writes rather
+     * than read it from disk before they are over.
+     */
+    std::unordered_multiset<page_id_t> writing_back_;
+    /** Signalled whenever an entry of io_pending_ or writing_back_ is cleared. */
+    std::condition_variable io_cv_;
+    /** Protects the page table, the free list, the page id counter and the metadata of this instance's frames. */
+    std::mutex latch_;
+  };
+
   /** Number of pages in the buffer pool. */
   const size_t pool_size_;
-  /** The next page id to be allocated  */
-  std::atomic<page_id_t> next_page_id_ = 0;
+  /** Replacement policy of every instance. */
+  const ReplacerPolicy replacer_policy_;
+  /** Round-robin cursor used to spread NewPage calls over the instances. */
+  std::atomic<size_t> next_instance_ = 0;
 
-  /** Array of buffer pool pages. */
+  /** Memory of the frames. */
+  std::unique_ptr<FrameArena> frames_;
+  /** Array of buffer pool pages, the metadata of the frames. */
   Page *pages_;
   /** Pointer to the disk manager. */
   DiskManager *disk_manager_ __attribute__((__unused__));
-  /** Pointer to the log manager. Please ignore this for P1. */
-  LogManager *log_manager_ __attribute__((__unused__));
-  /** Page table for keeping track of buffer pool pages. */
-  std::unordered_map<page_id_t, frame_id_t> page_table_;
-  /** Replacer to find unpinned pages for replacement. */
-  std::unique_ptr<LRUKReplacer> replacer_;
-  /** List of free frames that don't have any pages on them. */
-  std::list<frame_id_t> free_list_;
-  /** This latch protects shared data structures. We recommend updating this comment to describe what it protects. */
-  std::mutex latch_;
-
-  /**
-   * @brief Allocate a page on disk. Caller should acquire the latch before calling this function.
+  /** Pointer to the log manager, used to hold back writes of pages whose log records are not persistent yet. */
+  LogManager *log_manager_;
+  /** The partitions of the pool. */
+  std::vector<std::unique_ptr<BufferPoolInstance>> instances_;
+  /** Background I/O workers shared by all instances. */
+  std::unique_ptr<DiskScheduler> disk_scheduler_;
+
+  /** A chain of pages to read ahead. */
+  struct ReadAheadRequest {
+    page_id_t page_id_;
+    size_t count_;
+    NextPageIdFn next_page_id_;
+  };
+  /** Pending read-ahead requests; std::nullopt asks the read-ahead thread to exit. */
+  Channel<std::optional<ReadAheadRequest>> read_ahead_queue_;
+  std::optional<std::thread> read_ahead_thread_;
+  std::atomic<size_t> read_ahead_window_{READ_AHEAD_WINDOW};
+  std::atomic<uint64_t> read_ahead_issued_{0};
+  std::atomic<uint64_t> read_ahead_hits_{0};
+  std::atomic<uint64_t> read_ahead_wasted_{0};
+
+  /** Total size of the scan rings of all instances. */
+  std::atomic<size_t> scan_ring_size_{0};
+  /** (hits, misses) of FetchPage, indexed by AccessType. */
+  std::array<std::pair<std::atomic<uint64_t>, std::atomic<uint64_t>>, 3> access_stats_;
+
+  /** Protects the background writer options and stop flag. */
+  std::mutex bg_writer_latch_;
+  /** Wakes the background writer up early: on shutdown, on new options, and when a victim had to be written back. */
+  std::condition_variable bg_writer_cv_;
+  BackgroundWriterOptions bg_writer_options_;
+  bool bg_writer_stop_{false};
+  std::atomic<bool> bg_writer_kicked_{false};
+  std::optional<std::thread> bg_writer_thread_;
+  std::atomic<uint64_t> bg_writer_rounds_{0};
+  std::atomic<uint64_t> bg_writer_pages_written_{0};
+  std::atomic<uint64_t> clean_victims_{0};
+  std::atomic<uint64_t> dirty_victims_{0};
+
+  /** @return the instance responsible for the given page id */
+  auto InstanceOf(page_id_t page_id) -> BufferPoolInstance & {
+    return *instances_[static_cast<size_t>(page_id) % instances_.size()];
+  }
+
+  /** @return the frame id relative to the first frame of the instance, as used by the instance's replacer */
+  static auto LocalFrameId(const BufferPoolInstance &inst, frame_id_t frame_id) -> frame_id_t {
+    return static_cast<frame_id_t>(frame_id - inst.frame_offset_);
+  }
+
+  /**
+   * @brief Find a frame to hold a new page in the given instance: a free frame if any, otherwise a victim chosen by
+   * the replacer, whose page is removed from the page table. If the victim is dirty its write-back is scheduled
+   * before returning; the frame must not be overwritten until write_back completes. Caller should hold the instance
+   * latch, which also guarantees the write-back is queued before any later read of the victim page.
+   * @param[out] frame_id the (global) id of the acquired frame
+   * @param[out] write_back completion of the victim's write-back, invalid if nothing had to be written
+   * @return false if every frame of the instance is pinned
+   */
+  auto AcquireFrame(BufferPoolInstance &inst, frame_id_t *frame_id, std::future<bool> *write_back) -> bool;
+
+  /**
+   * @brief Like AcquireFrame, but for a scan: grow the instance's scan ring up to its capacity, then recycle the ring
+   * frames round-robin. Falls back to AcquireFrame if every ring frame is pinned. Caller should hold the latch.
+   */
+  auto AcquireScanFrame(BufferPoolInstance &inst, frame_id_t *frame_id, std::future<bool> *write_back) -> bool;
+
+  /**
+   * @brief Detach an evictable frame from its current page: drop its read-ahead mark, schedule its write-back if it
+   * is dirty or the background writer is still cleaning it, and remove the page from the page table. Caller should
+   * hold the latch.
+   */
+  void DetachFrame(BufferPoolInstance &inst, frame_id_t frame_id, std::future<bool> *write_back);
+
+  /**
+   * @brief Account for the end of the write-back of the victim of a frame, taken for another page. If the write
+   * failed, the victim, still in the frame, goes back in the page table, dirty, and the frame is unpinned. Caller
+   * should hold the latch, and notify io_cv_.
+   * @return whether the victim was written
+   */
+  auto FinishWriteBack(BufferPoolInstance &inst, frame_id_t frame_id, page_id_t victim_page_id, bool written) -> bool;
+
+  /** @brief Block until no write-back of the page as a victim is in flight. Caller holds the latch. */
+  void WaitForWriteBack(BufferPoolInstance &inst, page_id_t page_id, std::unique_lock<std::mutex> &lock);
+
+  /** @brief Remove a frame from the instance's scan ring, if it is part of it. Caller should hold the latch. */
+  void LeaveScanRing(BufferPoolInstance &inst, frame_id_t frame_id);
+
+  /** @brief Block until no read is in flight for the given frame. The frame must be pinned by the caller. */
+  void WaitForIO(BufferPoolInstance &inst, frame_id_t frame_id, std::unique_lock<std::mutex> &lock);
+
+  /** @brief Drop one pin on a frame, making it evictable when the count reaches zero. Caller holds the latch. */
+  void UnpinFrame(BufferPoolInstance &inst, frame_id_t frame_id);
+
+  /**
+   * @brief FetchPage, optionally on behalf of read-ahead. A read-ahead fetch does not count as an access for the
+   * replacer when the page is already resident, and marks the frame so that hits and waste can be accounted.
+   */
+  auto FetchPageImpl(page_id_t page_id, AccessType access_type, bool read_ahead) -> Page *;
+
+  /** @brief Body of the read-ahead thread. */
+  void ReadAheadWorker();
+
+  /** @brief Body of the background writer thread. */
+  void BackgroundWriterWorker();
+
+  /**
+   * @brief Write back up to `max_pages` dirty pages among the next `lookahead` eviction candidates of an instance.
+   * Only unpinned pages are written, from a copy taken under the latch, so the frames stay free to be pinned or
+   * evicted meanwhile; the per-page ordering of the disk scheduler keeps any later write or read of the page behind
+   * this write. The pages are in writing_back_ until their writes are over: one evicted meanwhile is written again
+   * from its frame, and one that failed is dirtied again if still resident. Pages not covered by the persistent log
+   * are skipped.
+   * @return the number of pages written
+   */
+  auto CleanEvictionCandidates(BufferPoolInstance &inst, size_t lookahead, size_t max_pages) -> size_t;
+
+  /** @return the number of dirty frames in the pool */
+  auto CountDirtyFrames() -> size_t;
+
+  /** @brief Try to create a new page in the given instance. */
+  auto NewPageIn(BufferPoolInstance &inst, page_id_t *page_id) -> Page *;
+
+  /**
+   * @brief Allocate a page on disk. Caller should acquire the instance latch before calling this function.
    * @return the id of the allocated page
    */
-  auto AllocatePage() -> page_id_t;
+  auto AllocatePage(BufferPoolInstance &inst) -> page_id_t;
 
   /**
    * @brief Deallocate a page on disk. Caller should acquire the latch before calling this function.
@@ -206,7 +490,5 @@ class BufferPoolManager {
   void DeallocatePage(__attribute__((unused)) page_id_t page_id) {
     // This is a no-nop right now without a more complex data structure to track deallocated pages
   }
-
-  // TODO(student): You may add additional private members and helper functions
 };
 }  // namespace bustub
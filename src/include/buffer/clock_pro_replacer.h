@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// clock_pro_replacer.h
+//
+// Identification: src/include/buffer/clock_pro_replacer.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <list>
+#include <mutex>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
+#include "buffer/replacer.h"
+#include "common/config.h"
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * ClockProReplacer implements CLOCK-Pro (Jiang, Chen and Zhang, USENIX ATC '05), a clock approximation of LIRS.
+ *
+ * Resident pages are either hot or cold. A newly loaded page is cold and starts a test period; if it is accessed
+ * again during the test period it becomes hot. Pages evicted during their test period stay on the clock as
+ * non-resident entries until the period ends, so that a quick reload also makes them hot. Three hands sweep the
+ * clock: HAND_cold evicts cold pages, HAND_hot demotes hot pages to keep their number within the hot target, and
+ * HAND_test ends the test periods of the oldest non-resident pages. The cold target grows whenever a page is accessed
+ * during its test period and shrinks whenever a test period ends without one.
+ *
+ * A Scan access to a cold page does not set its reference bit, so that a page read once by a scan stays cold.
+ */
+class ClockProReplacer : public Replacer {
+ public:
+  /**
+   * Create a new ClockProReplacer.
+   * @param num_frames the maximum number of frames the ClockProReplacer will be required to store
+   */
+  explicit ClockProReplacer(size_t num_frames);
+
+  ~ClockProReplacer() override = default;
+
+  auto Evict(frame_id_t *frame_id) -> bool override;
+
+  void RecordAccess(frame_id_t frame_id, AccessType access_type = AccessType::Unknown) override;
+
+  void SetEvictable(frame_id_t frame_id, bool set_evictable) override;
+
+  auto IsEvictable(frame_id_t frame_id) -> bool override;
+
+  void Remove(frame_id_t frame_id) override;
+
+  void SetPageId(frame_id_t frame_id, page_id_t page_id) override;
+
+  auto EvictionCandidates(size_t max_candidates) -> std::vector<frame_id_t> override;
+
+  auto Size() -> size_t override;
+
+ private:
+  struct Entry {
+    /** Frame holding the page, or INVALID_PAGE_ID for a non-resident page. */
+    frame_id_t frame_id_;
+    page_id_t page_id_;
+    bool hot_{false};
+    bool referenced_{false};
+    bool in_test_{false};
+  };
+  using EntryIter = std::list<Entry>::iterator;
+
+  void CheckFrameId(frame_id_t frame_id) const;
+  /** @return the entry after `it` on the clock */
+  auto Next(EntryIter it) -> EntryIter;
+  /** Insert an entry at the head of the clock, i.e. the position the hands reach last. */
+  auto InsertAtHead(Entry entry) -> EntryIter;
+  /** Move an entry to the head of the clock. */
+  void MoveToHead(EntryIter it);
+  /** Remove an entry from the clock, moving any hand that points at it. */
+  void EraseEntry(EntryIter it);
+  /** End the test period of a cold page without it having been accessed, removing it if it is not resident. */
+  void EndTest(EntryIter it);
+  /** Run HAND_hot until the number of hot pages is within the hot target, demoting at least `min_demotions` pages. */
+  void RunHandHot(size_t min_demotions);
+  /** Run HAND_test until the number of non-resident pages is within the number of frames. */
+  void RunHandTest();
+  /** Turn a cold resident page into a hot one, growing the cold target since it was accessed during its test. */
+  void Promote(EntryIter it);
+
+  std::list<Entry> clock_;
+  EntryIter hand_hot_;
+  EntryIter hand_cold_;
+  EntryIter hand_test_;
+  /** Clock entry of each resident frame. */
+  std::vector<EntryIter> resident_;
+  std::vector<bool> tracked_;
+  std::vector<bool> evictable_;
+  /** Page held by each frame, as told by SetPageId. */
+  std::vector<page_id_t> page_ids_;
+  /** Clock entries of non-resident pages in their test period. */
+  std::unordered_map<page_id_t, EntryIter> non_resident_;
+  /** Number of frames, m in the paper. */
+  size_t capacity_;
+  /** Target number of resident cold pages, m_c in the paper; the hot target is capacity_ - cold_target_. */
+  size_t cold_target_;
+  size_t num_hot_{0};
+  /** Number of evictable frames. */
+  size_t curr_size_{0};
+  std::mutex latch_;
+};
+
+}  // namespace bustub
@@ -12,17 +12,20 @@
 
 #pragma once
 
-#include <list>
 #include <mutex>  // NOLINT
 #include <vector>
 
 #include "buffer/replacer.h"
 #include "common/config.h"
+#include "common/macros.h"
 
 namespace bustub {
 
 /**
  * ClockReplacer implements the clock replacement policy, which approximates the Least Recently Used policy.
+ *
+ * Frames sit on the clock in frame id order. An access sets the frame's reference bit; Evict advances the hand,
+ * clearing reference bits, until it reaches an evictable frame whose bit is already clear.
  */
 class ClockReplacer : public Replacer {
  public:
@@ -37,16 +40,31 @@ class ClockReplacer : public Replacer {
    */
   ~ClockReplacer() override;
 
-  auto Victim(frame_id_t *frame_id) -> bool override;
+  auto Evict(frame_id_t *frame_id) -> bool override;
 
-  void Pin(frame_id_t frame_id) override;
+  void RecordAccess(frame_id_t frame_id, AccessType access_type = AccessType::Unknown) override;
 
-  void Unpin(frame_id_t frame_id) override;
+  void SetEvictable(frame_id_t frame_id, bool set_evictable) override;
+
+  auto IsEvictable(frame_id_t frame_id) -> bool override;
+
+  void Remove(frame_id_t frame_id) override;
+
+  auto EvictionCandidates(size_t max_candidates) -> std::vector<frame_id_t> override;
 
   auto Size() -> size_t override;
 
  private:
-  // TODO(student): implement me!
+  void CheckFrameId(frame_id_t frame_id) const;
+
+  std::vector<bool> tracked_;
+  std::vector<bool> evictable_;
+  std::vector<bool> referenced_;
+  /** Frame the clock hand points at. */
+  size_t hand_{0};
+  /** Number of evictable frames. */
+  size_t curr_size_{0};
+  std::mutex latch_;
 };
 
 }  // namespace bustub
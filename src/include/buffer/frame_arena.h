@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// frame_arena.h
+//
+// Identification: src/include/buffer/frame_arena.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+
+namespace bustub {
+
+/** How the memory of the buffer pool frames is obtained. */
+enum class FrameAllocation {
+  /** One heap allocation per frame. Slowest, but lets ASAN catch accesses past the end of a page. */
+  Heap = 0,
+  /** One page-aligned region holding every frame. */
+  Contiguous,
+  /** Like Contiguous, backed by 2MB pages: reserved huge pages if the system has some, transparent ones otherwise. */
+  HugePages
+};
+
+/** Where the frames are placed on a NUMA machine. */
+enum class NumaPolicy {
+  /** Leave placement to the kernel, i.e. on the node of the thread that first touches a frame. */
+  Default = 0,
+  /** Spread the frames over all nodes, so that no socket's memory bandwidth becomes the bottleneck. */
+  Interleave,
+  /** Place every frame on one node. */
+  Bind
+};
+
+struct FrameArenaOptions {
+  FrameAllocation allocation_{FrameAllocation::Contiguous};
+  NumaPolicy numa_policy_{NumaPolicy::Default};
+  /** Node the frames are bound to with NumaPolicy::Bind. */
+  int numa_node_{0};
+};
+
+/**
+ * FrameArena owns the memory of the buffer pool frames, BUSTUB_PAGE_SIZE bytes each and zeroed. The Page objects that
+ * describe the frames only point into it, so the page contents are packed together instead of being scattered over
+ * the heap between their metadata.
+ *
+ * Huge pages and NUMA placement are best effort: if the system refuses them the arena falls back to regular pages and
+ * default placement, which can be checked with UsesHugePages and GetNumaPolicy.
+ */
+class FrameArena {
+ public:
+  FrameArena(size_t num_frames, const FrameArenaOptions &options);
+  ~FrameArena();
+
+  DISALLOW_COPY_AND_MOVE(FrameArena);
+
+  /** @return the memory of the i-th frame */
+  auto GetFrame(size_t i) const -> char * {
+    return options_.allocation_ == FrameAllocation::Heap ? heap_frames_[i].get() : region_ + i * BUSTUB_PAGE_SIZE;
+  }
+
+  auto GetOptions() const -> const FrameArenaOptions & { return options_; }
+
+  /** @return true if the frames are backed by huge pages */
+  auto UsesHugePages() const -> bool { return huge_pages_; }
+
+  /** @return the NUMA policy actually in effect */
+  auto GetNumaPolicy() const -> NumaPolicy { return numa_policy_; }
+
+ private:
+  /** Map `size` bytes aligned to `alignment`, or return nullptr. */
+  static auto MapAligned(size_t size, size_t alignment) -> char *;
+  /** Apply the requested NUMA policy to the region; returns false if the kernel refused it. */
+  auto ApplyNumaPolicy() -> bool;
+
+  const FrameArenaOptions options_;
+  std::vector<std::unique_ptr<char[]>> heap_frames_;
+  char *region_{nullptr};
+  size_t region_size_{0};
+  bool huge_pages_{false};
+  NumaPolicy numa_policy_{NumaPolicy::Default};
+};
+
+/** @return the allocation named by `name` (heap, contiguous or huge_pages); throws if there is none */
+auto FrameAllocationFromString(const std::string &name) -> FrameAllocation;
+
+/** @return the name of an allocation, as accepted by FrameAllocationFromString */
+auto FrameAllocationToString(FrameAllocation allocation) -> std::string;
+
+}  // namespace bustub
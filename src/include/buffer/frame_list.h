@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// frame_list.h
+//
+// Identification: src/include/buffer/frame_list.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * An intrusive doubly-linked list of frame ids, with the links stored in arrays indexed by frame id. A frame is in at
+ * most one position of the list, and every operation is O(1) without allocating.
+ */
+class FrameList {
+ public:
+  explicit FrameList(size_t num_frames) : prev_(num_frames + 1, NIL), next_(num_frames + 1, NIL), head_(num_frames) {
+    prev_[head_] = next_[head_] = head_;
+  }
+
+  auto Empty() const -> bool { return size_ == 0; }
+  auto Size() const -> size_t { return size_; }
+  auto Contains(frame_id_t frame_id) const -> bool { return next_[frame_id] != NIL; }
+
+  /** @return the first frame, or INVALID_PAGE_ID if the list is empty */
+  auto Front() const -> frame_id_t { return Empty() ? INVALID_PAGE_ID : static_cast<frame_id_t>(next_[head_]); }
+  /** @return the frame after `frame_id`, or INVALID_PAGE_ID if it is the last one */
+  auto Next(frame_id_t frame_id) const -> frame_id_t {
+    return next_[frame_id] == head_ ? INVALID_PAGE_ID : static_cast<frame_id_t>(next_[frame_id]);
+  }
+
+  void PushBack(frame_id_t frame_id) { InsertAfter(prev_[head_], frame_id); }
+
+  void Erase(frame_id_t frame_id) {
+    BUSTUB_ASSERT(Contains(frame_id), "frame is not in the list");
+    next_[prev_[frame_id]] = next_[frame_id];
+    prev_[next_[frame_id]] = prev_[frame_id];
+    prev_[frame_id] = next_[frame_id] = NIL;
+    size_--;
+  }
+
+  /** Move a frame to the back, inserting it if it is not in the list. */
+  void MoveToBack(frame_id_t frame_id) {
+    if (Contains(frame_id)) {
+      Erase(frame_id);
+    }
+    PushBack(frame_id);
+  }
+
+ private:
+  static constexpr size_t NIL = static_cast<size_t>(-1);
+
+  void InsertAfter(size_t pos, frame_id_t frame_id) {
+    BUSTUB_ASSERT(!Contains(frame_id), "frame is already in the list");
+    auto fid = static_cast<size_t>(frame_id);
+    prev_[fid] = pos;
+    next_[fid] = next_[pos];
+    prev_[next_[pos]] = fid;
+    next_[pos] = fid;
+    size_++;
+  }
+
+  /** Links indexed by frame id; the extra last slot is the sentinel. */
+  std::vector<size_t> prev_;
+  std::vector<size_t> next_;
+  size_t head_;
+  size_t size_{0};
+};
+
+/**
+ * A FIFO of page ids that are no longer in the buffer pool, used by policies that adapt to pages coming back soon
+ * after they were evicted.
+ */
+class GhostList {
+ public:
+  auto Size() const -> size_t { return pages_.size(); }
+  auto Contains(page_id_t page_id) const -> bool { return index_.count(page_id) > 0; }
+
+  void PushBack(page_id_t page_id) {
+    if (page_id == INVALID_PAGE_ID || Contains(page_id)) {
+      return;
+    }
+    index_[page_id] = pages_.insert(pages_.end(), page_id);
+  }
+
+  void Erase(page_id_t page_id) {
+    auto it = index_.find(page_id);
+    if (it != index_.end()) {
+      pages_.erase(it->second);
+      index_.erase(it);
+    }
+  }
+
+  /** Forget the oldest page. */
+  void PopFront() {
+    if (!pages_.empty()) {
+      index_.erase(pages_.front());
+      pages_.pop_front();
+    }
+  }
+
+ private:
+  std::list<page_id_t> pages_;
+  std::unordered_map<page_id_t, std::list<page_id_t>::iterator> index_;
+};
+
+}  // namespace bustub
@@ -12,30 +12,19 @@
 
 #pragma once
 
+#include <atomic>
 #include <limits>
-#include <list>
+#include <memory>
 #include <mutex>  // NOLINT
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "buffer/replacer.h"
 #include "common/config.h"
 #include "common/macros.h"
 
 namespace bustub {
 
-enum class AccessType { Unknown = 0, Get, Scan };
-
-class LRUKNode {
- private:
-  /** History of last seen K timestamps of this page. Least recent timestamp stored in front. */
-  // Remove maybe_unused if you start using them. Feel free to change the member variables as you want.
-
-  [[maybe_unused]] std::list<size_t> history_;
-  [[maybe_unused]] size_t k_;
-  [[maybe_unused]] frame_id_t fid_;
-  [[maybe_unused]] bool is_evictable_{false};
-};
-
 /**
  * LRUKReplacer implements the LRU-k replacement policy.
  *
@@ -46,13 +35,20 @@ class LRUKNode {
  * A frame with less than k historical references is given
  * +inf as its backward k-distance. When multipe frames have +inf backward k-distance,
  * classical LRU algorithm is used to choose victim.
+ *
+ * Evictable frames are kept in two indexed min-heaps: one for frames with fewer than k accesses, keyed by their first
+ * access, and one for frames with k or more, keyed by their k-th most recent access. The victim is the top of the
+ * first heap if it is non-empty and the top of the second one otherwise, so Evict, SetEvictable and Remove are
+ * O(log n) instead of a scan over all frames. Access histories live in one preallocated array of k timestamps per
+ * frame, used as a ring.
+ *
+ * RecordAccess does not take the latch for a frame that is not evictable, which is the common case in the buffer
+ * pool: a frame is pinned (set non-evictable) before it is accessed. It only appends the timestamp to the frame's
+ * ring; the key is read from the ring when the frame becomes evictable again.
  */
-class LRUKReplacer {
+class LRUKReplacer : public Replacer {
  public:
   /**
-   *
-   * TODO(P1): Add implementation
-   *
    * @brief a new LRUKReplacer.
    * @param num_frames the maximum number of frames the LRUReplacer will be required to store
    */
@@ -61,15 +57,11 @@ class LRUKReplacer {
   DISALLOW_COPY_AND_MOVE(LRUKReplacer);
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Destroys the LRUReplacer.
    */
-  ~LRUKReplacer() = default;
+  ~LRUKReplacer() override = default;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Find the frame with largest backward k-distance and evict that frame. Only frames
    * that are marked as 'evictable' are candidates for eviction.
    *
@@ -83,11 +75,9 @@ class LRUKReplacer {
    * @param[out] frame_id id of frame that is evicted.
    * @return true if a frame is evicted successfully, false if no frames can be evicted.
    */
-  auto Evict(frame_id_t *frame_id) -> bool;
+  auto Evict(frame_id_t *frame_id) -> bool override;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Record the event that the given frame id is accessed at current timestamp.
    * Create a new entry for access history if frame id has not been seen before.
    *
@@ -98,11 +88,9 @@ class LRUKReplacer {
    * @param access_type type of access that was received. This parameter is only needed for
    * leaderboard tests.
    */
-  void RecordAccess(frame_id_t frame_id, AccessType access_type = AccessType::Unknown);
+  void RecordAccess(frame_id_t frame_id, AccessType access_type = AccessType::Unknown) override;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Toggle whether a frame is evictable or non-evictable. This function also
    * controls replacer's size. Note that size is equal to number of evictable entries.
    *
@@ -117,11 +105,11 @@ class LRUKReplacer {
    * @param frame_id id of frame whose 'evictable' status will be modified
    * @param set_evictable whether the given frame is evictable or not
    */
-  void SetEvictable(frame_id_t frame_id, bool set_evictable);
+  void SetEvictable(frame_id_t frame_id, bool set_evictable) override;
+
+  auto IsEvictable(frame_id_t frame_id) -> bool override;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Remove an evictable frame from replacer, along with its access history.
    * This function should also decrement replacer's size if removal is successful.
    *
@@ -136,26 +124,71 @@ class LRUKReplacer {
    *
    * @param frame_id id of frame to be removed
    */
-  void Remove(frame_id_t frame_id);
+  void Remove(frame_id_t frame_id) override;
+
+  auto EvictionCandidates(size_t max_candidates) -> std::vector<frame_id_t> override;
 
   /**
-   * TODO(P1): Add implementation
-   *
    * @brief Return replacer's size, which tracks the number of evictable frames.
    *
    * @return size_t
    */
-  auto Size() -> size_t;
+  auto Size() -> size_t override;
 
  private:
-  // TODO(student): implement me! You can replace these member variables as you like.
-  // Remove maybe_unused if you start using them.
-  [[maybe_unused]] std::unordered_map<frame_id_t, LRUKNode> node_store_;
-  [[maybe_unused]] size_t current_timestamp_{0};
-  [[maybe_unused]] size_t curr_size_{0};
-  [[maybe_unused]] size_t replacer_size_;
-  [[maybe_unused]] size_t k_;
-  [[maybe_unused]] std::mutex latch_;
+  /**
+   * A binary min-heap of (key, frame id) pairs that also records where each frame sits in it, so that any frame can
+   * be removed in O(log n) without searching for it. Storage for all frames is reserved up front.
+   */
+  class FrameHeap {
+   public:
+    explicit FrameHeap(size_t num_frames);
+
+    auto Empty() const -> bool { return heap_.empty(); }
+    auto Top() const -> frame_id_t { return heap_.front().second; }
+    auto Contains(frame_id_t frame_id) const -> bool { return pos_[frame_id] != NPOS; }
+    void Push(frame_id_t frame_id, size_t key);
+    void Erase(frame_id_t frame_id);
+    /** Append the frames with the `n` smallest keys to `out`, smallest first. */
+    void AppendSmallest(size_t n, std::vector<frame_id_t> *out) const;
+
+   private:
+    static constexpr size_t NPOS = std::numeric_limits<size_t>::max();
+
+    void Swap(size_t i, size_t j);
+    void SiftUp(size_t i);
+    void SiftDown(size_t i);
+
+    std::vector<std::pair<size_t, frame_id_t>> heap_;
+    /** Index of each frame in heap_, or NPOS if the frame is not in the heap. */
+    std::vector<size_t> pos_;
+  };
+
+  /** @return the eviction key of the frame: its first access if it has fewer than k, else its k-th most recent one */
+  auto Key(frame_id_t frame_id) const -> size_t;
+  /** Insert an evictable frame into the heap matching its number of accesses. Requires the latch. */
+  void Track(frame_id_t frame_id);
+  /** Remove a frame from whichever heap it is in. Requires the latch. */
+  void Untrack(frame_id_t frame_id);
+
+  /** Access timestamps, k consecutive slots per frame used as a ring indexed by access count modulo k. */
+  std::unique_ptr<std::atomic<size_t>[]> history_;
+  /** Number of accesses recorded per frame since it was last evicted or removed; 0 means the frame is not tracked. */
+  std::unique_ptr<std::atomic<size_t>[]> access_count_;
+  std::unique_ptr<std::atomic<bool>[]> evictable_;
+  /** Evictable frames with fewer than k accesses, i.e. +inf backward k-distance. */
+  FrameHeap cold_;
+  /** Evictable frames with at least k accesses. */
+  FrameHeap hot_;
+  /** Logical clock, advanced on every recorded access. */
+  std::atomic<size_t> current_timestamp_{0};
+  /** Number of evictable frames. */
+  size_t curr_size_{0};
+  /** Maximum number of frames the replacer tracks; valid frame ids are [0, replacer_size_). */
+  size_t replacer_size_;
+  size_t k_;
+  /** Protects the heaps and curr_size_, and serializes changes to evictable_. */
+  std::mutex latch_;
 };
 
 }  // namespace bustub
@@ -12,10 +12,10 @@
 
 #pragma once
 
-#include <list>
 #include <mutex>  // NOLINT
 #include <vector>
 
+#include "buffer/frame_list.h"
 #include "buffer/replacer.h"
 #include "common/config.h"
 
@@ -23,6 +23,9 @@ namespace bustub {
 
 /**
  * LRUReplacer implements the Least Recently Used replacement policy.
+ *
+ * Tracked frames are kept in one list ordered by their last access. Evict walks it from the least recently used end,
+ * skipping pinned frames.
  */
 class LRUReplacer : public Replacer {
  public:
@@ -37,16 +40,29 @@ class LRUReplacer : public Replacer {
    */
   ~LRUReplacer() override;
 
-  auto Victim(frame_id_t *frame_id) -> bool override;
+  auto Evict(frame_id_t *frame_id) -> bool override;
 
-  void Pin(frame_id_t frame_id) override;
+  void RecordAccess(frame_id_t frame_id, AccessType access_type = AccessType::Unknown) override;
 
-  void Unpin(frame_id_t frame_id) override;
+  void SetEvictable(frame_id_t frame_id, bool set_evictable) override;
+
+  auto IsEvictable(frame_id_t frame_id) -> bool override;
+
+  void Remove(frame_id_t frame_id) override;
+
+  auto EvictionCandidates(size_t max_candidates) -> std::vector<frame_id_t> override;
 
   auto Size() -> size_t override;
 
  private:
-  // TODO(student): implement me!
+  void CheckFrameId(frame_id_t frame_id) const;
+
+  /** Tracked frames, least recently used first. */
+  FrameList lru_;
+  std::vector<bool> evictable_;
+  /** Number of evictable frames. */
+  size_t curr_size_{0};
+  std::mutex latch_;
 };
 
 }  // namespace bustub
@@ -12,12 +12,24 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "common/config.h"
 
 namespace bustub {
 
+enum class AccessType { Unknown = 0, Get, Scan };
+
+/** The replacement policies a buffer pool can be configured with. */
+enum class ReplacerPolicy { LRUK = 0, LRU, Clock, ClockPro, TwoQ, ARC };
+
 /**
  * Replacer is an abstract class that tracks page usage.
+ *
+ * The buffer pool reports every access to a frame with RecordAccess, and marks a frame evictable once it is no longer
+ * pinned. A frame is tracked from its first recorded access until it is evicted or removed.
  */
 class Replacer {
  public:
@@ -25,26 +37,81 @@ class Replacer {
   virtual ~Replacer() = default;
 
   /**
-   * Remove the victim frame as defined by the replacement policy.
-   * @param[out] frame_id id of frame that was removed, nullptr if no victim was found
+   * Evict the victim frame as defined by the replacement policy. Only evictable frames are candidates. The evicted
+   * frame is no longer tracked.
+   * @param[out] frame_id id of frame that was evicted
    * @return true if a victim frame was found, false otherwise
    */
-  virtual auto Victim(frame_id_t *frame_id) -> bool = 0;
+  virtual auto Evict(frame_id_t *frame_id) -> bool = 0;
 
   /**
-   * Pins a frame, indicating that it should not be victimized until it is unpinned.
-   * @param frame_id the id of the frame to pin
+   * Record an access to the given frame, starting to track it if it is not tracked yet.
+   * @param frame_id id of frame that received a new access
+   * @param access_type type of access that was received
    */
-  virtual void Pin(frame_id_t frame_id) = 0;
+  virtual void RecordAccess(frame_id_t frame_id, AccessType access_type = AccessType::Unknown) = 0;
 
   /**
-   * Unpins a frame, indicating that it can now be victimized.
-   * @param frame_id the id of the frame to unpin
+   * Toggle whether a frame is evictable. Has no effect on a frame that is not tracked.
+   * @param frame_id id of frame whose 'evictable' status will be modified
+   * @param set_evictable whether the given frame is evictable or not
    */
-  virtual void Unpin(frame_id_t frame_id) = 0;
+  virtual void SetEvictable(frame_id_t frame_id, bool set_evictable) = 0;
+
+  /** @return true if the frame is tracked and evictable */
+  virtual auto IsEvictable(frame_id_t frame_id) -> bool = 0;
+
+  /**
+   * Stop tracking an evictable frame, without remembering its page as evicted. Does nothing for a frame that is not
+   * tracked; throws for a frame that is not evictable.
+   * @param frame_id id of frame to be removed
+   */
+  virtual void Remove(frame_id_t frame_id) = 0;
+
+  /**
+   * Tell the replacer which page a frame is about to be loaded with, before the first access to it is recorded.
+   * Policies that remember recently evicted pages use it to recognize a page coming back; the others ignore it.
+   */
+  virtual void SetPageId(frame_id_t frame_id, page_id_t page_id) {}
+
+  /**
+   * Predict the frames Evict would return next, without evicting them. Used to write dirty pages back before they
+   * are evicted, so the prediction only needs to be good, not exact.
+   * @param max_candidates the maximum number of frames to return
+   * @return up to max_candidates evictable frames, the next victim first
+   */
+  virtual auto EvictionCandidates(size_t max_candidates) -> std::vector<frame_id_t> = 0;
 
   /** @return the number of elements in the replacer that can be victimized */
   virtual auto Size() -> size_t = 0;
+
+  /** Same as Evict. */
+  auto Victim(frame_id_t *frame_id) -> bool { return Evict(frame_id); }
+
+  /** Pins a frame, indicating that it should not be victimized until it is unpinned. */
+  void Pin(frame_id_t frame_id) { SetEvictable(frame_id, false); }
+
+  /** Unpins a frame, indicating that it can now be victimized. Unpinning an unpinned frame does nothing. */
+  void Unpin(frame_id_t frame_id) {
+    if (!IsEvictable(frame_id)) {
+      RecordAccess(frame_id);
+      SetEvictable(frame_id, true);
+    }
+  }
 };
 
+/**
+ * Create a replacer for the given policy.
+ * @param policy the replacement policy
+ * @param num_frames the number of frames the replacer will be required to track
+ * @param k lookback window, only used by LRU-K
+ */
+auto MakeReplacer(ReplacerPolicy policy, size_t num_frames, size_t k) -> std::unique_ptr<Replacer>;
+
+/** @return the policy named by `name` (lru_k, lru, clock, clock_pro, 2q or arc); throws if there is none */
+auto ReplacerPolicyFromString(const std::string &name) -> ReplacerPolicy;
+
+/** @return the name of a policy, as accepted by ReplacerPolicyFromString */
+auto ReplacerPolicyToString(ReplacerPolicy policy) -> std::string;
+
 }  // namespace bustub
@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// two_q_replacer.h
+//
+// Identification: src/include/buffer/two_q_replacer.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "buffer/frame_list.h"
+#include "buffer/replacer.h"
+#include "common/config.h"
+
+namespace bustub {
+
+/**
+ * TwoQReplacer implements the full 2Q policy (Johnson and Shasha, VLDB '94).
+ *
+ * A page loaded for the first time goes to A1in, a FIFO that absorbs the burst of references right after a load.
+ * When a page is evicted from A1in its id is remembered in A1out. A page loaded again while its id is still in A1out
+ * has proven to be hot and goes to Am, an LRU list. Evict takes from A1in while it holds more than a quarter of the
+ * frames, and from Am otherwise.
+ */
+class TwoQReplacer : public Replacer {
+ public:
+  /**
+   * Create a new TwoQReplacer.
+   * @param num_frames the maximum number of frames the TwoQReplacer will be required to store
+   */
+  explicit TwoQReplacer(size_t num_frames);
+
+  ~TwoQReplacer() override = default;
+
+  auto Evict(frame_id_t *frame_id) -> bool override;
+
+  void RecordAccess(frame_id_t frame_id, AccessType access_type = AccessType::Unknown) override;
+
+  void SetEvictable(frame_id_t frame_id, bool set_evictable) override;
+
+  auto IsEvictable(frame_id_t frame_id) -> bool override;
+
+  void Remove(frame_id_t frame_id) override;
+
+  void SetPageId(frame_id_t frame_id, page_id_t page_id) override;
+
+  auto EvictionCandidates(size_t max_candidates) -> std::vector<frame_id_t> override;
+
+  auto Size() -> size_t override;
+
+ private:
+  void CheckFrameId(frame_id_t frame_id) const;
+  auto IsTracked(frame_id_t frame_id) const -> bool { return a1in_.Contains(frame_id) || am_.Contains(frame_id); }
+  /** Remove the first evictable frame of `list`, if any. */
+  auto EvictFrom(FrameList *list, frame_id_t *frame_id) -> bool;
+
+  /** Frames loaded once, oldest first. */
+  FrameList a1in_;
+  /** Frames loaded again soon after being evicted from A1in, least recently used first. */
+  FrameList am_;
+  /** Pages recently evicted from A1in, oldest first. */
+  GhostList a1out_;
+  /** Page held by each frame, as told by SetPageId. */
+  std::vector<page_id_t> page_ids_;
+  std::vector<bool> evictable_;
+  /** Number of frames A1in may hold before Evict takes from it. */
+  size_t kin_;
+  /** Number of pages A1out remembers. */
+  size_t kout_;
+  /** Number of evictable frames. */
+  size_t curr_size_{0};
+  std::mutex latch_;
+};
+
+}  // namespace bustub
@@ -22,6 +22,8 @@
 #include <utility>
 #include <vector>
 
+#include "buffer/frame_arena.h"
+#include "buffer/replacer.h"
 #include "catalog/catalog.h"
 #include "common/config.h"
 #include "common/util/string_util.h"
@@ -218,9 +220,22 @@ class BustubInstance {
   auto MakeExecutorContext(Transaction *txn, bool is_modify) -> std::unique_ptr<ExecutorContext>;
 
  public:
-  explicit BustubInstance(const std::string &db_file_name);
+  /**
+   * Create a BusTub instance backed by a database file.
+   * @param db_file_name the database file
+   * @param replacer_policy the replacement policy of the buffer pool
+   * @param frame_options how the memory of the buffer pool frames is allocated and placed
+   */
+  explicit BustubInstance(const std::string &db_file_name, ReplacerPolicy replacer_policy = ReplacerPolicy::LRUK,
+                          const FrameArenaOptions &frame_options = {});
 
-  BustubInstance();
+  /**
+   * Create a BusTub instance backed by memory.
+   * @param replacer_policy the replacement policy of the buffer pool
+   * @param frame_options how the memory of the buffer pool frames is allocated and placed
+   */
+  explicit BustubInstance(ReplacerPolicy replacer_policy = ReplacerPolicy::LRUK,
+                          const FrameArenaOptions &frame_options = {});
 
   ~BustubInstance();
 
@@ -275,6 +290,12 @@ class BustubInstance {
     return variable == "1" || variable == "true" || variable == "yes";
   }
 
+  /** @return the number a variable (a memory budget, a number of threads) is set to, or `default_value` if unset */
+  auto GetNumberVariable(const std::string &key, size_t default_value) -> size_t {
+    auto variable = GetSessionVariable(key);
+    return variable.empty() ? default_value : std::stoull(variable);
+  }
+
  private:
   void CmdDisplayTables(ResultWriter &writer);
   void CmdDisplayIndices(ResultWriter &writer);
@@ -35,7 +35,33 @@ static constexpr int BUSTUB_PAGE_SIZE = 4096;
 static constexpr int BUFFER_POOL_SIZE = 10;                                          // size of buffer pool
 static constexpr int LOG_BUFFER_SIZE = ((BUFFER_POOL_SIZE + 1) * BUSTUB_PAGE_SIZE);  // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                               // size of extendible hash bucket
-static constexpr int LRUK_REPLACER_K = 10;  // lookback window for lru-k replacer
+static constexpr int LRUK_REPLACER_K = 10;        // lookback window for lru-k replacer
+static constexpr int DISK_SCHEDULER_WORKERS = 4;  // number of background i/o threads per disk scheduler
+static constexpr int READ_AHEAD_WINDOW = 8;       // pages read ahead of a sequential scan, 0 disables read-ahead
+static constexpr int SCAN_RING_SIZE = 16;         // frames a scan may cycle through, 0 lets scans use the whole pool
+static constexpr int BACKGROUND_WRITER_INTERVAL_MS = 50;  // time between background writer rounds, 0 pauses it
+static constexpr int BACKGROUND_WRITER_MAX_PAGES = 32;    // pages the background writer cleans per round
+static constexpr double BULK_LOAD_FILL_FACTOR = 0.9;      // fraction of each b+ tree page filled by a bulk load
+static constexpr int INDEX_JOIN_BATCH_SIZE = 1024;        // outer tuples a nested index join looks up at once
+static constexpr int INDEX_SCAN_BATCH_SIZE = 256;         // entries an index range scan reads per descent of the tree
+static constexpr int HASH_JOIN_PARTITION_ROWS = 2048;     // build tuples per radix partition, whose table fits in cache
+static constexpr int HASH_JOIN_MAX_RADIX_BITS = 12;       // hash bits a hash join partitions its inputs by, at most
+static constexpr int HASH_JOIN_ROWS_PER_THREAD = 16384;   // input tuples each thread of a hash join gets, at least
+static constexpr size_t HASH_JOIN_MEMORY = 64 << 20;      // bytes of build tuples a hash join holds before it spills
+static constexpr int HASH_JOIN_SPILL_BITS = 4;            // hash bits each spill pass of a hash join splits inputs by
+static constexpr int HASH_JOIN_MAX_SPILL_DEPTH = 4;       // times a spilled partition is partitioned again, at most
+static constexpr size_t SORT_MEMORY = 64 << 20;           // bytes of tuples a sort holds before it spills a run
+static constexpr int SORT_MERGE_FANIN = 16;               // runs an external sort merges at once, at most
+static constexpr int BATCH_SIZE = 1024;                    // tuples an executor produces per batch when vectorized
+static constexpr int AGGREGATION_PARTITIONS = 64;         // partitions the groups of an aggregation are merged in
+static constexpr int AGGREGATION_ROWS_PER_THREAD = 16384;  // input tuples each thread of an aggregation gets, at least
+static constexpr int AGGREGATION_SAMPLE_ROWS = 4096;      // tuples a thread aggregates before it checks they group
+static constexpr double AGGREGATION_PASS_THROUGH_RATIO = 0.5;  // groups per sampled tuple past which they pass through
+static constexpr size_t AGGREGATION_MEMORY = 64 << 20;    // bytes of groups an aggregation holds before it spills
+static constexpr int AGGREGATION_SPILL_BITS = 4;          // hash bits each spill pass of an aggregation splits by
+static constexpr int AGGREGATION_MAX_SPILL_DEPTH = 4;     // times a spilled partition is partitioned again, at most
+static constexpr int MORSEL_PAGES = 8;                    // table pages a worker of a parallel scan takes at a time
+static constexpr int GATHER_BATCHES_PER_WORKER = 4;       // batches a gather holds per worker ahead of its consumer
 
 using frame_id_t = int32_t;    // frame id type
 using page_id_t = int32_t;     // page id type
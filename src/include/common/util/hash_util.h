@@ -49,6 +49,19 @@ class HashUtil {
     return (l % PRIME_FACTOR + r % PRIME_FACTOR) % PRIME_FACTOR;
   }
 
+  /**
+   * Spread the bits of a hash: hashes of small integers differ in their low bits only, while hash partitioning uses
+   * the low bits and the bits above them, or the top bits.
+   */
+  static inline auto MixHash(hash_t hash) -> hash_t {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
   template <typename T>
   static inline auto Hash(const T *ptr) -> hash_t {
     return HashBytes(reinterpret_cast<const char *>(ptr), sizeof(T));
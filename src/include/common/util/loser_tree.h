@@ -0,0 +1,88 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// loser_tree.h
+//
+// Identification: src/include/common/util/loser_tree.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+namespace bustub {
+
+/**
+ * LoserTree picks which of k sorted inputs holds the least head, for a k-way merge. Each internal node of the tree
+ * keeps the input that lost the match played there, so that once the winner advances, only the matches on its path
+ * to the root are replayed: log2(k) comparisons per element, against the previous losers, rather than the two per
+ * level of a binary heap.
+ *
+ * The tree only knows inputs by their index. `Less(a, b)` tells whether the head of input a sorts before the head of
+ * input b; exhausted inputs, marked with SetExhausted, lose against any other. Ties go to the lower index, which keeps
+ * a merge of sorted runs stable.
+ */
+template <typename Less>
+class LoserTree {
+ public:
+  LoserTree(size_t num_inputs, Less less) : less_(std::move(less)), tree_(num_inputs), exhausted_(num_inputs) {}
+
+  /** Play all matches, once every input has its first head (or is exhausted). */
+  void Build() {
+    if (!tree_.empty()) {
+      tree_[0] = Play(1);
+    }
+  }
+
+  /** @return the input holding the least head, or the number of inputs if all are exhausted */
+  auto Top() const -> size_t { return tree_.empty() || exhausted_[tree_[0]] ? tree_.size() : tree_[0]; }
+
+  /** Mark an input as having no more elements, before it is replayed. */
+  void SetExhausted(size_t input) { exhausted_[input] = true; }
+
+  /** Replay the matches of the winner, after it moved to its next head or was exhausted. */
+  void Replay() {
+    size_t num_inputs = tree_.size();
+    size_t winner = tree_[0];
+    for (size_t node = (winner + num_inputs) / 2; node > 0; node /= 2) {
+      if (Beats(tree_[node], winner)) {
+        std::swap(tree_[node], winner);
+      }
+    }
+    tree_[0] = winner;
+  }
+
+ private:
+  /** @return true if input a wins over input b */
+  auto Beats(size_t a, size_t b) -> bool {
+    if (exhausted_[a] || exhausted_[b]) {
+      return !exhausted_[a] && (exhausted_[b] || a < b);
+    }
+    return less_(a, b) || (!less_(b, a) && a < b);
+  }
+
+  /** Play the matches of the subtree under `node`: nodes [1, k) are internal, [k, 2k) the inputs. @return winner */
+  auto Play(size_t node) -> size_t {
+    size_t num_inputs = tree_.size();
+    if (node >= num_inputs) {
+      return node - num_inputs;
+    }
+    size_t left = Play(2 * node);
+    size_t right = Play(2 * node + 1);
+    bool left_wins = Beats(left, right);
+    tree_[node] = left_wins ? right : left;
+    return left_wins ? left : right;
+  }
+
+  Less less_;
+  /** The loser of the match at each internal node; the overall winner at 0. */
+  std::vector<size_t> tree_;
+  std::vector<bool> exhausted_;
+};
+
+}  // namespace bustub
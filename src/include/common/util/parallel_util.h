@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parallel_util.h
+//
+// Identification: src/include/common/util/parallel_util.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * WorkerPool keeps threads alive across the parallel phases of a query, so that a phase hands its tasks to them
+ * rather than starting threads of its own. The thread that runs a phase works through its tasks too, which is why a
+ * pool of `n` threads runs up to `n + 1` tasks at once, and why a task may run a phase of its own without waiting for a
+ * free worker.
+ */
+class WorkerPool {
+ public:
+  explicit WorkerPool(size_t num_workers);
+
+  ~WorkerPool();
+
+  DISALLOW_COPY_AND_MOVE(WorkerPool);
+
+  /** @return the number of threads of the pool, the ones of the callers aside */
+  auto NumWorkers() const -> size_t { return workers_.size(); }
+
+  /** Run task(0) to task(num_tasks - 1) on the workers and the calling thread, and rethrow their first error. */
+  void Run(size_t num_tasks, const std::function<void(size_t)> &task);
+
+ private:
+  /** The tasks of one call to Run, which whoever is free takes one at a time. */
+  struct Batch {
+    const std::function<void(size_t)> *task_;
+    size_t num_tasks_;
+    /** The next task to take and the number of tasks done, under latch_ */
+    size_t next_{0};
+    size_t done_{0};
+    std::vector<std::exception_ptr> errors_;
+  };
+
+  /** Run a task of the batch, taken with latch_ held; latch_ is held again on return. */
+  void RunTask(Batch *batch, size_t task, std::unique_lock<std::mutex> *lock);
+
+  void WorkerLoop();
+
+  std::mutex latch_;
+  /** Signaled when a batch comes in or the pool stops */
+  std::condition_variable work_cv_;
+  /** Signaled when a task is done */
+  std::condition_variable done_cv_;
+  /** The batches with tasks left to take, oldest first */
+  std::deque<Batch *> batches_;
+  bool stop_{false};
+  std::vector<std::thread> workers_;
+};
+
+/**
+ * Run task(0) to task(num_threads - 1) on the workers of the pool and the calling thread, and rethrow their errors.
+ * Without a pool, the tasks run one after the other on the calling thread.
+ */
+template <typename Task>
+void RunParallel(WorkerPool *pool, size_t num_threads, const Task &task) {
+  if (pool == nullptr || num_threads == 1) {
+    for (size_t i = 0; i < num_threads; i++) {
+      task(i);
+    }
+    return;
+  }
+  pool->Run(num_threads, task);
+}
+
+}  // namespace bustub
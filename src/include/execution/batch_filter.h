@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// batch_filter.h
+//
+// Identification: src/include/execution/batch_filter.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/filter_kernels.h"
+#include "execution/tuple_batch.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * BatchFilter selects the rows of a batch a predicate holds for with filter kernels, a column at a time, instead of
+ * evaluating it row by row.
+ *
+ * It covers ANDs and ORs of comparisons between columns, constants and integer arithmetic on them, all of the same
+ * type among INTEGER, BIGINT, DECIMAL and BOOLEAN (a constant is taken as one of the type of the column it compares
+ * with if it fits). Each comparison is a bitmap of the rows it is true for, so that AND and OR are those of bitmaps.
+ */
+class BatchFilter {
+ public:
+  /**
+   * @param predicate The predicate
+   * @param schema The schema of the batches it filters
+   * @return a filter for the predicate, or nullptr if the kernels do not cover it
+   */
+  static auto Create(const AbstractExpressionRef &predicate, const Schema &schema) -> std::unique_ptr<BatchFilter>;
+
+  /** Keep only the selected rows of a batch the predicate is true for. */
+  void Select(TupleBatch *batch);
+
+ private:
+  /** An operand of a comparison: a column, a constant, or the sum or difference of two INTEGER operands */
+  struct Operand {
+    enum class Kind { Column, Constant, Add, Subtract };
+    Kind kind_;
+    TypeId type_;
+    uint32_t col_{0};
+    /** A constant, and the same as a value of the type of the operand once converted */
+    Value constant_;
+    int64_t int_{0};
+    double decimal_{0};
+    std::unique_ptr<Operand> lhs_;
+    std::unique_ptr<Operand> rhs_;
+  };
+
+  /** A comparison of two operands, at least one of them not a constant, or an AND or OR of two nodes */
+  struct Node {
+    enum class Kind { Compare, And, Or };
+    Kind kind_;
+    ComparisonType op_{ComparisonType::Equal};
+    std::unique_ptr<Operand> lhs_;
+    std::unique_ptr<Operand> rhs_;
+    std::unique_ptr<Node> left_;
+    std::unique_ptr<Node> right_;
+  };
+
+  BatchFilter() = default;
+
+  auto BuildNode(const AbstractExpression &expr) -> std::unique_ptr<Node>;
+  auto BuildOperand(const AbstractExpression &expr) -> std::unique_ptr<Operand>;
+
+  /** Take a constant operand as one of a type. @return false if it does not fit the type */
+  static auto ConvertConstant(Operand *operand, TypeId type) -> bool;
+
+  /** Write the bitmap of the rows of a batch the node is true for. */
+  void Evaluate(const Node &node, const TupleBatch &batch, SelectionBitmap *bitmap);
+
+  /** @return the values of an INTEGER operand for the rows of a batch, computed in a scratch vector unless a column */
+  auto EvaluateIntegers(const Operand &operand, const TupleBatch &batch) -> const int32_t *;
+
+  template <TypeId type>
+  void Compare(const Node &node, const typename FilterKernelType<type>::Type *lhs, const TupleBatch &batch,
+               SelectionBitmap *bitmap);
+
+  /** @return a scratch vector of the size of the batch, free until the batch is selected */
+  auto ScratchIntegers(size_t num_rows) -> int32_t *;
+  auto ScratchBitmap(size_t num_rows) -> SelectionBitmap *;
+
+  const Schema *schema_{nullptr};
+  std::unique_ptr<Node> root_;
+
+  SelectionBitmap result_;
+  std::vector<std::unique_ptr<std::vector<int32_t>>> scratch_integers_;
+  size_t scratch_integers_used_{0};
+  std::vector<std::unique_ptr<SelectionBitmap>> scratch_bitmaps_;
+  size_t scratch_bitmaps_used_{0};
+};
+
+}  // namespace bustub
@@ -0,0 +1,190 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// compiled_expression.h
+//
+// Identification: src/include/execution/compiled_expression.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/batch_filter.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/tuple_batch.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * CompiledExpression evaluates an expression over tuples of a schema as a flat program for a register machine, rather
+ * than by walking the tree of the expression with a Value at every node and a virtual call of its Type for every
+ * operator.
+ *
+ * Each instruction writes one register from the tuple or from other registers, with an opcode specific to the types
+ * of its operands: an integer comparison compares two int64_t, a varchar comparison two runs of bytes in place in the
+ * tuple. Columns, constants, comparisons, arithmetic and logic are compiled; any other node, or one whose operands
+ * are of types the opcodes do not pair up (an integer and a decimal), is evaluated by the tree interpreter as one
+ * instruction, and the whole expression is if its root is. Results are those of AbstractExpression::Evaluate.
+ *
+ * A predicate filters batches with a BatchFilter, a column at a time, if the filter kernels cover it.
+ *
+ * The registers belong to the instance: it evaluates one tuple at a time, on one thread at a time.
+ */
+class CompiledExpression {
+ public:
+  /**
+   * Compile an expression.
+   * @param expr The expression
+   * @param schema The schema of the tuples it evaluates, which must outlive the compiled expression
+   */
+  CompiledExpression(AbstractExpressionRef expr, const Schema &schema);
+
+  CompiledExpression(const CompiledExpression &) = delete;
+  auto operator=(const CompiledExpression &) -> CompiledExpression & = delete;
+  CompiledExpression(CompiledExpression &&) = default;
+  auto operator=(CompiledExpression &&) -> CompiledExpression & = default;
+  ~CompiledExpression() = default;
+
+  /** @return the value of the expression for a tuple */
+  auto Evaluate(const Tuple &tuple) -> Value;
+
+  /** @return whether the expression, a predicate, is true (neither false nor null) for a tuple */
+  auto EvaluatePredicate(const Tuple &tuple) -> bool;
+
+  /** @return whether the expression, a predicate, is true for a tuple read in place, copied only for the interpreter */
+  auto EvaluatePredicate(const TupleRef &tuple) -> bool;
+
+  /** Evaluate the selected rows of a batch, as AbstractExpression::EvaluateBatch does. */
+  void EvaluateBatch(const TupleBatch &batch, std::vector<Value> *result);
+
+  /** Keep only the selected rows of a batch the expression, a predicate, is true for. */
+  void SelectBatch(TupleBatch *batch);
+
+  /** @return true if the expression selects batches with filter kernels */
+  auto HasBatchFilter() const -> bool { return batch_filter_ != nullptr; }
+
+  /** @return false if the expression is evaluated by the tree interpreter as a whole */
+  auto IsCompiled() const -> bool { return !tree_only_; }
+
+  /** @return the number of instructions of the program */
+  auto NumInstructions() const -> size_t { return program_.size(); }
+
+ private:
+  enum class Opcode : uint8_t {
+    // Load a column of the tuple, of the type of the opcode.
+    LoadBoolean,
+    LoadTinyInt,
+    LoadSmallInt,
+    LoadInteger,
+    LoadBigInt,
+    LoadDecimal,
+    LoadVarchar,
+    // Evaluate a subtree with the tree interpreter.
+    Evaluate,
+    // Compare integers (or booleans), decimals or varchars.
+    EqualInt,
+    NotEqualInt,
+    LessThanInt,
+    LessThanOrEqualInt,
+    GreaterThanInt,
+    GreaterThanOrEqualInt,
+    EqualDecimal,
+    NotEqualDecimal,
+    LessThanDecimal,
+    LessThanOrEqualDecimal,
+    GreaterThanDecimal,
+    GreaterThanOrEqualDecimal,
+    EqualVarchar,
+    NotEqualVarchar,
+    LessThanVarchar,
+    LessThanOrEqualVarchar,
+    GreaterThanVarchar,
+    GreaterThanOrEqualVarchar,
+    // Integer arithmetic, on 32 bits.
+    AddInteger,
+    SubtractInteger,
+    // Logic of SQL, with its nulls.
+    And,
+    Or,
+  };
+
+  struct Instruction {
+    Opcode op_;
+    uint32_t dst_;
+    uint32_t lhs_;
+    uint32_t rhs_;
+    /** The column a load reads, or the subtree an Evaluate evaluates */
+    uint32_t col_;
+    /** Where in a tuple a load finds the column, or the offset of its varchar */
+    uint32_t offset_;
+  };
+
+  /** A register holds a value of the type of the register, not null if `null_` is false. */
+  struct Register {
+    bool null_{true};
+    /** Booleans and integers */
+    int64_t int_{0};
+    double decimal_{0};
+    /** A varchar and its length as serialized, the terminating null character included */
+    const char *str_{nullptr};
+    uint32_t len_{0};
+  };
+
+  /** @return the type the program gives the value of an expression */
+  auto StaticType(const AbstractExpression &expr) const -> TypeId;
+
+  /** Compile an expression into instructions, or an instruction that evaluates it. @return its register */
+  auto Compile(const AbstractExpressionRef &expr) -> uint32_t;
+
+  /** @return a new register of a type */
+  auto NewRegister(TypeId type) -> uint32_t;
+
+  /** Emit an instruction. @return its register */
+  auto Emit(Opcode op, TypeId type, uint32_t lhs = 0, uint32_t rhs = 0, uint32_t col = 0, uint32_t offset = 0)
+      -> uint32_t;
+
+  /** Run the program on a tuple serialized at `data`, its subtrees evaluated on `tuple`. */
+  void RunOnTuple(const char *data, const Tuple *tuple);
+
+  /** Run the program on one row, its columns found by `data_of` and the values of subtrees by `evaluate`. */
+  template <typename DataOf, typename EvaluateFn>
+  void Run(const DataOf &data_of, const EvaluateFn &evaluate);
+
+  /** Load a value into a register. */
+  static void LoadValue(Register *reg, const Value &value);
+
+  /** @return the value of a register of a type */
+  static auto ToValue(const Register &reg, TypeId type) -> Value;
+
+  AbstractExpressionRef expr_;
+  const Schema *schema_;
+  bool tree_only_{false};
+
+  std::vector<Instruction> program_;
+  uint32_t result_{0};
+  /** The type of each register */
+  std::vector<TypeId> types_;
+  std::vector<Register> registers_;
+  /** The constants, each loaded in its register once and for all */
+  std::vector<std::pair<uint32_t, Value>> constants_;
+  /** The subtrees the tree interpreter evaluates, and their values for the current tuple or batch */
+  std::vector<AbstractExpressionRef> subtrees_;
+  std::vector<Value> subtree_values_;
+  std::vector<std::vector<Value>> subtree_batch_values_;
+  /** The filter of a predicate the filter kernels cover, and the values of one they do not */
+  std::unique_ptr<BatchFilter> batch_filter_;
+  std::vector<Value> predicate_values_;
+};
+
+}  // namespace bustub
@@ -63,7 +63,11 @@ class ExecutionEngine {
 
     try {
       executor->Init();
-      PollExecutor(executor.get(), plan, result_set);
+      if (exec_ctx->IsVectorized()) {
+        PollExecutorBatches(executor.get(), plan, result_set);
+      } else {
+        PollExecutor(executor.get(), plan, result_set);
+      }
       PerformChecks(exec_ctx);
     } catch (const ExecutionException &ex) {
       executor_succeeded = false;
@@ -103,6 +107,24 @@ class ExecutionEngine {
     }
   }
 
+  /**
+   * Poll the executor a batch at a time until exhausted, or exception escapes.
+   * @param executor The root executor
+   * @param plan The plan to execute
+   * @param result_set The tuple result set
+   */
+  static void PollExecutorBatches(AbstractExecutor *executor, const AbstractPlanNodeRef &plan,
+                                  std::vector<Tuple> *result_set) {
+    TupleBatch batch;
+    while (executor->NextBatch(&batch)) {
+      if (result_set != nullptr) {
+        for (auto row : batch.GetSelection()) {
+          result_set->push_back(batch.GetTuple(row, executor->GetOutputSchema()));
+        }
+      }
+    }
+  }
+
   [[maybe_unused]] BufferPoolManager *bpm_;
   [[maybe_unused]] TransactionManager *txn_mgr_;
   [[maybe_unused]] Catalog *catalog_;
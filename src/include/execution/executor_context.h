@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "catalog/catalog.h"
+#include "common/util/parallel_util.h"
 #include "concurrency/transaction.h"
 #include "execution/check_options.h"
 #include "execution/executors/abstract_executor.h"
@@ -93,6 +94,42 @@ class ExecutorContext {
 
   auto IsDelete() const -> bool { return is_delete_; }
 
+  /** @return the bytes of build tuples a hash join of the query keeps in memory before it spills them to temp pages */
+  auto GetHashJoinMemory() const -> size_t { return hash_join_mem_; }
+
+  /** Set the memory budget of the hash joins of the query, see GetHashJoinMemory. */
+  void SetHashJoinMemory(size_t hash_join_mem) { hash_join_mem_ = hash_join_mem; }
+
+  /** @return the bytes of tuples a sort of the query keeps in memory before it writes them out as a sorted run */
+  auto GetSortMemory() const -> size_t { return sort_mem_; }
+
+  /** Set the memory budget of the sorts of the query, see GetSortMemory. */
+  void SetSortMemory(size_t sort_mem) { sort_mem_ = sort_mem; }
+
+  /** @return the bytes of groups a hash aggregation of the query keeps in memory before it spills them to temp pages */
+  auto GetAggregationMemory() const -> size_t { return agg_mem_; }
+
+  /** Set the memory budget of the hash aggregations of the query, see GetAggregationMemory. */
+  void SetAggregationMemory(size_t agg_mem) { agg_mem_ = agg_mem; }
+
+  /** @return whether executors of the query pass tuples a batch at a time (NextBatch) rather than one at a time */
+  auto IsVectorized() const -> bool { return vectorized_; }
+
+  /** Set whether the query runs vectorized, see IsVectorized. */
+  void SetVectorized(bool vectorized) { vectorized_ = vectorized; }
+
+  /** @return the threads an executor of the query may run on at once; above 1, scans run morsel by morsel */
+  auto GetParallelism() const -> size_t { return parallelism_; }
+
+  /** Set the threads of the query, see GetParallelism, and start the workers that run its parallel phases. */
+  void SetParallelism(size_t parallelism) {
+    parallelism_ = parallelism;
+    worker_pool_ = parallelism > 1 ? std::make_unique<WorkerPool>(parallelism - 1) : nullptr;
+  }
+
+  /** @return the threads that help the executors of the query run their parallel phases, nullptr if there is one */
+  auto GetWorkerPool() -> WorkerPool * { return worker_pool_.get(); }
+
  private:
   /** The transaction context associated with this executor context */
   Transaction *transaction_;
@@ -109,6 +146,18 @@ class ExecutorContext {
   /** The set of check options associated with this executor context */
   std::shared_ptr<CheckOptions> check_options_;
   bool is_delete_;
+  /** The memory budget of each hash join, in bytes */
+  size_t hash_join_mem_{HASH_JOIN_MEMORY};
+  /** The memory budget of each sort, in bytes */
+  size_t sort_mem_{SORT_MEMORY};
+  /** The memory budget of each hash aggregation, in bytes */
+  size_t agg_mem_{AGGREGATION_MEMORY};
+  /** Whether executors pass tuples a batch at a time */
+  bool vectorized_{true};
+  /** The threads of each executor, one unless the session opts in with SET parallelism */
+  size_t parallelism_{1};
+  /** The parallelism_ - 1 threads besides the one running the query, kept for the query's lifetime */
+  std::unique_ptr<WorkerPool> worker_pool_;
 };
 
 }  // namespace bustub
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "execution/executor_context.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -21,6 +22,9 @@ class ExecutorContext;
  * The AbstractExecutor implements the Volcano tuple-at-a-time iterator model.
  * This is the base class from which all executors in the BustTub execution
  * engine inherit, and defines the minimal interface that all executors support.
+ *
+ * Executors may also produce their tuples a batch at a time (NextBatch), column by column, which vectorized execution
+ * (ExecutorContext::IsVectorized) asks of them. Those that do not implement it natively fill batches from Next.
  */
 class AbstractExecutor {
  public:
@@ -47,6 +51,21 @@ class AbstractExecutor {
    */
   virtual auto Next(Tuple *tuple, RID *rid) -> bool = 0;
 
+  /**
+   * Yield the next batch of tuples from this executor. Calls to Next and NextBatch must not be mixed.
+   * @param[out] batch The next batch of tuples, of the output schema, with at least one row selected
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  virtual auto NextBatch(TupleBatch *batch) -> bool {
+    batch->Reset(GetOutputSchema());
+    Tuple tuple;
+    RID rid;
+    while (batch->NumRows() < static_cast<size_t>(BATCH_SIZE) && Next(&tuple, &rid)) {
+      batch->AppendTuple(tuple, GetOutputSchema(), rid);
+    }
+    return batch->NumRows() > 0;
+  }
+
   /** @return The schema of the tuples that this executor produces */
   virtual auto GetOutputSchema() const -> const Schema & = 0;
 
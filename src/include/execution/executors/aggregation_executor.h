@@ -22,7 +22,9 @@
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/expressions/abstract_expression.h"
+#include "execution/morsel_pipeline.h"
 #include "execution/plans/aggregation_plan.h"
+#include "storage/table/tmp_tuple_file.h"
 #include "storage/table/tuple.h"
 #include "type/value_factory.h"
 
@@ -64,37 +66,85 @@ class SimpleAggregationHashTable {
   }
 
   /**
-   * TODO(Student)
-   *
    * Combines the input into the aggregation result.
    * @param[out] result The output aggregate value
    * @param input The input value
    */
   void CombineAggregateValues(AggregateValue *result, const AggregateValue &input) {
     for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
+      Value &agg = result->aggregates_[i];
+      const Value &value = input.aggregates_[i];
       switch (agg_types_[i]) {
         case AggregationType::CountStarAggregate:
+          agg = agg.Add(ValueFactory::GetIntegerValue(1));
+          break;
         case AggregationType::CountAggregate:
+          if (!value.IsNull()) {
+            agg = agg.IsNull() ? ValueFactory::GetIntegerValue(1) : agg.Add(ValueFactory::GetIntegerValue(1));
+          }
+          break;
         case AggregationType::SumAggregate:
         case AggregationType::MinAggregate:
         case AggregationType::MaxAggregate:
+          CombineValue(agg_types_[i], &agg, value);
           break;
       }
     }
   }
 
+  /**
+   * Merges a partial aggregation result, of the same group, into the aggregation result: counts add up rather than
+   * count the partial result once.
+   * @param[out] result The output aggregate value
+   * @param partial The partial aggregate value, as CombineAggregateValues leaves it or MakePartialAggregateValue makes
+   */
+  void MergeAggregateValues(AggregateValue *result, const AggregateValue &partial) {
+    for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
+      auto agg_type = agg_types_[i];
+      if (agg_type == AggregationType::CountStarAggregate || agg_type == AggregationType::CountAggregate) {
+        agg_type = AggregationType::SumAggregate;
+      }
+      CombineValue(agg_type, &result->aggregates_[i], partial.aggregates_[i]);
+    }
+  }
+
+  /** @return the partial aggregate value of a single input, for MergeAggregateValues */
+  auto MakePartialAggregateValue(const AggregateValue &input) -> AggregateValue {
+    auto partial = GenerateInitialAggregateValue();
+    CombineAggregateValues(&partial, input);
+    return partial;
+  }
+
   /**
    * Inserts a value into the hash table and then combines it with the current aggregation.
    * @param agg_key the key to be inserted
    * @param agg_val the value to be inserted
    */
   void InsertCombine(const AggregateKey &agg_key, const AggregateValue &agg_val) {
-    if (ht_.count(agg_key) == 0) {
-      ht_.insert({agg_key, GenerateInitialAggregateValue()});
+    auto iter = ht_.find(agg_key);
+    if (iter == ht_.end()) {
+      iter = ht_.insert({agg_key, GenerateInitialAggregateValue()}).first;
     }
-    CombineAggregateValues(&ht_[agg_key], agg_val);
+    CombineAggregateValues(&iter->second, agg_val);
   }
 
+  /**
+   * Inserts a partial aggregate value into the hash table and then merges it with the current aggregation.
+   * @param agg_key the key to be inserted
+   * @param partial the partial aggregate value to be inserted
+   */
+  void InsertMerge(const AggregateKey &agg_key, const AggregateValue &partial) {
+    auto iter = ht_.find(agg_key);
+    if (iter == ht_.end()) {
+      ht_.insert({agg_key, partial});
+      return;
+    }
+    MergeAggregateValues(&iter->second, partial);
+  }
+
+  /** @return the number of groups in the hash table */
+  auto Size() const -> size_t { return ht_.size(); }
+
   /**
    * Clear the hash table
    */
@@ -136,6 +186,31 @@ class SimpleAggregationHashTable {
   auto End() -> Iterator { return Iterator{ht_.cend()}; }
 
  private:
+  /** Combines a non-count value into an aggregate of the given type, which ignores nulls. */
+  static void CombineValue(AggregationType agg_type, Value *agg, const Value &value) {
+    if (value.IsNull()) {
+      return;
+    }
+    if (agg->IsNull()) {
+      *agg = value;
+      return;
+    }
+    switch (agg_type) {
+      case AggregationType::SumAggregate:
+        *agg = agg->Add(value);
+        break;
+      case AggregationType::MinAggregate:
+        *agg = agg->Min(value);
+        break;
+      case AggregationType::MaxAggregate:
+        *agg = agg->Max(value);
+        break;
+      case AggregationType::CountStarAggregate:
+      case AggregationType::CountAggregate:
+        break;
+    }
+  }
+
   /** The hash table is just a map from aggregate keys to aggregate values */
   std::unordered_map<AggregateKey, AggregateValue> ht_{};
   /** The aggregate expressions that we have */
@@ -146,7 +221,20 @@ class SimpleAggregationHashTable {
 
 /**
  * AggregationExecutor executes an aggregation operation (e.g. COUNT, SUM, MIN, MAX)
- * over the tuples produced by a child executor.
+ * over the tuples produced by a child executor, in two phases and in parallel.
+ *
+ * The child is read in chunks, of batches when vectorized. Worker threads pre-aggregate each chunk into tables of their
+ * own, one per partition of the group keys' hashes (AGGREGATION_PARTITIONS), without sharing any state. A thread whose
+ * first AGGREGATION_SAMPLE_ROWS tuples hardly fell into fewer groups stops pre-aggregating, and passes its tuples on as
+ * partial aggregates of one tuple each instead: with about as many groups as tuples, its tables would only add work.
+ * Once the child is exhausted, the merge phase gives each partition to one thread, which merges the partial aggregates
+ * of every thread for that partition into the final groups.
+ *
+ * When the partial aggregates outgrow the memory budget of the query (ExecutorContext::GetAggregationMemory), they are
+ * written to temp pages (TmpTupleFile) as tuples of the output schema, split into partitions by the top bits of the
+ * hashes, and pre-aggregation resumes with empty tables. Next then merges the spilled partitions one at a time; a
+ * partition that still does not fit is split again by the next bits, up to AGGREGATION_MAX_SPILL_DEPTH times. An
+ * aggregation without GROUP BY has a single group per thread, and never spills.
  */
 class AggregationExecutor : public AbstractExecutor {
  public:
@@ -177,8 +265,28 @@ class AggregationExecutor : public AbstractExecutor {
   auto GetChildExecutor() const -> const AbstractExecutor *;
 
  private:
+  /** The partial aggregates of one worker thread, by partition. */
+  struct LocalAggregation {
+    /** The groups the thread pre-aggregated */
+    std::vector<SimpleAggregationHashTable> tables_;
+    /** The tuples the thread passed through, as partial aggregates of one tuple each */
+    std::vector<std::vector<std::pair<AggregateKey, AggregateValue>>> passed_;
+    /** The tuples the thread pre-aggregated, up to AGGREGATION_SAMPLE_ROWS, and the groups they fell into */
+    size_t sampled_rows_{0};
+    size_t sampled_groups_{0};
+    /** The groups and passed tuples the thread holds */
+    size_t num_entries_{0};
+    bool pass_through_{false};
+  };
+
+  /** Partial aggregates spilled to temp pages, split by the top `depth_` times AGGREGATION_SPILL_BITS bits. */
+  struct SpilledPartition {
+    std::unique_ptr<TmpTupleFile> file_;
+    uint32_t depth_;
+  };
+
   /** @return The tuple as an AggregateKey */
-  auto MakeAggregateKey(const Tuple *tuple) -> AggregateKey {
+  auto MakeAggregateKey(const Tuple *tuple) const -> AggregateKey {
     std::vector<Value> keys;
     for (const auto &expr : plan_->GetGroupBys()) {
       keys.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
@@ -187,7 +295,7 @@ class AggregationExecutor : public AbstractExecutor {
   }
 
   /** @return The tuple as an AggregateValue */
-  auto MakeAggregateValue(const Tuple *tuple) -> AggregateValue {
+  auto MakeAggregateValue(const Tuple *tuple) const -> AggregateValue {
     std::vector<Value> vals;
     for (const auto &expr : plan_->GetAggregates()) {
       vals.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
@@ -195,14 +303,67 @@ class AggregationExecutor : public AbstractExecutor {
     return {vals};
   }
 
+  /** @return the hash of a group key, partitions are chosen by its low bits and spill partitions by its top bits */
+  static auto HashKey(const AggregateKey &key) -> hash_t { return HashUtil::MixHash(std::hash<AggregateKey>{}(key)); }
+
+  /** @return the memory a group or passed tuple takes, as counted against the budget */
+  auto EntryBytes() const -> size_t;
+
+  /** @return empty partial aggregates for `num_threads` threads */
+  auto MakeLocals(size_t num_threads) const -> std::vector<LocalAggregation>;
+
+  /** Pre-aggregate a chunk of child tuples into locals_, each thread a range of them. */
+  void PreAggregate(const std::vector<Tuple> &tuples);
+
+  /** Pre-aggregate a chunk of child batches into locals_, each thread a range of them. */
+  void PreAggregate(const std::vector<TupleBatch> &batches, size_t num_rows);
+
+  /**
+   * Pre-aggregate up to AGGREGATION_ROWS_PER_THREAD rows of each worker of a pipeline into locals_, each worker on a
+   * thread of its own, and flag the workers that ran out of rows.
+   * @return true if a worker may have more rows
+   */
+  auto PreAggregate(MorselPipeline *pipeline, std::vector<char> *exhausted) -> bool;
+
+  /** Pre-aggregate the selected rows of a batch of the child into a local aggregation. */
+  void AccumulateBatch(LocalAggregation *local, const TupleBatch &batch) const;
+
+  /** Aggregate a child tuple into the partial aggregates of a thread, or pass it through. */
+  static void Accumulate(LocalAggregation *local, AggregateKey key, const AggregateValue &value);
+
+  /** @return one empty temp file for each spill partition */
+  auto MakeSpillFiles() -> std::vector<std::unique_ptr<TmpTupleFile>>;
+
+  /** Write the partial aggregates of locals_ to the spill files of the first spill pass, and empty them. */
+  void SpillLocals(std::vector<std::unique_ptr<TmpTupleFile>> *files);
+
+  /** Queue the spill files up as pending partitions, of the given depth. */
+  void AddSpilledPartitions(std::vector<std::unique_ptr<TmpTupleFile>> files, uint32_t depth);
+
+  /** Merge the partial aggregates of locals_ into results_, each thread a partition at a time. */
+  void Merge();
+
+  /** Merge the last pending partition into results_, or split it into more pending partitions if it is too large. */
+  void MergeSpilledPartition();
+
+  /** @return a group as a tuple of the output schema */
+  auto MakeOutputTuple(const AggregateKey &key, const AggregateValue &value) const -> Tuple;
+
+  /** @return a tuple of the output schema as a group */
+  auto SplitOutputTuple(const Tuple &tuple) const -> std::pair<AggregateKey, AggregateValue>;
+
  private:
   /** The aggregation plan node */
   const AggregationPlanNode *plan_;
   /** The child executor that produces tuples over which the aggregation is computed */
   std::unique_ptr<AbstractExecutor> child_;
-  /** Simple aggregation hash table */
-  // TODO(Student): Uncomment SimpleAggregationHashTable aht_;
-  /** Simple aggregation hash table iterator */
-  // TODO(Student): Uncomment SimpleAggregationHashTable::Iterator aht_iterator_;
+  /** The partial aggregates of each worker thread */
+  std::vector<LocalAggregation> locals_;
+  /** The groups of each partition, and the next one to yield. */
+  std::vector<std::vector<Tuple>> results_;
+  size_t partition_index_{0};
+  size_t result_index_{0};
+  /** Spilled partitions not merged yet, the last one next. */
+  std::vector<SpilledPartition> pending_;
 };
 }  // namespace bustub
@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// gather_executor.h
+//
+// Identification: src/include/execution/executors/gather_executor.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "execution/executors/abstract_executor.h"
+#include "execution/morsel_pipeline.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/**
+ * GatherExecutor is the exchange that runs a pipeline in parallel (see MorselPipeline): it drives each worker of the
+ * pipeline on a thread of its own and merges their output, which it yields in the order of the table, as the pipeline
+ * would run on one thread.
+ *
+ * Workers put the batches of each morsel aside until the consumer reaches that morsel, up to
+ * GATHER_BATCHES_PER_WORKER batches per worker; the worker of the morsel the consumer is reading is never held back.
+ */
+class GatherExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new GatherExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The root of the pipeline
+   * @param pipeline The workers that run the pipeline
+   */
+  GatherExecutor(ExecutorContext *exec_ctx, const AbstractPlanNode *plan, std::unique_ptr<MorselPipeline> pipeline);
+
+  ~GatherExecutor() override;
+
+  /** Initialize the pipeline and start its workers. */
+  void Init() override;
+
+  /**
+   * Yield the next tuple of the pipeline.
+   * @param[out] tuple The next tuple produced by the pipeline
+   * @param[out] rid The next tuple RID produced by the pipeline
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /**
+   * Yield the next batch of tuples of the pipeline.
+   * @param[out] batch The next batch of tuples
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
+  /** @return The output schema of the pipeline */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
+
+  /**
+   * @return the pipeline, for executors that drive its workers themselves; the workers of the gather, if it runs, are
+   * stopped first
+   */
+  auto GetPipeline() -> MorselPipeline *;
+
+ private:
+  /** The batches of a morsel not read yet */
+  struct MorselOutput {
+    std::deque<TupleBatch> batches_;
+    bool finished_{false};
+  };
+
+  /** Run a worker of the pipeline, on a thread of its own. */
+  void RunWorker(size_t worker);
+
+  /** Stop and join the threads of the workers. */
+  void StopWorkers();
+
+  /** Take the next batch in the order of the table, waiting for the workers if need be. */
+  auto PopBatch(TupleBatch *batch) -> bool;
+
+  const AbstractPlanNode *plan_;
+  std::unique_ptr<MorselPipeline> pipeline_;
+  std::vector<std::thread> threads_;
+
+  std::mutex latch_;
+  std::condition_variable cv_;
+  /** The output of the morsels the consumer has not read yet, by morsel */
+  std::map<size_t, MorselOutput> outputs_;
+  /** The morsel the consumer is reading */
+  size_t next_morsel_{0};
+  /** The batches set aside in outputs_ */
+  size_t num_batches_{0};
+  size_t finished_workers_{0};
+  bool stopping_{false};
+  std::exception_ptr error_;
+
+  /** The batch Next is reading, and its next selected row */
+  TupleBatch batch_;
+  size_t next_row_{0};
+};
+
+}  // namespace bustub
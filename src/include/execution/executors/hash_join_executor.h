@@ -13,17 +13,38 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <utility>
+#include <vector>
 
+#include "common/util/hash_util.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/morsel_pipeline.h"
 #include "execution/plans/hash_join_plan.h"
+#include "storage/table/tmp_tuple_file.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * HashJoinExecutor executes a nested-loop JOIN on two tables.
+ * HashJoinExecutor executes a JOIN on two tables with hash tables, in parallel.
+ *
+ * The right child, the build side, is read whole, a batch at a time when vectorized, and its tuples hashed on their
+ * join keys. Worker threads partition it by the low bits of the hashes into partitions of about
+ * HASH_JOIN_PARTITION_ROWS tuples each (radix partitioning), and build an open addressing table over each partition,
+ * small enough to stay in cache. The left child, the probe side, is then streamed through the tables a probe batch at
+ * a time, HASH_JOIN_ROWS_PER_THREAD tuples per thread: each batch is hashed, scattered by the same bits, and its
+ * partitions probed in parallel, so that only the joined tuples of one batch are held at a time. The right side is the
+ * build side so that a left join pads the left tuples that match nothing while probing.
+ *
+ * When the right side outgrows the memory budget of the query (ExecutorContext::GetHashJoinMemory), the join falls
+ * back to a Grace hash join: both sides are written to temp pages (TmpTupleFile), split into partitions by the top
+ * bits of the hashes, the right tuples already in memory included, and the partitions are then joined one pair at a
+ * time as above, as Next asks for more tuples: the tables are built over the right file of a partition, and the left
+ * file streamed through them page by page.
+ * A partition whose right side still does not fit is split again by the next bits, up to HASH_JOIN_MAX_SPILL_DEPTH
+ * times; past that its tuples likely share a key, and it is joined in memory regardless.
  */
 class HashJoinExecutor : public AbstractExecutor {
  public:
@@ -52,8 +73,140 @@ class HashJoinExecutor : public AbstractExecutor {
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
  private:
-  /** The NestedLoopJoin plan node to be executed. */
+  /** A tuple of either side, with its join key. */
+  struct JoinRow {
+    Tuple tuple_;
+    std::vector<Value> keys_;
+    hash_t hash_;
+    /** Keys with a null never equal any other. */
+    bool null_key_;
+  };
+
+  /** The hash of a row and where it is in its side, as partitions keep them. */
+  struct PartitionEntry {
+    hash_t hash_;
+    uint32_t row_;
+  };
+
+  /** The rows of one side, grouped by partition: those of partition p are [offsets_[p], offsets_[p + 1]). */
+  struct PartitionedRows {
+    std::vector<PartitionEntry> entries_;
+    std::vector<size_t> offsets_;
+  };
+
+  /** Both sides of a partition spilled to temp pages, split by the top `depth_` times HASH_JOIN_SPILL_BITS bits. */
+  struct SpilledPartition {
+    std::unique_ptr<TmpTupleFile> left_;
+    std::unique_ptr<TmpTupleFile> right_;
+    uint32_t depth_;
+  };
+
+  /** Reads the tuples of a child with their join keys, a batch at a time if the query is vectorized. */
+  class ChildReader {
+   public:
+    ChildReader(AbstractExecutor *child, const std::vector<AbstractExpressionRef> &key_exprs);
+
+    /** @return whether there was another tuple, read into `row` */
+    auto Next(JoinRow *row) -> bool;
+
+   private:
+    AbstractExecutor *child_;
+    const std::vector<AbstractExpressionRef> &key_exprs_;
+    bool vectorized_;
+    /** The last batch of the child, the join keys of its rows, and the next of its selected rows to read */
+    TupleBatch batch_;
+    std::vector<std::vector<Value>> keys_;
+    size_t next_{0};
+  };
+
+  /** Hash the join key of a tuple. */
+  static auto MakeRow(Tuple &&tuple, const std::vector<AbstractExpressionRef> &key_exprs, const Schema &schema)
+      -> JoinRow;
+
+  /** Hash the join key of a tuple, already evaluated. */
+  static auto MakeRow(Tuple &&tuple, std::vector<Value> keys) -> JoinRow;
+
+  /** @return the memory a row of `tuple_length` bytes of tuple takes, as counted against the budget */
+  auto RowBytes(size_t tuple_length) const -> size_t;
+
+  /**
+   * Read the right side, a parallel pipeline, with its workers into `right_rows`, in the order of the table.
+   * @return false if it does not fit in memory, in which case it is all spilled to `right_files` instead
+   */
+  auto BuildInParallel(MorselPipeline *pipeline, std::vector<JoinRow> *right_rows,
+                       std::vector<std::unique_ptr<TmpTupleFile>> *right_files) -> bool;
+
+  /** @return the spill file of the top HASH_JOIN_SPILL_BITS bits of the hash of a row */
+  static auto SpillFileOf(const JoinRow &row, const std::vector<std::unique_ptr<TmpTupleFile>> &files)
+      -> TmpTupleFile * {
+    return files[row.hash_ >> (64 - HASH_JOIN_SPILL_BITS)].get();
+  }
+
+  /** Read all tuples of a spilled right file with their join keys. */
+  auto ReadRightRows(TmpTupleFile *file) -> std::vector<JoinRow>;
+
+  /** Partition the build side and build the table of each partition. */
+  void Build(std::vector<JoinRow> right_rows);
+
+  /**
+   * Read the next probe batch into probe_rows_, from the left child or the left file of a spilled partition, and join
+   * it. @return false if there was none
+   */
+  auto ProbeNextBatch() -> bool;
+
+  /** @return whether there was another probe row, read into `row` */
+  auto NextProbeRow(JoinRow *row) -> bool;
+
+  /** Join probe_rows_ with the build side, into results_. */
+  void Probe();
+
+  /** @return one empty temp file for each spill partition */
+  auto MakeSpillFiles() -> std::vector<std::unique_ptr<TmpTupleFile>>;
+
+  /** Pair up the spill files of both sides as pending partitions, of the given depth. */
+  void AddSpilledPartitions(std::vector<std::unique_ptr<TmpTupleFile>> left_files,
+                            std::vector<std::unique_ptr<TmpTupleFile>> right_files, uint32_t depth);
+
+  /**
+   * Build the tables over the last pending partition and probe them with its left file from then on, or split it into
+   * more pending partitions if it is too large.
+   */
+  void JoinSpilledPartition();
+
+  /** Partition rows by the low `radix_bits` bits of their hashes, each thread scattering a range of them. */
+  auto Partition(const std::vector<JoinRow> &rows, uint32_t radix_bits, size_t num_threads) -> PartitionedRows;
+
+  /** Build the table of partition `partition` of the build side. */
+  void BuildPartition(size_t partition);
+
+  /** Probe the table of partition `partition` with that partition of the probe batch, into results_[partition]. */
+  void ProbePartition(size_t partition, const PartitionedRows &left);
+
+  /** The HashJoin plan node to be executed. */
   const HashJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  std::unique_ptr<AbstractExecutor> right_executor_;
+  /**
+   * The build side, partitioned by the low radix_bits_ bits of the hashes, and the table of each partition: slots hold
+   * the position of an entry in its partition plus one, 0 if they are free.
+   */
+  std::vector<JoinRow> right_rows_;
+  PartitionedRows right_;
+  std::vector<std::vector<uint32_t>> tables_;
+  uint32_t radix_bits_{0};
+  /** Reads the probe side, nullptr once it was read whole or spilled. */
+  std::unique_ptr<ChildReader> left_reader_;
+  /** The left file of the spilled partition being joined, and its reader, the probe side while there is one. */
+  std::unique_ptr<TmpTupleFile> probe_file_;
+  std::optional<TmpTupleFile::Reader> probe_file_reader_;
+  /** The probe batch being joined. */
+  std::vector<JoinRow> probe_rows_;
+  /** The joined tuples of each partition of the probe batch, and the next one to yield. */
+  std::vector<std::vector<Tuple>> results_;
+  size_t partition_index_{0};
+  size_t result_index_{0};
+  /** Spilled partitions not joined yet, the last one next. */
+  std::vector<SpilledPartition> pending_;
 };
 
 }  // namespace bustub
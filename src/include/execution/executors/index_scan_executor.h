@@ -12,8 +12,10 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
+#include "catalog/catalog.h"
 #include "common/rid.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
@@ -23,7 +25,8 @@
 namespace bustub {
 
 /**
- * IndexScanExecutor executes an index scan over a table.
+ * IndexScanExecutor executes an index scan over a table: it reads the range of keys of the plan from the index, in
+ * the direction of the plan, and fetches the tuples of their RIDs from the table.
  */
 
 class IndexScanExecutor : public AbstractExecutor {
@@ -44,5 +47,8 @@ class IndexScanExecutor : public AbstractExecutor {
  private:
   /** The index scan plan node to be executed. */
   const IndexScanPlanNode *plan_;
+  const IndexInfo *index_info_{nullptr};
+  const TableInfo *table_info_{nullptr};
+  std::unique_ptr<IndexScanCursor> cursor_;
 };
 }  // namespace bustub
@@ -18,6 +18,7 @@
 #include <utility>
 #include <vector>
 
+#include "catalog/catalog.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/expressions/abstract_expression.h"
@@ -28,7 +29,8 @@
 namespace bustub {
 
 /**
- * IndexJoinExecutor executes index join operations.
+ * IndexJoinExecutor executes index join operations. Outer tuples are read INDEX_JOIN_BATCH_SIZE at a time, and their
+ * keys looked up in the index as one batch (see Index::ScanKeys), rather than descending it once per outer tuple.
  */
 class NestIndexJoinExecutor : public AbstractExecutor {
  public:
@@ -48,7 +50,18 @@ class NestIndexJoinExecutor : public AbstractExecutor {
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
  private:
+  /** Read the next batch of outer tuples and join them, filling `batch_`. */
+  void JoinBatch();
+
   /** The nested index join plan node. */
   const NestedIndexJoinPlanNode *plan_;
+  /** The outer table. */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  const IndexInfo *index_info_{nullptr};
+  const TableInfo *table_info_{nullptr};
+  /** Joined tuples of the current batch, and the next one to emit. */
+  std::vector<Tuple> batch_;
+  size_t batch_index_{0};
+  bool child_exhausted_{false};
 };
 }  // namespace bustub
@@ -12,17 +12,25 @@
 
 #pragma once
 
+#include <memory>
+#include <utility>
 #include <vector>
 
+#include "execution/compiled_expression.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "storage/table/table_iterator.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * The SeqScanExecutor executor executes a sequential table scan.
+ * The SeqScanExecutor executor executes a sequential table scan, skipping deleted tuples and those that fail the
+ * predicate pushed down into the scan, if any.
+ *
+ * A morsel-driven scan, one of the workers of a parallel scan (see MorselPipeline), only reads the morsels of the table
+ * it is given with SetMorsel, and ends with each of them.
  */
 class SeqScanExecutor : public AbstractExecutor {
  public:
@@ -30,8 +38,9 @@ class SeqScanExecutor : public AbstractExecutor {
    * Construct a new SeqScanExecutor instance.
    * @param exec_ctx The executor context
    * @param plan The sequential scan plan to be executed
+   * @param morsel_driven Whether the scan reads morsels it is given rather than the whole table
    */
-  SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan);
+  SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan, bool morsel_driven = false);
 
   /** Initialize the sequential scan */
   void Init() override;
@@ -44,11 +53,26 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the sequential scan, the predicate evaluated a batch at a time.
+   * @param[out] batch The next batch of tuples
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
+  /** Scan a morsel of the table next, the last one being exhausted. */
+  void SetMorsel(std::unique_ptr<TableIterator> iter) { iter_ = std::move(iter); }
+
   /** @return The output schema for the sequential scan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
  private:
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
+  bool morsel_driven_;
+  /** The iterator over the table or the current morsel, at the next tuple to read */
+  std::unique_ptr<TableIterator> iter_;
+  /** The filter predicate pushed down to the scan, compiled, if there is one */
+  std::unique_ptr<CompiledExpression> predicate_;
 };
 }  // namespace bustub
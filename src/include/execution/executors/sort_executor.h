@@ -13,18 +13,28 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "common/util/loser_tree.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/sort_plan.h"
+#include "execution/sort_key.h"
+#include "storage/table/tmp_tuple_file.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * The SortExecutor executor executes a sort.
+ * The SortExecutor executor executes a sort, an external merge sort once its input outgrows memory.
+ *
+ * Child tuples are buffered, with their normalized sort keys (see SortKeyEncoder), until they take more than the
+ * memory budget of the query (ExecutorContext::GetSortMemory). A full buffer is sorted and written to temp pages as a
+ * run (TmpTupleFile). Runs are merged SORT_MERGE_FANIN at a time into longer runs, until few enough are left for one
+ * last merge, which Next streams through a loser tree together with the tuples still buffered. An input that fits in
+ * memory is sorted there, and streamed the same way as a single run.
  */
 class SortExecutor : public AbstractExecutor {
  public:
@@ -50,7 +60,53 @@ class SortExecutor : public AbstractExecutor {
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
  private:
+  /** A tuple with its normalized sort key. */
+  struct SortRow {
+    Tuple tuple_;
+    std::string key_;
+  };
+
+  /** A sorted run being merged: either one spilled to temp pages, or the rows still in memory. */
+  struct MergeInput {
+    std::unique_ptr<TmpTupleFile> file_;
+    std::unique_ptr<TmpTupleFile::Reader> reader_;
+    std::vector<SortRow> rows_;
+    size_t next_row_{0};
+    /** The head of the run, valid until the run is exhausted. */
+    SortRow head_;
+  };
+
+  /** Orders merge inputs by their heads. */
+  struct HeadLess {
+    const std::vector<MergeInput> *inputs_;
+    auto operator()(size_t a, size_t b) const -> bool {
+      return (*inputs_)[a].head_.key_ < (*inputs_)[b].head_.key_;
+    }
+  };
+
+  /** Encode the sort key of a tuple. */
+  auto MakeRow(Tuple &&tuple) const -> SortRow;
+
+  /** Sort the buffered rows and write them out as a run. */
+  void SpillRun(std::vector<SortRow> *rows);
+
+  /** Move the head of an input to its next row. @return false if it has none */
+  auto Advance(MergeInput *input) const -> bool;
+
+  /** Start merging the given inputs, in a new loser tree. */
+  void StartMerge(std::vector<MergeInput> inputs);
+
+  /** Merge runs [begin, end) of runs_ into one run, written to temp pages. */
+  auto MergeRuns(size_t begin, size_t end) -> std::unique_ptr<TmpTupleFile>;
+
   /** The sort plan node to be executed */
   const SortPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  SortKeyEncoder encoder_;
+  /** Runs spilled by Init, not merged yet. */
+  std::vector<std::unique_ptr<TmpTupleFile>> runs_;
+  /** The inputs of the merge Next streams, and the tree that picks between them. */
+  std::vector<MergeInput> inputs_;
+  std::unique_ptr<LoserTree<HeadLess>> tree_;
 };
 }  // namespace bustub
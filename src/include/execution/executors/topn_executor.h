@@ -13,6 +13,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -20,12 +21,15 @@
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/topn_plan.h"
+#include "execution/sort_key.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * The TopNExecutor executor executes a topn.
+ * The TopNExecutor executor executes a topn: it keeps the first N tuples seen so far in a max-heap by their normalized
+ * sort keys (see SortKeyEncoder), so each child tuple is compared with the last of them, with a memcmp, and replaces it
+ * if it sorts before it. Equal keys keep the order the child produced them in.
  */
 class TopNExecutor : public AbstractExecutor {
  public:
@@ -61,7 +65,22 @@ class TopNExecutor : public AbstractExecutor {
  private:
   /** The topn plan node to be executed */
   const TopNPlanNode *plan_;
+  /** A tuple kept by the heap: its sort key, then its position in the child's output, to break ties. */
+  struct TopEntry {
+    std::string key_;
+    size_t seq_;
+    Tuple tuple_;
+
+    auto operator<(const TopEntry &other) const -> bool {
+      return key_ != other.key_ ? key_ < other.key_ : seq_ < other.seq_;
+    }
+  };
+
   /** The child executor from which tuples are obtained */
   std::unique_ptr<AbstractExecutor> child_executor_;
+  SortKeyEncoder encoder_;
+  /** A max-heap of the first tuples while Init reads the child, then those tuples in order. */
+  std::vector<TopEntry> top_entries_;
+  size_t next_entry_{0};
 };
 }  // namespace bustub
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "catalog/schema.h"
+#include "execution/tuple_batch.h"
 #include "fmt/format.h"
 #include "storage/table/tuple.h"
 
@@ -54,6 +55,21 @@ class AbstractExpression {
   /** @return The value obtained by evaluating the tuple with the given schema */
   virtual auto Evaluate(const Tuple *tuple, const Schema &schema) const -> Value = 0;
 
+  /**
+   * Evaluates the selected rows of a batch. Expressions evaluate their children a batch at a time too, rather than
+   * every node once per tuple; those that do not override this evaluate each row as a tuple.
+   * @param batch The batch, of the given schema
+   * @param schema The schema of the batch
+   * @param[out] result The value of each selected row, at the index of the row; other rows are left unset
+   */
+  virtual void EvaluateBatch(const TupleBatch &batch, const Schema &schema, std::vector<Value> *result) const {
+    result->resize(batch.NumRows());
+    for (auto row : batch.GetSelection()) {
+      auto tuple = batch.GetTuple(row, schema);
+      (*result)[row] = Evaluate(&tuple, schema);
+    }
+  }
+
   /**
    * Returns the value obtained by evaluating a JOIN.
    * @param left_tuple The left tuple
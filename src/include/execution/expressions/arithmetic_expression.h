@@ -54,6 +54,19 @@ class ArithmeticExpression : public AbstractExpression {
     return ValueFactory::GetIntegerValue(*res);
   }
 
+  void EvaluateBatch(const TupleBatch &batch, const Schema &schema, std::vector<Value> *result) const override {
+    std::vector<Value> lhs;
+    std::vector<Value> rhs;
+    GetChildAt(0)->EvaluateBatch(batch, schema, &lhs);
+    GetChildAt(1)->EvaluateBatch(batch, schema, &rhs);
+    result->resize(batch.NumRows());
+    for (auto row : batch.GetSelection()) {
+      auto res = PerformComputation(lhs[row], rhs[row]);
+      (*result)[row] = res == std::nullopt ? ValueFactory::GetNullValueByType(TypeId::INTEGER)
+                                           : ValueFactory::GetIntegerValue(*res);
+    }
+  }
+
   auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
                     const Schema &right_schema) const -> Value override {
     Value lhs = GetChildAt(0)->EvaluateJoin(left_tuple, left_schema, right_tuple, right_schema);
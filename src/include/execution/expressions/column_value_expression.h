@@ -39,6 +39,14 @@ class ColumnValueExpression : public AbstractExpression {
     return tuple->GetValue(&schema, col_idx_);
   }
 
+  void EvaluateBatch(const TupleBatch &batch, const Schema &schema, std::vector<Value> *result) const override {
+    result->resize(batch.NumRows());
+    const auto &column = batch.GetColumn(col_idx_);
+    for (auto row : batch.GetSelection()) {
+      (*result)[row] = column.GetValue(row);
+    }
+  }
+
   auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
                     const Schema &right_schema) const -> Value override {
     return tuple_idx_ == 0 ? left_tuple->GetValue(&left_schema, col_idx_)
@@ -29,6 +29,13 @@ class ConstantValueExpression : public AbstractExpression {
 
   auto Evaluate(const Tuple *tuple, const Schema &schema) const -> Value override { return val_; }
 
+  void EvaluateBatch(const TupleBatch &batch, const Schema &schema, std::vector<Value> *result) const override {
+    result->resize(batch.NumRows());
+    for (auto row : batch.GetSelection()) {
+      (*result)[row] = val_;
+    }
+  }
+
   auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
                     const Schema &right_schema) const -> Value override {
     return val_;
@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// filter_kernels.h
+//
+// Identification: src/include/execution/filter_kernels.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "execution/expressions/comparison_expression.h"
+#include "type/type_id.h"
+
+namespace bustub {
+
+/** Instruction sets filter kernels can compare columns with. */
+enum class FilterKernel { Scalar, AVX2 };
+
+auto FilterKernelToString(FilterKernel kernel) -> std::string;
+
+/** @return true if this CPU can run the kernel, which tests and benchmarks may call whatever the build targets */
+auto FilterKernelSupported(FilterKernel kernel) -> bool;
+
+/** @return the kernel filters run with: the widest one this CPU supports, checked once */
+auto DefaultFilterKernel() -> FilterKernel;
+
+/** A selection bitmap: bit `row % 64` of word `row / 64` is set if the row is selected. */
+using SelectionBitmap = std::vector<uint64_t>;
+
+/** @return the number of words of a selection bitmap of `num_rows` rows */
+inline auto SelectionBitmapWords(size_t num_rows) -> size_t { return (num_rows + 63) / 64; }
+
+/** The types filter kernels compare, as columns of a TupleBatch store them, their null value included. */
+template <TypeId type>
+struct FilterKernelType;
+template <>
+struct FilterKernelType<TypeId::BOOLEAN> {
+  using Type = int8_t;
+};
+template <>
+struct FilterKernelType<TypeId::INTEGER> {
+  using Type = int32_t;
+};
+template <>
+struct FilterKernelType<TypeId::BIGINT> {
+  using Type = int64_t;
+};
+template <>
+struct FilterKernelType<TypeId::DECIMAL> {
+  using Type = double;
+};
+
+/**
+ * Compare two columns of `num_rows` values row by row. The bit of a row is set if the comparison is true: neither
+ * value is null and they compare as `op` says. Every other bit of the `SelectionBitmapWords(num_rows)` words of the
+ * bitmap is cleared.
+ */
+template <TypeId type>
+void CompareColumns(ComparisonType op, const typename FilterKernelType<type>::Type *lhs,
+                    const typename FilterKernelType<type>::Type *rhs, size_t num_rows, uint64_t *bitmap,
+                    FilterKernel kernel = DefaultFilterKernel());
+
+/** Compare a column of `num_rows` values with a constant, as CompareColumns compares two columns. */
+template <TypeId type>
+void CompareColumnConstant(ComparisonType op, const typename FilterKernelType<type>::Type *lhs,
+                           typename FilterKernelType<type>::Type rhs, size_t num_rows, uint64_t *bitmap,
+                           FilterKernel kernel = DefaultFilterKernel());
+
+/**
+ * Add or subtract two columns of `num_rows` integers row by row, as ArithmeticExpression does: a result is null if
+ * either value is, and wraps around as 32-bit integers do otherwise, to the null integer included.
+ */
+void AddIntegers(const int32_t *lhs, const int32_t *rhs, size_t num_rows, int32_t *result,
+                 FilterKernel kernel = DefaultFilterKernel());
+void SubtractIntegers(const int32_t *lhs, const int32_t *rhs, size_t num_rows, int32_t *result,
+                      FilterKernel kernel = DefaultFilterKernel());
+
+/** @return the comparison that holds for (rhs, lhs) when `op` holds for (lhs, rhs) */
+auto FlipComparison(ComparisonType op) -> ComparisonType;
+
+}  // namespace bustub
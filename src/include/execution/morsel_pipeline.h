@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// morsel_pipeline.h
+//
+// Identification: src/include/execution/morsel_pipeline.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/executors/seq_scan_executor.h"
+#include "execution/plans/abstract_plan.h"
+#include "storage/table/morsel_queue.h"
+
+namespace bustub {
+
+/**
+ * MorselPipeline runs a pipeline, projections and filters over a sequential scan, on several workers at once: each
+ * worker has an instance of the pipeline of its own, whose scan reads the morsels of the table (see MorselQueue) the
+ * worker takes, one after the other. Worker `i` may only be driven by one thread at a time; different workers may run
+ * on different threads.
+ *
+ * The tuples of a worker come morsel by morsel, in the order of the table within a morsel. GatherExecutor merges the
+ * output of all workers back in the order of the table; pipeline breakers that do not need that order (aggregation,
+ * the build side of a hash join) drive the workers themselves instead.
+ */
+class MorselPipeline {
+ public:
+  /**
+   * Instantiate a pipeline for parallel execution.
+   * @return a pipeline of `num_workers` workers, nullptr if `plan` is not a pipeline or if there is a single worker
+   */
+  static auto Make(ExecutorContext *exec_ctx, const AbstractPlanNodeRef &plan, size_t num_workers)
+      -> std::unique_ptr<MorselPipeline>;
+
+  /** Start handing out the morsels of the table anew, and initialize the pipeline of every worker. */
+  void Init();
+
+  /** @return the number of workers */
+  auto NumWorkers() const -> size_t { return workers_.size(); }
+
+  /** @return the pipeline of a worker, which yields the tuples of its current morsel */
+  auto GetWorker(size_t worker) -> AbstractExecutor * { return workers_[worker].get(); }
+
+  /**
+   * Give a worker the next morsel of the table to scan.
+   * @param[out] morsel the number of the morsel
+   * @return `false` if the whole table was handed out
+   */
+  auto NextMorsel(size_t worker, size_t *morsel) -> bool;
+
+  /** Yield the next tuple of a worker, taking morsels as it needs. */
+  auto Next(size_t worker, Tuple *tuple, RID *rid) -> bool;
+
+  /** Yield the next batch of a worker, taking morsels as it needs. */
+  auto NextBatch(size_t worker, TupleBatch *batch) -> bool;
+
+ private:
+  MorselPipeline() = default;
+
+  /** @return an instance of a pipeline, its scan in `scan` */
+  static auto MakeWorker(ExecutorContext *exec_ctx, const AbstractPlanNodeRef &plan, SeqScanExecutor **scan)
+      -> std::unique_ptr<AbstractExecutor>;
+
+  std::unique_ptr<MorselQueue> morsels_;
+  std::vector<std::unique_ptr<AbstractExecutor>> workers_;
+  /** The scan at the bottom of the pipeline of each worker */
+  std::vector<SeqScanExecutor *> scans_;
+};
+
+}  // namespace bustub
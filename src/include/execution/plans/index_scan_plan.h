@@ -12,14 +12,24 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 #include <utility>
 
 #include "catalog/catalog.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
+#include "type/value.h"
 
 namespace bustub {
+
+/** One end of the range of keys an index scan reads: a value of the single key column of the index. */
+struct IndexScanBound {
+  Value value_;
+  /** Whether the range includes the value itself. */
+  bool inclusive_;
+};
+
 /**
  * IndexScanPlanNode identifies a table that should be scanned with an optional predicate.
  */
@@ -28,10 +38,21 @@ class IndexScanPlanNode : public AbstractPlanNode {
   /**
    * Creates a new index scan plan node.
    * @param output the output format of this scan plan node
-   * @param table_oid the identifier of table to be scanned
+   * @param index_oid the identifier of the index to be scanned
+   * @param filter_predicate the predicate the scanned tuples must satisfy, null if none
+   * @param low the lower bound of the keys to scan, none for the first key of the index
+   * @param high the upper bound of the keys to scan, none for the last key of the index
+   * @param reverse whether to scan from larger keys to smaller ones
    */
-  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid)
-      : AbstractPlanNode(std::move(output), {}), index_oid_(index_oid) {}
+  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid, AbstractExpressionRef filter_predicate = nullptr,
+                    std::optional<IndexScanBound> low = std::nullopt, std::optional<IndexScanBound> high = std::nullopt,
+                    bool reverse = false)
+      : AbstractPlanNode(std::move(output), {}),
+        index_oid_(index_oid),
+        filter_predicate_(std::move(filter_predicate)),
+        low_(std::move(low)),
+        high_(std::move(high)),
+        reverse_(reverse) {}
 
   auto GetType() const -> PlanType override { return PlanType::IndexScan; }
 
@@ -43,11 +64,32 @@ class IndexScanPlanNode : public AbstractPlanNode {
   /** The table whose tuples should be scanned. */
   index_oid_t index_oid_;
 
-  // Add anything you want here for index lookup
+  /** The predicate scanned tuples are filtered with, null if none. The range of keys is only a part of it. */
+  AbstractExpressionRef filter_predicate_;
+
+  /** The range of keys to scan, unbounded on the sides without a bound. */
+  std::optional<IndexScanBound> low_;
+  std::optional<IndexScanBound> high_;
+
+  /** Whether tuples come out in descending key order. */
+  bool reverse_;
 
  protected:
   auto PlanNodeToString() const -> std::string override {
-    return fmt::format("IndexScan {{ index_oid={} }}", index_oid_);
+    std::string extra;
+    if (low_.has_value() || high_.has_value()) {
+      extra += fmt::format(", range={}{}, {}{}", low_.has_value() && low_->inclusive_ ? "[" : "(",
+                           low_.has_value() ? low_->value_.ToString() : "-inf",
+                           high_.has_value() ? high_->value_.ToString() : "+inf",
+                           high_.has_value() && high_->inclusive_ ? "]" : ")");
+    }
+    if (reverse_) {
+      extra += ", reverse=true";
+    }
+    if (filter_predicate_) {
+      extra += fmt::format(", filter={}", filter_predicate_);
+    }
+    return fmt::format("IndexScan {{ index_oid={}{} }}", index_oid_, extra);
   }
 };
 
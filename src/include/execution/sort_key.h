@@ -0,0 +1,54 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key.h
+//
+// Identification: src/include/execution/sort_key.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "catalog/schema.h"
+#include "execution/expressions/abstract_expression.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * SortKeyEncoder encodes the ORDER BY columns of a tuple into a normalized sort key: a byte string that compares with
+ * memcmp (or std::string comparison) in the order the tuples sort in. Sort operators encode each tuple once, and then
+ * compare keys without evaluating expressions or dispatching on value types again.
+ *
+ * Each column is a null flag byte, 0 for a null, which sorts nulls before any other value ascending, and the bytes of
+ * the value unless it is null:
+ * - integers big-endian, with the sign bit flipped;
+ * - decimals as their IEEE bits big-endian, negative ones with all bits flipped, positive ones with the sign bit;
+ * - varchars byte by byte, 0x00 escaped as 0x00 0xFF and the end marked by 0x00 0x00, so that a prefix sorts first.
+ * Descending columns have all their bytes flipped, null flag included.
+ */
+class SortKeyEncoder {
+ public:
+  explicit SortKeyEncoder(const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys)
+      : order_bys_(order_bys) {}
+
+  /** @return the sort key of a tuple of the given schema */
+  auto Encode(const Tuple &tuple, const Schema &schema) const -> std::string;
+
+  /** Append the encoding of a value to a sort key, descending or not. */
+  static void EncodeValue(const Value &value, bool descending, std::string *key);
+
+ private:
+  const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,146 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_batch.h
+//
+// Identification: src/include/execution/tuple_batch.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * ColumnVector holds the values of one column of a TupleBatch, serialized as tuples store them, nulls included (as the
+ * null value of their type). Fixed-length values are packed back to back, so that a column of integers is an array of
+ * integers; varchars, their length first, are appended to a buffer and found by their offsets in it.
+ */
+class ColumnVector {
+ public:
+  explicit ColumnVector(TypeId type);
+
+  /** @return the type of the values of the column */
+  auto GetType() const -> TypeId { return type_; }
+
+  /** @return the number of values in the column */
+  auto Size() const -> size_t { return size_; }
+
+  /** @return the value of a row */
+  auto GetValue(size_t row) const -> Value;
+
+  /** Set the value of a row, cast to the type of the column if it is of another type. */
+  void SetValue(size_t row, const Value &value);
+
+  /** Append a value, cast to the type of the column if it is of another type. */
+  void Append(const Value &value);
+
+  /** Remove every value, keeping the memory that held them. */
+  void Clear();
+
+  /** Resize the column to `size` values, new ones left unset. */
+  void Resize(size_t size);
+
+  /** @return the packed values of a column of fixed-length values, of type T */
+  template <typename T>
+  auto GetData() const -> const T * {
+    return reinterpret_cast<const T *>(data_.data());
+  }
+
+ private:
+  friend class TupleBatch;
+  friend class CompiledExpression;
+
+  /** @return the length of a value serialized at `data`, a varchar's length included */
+  auto SerializedLength(const char *data) const -> uint32_t;
+
+  /** Append a value as it is serialized in a tuple. */
+  void AppendData(const char *data);
+
+  /** @return where a row is serialized */
+  auto GetDataPtr(size_t row) const -> const char * {
+    return data_.data() + (width_ == 0 ? offsets_[row] : row * width_);
+  }
+
+  TypeId type_;
+  /** The length of the values of the column, 0 for varchars */
+  uint32_t width_;
+  size_t size_{0};
+  std::vector<char> data_;
+  /** Where each varchar starts in data_ */
+  std::vector<uint32_t> offsets_;
+};
+
+/**
+ * TupleBatch holds up to about BATCH_SIZE tuples of a schema column by column, for executors to produce and consume
+ * tuples a batch at a time (AbstractExecutor::NextBatch) instead of one per virtual call.
+ *
+ * A selection vector lists the rows of the batch that are part of it, in order: a filter drops rows by narrowing the
+ * selection rather than by copying the rows it keeps. Rows outside the selection are only left in place.
+ */
+class TupleBatch {
+ public:
+  TupleBatch() = default;
+
+  /** Empty the batch, and make its columns those of a schema. */
+  void Reset(const Schema &schema);
+
+  /** @return the number of rows in the batch, selected or not */
+  auto NumRows() const -> size_t { return rids_.size(); }
+
+  /** @return the number of selected rows */
+  auto Size() const -> size_t { return selection_.size(); }
+
+  /** @return the selected rows, in order */
+  auto GetSelection() const -> const std::vector<uint32_t> & { return selection_; }
+
+  /** Keep only the selected rows for which a predicate, evaluated for every row, is true. */
+  void Select(const std::vector<Value> &predicate);
+
+  /** Keep only the selected rows whose bit is set in a selection bitmap (bit `row % 64` of word `row / 64`). */
+  void Select(const std::vector<uint64_t> &bitmap);
+
+  /** @return the number of columns */
+  auto GetColumnCount() const -> uint32_t { return columns_.size(); }
+
+  /** @return a column */
+  auto GetColumn(uint32_t col) const -> const ColumnVector & { return columns_[col]; }
+  auto GetColumn(uint32_t col) -> ColumnVector & { return columns_[col]; }
+
+  /** @return the value of a row in a column */
+  auto GetValue(uint32_t row, uint32_t col) const -> Value { return columns_[col].GetValue(row); }
+
+  /** @return the RID of a row, valid if it was read from a table */
+  auto GetRid(uint32_t row) const -> RID { return rids_[row]; }
+
+  /** Append a tuple of the schema of the batch as a selected row. */
+  void AppendTuple(const Tuple &tuple, const Schema &schema, RID rid) { AppendTuple(TupleRef(tuple), schema, rid); }
+  void AppendTuple(const TupleRef &tuple, const Schema &schema, RID rid);
+
+  /** Resize the batch to `num_rows` selected rows, for their columns to be set value by value. */
+  void Resize(size_t num_rows);
+
+  /** Set the RID of a row. */
+  void SetRid(uint32_t row, RID rid) { rids_[row] = rid; }
+
+  /** @return a row as a tuple of the schema of the batch */
+  auto GetTuple(uint32_t row, const Schema &schema) const -> Tuple;
+
+ private:
+  std::vector<ColumnVector> columns_;
+  std::vector<RID> rids_;
+  std::vector<uint32_t> selection_;
+};
+
+}  // namespace bustub
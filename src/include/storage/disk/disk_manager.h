@@ -25,6 +25,9 @@ namespace bustub {
 /**
  * DiskManager takes care of the allocation and deallocation of pages within a database. It performs the reading and
  * writing of pages to and from disk, providing a logical file layer within the context of a database management system.
+ *
+ * Page I/O uses positional pread/pwrite on the database file, so ReadPage and WritePage are safe to call from several
+ * threads at once (see DiskScheduler) and do not serialize on a shared file cursor.
  */
 class DiskManager {
  public:
@@ -37,7 +40,7 @@ class DiskManager {
   /** FOR TEST / LEADERBOARD ONLY, used by DiskManagerMemory */
   DiskManager() = default;
 
-  virtual ~DiskManager() = default;
+  virtual ~DiskManager();
 
   /**
    * Shut down the disk manager and close all the file resources.
@@ -48,15 +51,17 @@ class DiskManager {
    * Write a page to the database file.
    * @param page_id id of the page
    * @param page_data raw page data
+   * @return false if the page could not be written in full
    */
-  virtual void WritePage(page_id_t page_id, const char *page_data);
+  virtual auto WritePage(page_id_t page_id, const char *page_data) -> bool;
 
   /**
    * Read a page from the database file.
    * @param page_id id of the page
    * @param[out] page_data output buffer
+   * @return false if the page could not be read; a page past the end of the file reads as zeros
    */
-  virtual void ReadPage(page_id_t page_id, char *page_data);
+  virtual auto ReadPage(page_id_t page_id, char *page_data) -> bool;
 
   /**
    * Flush the entire log buffer into disk.
@@ -97,14 +102,14 @@ class DiskManager {
   // stream to write log file
   std::fstream log_io_;
   std::string log_name_;
-  // stream to write db file
-  std::fstream db_io_;
+  // descriptor of the db file, accessed with positional I/O only
+  int db_fd_{-1};
   std::string file_name_;
   int num_flushes_{0};
-  int num_writes_{0};
+  std::atomic<int> num_writes_{0};
   bool flush_log_{false};
   std::future<void> *flush_log_f_{nullptr};
-  // With multiple buffer pool instances, need to protect file access
+  // Protects opening and closing the db file; page reads and writes do not need it
   std::mutex db_io_latch_;
 };
 
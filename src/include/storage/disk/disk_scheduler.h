@@ -0,0 +1,118 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// disk_scheduler.h
+//
+// Identification: src/include/storage/disk/disk_scheduler.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <future>  // NOLINT
+#include <memory>
+#include <optional>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/channel.h"
+#include "common/config.h"
+#include "common/macros.h"
+#include "storage/disk/disk_manager.h"
+
+namespace bustub {
+
+/**
+ * @brief Represents a Write or Read request for the DiskManager to execute.
+ */
+struct DiskRequest {
+  /** Flag indicating whether the request is a write or a read. */
+  bool is_write_;
+
+  /**
+   *  Pointer to the start of the memory location where a page is either:
+   *   1. being read into from disk (on a read).
+   *   2. being written out to disk (on a write).
+   */
+  char *data_;
+
+  /** ID of the page being read from / written to disk. */
+  page_id_t page_id_;
+
+  /** Callback used to signal to the request issuer when the request has been completed, with false if it failed. */
+  std::promise<bool> callback_;
+};
+
+/**
+ * @brief The DiskScheduler schedules disk read and write operations.
+ *
+ * A request is scheduled by calling DiskScheduler::Schedule() with an appropriate DiskRequest object. The scheduler
+ * maintains a pool of background worker threads that process the scheduled requests using the disk manager, so the
+ * issuer can keep working (or issue more requests) and wait on the returned future only when it needs the result.
+ *
+ * Each worker owns its own queue and requests are routed to a worker by page id. All requests for the same page are
+ * therefore executed in the order they were scheduled, while requests for different pages proceed in parallel.
+ */
+class DiskScheduler {
+ public:
+  explicit DiskScheduler(DiskManager *disk_manager, size_t num_workers = DISK_SCHEDULER_WORKERS);
+  ~DiskScheduler();
+
+  DISALLOW_COPY_AND_MOVE(DiskScheduler);
+
+  /**
+   * @brief Schedules a request for the DiskManager to execute.
+   *
+   * @param r The request to be scheduled.
+   */
+  void Schedule(DiskRequest r);
+
+  /**
+   * @brief Schedules several requests at once. Requests for the same page keep their relative order.
+   *
+   * @param requests The requests to be scheduled.
+   */
+  void ScheduleBatch(std::vector<DiskRequest> requests);
+
+  /** @brief Convenience wrapper that schedules a read of page_id into data and returns its completion future. */
+  auto ScheduleRead(page_id_t page_id, char *data) -> std::future<bool>;
+
+  /** @brief Convenience wrapper that schedules a write of data to page_id and returns its completion future. */
+  auto ScheduleWrite(page_id_t page_id, const char *data) -> std::future<bool>;
+
+  /**
+   * @brief Create a Promise object. If you want to implement your own version of promise, you can change this function
+   * so that our test cases can use your promise implementation.
+   *
+   * @return std::promise<bool>
+   */
+  using DiskSchedulerPromise = std::promise<bool>;
+  auto CreatePromise() -> DiskSchedulerPromise { return {}; };
+
+  /** @return the number of background workers */
+  auto GetNumWorkers() const -> size_t { return workers_.size(); }
+
+ private:
+  /** A background worker and the queue it drains. */
+  struct Worker {
+    /** Queue of requests; std::nullopt asks the worker to exit. */
+    Channel<std::optional<DiskRequest>> request_queue_;
+    std::optional<std::thread> thread_;
+  };
+
+  /** @brief Body of a worker thread: process requests until a std::nullopt is received. */
+  void StartWorkerThread(Worker *worker);
+
+  auto WorkerOf(page_id_t page_id) -> Worker & {
+    return *workers_[static_cast<size_t>(page_id) % workers_.size()];
+  }
+
+  /** Pointer to the disk manager. */
+  DiskManager *disk_manager_ __attribute__((__unused__));
+  std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+}  // namespace bustub
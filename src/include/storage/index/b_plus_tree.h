@@ -11,7 +11,9 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <deque>
+#include <functional>
 #include <iostream>
 #include <optional>
 #include <queue>
@@ -56,6 +58,18 @@ class Context {
   auto IsRootPage(page_id_t page_id) -> bool { return page_id == root_page_id_; }
 };
 
+/** How concurrent operations on a BPlusTree synchronize with each other. */
+enum class BPlusTreeLatchMode {
+  /** Every operation latches its way down from the root, releasing the ancestors of a page once it is safe. */
+  Crabbing = 0,
+  /**
+   * Optimistic lock coupling: lookups descend without latching anything, checking the version of every page they read
+   * instead and restarting when one changed under them. Inserts and removals latch only the leaf, and fall back to
+   * crabbing when the leaf has to split or merge.
+   */
+  Optimistic
+};
+
 #define BPLUSTREE_TYPE BPlusTree<KeyType, ValueType, KeyComparator>
 
 // Main class providing the API for the Interactive B+ Tree.
@@ -67,7 +81,12 @@ class BPlusTree {
  public:
   explicit BPlusTree(std::string name, page_id_t header_page_id, BufferPoolManager *buffer_pool_manager,
                      const KeyComparator &comparator, int leaf_max_size = LEAF_PAGE_SIZE,
-                     int internal_max_size = INTERNAL_PAGE_SIZE);
+                     int internal_max_size = INTERNAL_PAGE_SIZE,
+                     BPlusTreeLatchMode latch_mode = BPlusTreeLatchMode::Crabbing);
+
+  ~BPlusTree();
+
+  DISALLOW_COPY_AND_MOVE(BPlusTree);
 
   // Returns true if this B+ tree has no keys and values.
   auto IsEmpty() const -> bool;
@@ -81,9 +100,38 @@ class BPlusTree {
   // Return the value associated with a given key
   auto GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *txn = nullptr) -> bool;
 
+  /**
+   * Look up many keys in one left-to-right pass: a key that is not past the last key of the leaf the previous one
+   * landed on is searched in that leaf, still latched, and only the others descend from the root again.
+   * @param keys the keys to look up, in ascending order
+   * @param results set to the values of each key, at the position of the key
+   */
+  void GetValues(const std::vector<KeyType> &keys, std::vector<std::vector<ValueType>> *results,
+                 Transaction *txn = nullptr);
+
+  /**
+   * Build the tree bottom-up from entries in strictly ascending key order, which is much faster than inserting them one
+   * by one: the leaves are filled left to right, then each level of internal pages is built over the one below it. The
+   * tree must not be used concurrently while it is being loaded.
+   * @param next writes the next entry and returns true, or returns false once the input is exhausted
+   * @param fill_factor fraction of each page to fill, leaving room for later inserts; pages are never filled below
+   * their min size
+   * @return false if the tree is not empty. Throws if the keys are not strictly ascending.
+   */
+  auto BulkLoad(const std::function<bool(MappingType *)> &next, double fill_factor = BULK_LOAD_FILL_FACTOR) -> bool;
+
+  /**
+   * Bulk load sorted entries with several threads: each builds the subtree over a contiguous range of the entries, then
+   * the subtrees are linked together and the levels above them built.
+   */
+  auto BulkLoadParallel(const std::vector<MappingType> &entries, size_t num_threads,
+                        double fill_factor = BULK_LOAD_FILL_FACTOR) -> bool;
+
   // Return the page id of the root node
   auto GetRootPageId() -> page_id_t;
 
+  auto GetLatchMode() const -> BPlusTreeLatchMode { return latch_mode_; }
+
   // Index iterator
   auto Begin() -> INDEXITERATOR_TYPE;
 
@@ -91,6 +139,19 @@ class BPlusTree {
 
   auto Begin(const KeyType &key) -> INDEXITERATOR_TYPE;
 
+  /** Iterate over every key in descending order. */
+  auto RBegin() -> INDEXITERATOR_TYPE;
+
+  /**
+   * Iterate over the keys between two bounds, in ascending order, or descending if `reverse`. The iterator ends at the
+   * first key past the range, without reading further.
+   * @param low the smallest key of the range, null if it has none
+   * @param high the largest key of the range, null if it has none
+   * @param low_inclusive, high_inclusive whether the range includes the bounds themselves
+   */
+  auto Range(const KeyType *low, bool low_inclusive, const KeyType *high, bool high_inclusive, bool reverse = false)
+      -> INDEXITERATOR_TYPE;
+
   // Print the B+ tree
   void Print(BufferPoolManager *bpm);
 
@@ -117,6 +178,9 @@ class BPlusTree {
   void RemoveFromFile(const std::string &file_name, Transaction *txn = nullptr);
 
  private:
+  /** Iterators descend the tree again when a backward step races with a writer. */
+  friend class IndexIterator<KeyType, ValueType, KeyComparator>;
+
   /* Debug Routines for FREE!! */
   void ToGraph(page_id_t page_id, const BPlusTreePage *page, std::ofstream &out);
 
@@ -130,6 +194,116 @@ class BPlusTree {
    */
   auto ToPrintableBPlusTree(page_id_t root_id) -> PrintableBPlusTree;
 
+  enum class Operation { Search, Insert, Remove };
+
+  /** Outcome of an operation attempted with the leaf latch only. */
+  enum class OptimisticResult {
+    /** The operation is complete. */
+    Done,
+    /** A page changed during the attempt, which can be retried. */
+    Restart,
+    /** The operation changes the structure of the tree and has to be done by crabbing. */
+    Escalate
+  };
+
+  /** A leaf reached without latching anything, and the version it was read at. */
+  struct OptimisticLeaf {
+    Page *page_{nullptr};
+    uint64_t version_{0};
+    /** False for the root, which the tree keeps pinned. */
+    bool pinned_{false};
+  };
+
+  /** Latch-free attempts of an operation before it falls back to crabbing. */
+  static constexpr int OPTIMISTIC_ATTEMPTS = 16;
+  /** Retries, 10us apart, of a fetch that finds every frame of the buffer pool pinned. */
+  static constexpr int FRAME_WAIT_ATTEMPTS = 100000;
+
+  /**
+   * Descend to the leaf that may contain the key without latching, validating the version of every page on the way.
+   * Leaves leaf->page_ null if the tree is empty.
+   * @return false if a page changed during the descent
+   */
+  auto DescendOptimistic(const KeyType &key, OptimisticLeaf *leaf) -> bool;
+
+  /**
+   * Binary search the keys in [left, right) of a page read without a latch, for the first key greater than the input
+   * key if upper is set, not less than it otherwise. Each key is copied out and validated before being compared, so
+   * the comparator never sees a key torn by a concurrent writer, unless the page compares torn keys safely.
+   * @return false if the page changed during the search
+   */
+  template <typename NodePage>
+  auto SearchOptimistic(Page *page, uint64_t version, const KeyType &key, int left, int right, bool upper,
+                        int *index) -> bool;
+
+  auto GetValueOptimistic(const KeyType &key, std::vector<ValueType> *result, bool *found) -> bool;
+  auto InsertOptimistic(const KeyType &key, const ValueType &value, bool *inserted) -> OptimisticResult;
+  auto RemoveOptimistic(const KeyType &key) -> OptimisticResult;
+
+  /** Write latch a leaf reached by DescendOptimistic and pin it; fails if it changed since it was read. */
+  auto LatchOptimisticLeaf(OptimisticLeaf *leaf) -> bool;
+  void ReleaseOptimisticLeaf(const OptimisticLeaf &leaf, bool is_dirty);
+
+  /**
+   * Read latch the leaf that may contain the key, or the leftmost leaf if key is null, the rightmost one if `rightmost`
+   * as well; nullopt for an empty tree.
+   */
+  auto FindLeafRead(const KeyType *key, bool rightmost = false) -> std::optional<ReadPageGuard>;
+
+  /**
+   * Write latch the path from the root to the leaf that may contain the key, keeping only the pages the operation
+   * may modify: the write set ends with the leaf, and the header stays latched only if the root may change.
+   */
+  void FindLeafWrite(const KeyType &key, Operation op, Context *ctx);
+
+  /** @return true if the operation cannot propagate a split or a merge from the page to its parent */
+  auto IsSafe(const BPlusTreePage *page, Operation op, bool is_root) const -> bool;
+
+  /** Insert the separator and the right page of a split of the last page of the write set into its parent. */
+  void InsertIntoParent(Context *ctx, const KeyType &key, page_id_t right_page_id);
+
+  /** Fix the last page of the write set if it is too small, merging pages bottom-up and collecting the dropped ones. */
+  void HandleUnderflow(Context *ctx, std::vector<page_id_t> *deleted_pages);
+
+  /**
+   * The pages of a level built by a bulk load, each with its separator from the page before it: a key greater than
+   * every key of that page and not greater than any of its own. The first page has its smallest key.
+   */
+  using LevelEntries = std::vector<std::pair<KeyType, page_id_t>>;
+
+  /** A bulk load thread gets at least this many leaves' worth of entries. */
+  static constexpr int BULK_LOAD_MIN_LEAVES_PER_THREAD = 64;
+
+  /** @return how many entries a bulk load puts in a page, given the fill factor and the bounds of the page size */
+  static auto FillSize(double fill_factor, int min_size, int capacity) -> int;
+
+  /**
+   * @return how many pages a bulk load spreads n entries over: as few as possible holding at most `fill` entries each,
+   * but never so many that a page gets fewer than min_size
+   */
+  static auto PageCount(int n, int fill, int min_size) -> int;
+
+  /**
+   * Fill leaves left to right from the input, appending them to `leaves`. Throws if the input is not sorted, leaving
+   * the leaves built so far in `leaves`.
+   */
+  void BuildLeaves(const std::function<bool(MappingType *)> &next, double fill_factor, LevelEntries *leaves);
+
+  /** Build the level of internal pages over the given pages, spreading them evenly as far as their bytes allow. */
+  auto BuildInternalLevel(const LevelEntries &children, double fill_factor) -> LevelEntries;
+
+  /** Build the levels above the given one up to a single root, and point the header at it. */
+  void FinishBulkLoad(WritePageGuard *header, LevelEntries level, double fill_factor);
+
+  /** Point the header at a new root, and keep that root pinned for latch-free readers. */
+  void SetRootPage(BPlusTreeHeaderPage *header, page_id_t root_page_id);
+
+  /** Pin a page, waiting for a frame if every frame of the buffer pool is pinned. Throws if none frees up. */
+  auto PinPage(page_id_t page_id) -> Page *;
+  auto FetchRead(page_id_t page_id) -> ReadPageGuard;
+  auto FetchWrite(page_id_t page_id) -> WritePageGuard;
+  auto NewWrite(page_id_t *page_id) -> WritePageGuard;
+
   // member variable
   std::string index_name_;
   BufferPoolManager *bpm_;
@@ -138,6 +312,9 @@ class BPlusTree {
   int leaf_max_size_;
   int internal_max_size_;
   page_id_t header_page_id_;
+  BPlusTreeLatchMode latch_mode_;
+  /** In optimistic mode, the root page. It stays pinned while it is the root, so readers need not pin it. */
+  std::atomic<Page *> root_page_{nullptr};
 };
 
 /**
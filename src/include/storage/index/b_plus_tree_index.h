@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "container/hash/hash_function.h"
@@ -35,6 +36,25 @@ class BPlusTreeIndex : public Index {
 
   void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
 
+  /** Sorts the keys, then looks them all up in one pass over the tree (see BPlusTree::GetValues). */
+  void ScanKeys(const std::vector<Tuple> &keys, std::vector<std::vector<RID>> *results,
+                Transaction *transaction) override;
+
+  /**
+   * Reads the range a batch of entries at a time, each batch from a fresh descent of the tree that resumes after the
+   * last key of the one before. The cursor never keeps a leaf latched between calls, so whoever consumes it may modify
+   * the index meanwhile.
+   */
+  auto ScanRange(const IndexScanRange &range, Transaction *transaction) -> std::unique_ptr<IndexScanCursor> override;
+
+  /**
+   * Fill an empty index with the given entries, sorting them and bulk loading the tree. Of several entries with the
+   * same key only the first is kept, as if they had been inserted in order.
+   * @param num_threads threads building the tree, fewer if there are too few entries to keep them busy
+   * @return false if the index is not empty
+   */
+  auto BulkLoad(std::vector<std::pair<KeyType, ValueType>> entries, size_t num_threads) -> bool;
+
   auto GetBeginIterator() -> INDEXITERATOR_TYPE;
 
   auto GetBeginIterator(const KeyType &key) -> INDEXITERATOR_TYPE;
@@ -39,6 +39,9 @@ class ExtendibleHashTableIndex : public Index {
 
   void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
 
+  /** Hash tables keep no order: the range must be a single key, which is looked up like ScanKey does. */
+  auto ScanRange(const IndexScanRange &range, Transaction *transaction) -> std::unique_ptr<IndexScanCursor> override;
+
  protected:
   // comparator for key
   KeyComparator comparator_;
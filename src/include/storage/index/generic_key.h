@@ -12,8 +12,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstring>
 
+#include "common/exception.h"
 #include "storage/table/tuple.h"
 #include "type/value.h"
 
@@ -30,6 +32,9 @@ template <size_t KeySize>
 class GenericKey {
  public:
   inline void SetFromKey(const Tuple &tuple) {
+    if (tuple.GetLength() > KeySize) {
+      throw Exception(ExceptionType::OUT_OF_RANGE, "the key does not fit in the key type of the index");
+    }
     // intialize to 0
     memset(data_, 0, KeySize);
     memcpy(data_, tuple.GetData(), tuple.GetLength());
@@ -94,13 +99,67 @@ class GenericComparator {
     return 0;
   }
 
-  GenericComparator(const GenericComparator &other) : key_schema_{other.key_schema_} {}
+  /**
+   * Suffix truncation: find a separator between two keys, lhs < rhs, that is as short as possible once the zero bytes
+   * padding it are dropped, so that B+ tree internal pages hold more of them. It is rhs with as many of its trailing
+   * bytes zeroed as the order allows. The offsets and lengths of VARCHAR columns are kept, for the key to still decode.
+   * @return a key greater than lhs and not greater than rhs
+   */
+  inline auto FindShortestSeparator(const GenericKey<KeySize> &lhs, const GenericKey<KeySize> &rhs) const
+      -> GenericKey<KeySize> {
+    size_t keep = 0;
+    for (auto column_idx : key_schema_->GetUnlinedColumns()) {
+      uint32_t column_offset = key_schema_->GetColumn(column_idx).GetOffset();
+      uint32_t offset;
+      memcpy(&offset, rhs.data_ + column_offset, sizeof(uint32_t));
+      keep = std::max<size_t>(keep, std::max<size_t>(column_offset, offset) + sizeof(uint32_t));
+    }
+
+    GenericKey<KeySize> separator = rhs;
+    size_t min_size = std::min(keep, KeySize);
+    for (size_t size = min_size; size < KeySize; size++) {
+      if (size > min_size && rhs.data_[size - 1] == 0) {
+        // Same candidate as the previous, shorter one.
+        continue;
+      }
+      memset(separator.data_ + size, 0, KeySize - size);
+      if ((*this)(lhs, separator) < 0 && (*this)(separator, rhs) <= 0) {
+        return separator;
+      }
+      memcpy(separator.data_ + size, rhs.data_ + size, KeySize - size);
+    }
+    return rhs;
+  }
+
+  /**
+   * Keys of a single signed integer column order like the 64-bit integers their first 8 bytes make once shifted left,
+   * which lets B+ tree pages search them without decoding values.
+   * @return the shift, or -1 if the keys are not of a single integer column
+   */
+  inline auto GetIntegerShift() const -> int { return integer_shift_; }
+
+  GenericComparator(const GenericComparator &other)
+      : key_schema_{other.key_schema_}, integer_shift_{other.integer_shift_} {}
 
   // constructor
-  explicit GenericComparator(Schema *key_schema) : key_schema_(key_schema) {}
+  explicit GenericComparator(Schema *key_schema) : key_schema_(key_schema) {
+    if (KeySize >= sizeof(int64_t) && key_schema_->GetColumnCount() == 1) {
+      switch (key_schema_->GetColumn(0).GetType()) {
+        case TypeId::TINYINT:
+        case TypeId::SMALLINT:
+        case TypeId::INTEGER:
+        case TypeId::BIGINT:
+          integer_shift_ = 64 - 8 * static_cast<int>(key_schema_->GetColumn(0).GetFixedLength());
+          break;
+        default:
+          break;
+      }
+    }
+  }
 
  private:
   Schema *key_schema_;
+  int integer_shift_{-1};
 };
 
 }  // namespace bustub
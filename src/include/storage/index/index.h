@@ -13,11 +13,13 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "catalog/schema.h"
+#include "common/exception.h"
 #include "storage/table/tuple.h"
 #include "type/value.h"
 
@@ -96,6 +98,26 @@ class IndexMetadata {
   std::shared_ptr<Schema> key_schema_;
 };
 
+/** The keys an index range scan reads: those between two optional bounds, in ascending order or descending. */
+struct IndexScanRange {
+  /** The smallest key of the range, none if it is unbounded below. */
+  std::optional<Tuple> low_;
+  bool low_inclusive_{true};
+  /** The largest key of the range, none if it is unbounded above. */
+  std::optional<Tuple> high_;
+  bool high_inclusive_{true};
+  bool reverse_{false};
+};
+
+/** The entries of an index range scan, produced one at a time. */
+class IndexScanCursor {
+ public:
+  virtual ~IndexScanCursor() = default;
+
+  /** @return false once the range is exhausted, otherwise true with the RID of the next entry */
+  virtual auto Next(RID *rid) -> bool = 0;
+};
+
 /////////////////////////////////////////////////////////////////////
 // Index class definition
 /////////////////////////////////////////////////////////////////////
@@ -176,6 +198,32 @@ class Index {
    */
   virtual void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) = 0;
 
+  /**
+   * Search the index for each of the provided keys. Indexes that can resolve a batch of keys faster than one at a
+   * time override it; by default each key is searched with ScanKey.
+   * @param keys The index keys, in any order
+   * @param results Set to the RIDs of each key, at the position of the key
+   * @param transaction The transaction context
+   */
+  virtual void ScanKeys(const std::vector<Tuple> &keys, std::vector<std::vector<RID>> *results,
+                        Transaction *transaction) {
+    results->assign(keys.size(), {});
+    for (size_t i = 0; i < keys.size(); i++) {
+      ScanKey(keys[i], &(*results)[i], transaction);
+    }
+  }
+
+  /**
+   * Scan the entries whose keys are within a range, in key order. Only ordered indexes support range scans; the
+   * others throw.
+   * @param range The bounds of the keys and the direction of the scan
+   * @param transaction The transaction context
+   * @return The entries of the range
+   */
+  virtual auto ScanRange(const IndexScanRange &range, Transaction *transaction) -> std::unique_ptr<IndexScanCursor> {
+    throw NotImplementedException("index does not support range scans");
+  }
+
  private:
   /** The Index structure owns its metadata */
   std::unique_ptr<IndexMetadata> metadata_;
@@ -13,31 +13,90 @@
  * For range scan of b+ tree
  */
 #pragma once
+#include <optional>
+#include <utility>
+
 #include "storage/page/b_plus_tree_leaf_page.h"
+#include "storage/page/page_guard.h"
 
 namespace bustub {
 
+INDEX_TEMPLATE_ARGUMENTS
+class BPlusTree;
+
 #define INDEXITERATOR_TYPE IndexIterator<KeyType, ValueType, KeyComparator>
 
+/**
+ * Walks the keys of a B+ tree within a range, from left to right along the leaf level, or from right to left.
+ *
+ * The iterator keeps its current leaf read latched. Forward, it latches the next leaf before releasing the current
+ * one, like every other traversal of the leaf chain. Backward, that would latch leaves right to left and deadlock with
+ * the traversals going the other way, so it releases the current leaf first, and checks that the left sibling still
+ * points back to it once latched. If the sibling split or merged meanwhile, the iterator descends from the root again
+ * to find its place, by the last key it returned.
+ */
 INDEX_TEMPLATE_ARGUMENTS
 class IndexIterator {
+  using LeafPage = BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>;
+  using Tree = BPlusTree<KeyType, ValueType, KeyComparator>;
+
  public:
-  // you may define your own constructor based on your member variables
+  /** Construct the end iterator. */
   IndexIterator();
+  /**
+   * Construct an iterator at the first key of a range, in the direction of the iterator.
+   * @param low the smallest key of the range, null if it has none
+   * @param high the largest key of the range, null if it has none
+   * @param low_inclusive, high_inclusive whether the range includes the bounds themselves
+   * @param reverse whether the iterator moves from larger keys to smaller ones
+   */
+  IndexIterator(Tree *tree, const KeyType *low, bool low_inclusive, const KeyType *high, bool high_inclusive,
+                bool reverse);
   ~IndexIterator();  // NOLINT
 
+  IndexIterator(IndexIterator &&that) noexcept = default;
+  auto operator=(IndexIterator &&that) noexcept -> IndexIterator & = default;
+
   auto IsEnd() -> bool;
 
+  /** The pair is decoded from the leaf, and stays valid until the iterator moves. */
   auto operator*() -> const MappingType &;
 
   auto operator++() -> IndexIterator &;
 
-  auto operator==(const IndexIterator &itr) const -> bool { throw std::runtime_error("unimplemented"); }
+  auto operator==(const IndexIterator &itr) const -> bool {
+    return page_id_ == itr.page_id_ && index_ == itr.index_;
+  }
 
-  auto operator!=(const IndexIterator &itr) const -> bool { throw std::runtime_error("unimplemented"); }
+  auto operator!=(const IndexIterator &itr) const -> bool { return !(*this == itr); }
 
  private:
-  // add your own private member variables here
+  /** Descend to the leaf of the first key left in the range, in the direction of the iterator. */
+  void Seek();
+
+  /** Move to the first pair of the next non-empty leaf if the index is past the end of the current one. */
+  void SkipExhaustedLeaves();
+
+  /** Move to the last pair of the previous non-empty leaf if the index is before the start of the current one. */
+  void SkipExhaustedLeavesBackward();
+
+  /** Become the end iterator if the current key is past the end of the range. */
+  void CheckEnd();
+
+  void SetEnd();
+
+  Tree *tree_{nullptr};
+  ReadPageGuard guard_;
+  /** The current leaf, INVALID_PAGE_ID at the end. */
+  page_id_t page_id_{INVALID_PAGE_ID};
+  int index_{0};
+  MappingType entry_;
+  std::optional<KeyType> low_;
+  bool low_inclusive_{true};
+  /** Going backward, lowered to each key as the iterator moves past it, so that Seek resumes after it. */
+  std::optional<KeyType> high_;
+  bool high_inclusive_{true};
+  bool reverse_{false};
 };
 
 }  // namespace bustub
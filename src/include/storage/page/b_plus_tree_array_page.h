@@ -0,0 +1,173 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_array_page.h
+//
+// Identification: src/include/storage/page/b_plus_tree_array_page.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "storage/page/b_plus_tree_key_search.h"
+#include "storage/page/b_plus_tree_page.h"
+#include "storage/page/b_plus_tree_slotted_page.h"
+
+namespace bustub {
+
+/**
+ * Entries of B+ tree pages of integer keys are stored in two arrays, keys apart from values, so that a search reads
+ * nothing but keys, a few vectors of them at once (see SearchIntegerKeys).
+ *
+ * Page format, below the header of the page kind:
+ *  ----------------------------------------------------------------------------------------
+ * | padding | KEY(0) | KEY(1) | ... | KEY(capacity-1) | VALUE(0) | ... | VALUE(capacity-1) |
+ *  ----------------------------------------------------------------------------------------
+ *
+ * Keys start at the first 8-byte aligned offset after the header. Both arrays are sized for as many entries as fit in
+ * the page, which may be fewer than the max size of the page.
+ */
+template <typename KeyType, typename ValueType>
+class BPlusTreeArrayPage : public BPlusTreePage {
+  static_assert(sizeof(KeyType) == sizeof(int64_t), "integer keys are 8 bytes");
+
+ public:
+  using Entry = std::pair<KeyType, ValueType>;
+
+  /**
+   * Keys are 8 bytes of inlined values, which compare whatever their bytes: a search racing with a writer returns
+   * a wrong index at worst, which the reader catches by validating the page afterwards.
+   */
+  static constexpr bool SEARCH_TOLERATES_RACES = true;
+
+  // Delete all constructor / destructor to ensure memory safety
+  BPlusTreeArrayPage() = delete;
+  BPlusTreeArrayPage(const BPlusTreeArrayPage &other) = delete;
+
+  /** Readers that do not latch the page may see its entries change under them, but never read outside of it. */
+  auto KeyAt(int index) const -> KeyType;
+  auto ValueAt(int index) const -> ValueType;
+  void SetValueAt(int index, const ValueType &value);
+
+  /**
+   * Insert an entry at the given index, shifting the later entries right.
+   * @return false, leaving the page unchanged, if the page has no room for one more entry
+   */
+  auto InsertAt(int index, const KeyType &key, const ValueType &value) -> bool;
+
+  /** Remove the entry at the given index, shifting the later entries left. */
+  void RemoveAt(int index);
+
+  /** @return true, keys all take the same room */
+  auto SetKeyAt(int index, const KeyType &key) -> bool;
+
+  /** @return the entries of the page */
+  auto GetEntries() const -> std::vector<Entry>;
+
+  /**
+   * Replace the entries of the page with entries [begin, end) of the vector.
+   * @return false, leaving the page unchanged, if they do not fit
+   */
+  auto Assign(const std::vector<Entry> &entries, size_t begin, size_t end) -> bool;
+
+  /** @return the bytes used by the entries */
+  auto GetUsedBytes() const -> int { return GetSize() * ENTRY_SIZE; }
+
+  /** @return the bytes the page can store entries in */
+  auto GetCapacity() const -> int { return capacity_ * ENTRY_SIZE; }
+
+  /** @return the most entries the page keeps before it splits */
+  auto GetMaxEntries() const -> int { return IsLeafPage() ? GetMaxSize() - 1 : GetMaxSize(); }
+
+  /** See BPlusTreeSlottedPage::IsUnderflow, whose pages hold entries by their bytes as well. */
+  auto IsUnderflow() const -> bool { return GetSize() < GetMinSize() && GetUsedBytes() < GetCapacity() / 4; }
+
+  /** @return true if one more entry fits */
+  auto IsSafeToInsert() const -> bool { return GetSize() < capacity_; }
+
+  /** @return true if removing any one entry does not make the page underflow */
+  auto IsSafeToRemove() const -> bool {
+    return GetSize() - 1 >= GetMinSize() || GetUsedBytes() - ENTRY_SIZE >= GetCapacity() / 4;
+  }
+
+  /** @return true if removing the entry at the given index does not make the page underflow */
+  auto CanRemoveAt(int index) const -> bool { return IsSafeToRemove(); }
+
+  /**
+   * @return where to split entries between two pages of this kind: the index of the first entry of the right page,
+   * halfway through them. -1 if they cannot both fit.
+   */
+  auto SplitPoint(const std::vector<Entry> &entries) const -> int;
+
+  /**
+   * Keys of a single integer column are searched by SearchIntegerKeys, others by a binary search with the comparator.
+   * @return the index of the first key in [begin, end) that is not less than the key, or greater than it if `upper`;
+   * end if there is none
+   */
+  template <typename KeyComparator>
+  auto SearchKey(const KeyType &key, const KeyComparator &comparator, int begin, int end, bool upper) const -> int {
+    // A reader racing with a writer may see any size, the search stays within the page.
+    end = std::min(end, static_cast<int>((BUSTUB_PAGE_SIZE - keys_offset_) / sizeof(KeyType)));
+    const char *keys = reinterpret_cast<const char *>(this) + keys_offset_;
+    int shift = comparator.GetIntegerShift();
+    if (shift >= 0) {
+      return SearchIntegerKeys(keys, begin, end, NormalizeIntegerKey(reinterpret_cast<const char *>(&key), shift),
+                               shift, upper);
+    }
+    int left = begin;
+    int right = end;
+    while (left < right) {
+      int mid = left + (right - left) / 2;
+      KeyType mid_key;
+      memcpy(&mid_key, keys + mid * sizeof(KeyType), sizeof(KeyType));
+      int cmp = comparator(mid_key, key);
+      if (cmp < 0 || (upper && cmp == 0)) {
+        left = mid + 1;
+      } else {
+        right = mid;
+      }
+    }
+    return left;
+  }
+
+ protected:
+  /** Set up an empty page whose entries start after `header_size` bytes of header. */
+  void InitEntries(int header_size);
+
+ private:
+  static constexpr int ENTRY_SIZE = sizeof(KeyType) + sizeof(ValueType);
+
+  auto Bytes() const -> const char * { return reinterpret_cast<const char *>(this); }
+  auto Bytes() -> char * { return reinterpret_cast<char *>(this); }
+
+  /** Offset of the first key from the start of the page. */
+  uint16_t keys_offset_;
+  /** Offset of the first value from the start of the page. */
+  uint16_t values_offset_;
+  /** Entries the arrays have room for. */
+  int32_t capacity_;
+};
+
+/**
+ * The layout entries of B+ tree pages are stored in: an array for integer keys, which are never worth compressing and
+ * are searched faster without decoding, slots with prefix compressed keys for the others.
+ */
+template <typename KeyType, typename ValueType>
+struct BPlusTreeEntryLayout {
+  using Type = BPlusTreeSlottedPage<KeyType, ValueType>;
+};
+
+template <typename ValueType>
+struct BPlusTreeEntryLayout<GenericKey<8>, ValueType> {
+  using Type = BPlusTreeArrayPage<GenericKey<8>, ValueType>;
+};
+
+}  // namespace bustub
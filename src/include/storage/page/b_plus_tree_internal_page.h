@@ -12,29 +12,32 @@
 
 #include <queue>
 #include <string>
+#include <utility>
 
-#include "storage/page/b_plus_tree_page.h"
+#include "storage/page/b_plus_tree_array_page.h"
 
 namespace bustub {
 
 #define B_PLUS_TREE_INTERNAL_PAGE_TYPE BPlusTreeInternalPage<KeyType, ValueType, KeyComparator>
-#define INTERNAL_PAGE_HEADER_SIZE 12
-#define INTERNAL_PAGE_SIZE ((BUSTUB_PAGE_SIZE - INTERNAL_PAGE_HEADER_SIZE) / (sizeof(MappingType)))
+#define INTERNAL_PAGE_HEADER_SIZE 20
+#define INTERNAL_PAGE_SIZE ((BUSTUB_PAGE_SIZE - INTERNAL_PAGE_HEADER_SIZE) / (sizeof(page_id_t) + 4))
 /**
  * Store n indexed keys and n+1 child pointers (page_id) within internal page.
  * Pointer PAGE_ID(i) points to a subtree in which all keys K satisfy:
  * K(i) <= K < K(i+1).
  * NOTE: since the number of keys does not equal to number of child pointers,
  * the first key always remains invalid. That is to say, any search/lookup
- * should ignore the first key.
+ * should ignore the first key. Pages of prefix compressed keys do not store it,
+ * and read it as zeroes.
  *
- * Internal page format (keys are stored in increasing order):
+ * Internal page format (keys are stored in increasing order, see BPlusTreeSlottedPage,
+ * or BPlusTreeArrayPage for integer keys):
  *  --------------------------------------------------------------------------
- * | HEADER | KEY(1)+PAGE_ID(1) | KEY(2)+PAGE_ID(2) | ... | KEY(n)+PAGE_ID(n) |
+ * | HEADER | SLOT(1) | ... | SLOT(n) | free space | SUFFIXES | PREFIX |
  *  --------------------------------------------------------------------------
  */
 INDEX_TEMPLATE_ARGUMENTS
-class BPlusTreeInternalPage : public BPlusTreePage {
+class BPlusTreeInternalPage : public BPlusTreeEntryLayout<KeyType, ValueType>::Type {
  public:
   // Deleted to disallow initialization
   BPlusTreeInternalPage() = delete;
@@ -47,19 +50,6 @@ class BPlusTreeInternalPage : public BPlusTreePage {
    */
   void Init(int max_size = INTERNAL_PAGE_SIZE);
 
-  /**
-   * @param index The index of the key to get. Index must be non-zero.
-   * @return Key at index
-   */
-  auto KeyAt(int index) const -> KeyType;
-
-  /**
-   *
-   * @param index The index of the key to set. Index must be non-zero.
-   * @param key The new value for key
-   */
-  void SetKeyAt(int index, const KeyType &key);
-
   /**
    *
    * @param value the value to search for
@@ -67,11 +57,11 @@ class BPlusTreeInternalPage : public BPlusTreePage {
   auto ValueIndex(const ValueType &value) const -> int;
 
   /**
-   *
-   * @param index the index
-   * @return the value at the index
+   * @param key the key to search for
+   * @param comparator the comparator of the keys
+   * @return the index of the child whose subtree may contain the key
    */
-  auto ValueAt(int index) const -> ValueType;
+  auto ChildIndex(const KeyType &key, const KeyComparator &comparator) const -> int;
 
   /**
    * @brief For test only, return a string representing all keys in
@@ -84,8 +74,8 @@ class BPlusTreeInternalPage : public BPlusTreePage {
     bool first = true;
 
     // first key of internal page is always invalid
-    for (int i = 1; i < GetSize(); i++) {
-      KeyType key = KeyAt(i);
+    for (int i = 1; i < this->GetSize(); i++) {
+      KeyType key = this->KeyAt(i);
       if (first) {
         first = false;
       } else {
@@ -98,9 +88,5 @@ class BPlusTreeInternalPage : public BPlusTreePage {
 
     return kstr;
   }
-
- private:
-  // Flexible array member for page data.
-  MappingType array_[0];
 };
 }  // namespace bustub
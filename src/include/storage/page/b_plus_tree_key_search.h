@@ -0,0 +1,51 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_key_search.h
+//
+// Identification: src/include/storage/page/b_plus_tree_key_search.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace bustub {
+
+/** Instruction sets B+ tree pages can search their integer keys with. */
+enum class KeySearchKernel { Scalar, SSE42, AVX2 };
+
+auto KeySearchKernelToString(KeySearchKernel kernel) -> std::string;
+
+/** @return true if this CPU can run the kernel, which tests and benchmarks may call whatever the build targets */
+auto KeySearchKernelSupported(KeySearchKernel kernel) -> bool;
+
+/** @return the kernel pages search with: the widest one this CPU supports, checked once */
+auto DefaultKeySearchKernel() -> KeySearchKernel;
+
+/** @return the first 8 bytes of an integer key, shifted left so that they order like the key */
+inline auto NormalizeIntegerKey(const char *key, int shift) -> int64_t {
+  uint64_t bits;
+  memcpy(&bits, key, sizeof(bits));
+  return static_cast<int64_t>(bits << shift);
+}
+
+/**
+ * Search integer keys stored contiguously, 8 bytes each, in ascending order once normalized. Binary search narrows
+ * the range down to a few vectors of keys, which are then compared to the key all at once.
+ * @param keys the first of the keys
+ * @param key the key to search for, normalized
+ * @param shift the shift that normalizes the stored keys, see NormalizeIntegerKey
+ * @return the index of the first key in [begin, end) that is not less than the key, or greater than it if `upper`;
+ * end if there is none
+ */
+auto SearchIntegerKeys(const char *keys, int begin, int end, int64_t key, int shift, bool upper,
+                       KeySearchKernel kernel = DefaultKeySearchKernel()) -> int;
+
+}  // namespace bustub
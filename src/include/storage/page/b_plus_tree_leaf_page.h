@@ -14,34 +14,38 @@
 #include <utility>
 #include <vector>
 
-#include "storage/page/b_plus_tree_page.h"
+#include "storage/page/b_plus_tree_array_page.h"
 
 namespace bustub {
 
 #define B_PLUS_TREE_LEAF_PAGE_TYPE BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>
-#define LEAF_PAGE_HEADER_SIZE 16
-#define LEAF_PAGE_SIZE ((BUSTUB_PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / sizeof(MappingType))
+#define LEAF_PAGE_HEADER_SIZE 28
+#define LEAF_PAGE_SIZE ((BUSTUB_PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / (sizeof(ValueType) + 4))
 
 /**
  * Store indexed key and record id(record id = page id combined with slot id,
  * see include/common/rid.h for detailed implementation) together within leaf
  * page. Only support unique key.
  *
- * Leaf page format (keys are stored in order):
+ * Leaf page format (keys are stored in order, see BPlusTreeSlottedPage, or
+ * BPlusTreeArrayPage for integer keys):
  *  ----------------------------------------------------------------------
- * | HEADER | KEY(1) + RID(1) | KEY(2) + RID(2) | ... | KEY(n) + RID(n)
+ * | HEADER | SLOT(1) | ... | SLOT(n) | free space | SUFFIXES | PREFIX |
  *  ----------------------------------------------------------------------
  *
- *  Header format (size in byte, 16 bytes in total):
+ *  Header format (size in byte, 28 bytes in total):
  *  ---------------------------------------------------------------------
  * | PageType (4) | CurrentSize (4) | MaxSize (4) |
  *  ---------------------------------------------------------------------
+ *  ---------------------------------------------------------------------
+ * | SlotsOffset (2) | PrefixSize (2) | HeapBegin (2) | GarbageSize (2) |
+ *  ---------------------------------------------------------------------
  *  -----------------------------------------------
- * |  NextPageId (4)
+ * |  NextPageId (4) | PrevPageId (4)
  *  -----------------------------------------------
  */
 INDEX_TEMPLATE_ARGUMENTS
-class BPlusTreeLeafPage : public BPlusTreePage {
+class BPlusTreeLeafPage : public BPlusTreeEntryLayout<KeyType, ValueType>::Type {
  public:
   // Delete all constructor / destructor to ensure memory safety
   BPlusTreeLeafPage() = delete;
@@ -57,7 +61,15 @@ class BPlusTreeLeafPage : public BPlusTreePage {
   // helper methods
   auto GetNextPageId() const -> page_id_t;
   void SetNextPageId(page_id_t next_page_id);
-  auto KeyAt(int index) const -> KeyType;
+  auto GetPrevPageId() const -> page_id_t;
+  void SetPrevPageId(page_id_t prev_page_id);
+
+  /**
+   * @param key the key to search for
+   * @param comparator the comparator of the keys
+   * @return the index of the first key that is not less than the input key, the size of the page if there is none
+   */
+  auto KeyIndex(const KeyType &key, const KeyComparator &comparator) const -> int;
 
   /**
    * @brief for test only return a string representing all keys in
@@ -69,8 +81,8 @@ class BPlusTreeLeafPage : public BPlusTreePage {
     std::string kstr = "(";
     bool first = true;
 
-    for (int i = 0; i < GetSize(); i++) {
-      KeyType key = KeyAt(i);
+    for (int i = 0; i < this->GetSize(); i++) {
+      KeyType key = this->KeyAt(i);
       if (first) {
         first = false;
       } else {
@@ -86,7 +98,10 @@ class BPlusTreeLeafPage : public BPlusTreePage {
 
  private:
   page_id_t next_page_id_;
-  // Flexible array member for page data.
-  MappingType array_[0];
+  /**
+   * The left sibling, which backward iteration steps to. Leaves are latched left to right, so a reader must release
+   * the leaf before latching its left sibling, and check that the sibling still points back to it.
+   */
+  page_id_t prev_page_id_;
 };
 }  // namespace bustub
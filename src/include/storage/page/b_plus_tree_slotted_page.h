@@ -0,0 +1,207 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_slotted_page.h
+//
+// Identification: src/include/storage/page/b_plus_tree_slotted_page.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "storage/page/b_plus_tree_page.h"
+
+namespace bustub {
+
+/**
+ * Entries of B+ tree pages are stored in slots, with their keys prefix compressed: the bytes that every key of the
+ * page starts with are stored once, and each slot only points to the rest of its key, without the zero bytes that pad
+ * it. A page holds as many entries as fit in its bytes, up to its max size, so short or similar keys raise the fanout
+ * of the tree, and long fixed-size keys such as those of VARCHAR columns only cost what they actually use.
+ *
+ * Page format, below the header of the page kind:
+ *  -------------------------------------------------------------------------------------------
+ * | SLOT(0) | SLOT(1) | ... | SLOT(n-1) | free space ... | SUFFIX(i) | ... | SUFFIX(j) | PREFIX |
+ *  -------------------------------------------------------------------------------------------
+ *
+ *  Slot format (size in byte, sizeof(ValueType) + 4 in total):
+ *  ----------------------------------------------------
+ * | Value | SuffixOffset (2) | SuffixSize (2) |
+ *  ----------------------------------------------------
+ *
+ * Suffixes are allocated from the end of the page. Those of removed entries are only reclaimed when the page runs out
+ * of contiguous free space and is rewritten. A key that does not start with the prefix shortens it, which rewrites the
+ * page as well.
+ *
+ * Internal pages ignore their first key, which is not stored.
+ */
+template <typename KeyType, typename ValueType>
+class BPlusTreeSlottedPage : public BPlusTreePage {
+ public:
+  using Entry = std::pair<KeyType, ValueType>;
+
+  /** Keys decoded from bytes torn by a concurrent writer may not be fit to compare: readers validate each one first. */
+  static constexpr bool SEARCH_TOLERATES_RACES = false;
+
+  // Delete all constructor / destructor to ensure memory safety
+  BPlusTreeSlottedPage() = delete;
+  BPlusTreeSlottedPage(const BPlusTreeSlottedPage &other) = delete;
+
+  /**
+   * Readers that do not latch the page may see its slots change under them. Key bytes are then only ever read from
+   * within the page, and such readers must validate the key before using it.
+   */
+  auto KeyAt(int index) const -> KeyType;
+  auto ValueAt(int index) const -> ValueType;
+  void SetValueAt(int index, const ValueType &value);
+
+  /**
+   * Insert an entry at the given index, shifting the later entries right. Internal pages only take an entry at index
+   * 0 when they are empty.
+   * @return false, leaving the page unchanged, if the entry does not fit in the bytes of the page
+   */
+  auto InsertAt(int index, const KeyType &key, const ValueType &value) -> bool;
+
+  /** Remove the entry at the given index, shifting the later entries left. */
+  void RemoveAt(int index);
+
+  /** @return false, leaving the page unchanged, if the page has no room for the new key */
+  auto SetKeyAt(int index, const KeyType &key) -> bool;
+
+  /** @return the entries of the page, decoded */
+  auto GetEntries() const -> std::vector<Entry>;
+
+  /**
+   * Replace the entries of the page with entries [begin, end) of the vector, recomputing the prefix.
+   * @return false, leaving the page unchanged, if they do not fit
+   */
+  auto Assign(const std::vector<Entry> &entries, size_t begin, size_t end) -> bool;
+
+  /** @return the bytes used by the slots, the prefix and the suffixes of the live entries */
+  auto GetUsedBytes() const -> int;
+
+  /** @return the bytes the page can store entries in */
+  auto GetCapacity() const -> int { return BUSTUB_PAGE_SIZE - slots_offset_; }
+
+  auto GetPrefixSize() const -> int { return prefix_size_; }
+
+  /** @return the most entries the page keeps before it splits */
+  auto GetMaxEntries() const -> int { return IsLeafPage() ? GetMaxSize() - 1 : GetMaxSize(); }
+
+  /**
+   * A page underflows when it is below its min size both in entries and in bytes: a page of large keys holds far
+   * fewer entries than its max size allows and is still full.
+   */
+  auto IsUnderflow() const -> bool;
+
+  /** @return true if one more entry fits whatever its key, and whatever prefix it leaves the page with */
+  auto IsSafeToInsert() const -> bool;
+
+  /** @return true if removing any one entry does not make the page underflow */
+  auto IsSafeToRemove() const -> bool;
+
+  /** @return true if removing the entry at the given index does not make the page underflow */
+  auto CanRemoveAt(int index) const -> bool;
+
+  /**
+   * @return where to split entries between two pages of this kind: the index of the first entry of the right page,
+   * chosen so that both pages fit and are as evenly filled as possible. -1 if they cannot both fit.
+   */
+  auto SplitPoint(const std::vector<Entry> &entries) const -> int;
+
+  /**
+   * Binary search with the comparator.
+   * @return the index of the first key in [begin, end) that is not less than the key, or greater than it if `upper`;
+   * end if there is none
+   */
+  template <typename KeyComparator>
+  auto SearchKey(const KeyType &key, const KeyComparator &comparator, int begin, int end, bool upper) const -> int {
+    int left = begin;
+    int right = end;
+    while (left < right) {
+      int mid = left + (right - left) / 2;
+      int cmp = comparator(KeyAt(mid), key);
+      if (cmp < 0 || (upper && cmp == 0)) {
+        left = mid + 1;
+      } else {
+        right = mid;
+      }
+    }
+    return left;
+  }
+
+ protected:
+  /** Set up an empty page whose slots start `header_size` bytes into the page. */
+  void InitEntries(int header_size);
+
+ private:
+  struct Slot {
+    ValueType value_;
+    uint16_t offset_;
+    uint16_t size_;
+  };
+
+  /** Computes the bytes a page takes to hold a growing set of entries, in any order. */
+  class SizeCounter {
+   public:
+    SizeCounter() : key_sizes_(sizeof(KeyType) + 1) {}
+
+    void AddSlot() { num_slots_++; }
+    void AddKey(const KeyType &key);
+    auto GetPrefixSize() const -> int { return num_keys_ == 0 ? 0 : std::min(common_size_, max_key_size_); }
+    auto GetBytes() const -> int;
+
+   private:
+    int num_slots_{0};
+    int num_keys_{0};
+    KeyType first_key_;
+    /** How many keys there are of each size. */
+    std::vector<int> key_sizes_;
+    /** Length of the prefix all the keys share. */
+    int common_size_{0};
+    int max_key_size_{0};
+  };
+
+  auto Slots() const -> const Slot * {
+    return reinterpret_cast<const Slot *>(reinterpret_cast<const char *>(this) + slots_offset_);
+  }
+  auto Slots() -> Slot * { return reinterpret_cast<Slot *>(reinterpret_cast<char *>(this) + slots_offset_); }
+  auto Bytes() const -> const char * { return reinterpret_cast<const char *>(this); }
+  auto Bytes() -> char * { return reinterpret_cast<char *>(this); }
+
+  /** @return true if the key at the given index is stored, i.e. it is not the first key of an internal page */
+  auto StoresKey(int index) const -> bool { return index > 0 || IsLeafPage(); }
+  auto GetNumKeys() const -> int { return IsLeafPage() ? GetSize() : std::max(GetSize() - 1, 0); }
+  /** @return the contiguous bytes between the slots and the suffixes */
+  auto GetFreeSpace() const -> int {
+    return heap_begin_ - slots_offset_ - GetSize() * static_cast<int>(sizeof(Slot));
+  }
+  /** @return the length of the prefix of the page the key starts with */
+  auto MatchPrefix(const KeyType &key) const -> int;
+
+  /** Rewrite the page with the given entries, which must fit. */
+  void Write(const std::vector<Entry> &entries, size_t begin, size_t end, int prefix_size);
+
+  /** @return the size of a key without the zero bytes that pad it */
+  static auto KeySize(const KeyType &key) -> int;
+  static auto CommonPrefixSize(const char *lhs, const char *rhs, int limit) -> int;
+
+  /** Offset of the first slot from the start of the page. */
+  uint16_t slots_offset_;
+  /** Length of the prefix every stored key starts with. */
+  uint16_t prefix_size_;
+  /** Offset of the lowest allocated suffix byte from the start of the page. */
+  uint16_t heap_begin_;
+  /** Bytes of the suffixes of removed entries, still allocated. */
+  uint16_t garbage_size_;
+};
+
+}  // namespace bustub
@@ -85,6 +85,11 @@ class TablePage {
    */
   auto GetTuple(const RID &rid) const -> std::pair<TupleMeta, Tuple>;
 
+  /**
+   * Read a tuple from a table in place, valid for as long as the page stays pinned and latched.
+   */
+  auto GetTupleRef(const RID &rid) const -> std::pair<TupleMeta, TupleRef>;
+
   /**
    * Read a tuple meta from a table.
    */
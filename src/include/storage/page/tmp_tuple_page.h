@@ -1,16 +1,19 @@
 #pragma once
 
-#include "storage/page/page.h"
+#include <vector>
+
+#include "common/config.h"
 #include "storage/table/tmp_tuple.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
-// To pass the test cases for this class, you must follow the existing TmpTuplePage format and implement the
-// existing functions exactly as they are! It may be helpful to look at TablePage.
-// Remember that this task is optional, you get full credit if you finish the next task.
+static constexpr size_t TMP_TUPLE_PAGE_HEADER_SIZE = 12;
 
 /**
+ * TmpTuplePage holds tuples an operator writes out of memory, e.g. the partitions of a hash join that does not fit in
+ * its memory budget, until it reads them back. Tuples are only ever appended, and read back whole.
+ *
  * TmpTuplePage format:
  *
  * Sizes are in bytes.
@@ -18,19 +21,48 @@ namespace bustub {
  *
  * We choose this format because DeserializeExpression expects to read Size followed by Data.
  */
-class TmpTuplePage : public Page {
+class TmpTuplePage {
  public:
-  void Init(page_id_t page_id, uint32_t page_size) {
-    memcpy(GetData(), &page_id, sizeof(page_id_t));
-    memcpy(GetData() + sizeof(page_id_t), &page_size, sizeof(uint32_t));
-  }
+  // Delete all constructor / destructor to ensure memory safety
+  TmpTuplePage() = delete;
+  TmpTuplePage(const TmpTuplePage &other) = delete;
+
+  /** Set up an empty page of `page_size` bytes. */
+  void Init(page_id_t page_id, uint32_t page_size);
+
+  /** @return the page id of this page */
+  auto GetTablePageId() const -> page_id_t { return page_id_; }
+
+  /**
+   * Append a tuple to the page.
+   * @param[out] out where the tuple is stored
+   * @return false, leaving the page unchanged, if the tuple does not fit
+   */
+  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool;
 
-  auto GetTablePageId() -> page_id_t { return INVALID_PAGE_ID; }
+  /** @return the tuple stored at the offset of a TmpTuple of this page */
+  auto Get(size_t offset) const -> Tuple;
 
-  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool { return false; }
+  /** @return the offsets of the tuples of the page, in the order they were inserted */
+  auto GetTupleOffsets() const -> std::vector<size_t>;
+
+  /** @return true if a page holds a tuple of this size, alone */
+  static auto Fits(const Tuple &tuple) -> bool {
+    return TMP_TUPLE_PAGE_HEADER_SIZE + sizeof(uint32_t) + tuple.GetLength() <= BUSTUB_PAGE_SIZE;
+  }
 
  private:
   static_assert(sizeof(page_id_t) == 4);
+  static_assert(sizeof(lsn_t) == 4);
+
+  auto Bytes() const -> const char * { return reinterpret_cast<const char *>(this); }
+
+  page_id_t page_id_;
+  lsn_t lsn_;
+  /** Offset of the last inserted tuple, the end of the free space. */
+  uint32_t free_space_;
 };
 
+static_assert(sizeof(TmpTuplePage) == TMP_TUPLE_PAGE_HEADER_SIZE);
+
 }  // namespace bustub
@@ -0,0 +1,58 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// morsel_queue.h
+//
+// Identification: src/include/storage/table/morsel_queue.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <mutex>  // NOLINT
+
+#include "common/config.h"
+#include "common/rid.h"
+#include "storage/table/table_iterator.h"
+
+namespace bustub {
+
+class TableHeap;
+
+/**
+ * MorselQueue splits a scan of a TableHeap into morsels of MORSEL_PAGES consecutive pages of its chain, handed out in
+ * order to the threads scanning the table in parallel, each as a TableIterator over its pages. Like
+ * TableHeap::MakeIterator, the scan ends at the tuples the table had when the queue was reset.
+ *
+ * Morsels are numbered from 0 in the order of the chain, so that their tuples can be put back in that order.
+ */
+class MorselQueue {
+ public:
+  explicit MorselQueue(TableHeap *table_heap) : table_heap_(table_heap) {}
+
+  /** Start handing out the morsels of the table anew. */
+  void Reset();
+
+  /**
+   * Take the next morsel, thread-safe.
+   * @param[out] morsel the number of the morsel
+   * @return an iterator over the tuples of the morsel, nullptr if the whole table was handed out
+   */
+  auto Next(size_t *morsel) -> std::unique_ptr<TableIterator>;
+
+ private:
+  TableHeap *table_heap_;
+  /** The last tuple of the scan, past which it stops */
+  RID stop_at_rid_;
+
+  std::mutex latch_;
+  /** The first page of the next morsel, INVALID_PAGE_ID once the whole table was handed out */
+  page_id_t next_page_id_{INVALID_PAGE_ID};
+  size_t next_morsel_{0};
+};
+
+}  // namespace bustub
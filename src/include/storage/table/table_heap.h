@@ -32,6 +32,7 @@ namespace bustub {
  * This is just a doubly-linked list of pages.
  */
 class TableHeap {
+  friend class MorselQueue;
   friend class TableIterator;
 
  public:
@@ -19,14 +19,24 @@
 #include "common/macros.h"
 #include "common/rid.h"
 #include "concurrency/transaction.h"
+#include "storage/page/page_guard.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 class TableHeap;
+class TablePage;
 
 /**
  * TableIterator enables the sequential scan of a TableHeap.
+ *
+ * Once the iterator has moved across a couple of pages it assumes it is running a sequential scan and asks the buffer
+ * pool to read the following pages of the heap chain ahead (see BufferPoolManager::ReadAhead). A new batch is
+ * requested whenever less than half of the previous window is left in front of the cursor.
+ *
+ * GetTupleRef reads tuples in place: the iterator keeps the page under the cursor pinned and read-latched until the
+ * cursor leaves it or DropPage is called, so that a scan latches each page once rather than once per tuple. Callers
+ * must drop the page before anything may write to the table, their own query included.
  */
 class TableIterator {
   friend class Cursor;
@@ -41,6 +51,12 @@ class TableIterator {
 
   auto GetTuple() -> std::pair<TupleMeta, Tuple>;
 
+  /** @return the tuple under the cursor, read in place: valid until the cursor leaves its page, or DropPage */
+  auto GetTupleRef() -> std::pair<TupleMeta, TupleRef>;
+
+  /** Unpin and unlatch the page GetTupleRef keeps, if any. */
+  void DropPage();
+
   auto GetRID() -> RID;
 
   auto IsEnd() -> bool;
@@ -55,6 +71,18 @@ class TableIterator {
   // Otherwise we will have dead loops when updating while scanning. (In project 4, update should be implemented as
   // deletion + insertion.)
   RID stop_at_rid_;
+
+  /** Number of page boundaries crossed so far. */
+  size_t pages_crossed_{0};
+  /** Number of pages that have been requested for read-ahead and are still in front of the cursor. */
+  size_t read_ahead_remaining_{0};
+
+  /** The page under the cursor, pinned and latched by GetTupleRef, if page_id_ is valid */
+  ReadPageGuard page_guard_;
+  page_id_t page_id_{INVALID_PAGE_ID};
+
+  /** @brief Called when the cursor moves to a new page; issues read-ahead if the scan looks sequential. */
+  void MaybeReadAhead(page_id_t page_id);
 };
 
 }  // namespace bustub
@@ -4,8 +4,10 @@
 
 namespace bustub {
 
-// Document this class! What does it represent?
-
+/**
+ * TmpTuple is where a tuple written to a TmpTuplePage is: the page, and the offset of the tuple in it. It is to temp
+ * pages what a RID is to table pages.
+ */
 class TmpTuple {
  public:
   TmpTuple(page_id_t page_id, size_t offset) : page_id_(page_id), offset_(offset) {}
@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_file.h
+//
+// Identification: src/include/storage/table/tmp_tuple_file.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/macros.h"
+#include "storage/page/page_guard.h"
+#include "storage/page/tmp_tuple_page.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * TmpTupleFile is a sequence of tuples an operator spills out of memory, on TmpTuplePages of the buffer pool, which
+ * writes them to disk as it needs their frames. Tuples are appended, then read back in the same order, as often as
+ * needed. Only the page being appended to stays pinned; the pages are deleted with the file.
+ *
+ * A file is used by one thread at a time.
+ */
+class TmpTupleFile {
+ public:
+  explicit TmpTupleFile(BufferPoolManager *bpm) : bpm_(bpm) {}
+  ~TmpTupleFile();
+
+  DISALLOW_COPY_AND_MOVE(TmpTupleFile);
+
+  /**
+   * Append a tuple to the file.
+   * @return where the tuple is stored
+   * @throws ExecutionException if the tuple does not fit in a page, or the buffer pool has no frame for a new page
+   */
+  auto Append(const Tuple &tuple) -> TmpTuple;
+
+  /** Unpin the page being appended to, once the file is complete. Nothing is appended to the file after it. */
+  void Finish();
+
+  /** @return the number of tuples in the file */
+  auto GetNumTuples() const -> size_t { return num_tuples_; }
+
+  /** @return the bytes of the tuples of the file */
+  auto GetTupleBytes() const -> size_t { return tuple_bytes_; }
+
+  /** Reads the tuples of a file in the order they were appended, pinning one page at a time. */
+  class Reader {
+   public:
+    explicit Reader(TmpTupleFile *file) : file_(file) {}
+
+    /** @return false once every tuple was read */
+    auto Next(Tuple *tuple) -> bool;
+
+   private:
+    TmpTupleFile *file_;
+    /** The next page to read. */
+    size_t page_index_{0};
+    BasicPageGuard guard_;
+    std::vector<size_t> offsets_;
+    size_t offset_index_{0};
+  };
+
+  /** @return a reader of the file from its first tuple, finishing the file */
+  auto Read() -> Reader;
+
+ private:
+  BufferPoolManager *bpm_;
+  std::vector<page_id_t> page_ids_;
+  /** The last page of the file, pinned while tuples are appended to it. */
+  BasicPageGuard tail_;
+  size_t num_tuples_{0};
+  size_t tuple_bytes_{0};
+  bool finished_{false};
+};
+
+}  // namespace bustub
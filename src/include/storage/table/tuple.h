@@ -52,6 +52,8 @@ class Tuple {
   friend class TablePage;
   friend class TableHeap;
   friend class TableIterator;
+  friend class TupleBatch;
+  friend class TupleRef;
 
  public:
   // Default constructor (to create a dummy tuple)
@@ -83,6 +85,9 @@ class Tuple {
   // return RID of current tuple
   inline auto GetRid() const -> RID { return rid_; }
 
+  // set RID of current tuple
+  inline void SetRid(RID rid) { rid_ = rid; }
+
   // Get the address of this tuple in the table's backing store
   inline auto GetData() const -> const char * { return data_.data(); }
 
@@ -112,4 +117,36 @@ class Tuple {
   std::vector<char> data_;
 };
 
+/**
+ * TupleRef is a view of a tuple serialized elsewhere, usually in a table page pinned and latched by whoever hands it
+ * out (see TableIterator::GetTupleRef). Columns are read in place; ToTuple copies the tuple if it must outlive the
+ * view.
+ */
+class TupleRef {
+ public:
+  TupleRef() = default;
+  TupleRef(const char *data, uint32_t length, RID rid) : data_(data), length_(length), rid_(rid) {}
+  explicit TupleRef(const Tuple &tuple) : data_(tuple.GetData()), length_(tuple.GetLength()), rid_(tuple.GetRid()) {}
+
+  inline auto GetRid() const -> RID { return rid_; }
+
+  inline auto GetData() const -> const char * { return data_; }
+
+  inline auto GetLength() const -> uint32_t { return length_; }
+
+  // Get the value of a specified column, deserialized from the tuple in place
+  auto GetValue(const Schema *schema, uint32_t column_idx) const -> Value;
+
+  // Get the starting storage address of specific column
+  auto GetDataPtr(const Schema *schema, uint32_t column_idx) const -> const char *;
+
+  // Copy the tuple into one of its own
+  auto ToTuple() const -> Tuple;
+
+ private:
+  const char *data_{nullptr};
+  uint32_t length_{0};
+  RID rid_{};
+};
+
 }  // namespace bustub
@@ -1,6 +1,13 @@
 #include <memory>
+#include <optional>
+#include <utility>
 #include <vector>
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
 #include "execution/plans/filter_plan.h"
+#include "execution/plans/index_scan_plan.h"
 #include "execution/plans/limit_plan.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/sort_plan.h"
@@ -34,4 +41,165 @@ auto Optimizer::OptimizeMergeFilterScan(const AbstractPlanNodeRef &plan) -> Abst
   return optimized_plan;
 }
 
+namespace {
+
+void SplitConjuncts(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *conjuncts) {
+  const auto *logic_expr = dynamic_cast<const LogicExpression *>(expr.get());
+  if (logic_expr != nullptr && logic_expr->logic_type_ == LogicType::And) {
+    SplitConjuncts(logic_expr->GetChildAt(0), conjuncts);
+    SplitConjuncts(logic_expr->GetChildAt(1), conjuncts);
+    return;
+  }
+  conjuncts->push_back(expr);
+}
+
+/**
+ * Convert a constant to the type of a key column, if the key built from it compares with the keys of the index just
+ * like the constant compares with the column: the types must match, except that integers may be widened.
+ */
+auto CastToKey(const Value &value, TypeId key_type) -> std::optional<Value> {
+  if (value.IsNull() || key_type == TypeId::VARCHAR) {
+    // Variable-length keys are cut to the size of the index key, a bound longer than that would be cut as well.
+    return std::nullopt;
+  }
+  if (value.GetTypeId() == key_type) {
+    return value;
+  }
+  auto is_integer = [](TypeId type) { return type >= TypeId::TINYINT && type <= TypeId::BIGINT; };
+  if (is_integer(value.GetTypeId()) && is_integer(key_type) && value.GetTypeId() < key_type) {
+    return value.CastAs(key_type);
+  }
+  return std::nullopt;
+}
+
+/** Tighten a bound of a range with another one on the same side: the larger lower bound, the smaller upper bound. */
+void TightenBound(std::optional<IndexScanBound> *bound, IndexScanBound candidate, bool lower) {
+  if (!bound->has_value()) {
+    *bound = std::move(candidate);
+    return;
+  }
+  const Value &current = (*bound)->value_;
+  CmpBool tighter =
+      lower ? candidate.value_.CompareGreaterThan(current) : candidate.value_.CompareLessThan(current);
+  if (tighter == CmpBool::CmpTrue ||
+      (candidate.value_.CompareEquals(current) == CmpBool::CmpTrue && !candidate.inclusive_)) {
+    *bound = std::move(candidate);
+  }
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeSeqScanAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  // A modification that read its table through an index of it could see the entries it moves ahead of the scan.
+  if (plan->GetType() == PlanType::Insert || plan->GetType() == PlanType::Update ||
+      plan->GetType() == PlanType::Delete) {
+    return plan;
+  }
+
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeSeqScanAsIndexScan(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::SeqScan) {
+    return optimized_plan;
+  }
+  const auto &seq_scan_plan = dynamic_cast<const SeqScanPlanNode &>(*optimized_plan);
+  if (seq_scan_plan.filter_predicate_ == nullptr) {
+    return optimized_plan;
+  }
+  std::vector<AbstractExpressionRef> conjuncts;
+  SplitConjuncts(seq_scan_plan.filter_predicate_, &conjuncts);
+
+  // Scan the index bounded on most sides by the comparisons of its key column with constants, or look the key up in a
+  // hash index if the column equals one, which beats any range. The whole predicate stays a filter of the scan, the
+  // range only skips the keys it rejects anyway.
+  const auto *table_info = catalog_.GetTable(seq_scan_plan.GetTableOid());
+  const IndexInfo *best_index = nullptr;
+  std::optional<IndexScanBound> best_low;
+  std::optional<IndexScanBound> best_high;
+  int best_sides = 0;
+  for (const auto *index : catalog_.GetTableIndexes(table_info->name_)) {
+    const auto &key_attrs = index->index_->GetKeyAttrs();
+    if (key_attrs.size() != 1) {
+      continue;
+    }
+    TypeId key_type = index->key_schema_.GetColumn(0).GetType();
+    std::optional<IndexScanBound> low;
+    std::optional<IndexScanBound> high;
+    for (const auto &conjunct : conjuncts) {
+      const auto *cmp_expr = dynamic_cast<const ComparisonExpression *>(conjunct.get());
+      if (cmp_expr == nullptr) {
+        continue;
+      }
+      const auto *column = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(0).get());
+      const auto *constant = dynamic_cast<const ConstantValueExpression *>(cmp_expr->GetChildAt(1).get());
+      ComparisonType comp_type = cmp_expr->comp_type_;
+      if (column == nullptr || constant == nullptr) {
+        // `constant < column` bounds the column like `column > constant`.
+        column = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(1).get());
+        constant = dynamic_cast<const ConstantValueExpression *>(cmp_expr->GetChildAt(0).get());
+        switch (comp_type) {
+          case ComparisonType::LessThan:
+            comp_type = ComparisonType::GreaterThan;
+            break;
+          case ComparisonType::LessThanOrEqual:
+            comp_type = ComparisonType::GreaterThanOrEqual;
+            break;
+          case ComparisonType::GreaterThan:
+            comp_type = ComparisonType::LessThan;
+            break;
+          case ComparisonType::GreaterThanOrEqual:
+            comp_type = ComparisonType::LessThanOrEqual;
+            break;
+          default:
+            break;
+        }
+      }
+      if (column == nullptr || constant == nullptr || column->GetColIdx() != key_attrs[0]) {
+        continue;
+      }
+      auto value = CastToKey(constant->val_, key_type);
+      if (!value.has_value()) {
+        continue;
+      }
+      switch (comp_type) {
+        case ComparisonType::Equal:
+          TightenBound(&low, {*value, true}, true);
+          TightenBound(&high, {*value, true}, false);
+          break;
+        case ComparisonType::GreaterThan:
+        case ComparisonType::GreaterThanOrEqual:
+          TightenBound(&low, {*value, comp_type == ComparisonType::GreaterThanOrEqual}, true);
+          break;
+        case ComparisonType::LessThan:
+        case ComparisonType::LessThanOrEqual:
+          TightenBound(&high, {*value, comp_type == ComparisonType::LessThanOrEqual}, false);
+          break;
+        default:
+          break;
+      }
+    }
+    int sides = static_cast<int>(low.has_value()) + static_cast<int>(high.has_value());
+    if (index->index_type_ == IndexType::HashTableIndex) {
+      bool point = sides == 2 && low->inclusive_ && high->inclusive_ &&
+                   low->value_.CompareEquals(high->value_) == CmpBool::CmpTrue;
+      sides = point ? 3 : 0;
+    }
+    if (sides > best_sides) {
+      best_index = index;
+      best_low = std::move(low);
+      best_high = std::move(high);
+      best_sides = sides;
+    }
+  }
+  if (best_index == nullptr) {
+    return optimized_plan;
+  }
+  return std::make_shared<IndexScanPlanNode>(seq_scan_plan.output_schema_, best_index->index_oid_,
+                                             seq_scan_plan.filter_predicate_, std::move(best_low),
+                                             std::move(best_high));
+}
+
 }  // namespace bustub
@@ -1,5 +1,7 @@
 #include <algorithm>
 #include <memory>
+#include <utility>
+#include <vector>
 #include "catalog/column.h"
 #include "catalog/schema.h"
 #include "common/exception.h"
@@ -7,6 +9,7 @@
 #include "execution/expressions/column_value_expression.h"
 #include "execution/expressions/comparison_expression.h"
 #include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
 #include "execution/plans/abstract_plan.h"
 #include "execution/plans/filter_plan.h"
 #include "execution/plans/hash_join_plan.h"
@@ -17,12 +20,62 @@
 
 namespace bustub {
 
+namespace {
+
+/**
+ * Collect the keys of a conjunction of `<column> = <column>` comparisons between the two sides of a join, each key as
+ * a column of its own side.
+ * @return false if any part of the predicate is something else
+ */
+auto ExtractEquiJoinKeys(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *left_keys,
+                         std::vector<AbstractExpressionRef> *right_keys) -> bool {
+  if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(expr.get()); logic_expr != nullptr) {
+    return logic_expr->logic_type_ == LogicType::And &&
+           ExtractEquiJoinKeys(logic_expr->GetChildAt(0), left_keys, right_keys) &&
+           ExtractEquiJoinKeys(logic_expr->GetChildAt(1), left_keys, right_keys);
+  }
+  const auto *cmp_expr = dynamic_cast<const ComparisonExpression *>(expr.get());
+  if (cmp_expr == nullptr || cmp_expr->comp_type_ != ComparisonType::Equal) {
+    return false;
+  }
+  const auto *first = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(0).get());
+  const auto *second = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(1).get());
+  if (first == nullptr || second == nullptr || first->GetTupleIdx() == second->GetTupleIdx()) {
+    return false;
+  }
+  if (first->GetTupleIdx() == 1) {
+    std::swap(first, second);
+  }
+  // Each key is evaluated against the tuples of its own side alone.
+  left_keys->push_back(std::make_shared<ColumnValueExpression>(0, first->GetColIdx(), first->GetReturnType()));
+  right_keys->push_back(std::make_shared<ColumnValueExpression>(0, second->GetColIdx(), second->GetReturnType()));
+  return true;
+}
+
+}  // namespace
+
 auto Optimizer::OptimizeNLJAsHashJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
-  // TODO(student): implement NestedLoopJoin -> HashJoin optimizer rule
-  // Note for 2023 Spring: You should at least support join keys of the form:
-  // 1. <column expr> = <column expr>
-  // 2. <column expr> = <column expr> AND <column expr> = <column expr>
-  return plan;
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeNLJAsHashJoin(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::NestedLoopJoin) {
+    return optimized_plan;
+  }
+  const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*optimized_plan);
+  BUSTUB_ENSURE(nlj_plan.children_.size() == 2, "NLJ should have exactly 2 children.");
+  if (nlj_plan.GetJoinType() != JoinType::INNER && nlj_plan.GetJoinType() != JoinType::LEFT) {
+    return optimized_plan;
+  }
+  std::vector<AbstractExpressionRef> left_keys;
+  std::vector<AbstractExpressionRef> right_keys;
+  if (!ExtractEquiJoinKeys(nlj_plan.Predicate(), &left_keys, &right_keys)) {
+    return optimized_plan;
+  }
+  return std::make_shared<HashJoinPlanNode>(nlj_plan.output_schema_, nlj_plan.GetLeftPlan(), nlj_plan.GetRightPlan(),
+                                            std::move(left_keys), std::move(right_keys), nlj_plan.GetJoinType());
 }
 
 }  // namespace bustub
@@ -23,13 +23,19 @@ namespace bustub {
 
 auto Optimizer::MatchIndex(const std::string &table_name, uint32_t index_key_idx)
     -> std::optional<std::tuple<index_oid_t, std::string>> {
+  // Probes are point lookups: a hash index answers them in a single bucket, a B+ tree in a descent.
   const auto key_attrs = std::vector{index_key_idx};
+  const IndexInfo *match = nullptr;
   for (const auto *index_info : catalog_.GetTableIndexes(table_name)) {
-    if (key_attrs == index_info->index_->GetKeyAttrs()) {
-      return std::make_optional(std::make_tuple(index_info->index_oid_, index_info->name_));
+    if (key_attrs == index_info->index_->GetKeyAttrs() &&
+        (match == nullptr || index_info->index_type_ == IndexType::HashTableIndex)) {
+      match = index_info;
     }
   }
-  return std::nullopt;
+  if (match == nullptr) {
+    return std::nullopt;
+  }
+  return std::make_optional(std::make_tuple(match->index_oid_, match->name_));
 }
 
 auto Optimizer::OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
@@ -57,8 +63,9 @@ auto Optimizer::OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> Abstr
                 std::make_shared<ColumnValueExpression>(0, right_expr->GetColIdx(), right_expr->GetReturnType());
             // Now it's in form of <column_expr> = <column_expr>. Let's match an index for them.
 
-            // Ensure right child is table scan
-            if (nlj_plan.GetRightPlan()->GetType() == PlanType::SeqScan) {
+            // Ensure right child is table scan, and that probe keys are built from values of the key's own type
+            if (nlj_plan.GetRightPlan()->GetType() == PlanType::SeqScan &&
+                left_expr->GetReturnType() == right_expr->GetReturnType()) {
               const auto &right_seq_scan = dynamic_cast<const SeqScanPlanNode &>(*nlj_plan.GetRightPlan());
               if (left_expr->GetTupleIdx() == 0 && right_expr->GetTupleIdx() == 1) {
                 if (auto index = MatchIndex(right_seq_scan.table_name_, right_expr->GetColIdx());
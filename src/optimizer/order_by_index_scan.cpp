@@ -32,10 +32,11 @@ auto Optimizer::OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> A
     const auto &sort_plan = dynamic_cast<const SortPlanNode &>(*optimized_plan);
     const auto &order_bys = sort_plan.GetOrderBy();
 
+    // The index is scanned forward for an ascending order, backward for a descending one; mixed orders need a sort.
     std::vector<uint32_t> order_by_column_ids;
+    bool reverse = !order_bys.empty() && order_bys[0].first == OrderByType::DESC;
     for (const auto &[order_type, expr] : order_bys) {
-      // Order type is asc or default
-      if (!(order_type == OrderByType::ASC || order_type == OrderByType::DEFAULT)) {
+      if (order_type == OrderByType::INVALID || (order_type == OrderByType::DESC) != reverse) {
         return optimized_plan;
       }
 
@@ -52,28 +53,46 @@ auto Optimizer::OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> A
     BUSTUB_ENSURE(optimized_plan->children_.size() == 1, "Sort with multiple children?? Impossible!");
     const auto &child_plan = optimized_plan->children_[0];
 
+    // check index key schema == order by columns
+    auto matches_order = [&](const IndexInfo *index, const TableInfo *table_info) {
+      if (index->index_type_ != IndexType::BPlusTreeIndex) {
+        return false;
+      }
+      const auto &columns = index->key_schema_.GetColumns();
+      if (columns.size() != order_by_column_ids.size()) {
+        return false;
+      }
+      for (size_t i = 0; i < columns.size(); i++) {
+        if (columns[i].GetName() != table_info->schema_.GetColumn(order_by_column_ids[i]).GetName()) {
+          return false;
+        }
+      }
+      return true;
+    };
+
     if (child_plan->GetType() == PlanType::SeqScan) {
       const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*child_plan);
       const auto *table_info = catalog_.GetTable(seq_scan.GetTableOid());
       const auto indices = catalog_.GetTableIndexes(table_info->name_);
 
       for (const auto *index : indices) {
-        const auto &columns = index->key_schema_.GetColumns();
-        // check index key schema == order by columns
-        bool valid = true;
-        if (columns.size() == order_by_column_ids.size()) {
-          for (size_t i = 0; i < columns.size(); i++) {
-            if (columns[i].GetName() != table_info->schema_.GetColumn(order_by_column_ids[i]).GetName()) {
-              valid = false;
-              break;
-            }
-          }
-          if (valid) {
-            return std::make_shared<IndexScanPlanNode>(optimized_plan->output_schema_, index->index_oid_);
-          }
+        if (matches_order(index, table_info)) {
+          return std::make_shared<IndexScanPlanNode>(optimized_plan->output_schema_, index->index_oid_,
+                                                     seq_scan.filter_predicate_, std::nullopt, std::nullopt, reverse);
         }
       }
     }
+
+    // A range scan of an index in the order of the sort only needs to go the right way.
+    if (child_plan->GetType() == PlanType::IndexScan) {
+      const auto &index_scan = dynamic_cast<const IndexScanPlanNode &>(*child_plan);
+      const auto *index = catalog_.GetIndex(index_scan.GetIndexOid());
+      if (matches_order(index, catalog_.GetTable(index->table_name_))) {
+        return std::make_shared<IndexScanPlanNode>(optimized_plan->output_schema_, index_scan.index_oid_,
+                                                   index_scan.filter_predicate_, index_scan.low_, index_scan.high_,
+                                                   reverse);
+      }
+    }
   }
 
   return optimized_plan;
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// disk_scheduler.cpp
+//
+// Identification: src/storage/disk/disk_scheduler.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/disk/disk_scheduler.h"
+
+#include <utility>
+
+#include "common/exception.h"
+#include "common/macros.h"
+
+namespace bustub {
+
+DiskScheduler::DiskScheduler(DiskManager *disk_manager, size_t num_workers) : disk_manager_(disk_manager) {
+  BUSTUB_ENSURE(num_workers > 0, "the disk scheduler needs at least one worker");
+  for (size_t i = 0; i < num_workers; i++) {
+    workers_.emplace_back(std::make_unique<Worker>());
+  }
+  // Spawn the background threads only once every queue exists.
+  for (auto &worker : workers_) {
+    worker->thread_.emplace([this, w = worker.get()] { StartWorkerThread(w); });
+  }
+}
+
+DiskScheduler::~DiskScheduler() {
+  // Put a `std::nullopt` in each queue to signal to exit the loop
+  for (auto &worker : workers_) {
+    worker->request_queue_.Put(std::nullopt);
+  }
+  for (auto &worker : workers_) {
+    if (worker->thread_.has_value()) {
+      worker->thread_->join();
+    }
+  }
+}
+
+void DiskScheduler::Schedule(DiskRequest r) { WorkerOf(r.page_id_).request_queue_.Put(std::move(r)); }
+
+void DiskScheduler::ScheduleBatch(std::vector<DiskRequest> requests) {
+  // Bucket by worker so each queue is locked and signalled once per batch.
+  std::vector<std::vector<std::optional<DiskRequest>>> buckets(workers_.size());
+  for (auto &r : requests) {
+    buckets[static_cast<size_t>(r.page_id_) % workers_.size()].emplace_back(std::move(r));
+  }
+  for (size_t i = 0; i < workers_.size(); i++) {
+    if (!buckets[i].empty()) {
+      workers_[i]->request_queue_.PutBatch(std::move(buckets[i]));
+    }
+  }
+}
+
+auto DiskScheduler::ScheduleRead(page_id_t page_id, char *data) -> std::future<bool> {
+  auto promise = CreatePromise();
+  auto future = promise.get_future();
+  Schedule({/*is_write=*/false, data, page_id, std::move(promise)});
+  return future;
+}
+
+auto DiskScheduler::ScheduleWrite(page_id_t page_id, const char *data) -> std::future<bool> {
+  auto promise = CreatePromise();
+  auto future = promise.get_future();
+  // The data is only read for a write request.
+  Schedule({/*is_write=*/true, const_cast<char *>(data), page_id, std::move(promise)});  // NOLINT
+  return future;
+}
+
+void DiskScheduler::StartWorkerThread(Worker *worker) {
+  while (true) {
+    auto request = worker->request_queue_.Get();
+    if (!request.has_value()) {
+      return;
+    }
+    bool ok = request->is_write_ ? disk_manager_->WritePage(request->page_id_, request->data_)
+                                 : disk_manager_->ReadPage(request->page_id_, request->data_);
+    request->callback_.set_value(ok);
+  }
+}
+
+}  // namespace bustub
@@ -1,5 +1,11 @@
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <exception>
+#include <functional>
 #include <sstream>
 #include <string>
+#include <thread>  // NOLINT
+#include <utility>
 
 #include "common/exception.h"
 #include "common/logger.h"
@@ -10,23 +16,36 @@ namespace bustub {
 
 INDEX_TEMPLATE_ARGUMENTS
 BPLUSTREE_TYPE::BPlusTree(std::string name, page_id_t header_page_id, BufferPoolManager *buffer_pool_manager,
-                          const KeyComparator &comparator, int leaf_max_size, int internal_max_size)
+                          const KeyComparator &comparator, int leaf_max_size, int internal_max_size,
+                          BPlusTreeLatchMode latch_mode)
     : index_name_(std::move(name)),
       bpm_(buffer_pool_manager),
       comparator_(std::move(comparator)),
       leaf_max_size_(leaf_max_size),
       internal_max_size_(internal_max_size),
-      header_page_id_(header_page_id) {
+      header_page_id_(header_page_id),
+      latch_mode_(latch_mode) {
   WritePageGuard guard = bpm_->FetchPageWrite(header_page_id_);
   auto root_page = guard.AsMut<BPlusTreeHeaderPage>();
   root_page->root_page_id_ = INVALID_PAGE_ID;
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+BPLUSTREE_TYPE::~BPlusTree() {
+  Page *root = root_page_.load();
+  if (root != nullptr) {
+    bpm_->UnpinPage(root->GetPageId(), false);
+  }
+}
+
 /*
  * Helper function to decide whether current b+tree is empty
  */
 INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_TYPE::IsEmpty() const -> bool { return true; }
+auto BPLUSTREE_TYPE::IsEmpty() const -> bool {
+  ReadPageGuard guard = bpm_->FetchPageRead(header_page_id_);
+  return guard.As<BPlusTreeHeaderPage>()->root_page_id_ == INVALID_PAGE_ID;
+}
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
@@ -37,10 +56,197 @@ auto BPLUSTREE_TYPE::IsEmpty() const -> bool { return true; }
  */
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *txn) -> bool {
-  // Declaration of context instance.
-  Context ctx;
-  (void)ctx;
-  return false;
+  if (latch_mode_ == BPlusTreeLatchMode::Optimistic) {
+    for (int attempt = 0; attempt < OPTIMISTIC_ATTEMPTS; attempt++) {
+      bool found;
+      if (GetValueOptimistic(key, result, &found)) {
+        return found;
+      }
+    }
+  }
+
+  auto guard = FindLeafRead(&key);
+  if (!guard.has_value()) {
+    return false;
+  }
+  auto *leaf = guard->template As<LeafPage>();
+  int index = leaf->KeyIndex(key, comparator_);
+  if (index == leaf->GetSize() || comparator_(leaf->KeyAt(index), key) != 0) {
+    return false;
+  }
+  result->push_back(leaf->ValueAt(index));
+  return true;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::GetValues(const std::vector<KeyType> &keys, std::vector<std::vector<ValueType>> *results,
+                               Transaction *txn) {
+  results->assign(keys.size(), {});
+  std::optional<ReadPageGuard> guard;
+  for (size_t i = 0; i < keys.size(); i++) {
+    const KeyType &key = keys[i];
+    BUSTUB_ASSERT(i == 0 || comparator_(keys[i - 1], key) <= 0, "keys must be in ascending order");
+    // The previous key lies in the current leaf, so this one does as well unless it is past the last key.
+    if (guard.has_value()) {
+      const auto *leaf = guard->template As<LeafPage>();
+      if (leaf->GetSize() == 0 || comparator_(leaf->KeyAt(leaf->GetSize() - 1), key) < 0) {
+        guard = std::nullopt;
+      }
+    }
+    if (!guard.has_value()) {
+      guard = FindLeafRead(&key);
+      if (!guard.has_value()) {
+        return;
+      }
+    }
+    const auto *leaf = guard->template As<LeafPage>();
+    int index = leaf->KeyIndex(key, comparator_);
+    if (index < leaf->GetSize() && comparator_(leaf->KeyAt(index), key) == 0) {
+      (*results)[i].push_back(leaf->ValueAt(index));
+    }
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::GetValueOptimistic(const KeyType &key, std::vector<ValueType> *result, bool *found) -> bool {
+  OptimisticLeaf leaf;
+  if (!DescendOptimistic(key, &leaf)) {
+    return false;
+  }
+  if (leaf.page_ == nullptr) {
+    *found = false;
+    return true;
+  }
+
+  int size = reinterpret_cast<const LeafPage *>(leaf.page_->GetData())->GetSize();
+  int index;
+  bool valid = leaf.page_->ValidateVersion(leaf.version_) &&
+               SearchOptimistic<LeafPage>(leaf.page_, leaf.version_, key, 0, size, false, &index);
+  if (valid && index < size) {
+    const auto *page = reinterpret_cast<const LeafPage *>(leaf.page_->GetData());
+    KeyType found_key = page->KeyAt(index);
+    ValueType value = page->ValueAt(index);
+    valid = leaf.page_->ValidateVersion(leaf.version_);
+    *found = valid && comparator_(found_key, key) == 0;
+    if (*found) {
+      result->push_back(value);
+    }
+  } else {
+    *found = false;
+  }
+  if (leaf.pinned_) {
+    bpm_->UnpinPage(leaf.page_->GetPageId(), false);
+  }
+  return valid;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::DescendOptimistic(const KeyType &key, OptimisticLeaf *leaf) -> bool {
+  Page *page = root_page_.load(std::memory_order_acquire);
+  if (page == nullptr) {
+    leaf->page_ = nullptr;
+    return true;
+  }
+  // The root is replaced before its old page is unlatched, so a root read at a stable version that is still the root
+  // afterwards was the root at that version.
+  uint64_t version = page->GetVersion();
+  if ((version & 1) != 0 || root_page_.load(std::memory_order_acquire) != page) {
+    return false;
+  }
+
+  bool pinned = false;
+  auto fail = [&](Page *child) {
+    if (child != nullptr) {
+      bpm_->UnpinPage(child->GetPageId(), false);
+    }
+    if (pinned) {
+      bpm_->UnpinPage(page->GetPageId(), false);
+    }
+    return false;
+  };
+  while (true) {
+    const auto *node = reinterpret_cast<const BPlusTreePage *>(page->GetData());
+    bool is_leaf = node->IsLeafPage();
+    int size = node->GetSize();
+    if (!page->ValidateVersion(version)) {
+      return fail(nullptr);
+    }
+    if (is_leaf) {
+      *leaf = {page, version, pinned};
+      return true;
+    }
+
+    int index;
+    if (!SearchOptimistic<InternalPage>(page, version, key, 1, size, true, &index)) {
+      return fail(nullptr);
+    }
+    page_id_t child_id = reinterpret_cast<const InternalPage *>(node)->ValueAt(index - 1);
+    if (!page->ValidateVersion(version)) {
+      return fail(nullptr);
+    }
+    Page *child = PinPage(child_id);
+    uint64_t child_version = child->GetVersion();
+    // The parent still pointing to the child once the child's version is read proves that the child was not split
+    // or merged away in between.
+    if ((child_version & 1) != 0 || !page->ValidateVersion(version)) {
+      return fail(child);
+    }
+    if (pinned) {
+      bpm_->UnpinPage(page->GetPageId(), false);
+    }
+    page = child;
+    version = child_version;
+    pinned = true;
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+template <typename NodePage>
+auto BPLUSTREE_TYPE::SearchOptimistic(Page *page, uint64_t version, const KeyType &key, int left, int right,
+                                      bool upper, int *index) -> bool {
+  const auto *node = reinterpret_cast<const NodePage *>(page->GetData());
+  if constexpr (NodePage::SEARCH_TOLERATES_RACES) {
+    *index = node->SearchKey(key, comparator_, left, right, upper);
+    return page->ValidateVersion(version);
+  }
+  while (left < right) {
+    int mid = left + (right - left) / 2;
+    KeyType mid_key = node->KeyAt(mid);
+    if (!page->ValidateVersion(version)) {
+      return false;
+    }
+    int cmp = comparator_(mid_key, key);
+    if (cmp < 0 || (upper && cmp == 0)) {
+      left = mid + 1;
+    } else {
+      right = mid;
+    }
+  }
+  *index = left;
+  return true;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::FindLeafRead(const KeyType *key, bool rightmost) -> std::optional<ReadPageGuard> {
+  ReadPageGuard header_guard = FetchRead(header_page_id_);
+  page_id_t root_page_id = header_guard.As<BPlusTreeHeaderPage>()->root_page_id_;
+  if (root_page_id == INVALID_PAGE_ID) {
+    return std::nullopt;
+  }
+  ReadPageGuard guard = FetchRead(root_page_id);
+  header_guard.Drop();
+  while (!guard.As<BPlusTreePage>()->IsLeafPage()) {
+    auto *internal = guard.As<InternalPage>();
+    int index;
+    if (key != nullptr) {
+      index = internal->ChildIndex(*key, comparator_);
+    } else {
+      index = rightmost ? internal->GetSize() - 1 : 0;
+    }
+    // The assignment releases the parent only once the child is latched.
+    guard = FetchRead(internal->ValueAt(index));
+  }
+  return guard;
 }
 
 /*****************************************************************************
@@ -55,10 +261,202 @@ auto BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result
  */
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *txn) -> bool {
-  // Declaration of context instance.
+  if (latch_mode_ == BPlusTreeLatchMode::Optimistic) {
+    for (int attempt = 0; attempt < OPTIMISTIC_ATTEMPTS; attempt++) {
+      bool inserted;
+      auto result = InsertOptimistic(key, value, &inserted);
+      if (result == OptimisticResult::Done) {
+        return inserted;
+      }
+      if (result == OptimisticResult::Escalate) {
+        break;
+      }
+    }
+  }
+
   Context ctx;
-  (void)ctx;
-  return false;
+  ctx.header_page_ = FetchWrite(header_page_id_);
+  if (ctx.header_page_->As<BPlusTreeHeaderPage>()->root_page_id_ == INVALID_PAGE_ID) {
+    page_id_t root_page_id;
+    WritePageGuard root_guard = NewWrite(&root_page_id);
+    auto *root = root_guard.AsMut<LeafPage>();
+    root->Init(leaf_max_size_);
+    root->InsertAt(0, key, value);
+    SetRootPage(ctx.header_page_->AsMut<BPlusTreeHeaderPage>(), root_page_id);
+    return true;
+  }
+
+  FindLeafWrite(key, Operation::Insert, &ctx);
+  auto &leaf_guard = ctx.write_set_.back();
+  int index = leaf_guard.As<LeafPage>()->KeyIndex(key, comparator_);
+  if (index < leaf_guard.As<LeafPage>()->GetSize() &&
+      comparator_(leaf_guard.As<LeafPage>()->KeyAt(index), key) == 0) {
+    return false;
+  }
+  auto *leaf = leaf_guard.AsMut<LeafPage>();
+  if (leaf->GetSize() + 1 < leaf->GetMaxSize() && leaf->InsertAt(index, key, value)) {
+    return true;
+  }
+
+  // The leaf is full, in entries or in bytes: spread its entries and the new one over it and a new right sibling.
+  auto entries = leaf->GetEntries();
+  entries.emplace(entries.begin() + index, key, value);
+  int split = leaf->SplitPoint(entries);
+  BUSTUB_ASSERT(split > 0, "the entries of a split leaf do not fit in two leaves");
+  page_id_t sibling_page_id;
+  WritePageGuard sibling_guard = NewWrite(&sibling_page_id);
+  auto *sibling = sibling_guard.AsMut<LeafPage>();
+  sibling->Init(leaf_max_size_);
+  leaf->Assign(entries, 0, split);
+  sibling->Assign(entries, split, entries.size());
+  sibling->SetNextPageId(leaf->GetNextPageId());
+  sibling->SetPrevPageId(leaf_guard.PageId());
+  leaf->SetNextPageId(sibling_page_id);
+  if (sibling->GetNextPageId() != INVALID_PAGE_ID) {
+    // The old right sibling is to the right of both leaves, so latching it keeps to the left-to-right order.
+    FetchWrite(sibling->GetNextPageId()).template AsMut<LeafPage>()->SetPrevPageId(sibling_page_id);
+  }
+  InsertIntoParent(&ctx, comparator_.FindShortestSeparator(entries[split - 1].first, entries[split].first),
+                   sibling_page_id);
+  return true;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::InsertOptimistic(const KeyType &key, const ValueType &value, bool *inserted)
+    -> OptimisticResult {
+  OptimisticLeaf leaf;
+  if (!DescendOptimistic(key, &leaf)) {
+    return OptimisticResult::Restart;
+  }
+  if (leaf.page_ == nullptr) {
+    return OptimisticResult::Escalate;
+  }
+  if (!LatchOptimisticLeaf(&leaf)) {
+    return OptimisticResult::Restart;
+  }
+
+  auto *page = reinterpret_cast<LeafPage *>(leaf.page_->GetData());
+  int index = page->KeyIndex(key, comparator_);
+  if (index < page->GetSize() && comparator_(page->KeyAt(index), key) == 0) {
+    *inserted = false;
+    ReleaseOptimisticLeaf(leaf, false);
+    return OptimisticResult::Done;
+  }
+  // An insert that does not fit leaves the page as it was.
+  if (page->GetSize() + 1 >= page->GetMaxSize() || !page->InsertAt(index, key, value)) {
+    ReleaseOptimisticLeaf(leaf, false);
+    return OptimisticResult::Escalate;
+  }
+  *inserted = true;
+  ReleaseOptimisticLeaf(leaf, true);
+  return OptimisticResult::Done;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::LatchOptimisticLeaf(OptimisticLeaf *leaf) -> bool {
+  leaf->page_->WLatch();
+  if (!leaf->page_->ValidateVersion(leaf->version_ + 1)) {
+    leaf->page_->WUnlatch();
+    if (leaf->pinned_) {
+      bpm_->UnpinPage(leaf->page_->GetPageId(), false);
+    }
+    return false;
+  }
+  if (!leaf->pinned_) {
+    // The leaf is the root. Latched, it stays the root and pinned by the tree; take a pin of our own to be able to
+    // mark it dirty when releasing it.
+    bpm_->FetchPage(leaf->page_->GetPageId());
+    leaf->pinned_ = true;
+  }
+  return true;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::ReleaseOptimisticLeaf(const OptimisticLeaf &leaf, bool is_dirty) {
+  page_id_t page_id = leaf.page_->GetPageId();
+  leaf.page_->WUnlatch();
+  bpm_->UnpinPage(page_id, is_dirty);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::FindLeafWrite(const KeyType &key, Operation op, Context *ctx) {
+  ctx->root_page_id_ = ctx->header_page_->template As<BPlusTreeHeaderPage>()->root_page_id_;
+  ctx->write_set_.push_back(FetchWrite(ctx->root_page_id_));
+  if (IsSafe(ctx->write_set_.back().template As<BPlusTreePage>(), op, true)) {
+    ctx->header_page_ = std::nullopt;
+  }
+  while (!ctx->write_set_.back().template As<BPlusTreePage>()->IsLeafPage()) {
+    auto *internal = ctx->write_set_.back().template As<InternalPage>();
+    ctx->write_set_.push_back(FetchWrite(internal->ValueAt(internal->ChildIndex(key, comparator_))));
+    if (IsSafe(ctx->write_set_.back().template As<BPlusTreePage>(), op, false)) {
+      ctx->header_page_ = std::nullopt;
+      while (ctx->write_set_.size() > 1) {
+        ctx->write_set_.pop_front();
+      }
+    }
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::IsSafe(const BPlusTreePage *page, Operation op, bool is_root) const -> bool {
+  const auto *leaf = reinterpret_cast<const LeafPage *>(page);
+  const auto *internal = reinterpret_cast<const InternalPage *>(page);
+  switch (op) {
+    case Operation::Search:
+      return true;
+    case Operation::Insert:
+      // A leaf splits when it becomes full, an internal page when it is full and gets one more child. Either also
+      // splits when it runs out of bytes.
+      return page->IsLeafPage() ? page->GetSize() + 1 < page->GetMaxSize() && leaf->IsSafeToInsert()
+                                : page->GetSize() < page->GetMaxSize() && internal->IsSafeToInsert();
+    case Operation::Remove:
+      if (is_root) {
+        // A root leaf can shrink down to one pair, a root internal page down to two children.
+        return page->GetSize() > (page->IsLeafPage() ? 1 : 2);
+      }
+      return page->IsLeafPage() ? leaf->IsSafeToRemove() : internal->IsSafeToRemove();
+  }
+  UNREACHABLE("unknown operation");
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::InsertIntoParent(Context *ctx, const KeyType &key, page_id_t right_page_id) {
+  page_id_t left_page_id = ctx->write_set_.back().PageId();
+  if (ctx->IsRootPage(left_page_id)) {
+    BUSTUB_ASSERT(ctx->header_page_.has_value(), "splitting the root without holding the header");
+    page_id_t root_page_id;
+    WritePageGuard root_guard = NewWrite(&root_page_id);
+    auto *root = root_guard.AsMut<InternalPage>();
+    root->Init(internal_max_size_);
+    root->InsertAt(0, key, left_page_id);
+    root->InsertAt(1, key, right_page_id);
+    SetRootPage(ctx->header_page_->template AsMut<BPlusTreeHeaderPage>(), root_page_id);
+    ctx->root_page_id_ = root_page_id;
+    return;
+  }
+
+  // The split page is complete; its parent, which is not safe, is the previous page of the write set.
+  ctx->write_set_.pop_back();
+  auto *parent = ctx->write_set_.back().template AsMut<InternalPage>();
+  int index = parent->ValueIndex(left_page_id) + 1;
+  if (parent->GetSize() < parent->GetMaxSize() && parent->InsertAt(index, key, right_page_id)) {
+    return;
+  }
+
+  // The parent is full as well, in entries or in bytes, so split it through a copy.
+  auto entries = parent->GetEntries();
+  entries.emplace(entries.begin() + index, key, right_page_id);
+  int split = parent->SplitPoint(entries);
+  BUSTUB_ASSERT(split > 0, "the entries of a split internal page do not fit in two pages");
+
+  page_id_t sibling_page_id;
+  WritePageGuard sibling_guard = NewWrite(&sibling_page_id);
+  auto *sibling = sibling_guard.AsMut<InternalPage>();
+  sibling->Init(internal_max_size_);
+  sibling->Assign(entries, split, entries.size());
+  parent->Assign(entries, 0, split);
+  // The first key of the sibling moves up; the sibling does not store it, as its invalid first key.
+  InsertIntoParent(ctx, entries[split].first, sibling_page_id);
 }
 
 /*****************************************************************************
@@ -73,9 +471,507 @@ auto BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transact
  */
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *txn) {
-  // Declaration of context instance.
-  Context ctx;
-  (void)ctx;
+  if (latch_mode_ == BPlusTreeLatchMode::Optimistic) {
+    for (int attempt = 0; attempt < OPTIMISTIC_ATTEMPTS; attempt++) {
+      auto result = RemoveOptimistic(key);
+      if (result == OptimisticResult::Done) {
+        return;
+      }
+      if (result == OptimisticResult::Escalate) {
+        break;
+      }
+    }
+  }
+
+  std::vector<page_id_t> deleted_pages;
+  {
+    Context ctx;
+    ctx.header_page_ = FetchWrite(header_page_id_);
+    if (ctx.header_page_->As<BPlusTreeHeaderPage>()->root_page_id_ == INVALID_PAGE_ID) {
+      return;
+    }
+    FindLeafWrite(key, Operation::Remove, &ctx);
+    auto &leaf_guard = ctx.write_set_.back();
+    int index = leaf_guard.As<LeafPage>()->KeyIndex(key, comparator_);
+    if (index == leaf_guard.As<LeafPage>()->GetSize() ||
+        comparator_(leaf_guard.As<LeafPage>()->KeyAt(index), key) != 0) {
+      return;
+    }
+    leaf_guard.AsMut<LeafPage>()->RemoveAt(index);
+    HandleUnderflow(&ctx, &deleted_pages);
+  }
+  // A page still pinned by a concurrent reader cannot be deleted; it is only lost to the tree.
+  for (auto page_id : deleted_pages) {
+    bpm_->DeletePage(page_id);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::RemoveOptimistic(const KeyType &key) -> OptimisticResult {
+  OptimisticLeaf leaf;
+  if (!DescendOptimistic(key, &leaf)) {
+    return OptimisticResult::Restart;
+  }
+  if (leaf.page_ == nullptr) {
+    return OptimisticResult::Done;
+  }
+  if (!LatchOptimisticLeaf(&leaf)) {
+    return OptimisticResult::Restart;
+  }
+
+  auto *page = reinterpret_cast<LeafPage *>(leaf.page_->GetData());
+  int index = page->KeyIndex(key, comparator_);
+  if (index == page->GetSize() || comparator_(page->KeyAt(index), key) != 0) {
+    ReleaseOptimisticLeaf(leaf, false);
+    return OptimisticResult::Done;
+  }
+  // Whether the leaf is the root or not, keeping it from underflowing and non-empty needs no merge.
+  if (!page->CanRemoveAt(index) || page->GetSize() == 1) {
+    ReleaseOptimisticLeaf(leaf, false);
+    return OptimisticResult::Escalate;
+  }
+  page->RemoveAt(index);
+  ReleaseOptimisticLeaf(leaf, true);
+  return OptimisticResult::Done;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::HandleUnderflow(Context *ctx, std::vector<page_id_t> *deleted_pages) {
+  auto is_underflow = [](const BPlusTreePage *page) {
+    return page->IsLeafPage() ? reinterpret_cast<const LeafPage *>(page)->IsUnderflow()
+                              : reinterpret_cast<const InternalPage *>(page)->IsUnderflow();
+  };
+  while (true) {
+    page_id_t page_id = ctx->write_set_.back().PageId();
+    const auto *page = ctx->write_set_.back().template As<BPlusTreePage>();
+    if (ctx->IsRootPage(page_id)) {
+      if (page->IsLeafPage() ? page->GetSize() == 0 : page->GetSize() == 1) {
+        // The tree became empty, or the root has a single child left that becomes the new root.
+        page_id_t root_page_id =
+            page->IsLeafPage() ? INVALID_PAGE_ID : ctx->write_set_.back().template As<InternalPage>()->ValueAt(0);
+        BUSTUB_ASSERT(ctx->header_page_.has_value(), "replacing the root without holding the header");
+        SetRootPage(ctx->header_page_->template AsMut<BPlusTreeHeaderPage>(), root_page_id);
+        deleted_pages->push_back(page_id);
+      }
+      return;
+    }
+    if (!is_underflow(page)) {
+      return;
+    }
+
+    // The page was not safe, so its parent is latched as well.
+    auto &parent_guard = ctx->write_set_[ctx->write_set_.size() - 2];
+    auto *parent = parent_guard.template AsMut<InternalPage>();
+    int index = parent->ValueIndex(page_id);
+    WritePageGuard sibling_guard;
+    WritePageGuard *left_guard;
+    WritePageGuard *right_guard;
+    int right_index;
+    if (index + 1 < parent->GetSize()) {
+      sibling_guard = FetchWrite(parent->ValueAt(index + 1));
+      left_guard = &ctx->write_set_.back();
+      right_guard = &sibling_guard;
+      right_index = index + 1;
+    } else {
+      // Pages of a level are latched from left to right, the order the leaf chain is walked in, so release the page
+      // before latching its left sibling. Its parent stays latched, so only leaf-only writers can touch it meanwhile.
+      ctx->write_set_.pop_back();
+      sibling_guard = FetchWrite(parent->ValueAt(index - 1));
+      ctx->write_set_.push_back(FetchWrite(page_id));
+      page = ctx->write_set_.back().template As<BPlusTreePage>();
+      if (!is_underflow(page)) {
+        return;
+      }
+      left_guard = &sibling_guard;
+      right_guard = &ctx->write_set_.back();
+      right_index = index;
+    }
+    page_id_t right_page_id = right_guard->PageId();
+
+    // Merge the right page into the left one if everything fits in a page. Otherwise even the pages out, as long as
+    // the parent has room for their new separator: they are then full enough in bytes that leaving them is harmless.
+    if (page->IsLeafPage()) {
+      auto *left = left_guard->template AsMut<LeafPage>();
+      auto *right = right_guard->template AsMut<LeafPage>();
+      auto entries = left->GetEntries();
+      auto right_entries = right->GetEntries();
+      entries.insert(entries.end(), right_entries.begin(), right_entries.end());
+      if (static_cast<int>(entries.size()) > left->GetMaxEntries() || !left->Assign(entries, 0, entries.size())) {
+        int split = left->SplitPoint(entries);
+        if (split > 0 &&
+            parent->SetKeyAt(right_index,
+                             comparator_.FindShortestSeparator(entries[split - 1].first, entries[split].first))) {
+          left->Assign(entries, 0, split);
+          right->Assign(entries, split, entries.size());
+        }
+        return;
+      }
+      left->SetNextPageId(right->GetNextPageId());
+      if (right->GetNextPageId() != INVALID_PAGE_ID) {
+        FetchWrite(right->GetNextPageId()).template AsMut<LeafPage>()->SetPrevPageId(left_guard->PageId());
+      }
+      right->SetSize(0);
+    } else {
+      auto *left = left_guard->template AsMut<InternalPage>();
+      auto *right = right_guard->template AsMut<InternalPage>();
+      // The separator in the parent moves down as the first key of the right page.
+      auto entries = left->GetEntries();
+      auto right_entries = right->GetEntries();
+      right_entries[0].first = parent->KeyAt(right_index);
+      entries.insert(entries.end(), right_entries.begin(), right_entries.end());
+      if (static_cast<int>(entries.size()) > left->GetMaxEntries() || !left->Assign(entries, 0, entries.size())) {
+        int split = left->SplitPoint(entries);
+        if (split > 0 && parent->SetKeyAt(right_index, entries[split].first)) {
+          left->Assign(entries, 0, split);
+          right->Assign(entries, split, entries.size());
+        }
+        return;
+      }
+      right->SetSize(0);
+    }
+
+    // The right page was merged into the left one; the parent loses an entry and may underflow in turn.
+    parent->RemoveAt(right_index);
+    deleted_pages->push_back(right_page_id);
+    ctx->write_set_.pop_back();
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::SetRootPage(BPlusTreeHeaderPage *header, page_id_t root_page_id) {
+  page_id_t old_root_page_id = header->root_page_id_;
+  header->root_page_id_ = root_page_id;
+  if (latch_mode_ != BPlusTreeLatchMode::Optimistic) {
+    return;
+  }
+  // Both roots are latched by the caller: readers that saw the old root fail to validate it once it is unlatched.
+  root_page_.store(root_page_id == INVALID_PAGE_ID ? nullptr : PinPage(root_page_id), std::memory_order_release);
+  if (old_root_page_id != INVALID_PAGE_ID) {
+    bpm_->UnpinPage(old_root_page_id, false);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::PinPage(page_id_t page_id) -> Page * {
+  for (int attempt = 0; attempt < FRAME_WAIT_ATTEMPTS; attempt++) {
+    Page *page = bpm_->FetchPage(page_id);
+    if (page != nullptr) {
+      return page;
+    }
+    // Every frame is pinned, most likely by concurrent operations that will soon release theirs.
+    std::this_thread::sleep_for(std::chrono::microseconds(10));
+  }
+  throw Exception(ExceptionType::OUT_OF_MEMORY, "no frame of the buffer pool is available to the index");
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::FetchRead(page_id_t page_id) -> ReadPageGuard {
+  Page *page = PinPage(page_id);
+  page->RLatch();
+  return {bpm_, page};
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::FetchWrite(page_id_t page_id) -> WritePageGuard {
+  Page *page = PinPage(page_id);
+  page->WLatch();
+  return {bpm_, page};
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::NewWrite(page_id_t *page_id) -> WritePageGuard {
+  for (int attempt = 0; attempt < FRAME_WAIT_ATTEMPTS; attempt++) {
+    Page *page = bpm_->NewPage(page_id);
+    if (page != nullptr) {
+      page->WLatch();
+      return {bpm_, page};
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(10));
+  }
+  throw Exception(ExceptionType::OUT_OF_MEMORY, "no frame of the buffer pool is available to the index");
+}
+
+/*****************************************************************************
+ * BULK LOAD
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::BulkLoad(const std::function<bool(MappingType *)> &next, double fill_factor) -> bool {
+  WritePageGuard header = FetchWrite(header_page_id_);
+  if (header.As<BPlusTreeHeaderPage>()->root_page_id_ != INVALID_PAGE_ID) {
+    return false;
+  }
+  LevelEntries leaves;
+  try {
+    BuildLeaves(next, fill_factor, &leaves);
+  } catch (...) {
+    for (const auto &[key, page_id] : leaves) {
+      bpm_->DeletePage(page_id);
+    }
+    throw;
+  }
+  FinishBulkLoad(&header, std::move(leaves), fill_factor);
+  return true;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::BulkLoadParallel(const std::vector<MappingType> &entries, size_t num_threads, double fill_factor)
+    -> bool {
+  // A thread with only a few leaves to build costs more to start than it saves.
+  size_t max_threads = entries.size() / (static_cast<size_t>(leaf_max_size_) * BULK_LOAD_MIN_LEAVES_PER_THREAD);
+  num_threads = std::min(num_threads, max_threads);
+  if (num_threads <= 1) {
+    size_t pos = 0;
+    return BulkLoad(
+        [&](MappingType *entry) {
+          if (pos == entries.size()) {
+            return false;
+          }
+          *entry = entries[pos++];
+          return true;
+        },
+        fill_factor);
+  }
+
+  WritePageGuard header = FetchWrite(header_page_id_);
+  if (header.As<BPlusTreeHeaderPage>()->root_page_id_ != INVALID_PAGE_ID) {
+    return false;
+  }
+  std::vector<size_t> bounds(num_threads + 1);
+  for (size_t i = 0; i <= num_threads; i++) {
+    bounds[i] = entries.size() * i / num_threads;
+  }
+  // Each thread checks the order within its range, which leaves the boundaries between ranges to check here.
+  for (size_t i = 1; i < num_threads; i++) {
+    if (comparator_(entries[bounds[i] - 1].first, entries[bounds[i]].first) >= 0) {
+      throw Exception(ExceptionType::INVALID, "bulk loaded keys are not strictly ascending");
+    }
+  }
+
+  std::vector<LevelEntries> subtrees(num_threads);
+  std::vector<std::exception_ptr> errors(num_threads);
+  auto run_threads = [&](const std::function<void(size_t)> &task) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < num_threads; i++) {
+      threads.emplace_back([&, i] {
+        try {
+          task(i);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  };
+
+  run_threads([&](size_t i) {
+    size_t pos = bounds[i];
+    BuildLeaves(
+        [&](MappingType *entry) {
+          if (pos == bounds[i + 1]) {
+            return false;
+          }
+          *entry = entries[pos++];
+          return true;
+        },
+        fill_factor, &subtrees[i]);
+  });
+  for (const auto &error : errors) {
+    if (error != nullptr) {
+      for (const auto &subtree : subtrees) {
+        for (const auto &[key, page_id] : subtree) {
+          bpm_->DeletePage(page_id);
+        }
+      }
+      std::rethrow_exception(error);
+    }
+  }
+  for (size_t i = 1; i < num_threads; i++) {
+    WritePageGuard guard = FetchWrite(subtrees[i - 1].back().second);
+    guard.AsMut<LeafPage>()->SetNextPageId(subtrees[i].front().second);
+    FetchWrite(subtrees[i].front().second).template AsMut<LeafPage>()->SetPrevPageId(guard.PageId());
+  }
+
+  // The subtrees grow as long as every one of them has enough pages at its top level for the level above to keep its
+  // pages at their min size without borrowing from its neighbours. The levels above them are built over all of them.
+  int min_size = BPlusTreePage::MinSize(false, internal_max_size_);
+  int fill = FillSize(fill_factor, std::max(min_size, 2), internal_max_size_);
+  std::vector<int> sizes;
+  for (const auto &subtree : subtrees) {
+    sizes.push_back(static_cast<int>(subtree.size()));
+  }
+  int depth = 0;
+  while (std::all_of(sizes.begin(), sizes.end(), [&](int size) { return size >= std::max(min_size, 2); })) {
+    for (auto &size : sizes) {
+      size = PageCount(size, fill, min_size);
+    }
+    depth++;
+  }
+  run_threads([&](size_t i) {
+    for (int level = 0; level < depth; level++) {
+      subtrees[i] = BuildInternalLevel(subtrees[i], fill_factor);
+    }
+  });
+  for (const auto &error : errors) {
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  LevelEntries level;
+  for (const auto &subtree : subtrees) {
+    level.insert(level.end(), subtree.begin(), subtree.end());
+  }
+  FinishBulkLoad(&header, std::move(level), fill_factor);
+  return true;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::FillSize(double fill_factor, int min_size, int capacity) -> int {
+  return std::clamp(static_cast<int>(fill_factor * capacity), min_size, capacity);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::PageCount(int n, int fill, int min_size) -> int {
+  return std::max(1, std::min((n + fill - 1) / fill, n / min_size));
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::BuildLeaves(const std::function<bool(MappingType *)> &next, double fill_factor,
+                                 LevelEntries *leaves) {
+  // A leaf splits once it reaches its max size, so it holds max size - 1 entries at most.
+  int capacity = leaf_max_size_ - 1;
+  int min_size = BPlusTreePage::MinSize(true, leaf_max_size_);
+  int fill = FillSize(fill_factor, min_size, capacity);
+  int byte_capacity = BUSTUB_PAGE_SIZE - LEAF_PAGE_HEADER_SIZE;
+  int byte_fill = FillSize(fill_factor, byte_capacity / 2, byte_capacity);
+
+  // The previous leaf stays latched, so that the last one can be evened out with it.
+  std::optional<WritePageGuard> prev;
+  std::optional<WritePageGuard> cur;
+  MappingType entry;
+  KeyType last_key;
+  while (next(&entry)) {
+    if (cur.has_value() && comparator_(last_key, entry.first) >= 0) {
+      throw Exception(ExceptionType::INVALID, "bulk loaded keys are not strictly ascending");
+    }
+    // A leaf takes entries until it holds `fill` of them, or fills that fraction of its bytes, or runs out of room.
+    bool added = false;
+    if (cur.has_value()) {
+      auto *leaf = cur->AsMut<LeafPage>();
+      added = leaf->GetSize() < fill && leaf->GetUsedBytes() < byte_fill &&
+              leaf->InsertAt(leaf->GetSize(), entry.first, entry.second);
+    }
+    if (!added) {
+      page_id_t page_id;
+      WritePageGuard guard = NewWrite(&page_id);
+      auto *leaf = guard.AsMut<LeafPage>();
+      leaf->Init(leaf_max_size_);
+      leaf->InsertAt(0, entry.first, entry.second);
+      if (cur.has_value()) {
+        cur->AsMut<LeafPage>()->SetNextPageId(page_id);
+        leaf->SetPrevPageId(cur->PageId());
+        leaves->emplace_back(comparator_.FindShortestSeparator(last_key, entry.first), page_id);
+      } else {
+        leaves->emplace_back(entry.first, page_id);
+      }
+      prev = std::move(cur);
+      cur = std::move(guard);
+    }
+    last_key = entry.first;
+  }
+  if (!prev.has_value() || !cur->As<LeafPage>()->IsUnderflow()) {
+    return;
+  }
+
+  // The last leaf is too small: fold it into the previous one if they fit in one leaf. Otherwise together they hold
+  // more than a leaf does, and spreading them evenly leaves neither too small.
+  auto *left = prev->AsMut<LeafPage>();
+  auto *right = cur->AsMut<LeafPage>();
+  auto entries = left->GetEntries();
+  auto right_entries = right->GetEntries();
+  entries.insert(entries.end(), right_entries.begin(), right_entries.end());
+  if (static_cast<int>(entries.size()) <= capacity && left->Assign(entries, 0, entries.size())) {
+    left->SetNextPageId(INVALID_PAGE_ID);
+    page_id_t right_page_id = cur->PageId();
+    cur->Drop();
+    bpm_->DeletePage(right_page_id);
+    leaves->pop_back();
+    return;
+  }
+  int split = left->SplitPoint(entries);
+  left->Assign(entries, 0, split);
+  right->Assign(entries, split, entries.size());
+  leaves->back().first = comparator_.FindShortestSeparator(entries[split - 1].first, entries[split].first);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::BuildInternalLevel(const LevelEntries &children, double fill_factor) -> LevelEntries {
+  // A page with a single child would not shrink the level, so pages get at least two.
+  int min_size = BPlusTreePage::MinSize(false, internal_max_size_);
+  int fill = FillSize(fill_factor, std::max(min_size, 2), internal_max_size_);
+  int n = static_cast<int>(children.size());
+  int num_pages = PageCount(n, fill, min_size);
+
+  // Children are spread evenly over the planned pages. A page that runs out of bytes early leaves its share to the
+  // next ones, and the last one may then have to be evened out with the one before it.
+  LevelEntries parents;
+  std::optional<WritePageGuard> prev;
+  std::optional<WritePageGuard> cur;
+  int target = 0;
+  for (int child = 0; child < n; child++) {
+    const auto &[key, child_page_id] = children[child];
+    bool added = false;
+    if (cur.has_value()) {
+      auto *page = cur->AsMut<InternalPage>();
+      added = page->GetSize() < target && page->InsertAt(page->GetSize(), key, child_page_id);
+    }
+    if (!added) {
+      int pages_left = std::max(num_pages - static_cast<int>(parents.size()), 1);
+      target = (n - child + pages_left - 1) / pages_left;
+      page_id_t page_id;
+      WritePageGuard guard = NewWrite(&page_id);
+      auto *page = guard.AsMut<InternalPage>();
+      page->Init(internal_max_size_);
+      page->InsertAt(0, key, child_page_id);
+      parents.emplace_back(key, page_id);
+      prev = std::move(cur);
+      cur = std::move(guard);
+    }
+  }
+  if (!prev.has_value() || !cur->As<InternalPage>()->IsUnderflow()) {
+    return parents;
+  }
+
+  auto *left = prev->AsMut<InternalPage>();
+  auto *right = cur->AsMut<InternalPage>();
+  auto entries = left->GetEntries();
+  auto right_entries = right->GetEntries();
+  right_entries[0].first = parents.back().first;
+  entries.insert(entries.end(), right_entries.begin(), right_entries.end());
+  if (static_cast<int>(entries.size()) <= internal_max_size_ && left->Assign(entries, 0, entries.size())) {
+    page_id_t right_page_id = cur->PageId();
+    cur->Drop();
+    bpm_->DeletePage(right_page_id);
+    parents.pop_back();
+    return parents;
+  }
+  int split = left->SplitPoint(entries);
+  left->Assign(entries, 0, split);
+  right->Assign(entries, split, entries.size());
+  parents.back().first = entries[split].first;
+  return parents;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::FinishBulkLoad(WritePageGuard *header, LevelEntries level, double fill_factor) {
+  while (level.size() > 1) {
+    level = BuildInternalLevel(level, fill_factor);
+  }
+  if (!level.empty()) {
+    SetRootPage(header->AsMut<BPlusTreeHeaderPage>(), level[0].second);
+  }
 }
 
 /*****************************************************************************
@@ -87,7 +983,7 @@ void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *txn) {
  * @return : index iterator
  */
 INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_TYPE::Begin() -> INDEXITERATOR_TYPE { return INDEXITERATOR_TYPE(); }
+auto BPLUSTREE_TYPE::Begin() -> INDEXITERATOR_TYPE { return Range(nullptr, true, nullptr, true); }
 
 /*
  * Input parameter is low key, find the leaf page that contains the input key
@@ -95,7 +991,16 @@ auto BPLUSTREE_TYPE::Begin() -> INDEXITERATOR_TYPE { return INDEXITERATOR_TYPE()
  * @return : index iterator
  */
 INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_TYPE::Begin(const KeyType &key) -> INDEXITERATOR_TYPE { return INDEXITERATOR_TYPE(); }
+auto BPLUSTREE_TYPE::Begin(const KeyType &key) -> INDEXITERATOR_TYPE { return Range(&key, true, nullptr, true); }
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::RBegin() -> INDEXITERATOR_TYPE { return Range(nullptr, true, nullptr, true, true); }
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::Range(const KeyType *low, bool low_inclusive, const KeyType *high, bool high_inclusive,
+                           bool reverse) -> INDEXITERATOR_TYPE {
+  return INDEXITERATOR_TYPE(this, low, low_inclusive, high, high_inclusive, reverse);
+}
 
 /*
  * Input parameter is void, construct an index iterator representing the end
@@ -109,7 +1014,10 @@ auto BPLUSTREE_TYPE::End() -> INDEXITERATOR_TYPE { return INDEXITERATOR_TYPE();
  * @return Page id of the root of this tree
  */
 INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_TYPE::GetRootPageId() -> page_id_t { return 0; }
+auto BPLUSTREE_TYPE::GetRootPageId() -> page_id_t {
+  ReadPageGuard guard = bpm_->FetchPageRead(header_page_id_);
+  return guard.As<BPlusTreeHeaderPage>()->root_page_id_;
+}
 
 /*****************************************************************************
  * UTILITIES AND DEBUG
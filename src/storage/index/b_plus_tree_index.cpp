@@ -11,7 +11,77 @@
 
 #include "storage/index/b_plus_tree_index.h"
 
+#include <algorithm>
+#include <numeric>
+#include <optional>
+
 namespace bustub {
+
+/** See BPlusTreeIndex::ScanRange. */
+INDEX_TEMPLATE_ARGUMENTS
+class BPlusTreeIndexCursor : public IndexScanCursor {
+ public:
+  BPlusTreeIndexCursor(std::shared_ptr<BPlusTree<KeyType, ValueType, KeyComparator>> tree,
+                       std::optional<KeyType> low, bool low_inclusive, std::optional<KeyType> high,
+                       bool high_inclusive, bool reverse)
+      : tree_(std::move(tree)),
+        low_(low),
+        low_inclusive_(low_inclusive),
+        high_(high),
+        high_inclusive_(high_inclusive),
+        reverse_(reverse) {}
+
+  auto Next(RID *rid) -> bool override {
+    if (batch_index_ == batch_.size()) {
+      if (exhausted_) {
+        return false;
+      }
+      ReadBatch();
+      if (batch_.empty()) {
+        return false;
+      }
+    }
+    *rid = batch_[batch_index_++];
+    return true;
+  }
+
+ private:
+  void ReadBatch() {
+    batch_.clear();
+    batch_index_ = 0;
+    auto iter = tree_->Range(low_.has_value() ? &*low_ : nullptr, low_inclusive_,
+                             high_.has_value() ? &*high_ : nullptr, high_inclusive_, reverse_);
+    KeyType last_key;
+    while (!iter.IsEnd() && batch_.size() < static_cast<size_t>(INDEX_SCAN_BATCH_SIZE)) {
+      const auto &[key, value] = *iter;
+      batch_.push_back(value);
+      last_key = key;
+      ++iter;
+    }
+    exhausted_ = iter.IsEnd();
+    // Keys are unique, so the next batch starts right after the last key of this one.
+    if (!batch_.empty()) {
+      if (reverse_) {
+        high_ = last_key;
+        high_inclusive_ = false;
+      } else {
+        low_ = last_key;
+        low_inclusive_ = false;
+      }
+    }
+  }
+
+  std::shared_ptr<BPlusTree<KeyType, ValueType, KeyComparator>> tree_;
+  std::optional<KeyType> low_;
+  bool low_inclusive_;
+  std::optional<KeyType> high_;
+  bool high_inclusive_;
+  bool reverse_;
+  std::vector<ValueType> batch_;
+  size_t batch_index_{0};
+  bool exhausted_{false};
+};
+
 /*
  * Constructor
  */
@@ -20,8 +90,9 @@ BPLUSTREE_INDEX_TYPE::BPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata,
     : Index(std::move(metadata)), comparator_(GetMetadata()->GetKeySchema()) {
   page_id_t header_page_id;
   buffer_pool_manager->NewPage(&header_page_id);
-  container_ = std::make_shared<BPlusTree<KeyType, ValueType, KeyComparator>>(GetMetadata()->GetName(), header_page_id,
-                                                                              buffer_pool_manager, comparator_);
+  container_ = std::make_shared<BPlusTree<KeyType, ValueType, KeyComparator>>(
+      GetMetadata()->GetName(), header_page_id, buffer_pool_manager, comparator_, LEAF_PAGE_SIZE, INTERNAL_PAGE_SIZE,
+      BPlusTreeLatchMode::Optimistic);
 }
 
 INDEX_TEMPLATE_ARGUMENTS
@@ -51,6 +122,57 @@ void BPLUSTREE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, T
   container_->GetValue(index_key, result, transaction);
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::ScanKeys(const std::vector<Tuple> &keys, std::vector<std::vector<RID>> *results,
+                                    Transaction *transaction) {
+  std::vector<KeyType> index_keys(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromKey(keys[i]);
+  }
+  std::vector<size_t> order(keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&](size_t a, size_t b) { return comparator_(index_keys[a], index_keys[b]) < 0; });
+
+  std::vector<KeyType> sorted_keys;
+  sorted_keys.reserve(keys.size());
+  for (auto i : order) {
+    sorted_keys.push_back(index_keys[i]);
+  }
+  std::vector<std::vector<RID>> sorted_results;
+  container_->GetValues(sorted_keys, &sorted_results, transaction);
+
+  results->assign(keys.size(), {});
+  for (size_t i = 0; i < order.size(); i++) {
+    (*results)[order[i]] = std::move(sorted_results[i]);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::ScanRange(const IndexScanRange &range, Transaction *transaction)
+    -> std::unique_ptr<IndexScanCursor> {
+  auto to_key = [](const std::optional<Tuple> &bound) -> std::optional<KeyType> {
+    if (!bound.has_value()) {
+      return std::nullopt;
+    }
+    KeyType index_key;
+    index_key.SetFromKey(*bound);
+    return index_key;
+  };
+  return std::make_unique<BPlusTreeIndexCursor<KeyType, ValueType, KeyComparator>>(
+      container_, to_key(range.low_), range.low_inclusive_, to_key(range.high_), range.high_inclusive_,
+      range.reverse_);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::BulkLoad(std::vector<std::pair<KeyType, ValueType>> entries, size_t num_threads) -> bool {
+  auto less = [&](const auto &a, const auto &b) { return comparator_(a.first, b.first) < 0; };
+  std::stable_sort(entries.begin(), entries.end(), less);
+  auto equal = [&](const auto &a, const auto &b) { return comparator_(a.first, b.first) == 0; };
+  entries.erase(std::unique(entries.begin(), entries.end(), equal), entries.end());
+  return container_->BulkLoadParallel(entries, num_threads);
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_INDEX_TYPE::GetBeginIterator() -> INDEXITERATOR_TYPE { return container_->Begin(); }
 
@@ -1,8 +1,33 @@
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "storage/index/extendible_hash_table_index.h"
 
 namespace bustub {
+
+namespace {
+
+/** The entries of a point lookup, all looked up at once. */
+class HashIndexCursor : public IndexScanCursor {
+ public:
+  explicit HashIndexCursor(std::vector<RID> rids) : rids_(std::move(rids)) {}
+
+  auto Next(RID *rid) -> bool override {
+    if (next_ == rids_.size()) {
+      return false;
+    }
+    *rid = rids_[next_++];
+    return true;
+  }
+
+ private:
+  std::vector<RID> rids_;
+  size_t next_{0};
+};
+
+}  // namespace
+
 /*
  * Constructor
  */
@@ -40,6 +65,24 @@ void HASH_TABLE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result,
 
   container_.GetValue(transaction, index_key, result);
 }
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_INDEX_TYPE::ScanRange(const IndexScanRange &range, Transaction *transaction)
+    -> std::unique_ptr<IndexScanCursor> {
+  if (!range.low_.has_value() || !range.high_.has_value() || !range.low_inclusive_ || !range.high_inclusive_) {
+    throw NotImplementedException("hash indexes only support point lookups");
+  }
+  KeyType low_key;
+  low_key.SetFromKey(*range.low_);
+  KeyType high_key;
+  high_key.SetFromKey(*range.high_);
+  if (comparator_(low_key, high_key) != 0) {
+    throw NotImplementedException("hash indexes only support point lookups");
+  }
+  std::vector<RID> rids;
+  container_.GetValue(transaction, low_key, &rids);
+  return std::make_unique<HashIndexCursor>(std::move(rids));
+}
 template class ExtendibleHashTableIndex<GenericKey<4>, RID, GenericComparator<4>>;
 template class ExtendibleHashTableIndex<GenericKey<8>, RID, GenericComparator<8>>;
 template class ExtendibleHashTableIndex<GenericKey<16>, RID, GenericComparator<16>>;
@@ -3,28 +3,165 @@
  */
 #include <cassert>
 
+#include "storage/index/b_plus_tree.h"
 #include "storage/index/index_iterator.h"
 
 namespace bustub {
 
-/*
- * NOTE: you can change the destructor/constructor method here
- * set your own input parameters
- */
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE::IndexIterator() = default;
 
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE::IndexIterator(Tree *tree, const KeyType *low, bool low_inclusive, const KeyType *high,
+                                  bool high_inclusive, bool reverse)
+    : tree_(tree), low_inclusive_(low_inclusive), high_inclusive_(high_inclusive), reverse_(reverse) {
+  if (low != nullptr) {
+    low_ = *low;
+  }
+  if (high != nullptr) {
+    high_ = *high;
+  }
+  Seek();
+  if (reverse_) {
+    SkipExhaustedLeavesBackward();
+  } else {
+    SkipExhaustedLeaves();
+  }
+  CheckEnd();
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE::~IndexIterator() = default;  // NOLINT
 
 INDEX_TEMPLATE_ARGUMENTS
-auto INDEXITERATOR_TYPE::IsEnd() -> bool { throw std::runtime_error("unimplemented"); }
+auto INDEXITERATOR_TYPE::IsEnd() -> bool { return page_id_ == INVALID_PAGE_ID; }
+
+INDEX_TEMPLATE_ARGUMENTS
+auto INDEXITERATOR_TYPE::operator*() -> const MappingType & {
+  BUSTUB_ASSERT(!IsEnd(), "dereferencing the end iterator");
+  const auto *leaf = guard_.template As<LeafPage>();
+  entry_ = {leaf->KeyAt(index_), leaf->ValueAt(index_)};
+  return entry_;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto INDEXITERATOR_TYPE::operator++() -> INDEXITERATOR_TYPE & {
+  if (IsEnd()) {
+    return *this;
+  }
+  if (reverse_) {
+    high_ = guard_.template As<LeafPage>()->KeyAt(index_);
+    high_inclusive_ = false;
+    index_--;
+    SkipExhaustedLeavesBackward();
+  } else {
+    index_++;
+    SkipExhaustedLeaves();
+  }
+  CheckEnd();
+  return *this;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::Seek() {
+  const KeyType *bound = reverse_ ? (high_.has_value() ? &*high_ : nullptr) : (low_.has_value() ? &*low_ : nullptr);
+  auto guard = tree_->FindLeafRead(bound, reverse_);
+  if (!guard.has_value()) {
+    SetEnd();
+    return;
+  }
+  guard_ = std::move(*guard);
+  page_id_ = guard_.PageId();
+  const auto *leaf = guard_.template As<LeafPage>();
+  if (bound == nullptr) {
+    index_ = reverse_ ? leaf->GetSize() - 1 : 0;
+  } else if (reverse_) {
+    // The last key not greater than the bound, or less than it if the bound is excluded.
+    index_ = leaf->SearchKey(*bound, tree_->comparator_, 0, leaf->GetSize(), high_inclusive_) - 1;
+  } else {
+    index_ = leaf->SearchKey(*bound, tree_->comparator_, 0, leaf->GetSize(), !low_inclusive_);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::SkipExhaustedLeaves() {
+  while (page_id_ != INVALID_PAGE_ID) {
+    const auto *leaf = guard_.template As<LeafPage>();
+    if (index_ < leaf->GetSize()) {
+      return;
+    }
+    page_id_t next_page_id = leaf->GetNextPageId();
+    if (next_page_id == INVALID_PAGE_ID) {
+      SetEnd();
+      return;
+    }
+    // Assigning the next guard releases the current leaf only once the next one is latched.
+    guard_ = tree_->bpm_->FetchPageRead(next_page_id, AccessType::Scan);
+    page_id_ = next_page_id;
+    index_ = 0;
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::SkipExhaustedLeavesBackward() {
+  while (page_id_ != INVALID_PAGE_ID) {
+    const auto *leaf = guard_.template As<LeafPage>();
+    if (index_ >= 0) {
+      return;
+    }
+    page_id_t prev_page_id = leaf->GetPrevPageId();
+    if (prev_page_id == INVALID_PAGE_ID) {
+      SetEnd();
+      return;
+    }
+    // Latching the sibling while holding this leaf could deadlock with writers, which latch left to right. Keep the
+    // leaf pinned instead, and check afterwards that no writer touched it in between: entries it lent to or borrowed
+    // from the sibling would otherwise be read twice or not at all.
+    page_id_t page_id = page_id_;
+    Page *page = tree_->bpm_->FetchPage(page_id, AccessType::Scan);
+    uint64_t version = page == nullptr ? 0 : page->GetVersion();
+    guard_.Drop();
+    guard_ = tree_->bpm_->FetchPageRead(prev_page_id, AccessType::Scan);
+    leaf = guard_.template As<LeafPage>();
+    bool unchanged = page != nullptr && page->ValidateVersion(version);
+    if (page != nullptr) {
+      tree_->bpm_->UnpinPage(page_id, false, AccessType::Scan);
+    }
+    if (!unchanged || !leaf->IsLeafPage() || leaf->GetNextPageId() != page_id) {
+      // The sibling split, merged or was deleted, or entries moved between the two, while no leaf was latched.
+      guard_.Drop();
+      Seek();
+      continue;
+    }
+    page_id_ = prev_page_id;
+    index_ = leaf->GetSize() - 1;
+  }
+}
 
 INDEX_TEMPLATE_ARGUMENTS
-auto INDEXITERATOR_TYPE::operator*() -> const MappingType & { throw std::runtime_error("unimplemented"); }
+void INDEXITERATOR_TYPE::CheckEnd() {
+  if (IsEnd()) {
+    return;
+  }
+  const auto &bound = reverse_ ? low_ : high_;
+  if (!bound.has_value()) {
+    return;
+  }
+  int cmp = tree_->comparator_(guard_.template As<LeafPage>()->KeyAt(index_), *bound);
+  bool inclusive = reverse_ ? low_inclusive_ : high_inclusive_;
+  if (reverse_ ? cmp < 0 : cmp > 0) {
+    SetEnd();
+  } else if (cmp == 0 && !inclusive) {
+    SetEnd();
+  }
+}
 
 INDEX_TEMPLATE_ARGUMENTS
-auto INDEXITERATOR_TYPE::operator++() -> INDEXITERATOR_TYPE & { throw std::runtime_error("unimplemented"); }
+void INDEXITERATOR_TYPE::SetEnd() {
+  guard_.Drop();
+  page_id_ = INVALID_PAGE_ID;
+  index_ = 0;
+}
 
 template class IndexIterator<GenericKey<4>, RID, GenericComparator<4>>;
 
@@ -0,0 +1,139 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_array_page.cpp
+//
+// Identification: src/storage/page/b_plus_tree_array_page.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+
+#include "common/rid.h"
+#include "storage/page/b_plus_tree_array_page.h"
+
+namespace bustub {
+
+#define ARRAY_TEMPLATE_ARGUMENTS template <typename KeyType, typename ValueType>
+#define B_PLUS_TREE_ARRAY_PAGE_TYPE BPlusTreeArrayPage<KeyType, ValueType>
+
+ARRAY_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_ARRAY_PAGE_TYPE::InitEntries(int header_size) {
+  keys_offset_ = (header_size + sizeof(KeyType) - 1) / sizeof(KeyType) * sizeof(KeyType);
+  capacity_ = (BUSTUB_PAGE_SIZE - keys_offset_) / ENTRY_SIZE;
+  values_offset_ = keys_offset_ + capacity_ * sizeof(KeyType);
+}
+
+/*****************************************************************************
+ * ACCESSORS
+ *****************************************************************************/
+/*
+ * Indexes are checked against the page rather than its size, which a reader racing with a writer may see torn.
+ */
+ARRAY_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_ARRAY_PAGE_TYPE::KeyAt(int index) const -> KeyType {
+  KeyType key;
+  size_t offset = keys_offset_ + static_cast<size_t>(index) * sizeof(KeyType);
+  if (index < 0 || offset + sizeof(KeyType) > BUSTUB_PAGE_SIZE) {
+    memset(&key, 0, sizeof(KeyType));
+    return key;
+  }
+  memcpy(&key, Bytes() + offset, sizeof(KeyType));
+  return key;
+}
+
+ARRAY_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_ARRAY_PAGE_TYPE::ValueAt(int index) const -> ValueType {
+  size_t offset = values_offset_ + static_cast<size_t>(index) * sizeof(ValueType);
+  if (index < 0 || offset + sizeof(ValueType) > BUSTUB_PAGE_SIZE) {
+    return {};
+  }
+  ValueType value;
+  memcpy(&value, Bytes() + offset, sizeof(ValueType));
+  return value;
+}
+
+ARRAY_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_ARRAY_PAGE_TYPE::SetValueAt(int index, const ValueType &value) {
+  memcpy(Bytes() + values_offset_ + index * sizeof(ValueType), &value, sizeof(ValueType));
+}
+
+ARRAY_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_ARRAY_PAGE_TYPE::GetEntries() const -> std::vector<Entry> {
+  std::vector<Entry> entries;
+  entries.reserve(GetSize());
+  for (int i = 0; i < GetSize(); i++) {
+    entries.emplace_back(KeyAt(i), ValueAt(i));
+  }
+  return entries;
+}
+
+/*****************************************************************************
+ * MODIFIERS
+ *****************************************************************************/
+ARRAY_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_ARRAY_PAGE_TYPE::InsertAt(int index, const KeyType &key, const ValueType &value) -> bool {
+  if (GetSize() >= capacity_) {
+    return false;
+  }
+  char *keys = Bytes() + keys_offset_;
+  char *values = Bytes() + values_offset_;
+  memmove(keys + (index + 1) * sizeof(KeyType), keys + index * sizeof(KeyType), (GetSize() - index) * sizeof(KeyType));
+  memmove(values + (index + 1) * sizeof(ValueType), values + index * sizeof(ValueType),
+          (GetSize() - index) * sizeof(ValueType));
+  memcpy(keys + index * sizeof(KeyType), &key, sizeof(KeyType));
+  memcpy(values + index * sizeof(ValueType), &value, sizeof(ValueType));
+  IncreaseSize(1);
+  return true;
+}
+
+ARRAY_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_ARRAY_PAGE_TYPE::RemoveAt(int index) {
+  char *keys = Bytes() + keys_offset_;
+  char *values = Bytes() + values_offset_;
+  memmove(keys + index * sizeof(KeyType), keys + (index + 1) * sizeof(KeyType),
+          (GetSize() - index - 1) * sizeof(KeyType));
+  memmove(values + index * sizeof(ValueType), values + (index + 1) * sizeof(ValueType),
+          (GetSize() - index - 1) * sizeof(ValueType));
+  IncreaseSize(-1);
+}
+
+ARRAY_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_ARRAY_PAGE_TYPE::SetKeyAt(int index, const KeyType &key) -> bool {
+  memcpy(Bytes() + keys_offset_ + index * sizeof(KeyType), &key, sizeof(KeyType));
+  return true;
+}
+
+ARRAY_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_ARRAY_PAGE_TYPE::Assign(const std::vector<Entry> &entries, size_t begin, size_t end) -> bool {
+  if (end - begin > static_cast<size_t>(capacity_)) {
+    return false;
+  }
+  SetSize(static_cast<int>(end - begin));
+  for (size_t i = begin; i < end; i++) {
+    memcpy(Bytes() + keys_offset_ + (i - begin) * sizeof(KeyType), &entries[i].first, sizeof(KeyType));
+    memcpy(Bytes() + values_offset_ + (i - begin) * sizeof(ValueType), &entries[i].second, sizeof(ValueType));
+  }
+  return true;
+}
+
+/*****************************************************************************
+ * SPACE ACCOUNTING
+ *****************************************************************************/
+ARRAY_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_ARRAY_PAGE_TYPE::SplitPoint(const std::vector<Entry> &entries) const -> int {
+  int n = static_cast<int>(entries.size());
+  int limit = std::min(GetMaxEntries(), static_cast<int>(capacity_));
+  int split = n / 2;
+  if (split == 0 || split > limit || n - split > limit) {
+    return -1;
+  }
+  return split;
+}
+
+template class BPlusTreeArrayPage<GenericKey<8>, RID>;
+template class BPlusTreeArrayPage<GenericKey<8>, page_id_t>;
+}  // namespace bustub
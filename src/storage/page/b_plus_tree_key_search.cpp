@@ -0,0 +1,146 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_key_search.cpp
+//
+// Identification: src/storage/page/b_plus_tree_key_search.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/b_plus_tree_key_search.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace bustub {
+
+namespace {
+
+/** Binary search stops once this few keys are left, which the vector kernels compare all at once. */
+constexpr int VECTOR_WINDOW = 16;
+
+/** @return how many keys in [begin, end) are less than the key, or not greater than it if `upper` */
+auto CountScalar(const char *keys, int begin, int end, int64_t key, int shift, bool upper) -> int {
+  int count = 0;
+  for (int i = begin; i < end; i++) {
+    int64_t stored = NormalizeIntegerKey(keys + i * sizeof(int64_t), shift);
+    count += static_cast<int>(upper ? stored <= key : stored < key);
+  }
+  return count;
+}
+
+#if defined(__x86_64__)
+/*
+ * The vector kernels are compiled for their instruction set whatever the build targets, and pages pick one at run
+ * time, see DefaultKeySearchKernel.
+ */
+__attribute__((target("sse4.2"))) auto CountSse42(const char *keys, int begin, int end, int64_t key, int shift,
+                                                   bool upper) -> int {
+  __m128i target = _mm_set1_epi64x(key);
+  __m128i shift_count = _mm_cvtsi32_si128(shift);
+  int count = 0;
+  int i = begin;
+  for (; i + 2 <= end; i += 2) {
+    __m128i stored = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i * sizeof(int64_t)));
+    stored = _mm_sll_epi64(stored, shift_count);
+    if (upper) {
+      count += 2 - __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(stored, target))));
+    } else {
+      count += __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(target, stored))));
+    }
+  }
+  return count + CountScalar(keys, i, end, key, shift, upper);
+}
+
+__attribute__((target("avx2"))) auto CountAvx2(const char *keys, int begin, int end, int64_t key, int shift,
+                                                bool upper) -> int {
+  __m256i target = _mm256_set1_epi64x(key);
+  __m128i shift_count = _mm_cvtsi32_si128(shift);
+  int count = 0;
+  int i = begin;
+  for (; i + 4 <= end; i += 4) {
+    __m256i stored = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i * sizeof(int64_t)));
+    stored = _mm256_sll_epi64(stored, shift_count);
+    if (upper) {
+      count += 4 - __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(stored, target))));
+    } else {
+      count += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(target, stored))));
+    }
+  }
+  return count + CountScalar(keys, i, end, key, shift, upper);
+}
+#endif
+
+}  // namespace
+
+auto KeySearchKernelToString(KeySearchKernel kernel) -> std::string {
+  switch (kernel) {
+    case KeySearchKernel::Scalar:
+      return "scalar";
+    case KeySearchKernel::SSE42:
+      return "sse4.2";
+    case KeySearchKernel::AVX2:
+      return "avx2";
+  }
+  return "unknown";
+}
+
+auto KeySearchKernelSupported(KeySearchKernel kernel) -> bool {
+  switch (kernel) {
+    case KeySearchKernel::Scalar:
+      return true;
+#if defined(__x86_64__)
+    case KeySearchKernel::SSE42:
+      return __builtin_cpu_supports("sse4.2");
+    case KeySearchKernel::AVX2:
+      return __builtin_cpu_supports("avx2");
+#endif
+    default:
+      return false;
+  }
+}
+
+auto DefaultKeySearchKernel() -> KeySearchKernel {
+  static const KeySearchKernel KERNEL = [] {
+    for (auto kernel : {KeySearchKernel::AVX2, KeySearchKernel::SSE42}) {
+      if (KeySearchKernelSupported(kernel)) {
+        return kernel;
+      }
+    }
+    return KeySearchKernel::Scalar;
+  }();
+  return KERNEL;
+}
+
+auto SearchIntegerKeys(const char *keys, int begin, int end, int64_t key, int shift, bool upper,
+                       KeySearchKernel kernel) -> int {
+  int left = begin;
+  int right = end;
+  int window = kernel == KeySearchKernel::Scalar ? 0 : VECTOR_WINDOW;
+  while (right - left > window) {
+    int mid = left + (right - left) / 2;
+    int64_t stored = NormalizeIntegerKey(keys + mid * sizeof(int64_t), shift);
+    if (stored < key || (upper && stored == key)) {
+      left = mid + 1;
+    } else {
+      right = mid;
+    }
+  }
+  // The position is in [left, right]: the kernel counts how many of the keys in between come before it.
+  switch (kernel) {
+#if defined(__x86_64__)
+    case KeySearchKernel::SSE42:
+      return left + CountSse42(keys, left, right, key, shift, upper);
+    case KeySearchKernel::AVX2:
+      return left + CountAvx2(keys, left, right, key, shift, upper);
+#endif
+    default:
+      return left + CountScalar(keys, left, right, key, shift, upper);
+  }
+}
+
+}  // namespace bustub
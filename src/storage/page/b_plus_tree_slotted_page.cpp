@@ -0,0 +1,343 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_slotted_page.cpp
+//
+// Identification: src/storage/page/b_plus_tree_slotted_page.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/rid.h"
+#include "storage/page/b_plus_tree_slotted_page.h"
+
+namespace bustub {
+
+#define SLOTTED_TEMPLATE_ARGUMENTS template <typename KeyType, typename ValueType>
+#define B_PLUS_TREE_SLOTTED_PAGE_TYPE BPlusTreeSlottedPage<KeyType, ValueType>
+
+SLOTTED_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_SLOTTED_PAGE_TYPE::InitEntries(int header_size) {
+  static_assert(sizeof(Slot) == sizeof(ValueType) + 2 * sizeof(uint16_t), "slots must not be padded");
+  slots_offset_ = header_size;
+  prefix_size_ = 0;
+  heap_begin_ = BUSTUB_PAGE_SIZE;
+  garbage_size_ = 0;
+}
+
+/*****************************************************************************
+ * ACCESSORS
+ *****************************************************************************/
+/*
+ * Every offset is read once and clamped, so that a reader racing with a writer never reads outside of the page.
+ */
+SLOTTED_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_SLOTTED_PAGE_TYPE::KeyAt(int index) const -> KeyType {
+  KeyType key;
+  auto *out = reinterpret_cast<char *>(&key);
+  memset(out, 0, sizeof(KeyType));
+  if (!StoresKey(index)) {
+    return key;
+  }
+  size_t slot_offset = slots_offset_ + static_cast<size_t>(index) * sizeof(Slot);
+  if (slot_offset + sizeof(Slot) > BUSTUB_PAGE_SIZE) {
+    return key;
+  }
+  Slot slot;
+  memcpy(&slot, Bytes() + slot_offset, sizeof(Slot));
+  size_t prefix_size = std::min<size_t>(prefix_size_, sizeof(KeyType));
+  size_t suffix_size = std::min<size_t>(slot.size_, sizeof(KeyType) - prefix_size);
+  size_t suffix_offset = std::min<size_t>(slot.offset_, BUSTUB_PAGE_SIZE - suffix_size);
+  memcpy(out, Bytes() + BUSTUB_PAGE_SIZE - prefix_size, prefix_size);
+  memcpy(out + prefix_size, Bytes() + suffix_offset, suffix_size);
+  return key;
+}
+
+SLOTTED_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_SLOTTED_PAGE_TYPE::ValueAt(int index) const -> ValueType {
+  size_t slot_offset = slots_offset_ + static_cast<size_t>(index) * sizeof(Slot);
+  if (slot_offset + sizeof(Slot) > BUSTUB_PAGE_SIZE) {
+    return {};
+  }
+  ValueType value;
+  memcpy(&value, Bytes() + slot_offset, sizeof(ValueType));
+  return value;
+}
+
+SLOTTED_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_SLOTTED_PAGE_TYPE::SetValueAt(int index, const ValueType &value) { Slots()[index].value_ = value; }
+
+SLOTTED_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_SLOTTED_PAGE_TYPE::GetEntries() const -> std::vector<Entry> {
+  std::vector<Entry> entries;
+  entries.reserve(GetSize());
+  for (int i = 0; i < GetSize(); i++) {
+    entries.emplace_back(KeyAt(i), ValueAt(i));
+  }
+  return entries;
+}
+
+/*****************************************************************************
+ * MODIFIERS
+ *****************************************************************************/
+SLOTTED_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_SLOTTED_PAGE_TYPE::InsertAt(int index, const KeyType &key, const ValueType &value) -> bool {
+  bool stores_key = StoresKey(index);
+  if (stores_key && (GetNumKeys() == 0 || MatchPrefix(key) < prefix_size_)) {
+    // The page gets its first key, or one that shortens the prefix.
+    auto entries = GetEntries();
+    entries.emplace(entries.begin() + index, key, value);
+    return Assign(entries, 0, entries.size());
+  }
+
+  int suffix_size = stores_key ? std::max(KeySize(key) - prefix_size_, 0) : 0;
+  int needed = static_cast<int>(sizeof(Slot)) + suffix_size;
+  if (GetFreeSpace() < needed) {
+    if (GetUsedBytes() + needed > GetCapacity()) {
+      return false;
+    }
+    Write(GetEntries(), 0, GetSize(), prefix_size_);
+  }
+  heap_begin_ -= suffix_size;
+  memcpy(Bytes() + heap_begin_, reinterpret_cast<const char *>(&key) + prefix_size_, suffix_size);
+  Slot *slots = Slots();
+  memmove(slots + index + 1, slots + index, (GetSize() - index) * sizeof(Slot));
+  slots[index] = {value, heap_begin_, static_cast<uint16_t>(suffix_size)};
+  IncreaseSize(1);
+  return true;
+}
+
+SLOTTED_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_SLOTTED_PAGE_TYPE::RemoveAt(int index) {
+  Slot *slots = Slots();
+  garbage_size_ += slots[index].size_;
+  memmove(slots + index, slots + index + 1, (GetSize() - index - 1) * sizeof(Slot));
+  IncreaseSize(-1);
+  if (!IsLeafPage() && index == 0 && GetSize() > 0) {
+    // The second key of an internal page becomes its first one, which is not stored.
+    garbage_size_ += slots[0].size_;
+    slots[0].size_ = 0;
+  }
+  if (GetNumKeys() == 0) {
+    prefix_size_ = 0;
+    heap_begin_ = BUSTUB_PAGE_SIZE;
+    garbage_size_ = 0;
+  }
+}
+
+SLOTTED_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_SLOTTED_PAGE_TYPE::SetKeyAt(int index, const KeyType &key) -> bool {
+  if (!StoresKey(index)) {
+    return true;
+  }
+  Slot &slot = Slots()[index];
+  if (MatchPrefix(key) == prefix_size_) {
+    int suffix_size = std::max(KeySize(key) - prefix_size_, 0);
+    const char *suffix = reinterpret_cast<const char *>(&key) + prefix_size_;
+    if (suffix_size <= slot.size_) {
+      memcpy(Bytes() + slot.offset_, suffix, suffix_size);
+      garbage_size_ += slot.size_ - suffix_size;
+      slot.size_ = suffix_size;
+      return true;
+    }
+    if (suffix_size <= GetFreeSpace()) {
+      heap_begin_ -= suffix_size;
+      memcpy(Bytes() + heap_begin_, suffix, suffix_size);
+      garbage_size_ += slot.size_;
+      slot.offset_ = heap_begin_;
+      slot.size_ = suffix_size;
+      return true;
+    }
+  }
+  auto entries = GetEntries();
+  entries[index].first = key;
+  return Assign(entries, 0, entries.size());
+}
+
+SLOTTED_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_SLOTTED_PAGE_TYPE::Assign(const std::vector<Entry> &entries, size_t begin, size_t end) -> bool {
+  SizeCounter counter;
+  for (size_t i = begin; i < end; i++) {
+    counter.AddSlot();
+    if (IsLeafPage() || i > begin) {
+      counter.AddKey(entries[i].first);
+    }
+  }
+  if (counter.GetBytes() > GetCapacity()) {
+    return false;
+  }
+  Write(entries, begin, end, counter.GetPrefixSize());
+  return true;
+}
+
+SLOTTED_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_SLOTTED_PAGE_TYPE::Write(const std::vector<Entry> &entries, size_t begin, size_t end,
+                                           int prefix_size) {
+  SetSize(static_cast<int>(end - begin));
+  prefix_size_ = GetNumKeys() == 0 ? 0 : prefix_size;
+  heap_begin_ = BUSTUB_PAGE_SIZE - prefix_size_;
+  garbage_size_ = 0;
+  if (prefix_size_ > 0) {
+    size_t first_key = IsLeafPage() ? begin : begin + 1;
+    memcpy(Bytes() + heap_begin_, &entries[first_key].first, prefix_size_);
+  }
+  Slot *slots = Slots();
+  for (size_t i = begin; i < end; i++) {
+    int suffix_size = IsLeafPage() || i > begin ? std::max(KeySize(entries[i].first) - prefix_size_, 0) : 0;
+    heap_begin_ -= suffix_size;
+    memcpy(Bytes() + heap_begin_, reinterpret_cast<const char *>(&entries[i].first) + prefix_size_, suffix_size);
+    slots[i - begin] = {entries[i].second, heap_begin_, static_cast<uint16_t>(suffix_size)};
+  }
+}
+
+/*****************************************************************************
+ * SPACE ACCOUNTING
+ *****************************************************************************/
+SLOTTED_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_SLOTTED_PAGE_TYPE::GetUsedBytes() const -> int {
+  return GetSize() * static_cast<int>(sizeof(Slot)) + BUSTUB_PAGE_SIZE - heap_begin_ - garbage_size_;
+}
+
+SLOTTED_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_SLOTTED_PAGE_TYPE::IsUnderflow() const -> bool {
+  return GetSize() < GetMinSize() && GetUsedBytes() < GetCapacity() / 4;
+}
+
+/*
+ * In the worst case the new key is as long as a key gets, and shares nothing with the prefix, which every stored key
+ * then has to hold in its suffix.
+ */
+SLOTTED_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_SLOTTED_PAGE_TYPE::IsSafeToInsert() const -> bool {
+  int worst = GetUsedBytes() + static_cast<int>(sizeof(Slot) + sizeof(KeyType)) + prefix_size_ * GetNumKeys();
+  return worst <= GetCapacity();
+}
+
+SLOTTED_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_SLOTTED_PAGE_TYPE::IsSafeToRemove() const -> bool {
+  return GetSize() - 1 >= GetMinSize() ||
+         GetUsedBytes() - static_cast<int>(sizeof(Slot) + sizeof(KeyType)) >= GetCapacity() / 4;
+}
+
+SLOTTED_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_SLOTTED_PAGE_TYPE::CanRemoveAt(int index) const -> bool {
+  return GetSize() - 1 >= GetMinSize() ||
+         GetUsedBytes() - static_cast<int>(sizeof(Slot)) - Slots()[index].size_ >= GetCapacity() / 4;
+}
+
+/*
+ * A page is as full as the fuller of its entry count and its bytes make it. Sizes of every prefix and suffix of the
+ * entries are counted first, then the split that leaves the emptier page fullest wins, the leftmost on ties.
+ */
+SLOTTED_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_SLOTTED_PAGE_TYPE::SplitPoint(const std::vector<Entry> &entries) const -> int {
+  int n = static_cast<int>(entries.size());
+  bool is_leaf = IsLeafPage();
+  std::vector<int> left_bytes(n + 1);
+  std::vector<int> right_bytes(n + 1);
+  SizeCounter left;
+  for (int k = 1; k <= n; k++) {
+    left.AddSlot();
+    if (is_leaf || k > 1) {
+      left.AddKey(entries[k - 1].first);
+    }
+    left_bytes[k] = left.GetBytes();
+  }
+  SizeCounter right;
+  for (int k = n - 1; k >= 0; k--) {
+    right.AddSlot();
+    // The first key of an internal page is not stored.
+    if (is_leaf || k + 1 < n) {
+      right.AddKey(entries[is_leaf ? k : k + 1].first);
+    }
+    right_bytes[k] = right.GetBytes();
+  }
+
+  int max_entries = GetMaxEntries();
+  double capacity = GetCapacity();
+  auto fill = [&](int count, int bytes) {
+    return std::max(static_cast<double>(count) / max_entries, static_cast<double>(bytes) / capacity);
+  };
+  int best = -1;
+  double best_fill = -1;
+  for (int k = 1; k < n; k++) {
+    if (k > max_entries || n - k > max_entries || left_bytes[k] > capacity || right_bytes[k] > capacity) {
+      continue;
+    }
+    double min_fill = std::min(fill(k, left_bytes[k]), fill(n - k, right_bytes[k]));
+    if (min_fill > best_fill) {
+      best = k;
+      best_fill = min_fill;
+    }
+  }
+  return best;
+}
+
+SLOTTED_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_SLOTTED_PAGE_TYPE::SizeCounter::AddKey(const KeyType &key) {
+  int size = KeySize(key);
+  key_sizes_[size]++;
+  max_key_size_ = std::max(max_key_size_, size);
+  if (num_keys_++ == 0) {
+    first_key_ = key;
+    common_size_ = sizeof(KeyType);
+  } else {
+    common_size_ = CommonPrefixSize(reinterpret_cast<const char *>(&first_key_), reinterpret_cast<const char *>(&key),
+                                    common_size_);
+  }
+}
+
+SLOTTED_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_SLOTTED_PAGE_TYPE::SizeCounter::GetBytes() const -> int {
+  int prefix_size = GetPrefixSize();
+  int bytes = num_slots_ * static_cast<int>(sizeof(Slot)) + prefix_size;
+  for (int size = prefix_size + 1; size < static_cast<int>(key_sizes_.size()); size++) {
+    bytes += key_sizes_[size] * (size - prefix_size);
+  }
+  return bytes;
+}
+
+/*****************************************************************************
+ * KEY BYTES
+ *****************************************************************************/
+SLOTTED_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_SLOTTED_PAGE_TYPE::MatchPrefix(const KeyType &key) const -> int {
+  return CommonPrefixSize(reinterpret_cast<const char *>(&key), Bytes() + BUSTUB_PAGE_SIZE - prefix_size_,
+                          prefix_size_);
+}
+
+SLOTTED_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_SLOTTED_PAGE_TYPE::KeySize(const KeyType &key) -> int {
+  const auto *bytes = reinterpret_cast<const char *>(&key);
+  int size = sizeof(KeyType);
+  while (size > 0 && bytes[size - 1] == 0) {
+    size--;
+  }
+  return size;
+}
+
+SLOTTED_TEMPLATE_ARGUMENTS
+auto B_PLUS_TREE_SLOTTED_PAGE_TYPE::CommonPrefixSize(const char *lhs, const char *rhs, int limit) -> int {
+  int size = 0;
+  while (size < limit && lhs[size] == rhs[size]) {
+    size++;
+  }
+  return size;
+}
+
+template class BPlusTreeSlottedPage<GenericKey<4>, RID>;
+template class BPlusTreeSlottedPage<GenericKey<8>, RID>;
+template class BPlusTreeSlottedPage<GenericKey<16>, RID>;
+template class BPlusTreeSlottedPage<GenericKey<32>, RID>;
+template class BPlusTreeSlottedPage<GenericKey<64>, RID>;
+template class BPlusTreeSlottedPage<GenericKey<4>, page_id_t>;
+template class BPlusTreeSlottedPage<GenericKey<8>, page_id_t>;
+template class BPlusTreeSlottedPage<GenericKey<16>, page_id_t>;
+template class BPlusTreeSlottedPage<GenericKey<32>, page_id_t>;
+template class BPlusTreeSlottedPage<GenericKey<64>, page_id_t>;
+}  // namespace bustub
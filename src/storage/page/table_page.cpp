@@ -69,16 +69,17 @@ void TablePage::UpdateTupleMeta(const TupleMeta &meta, const RID &rid) {
 }
 
 auto TablePage::GetTuple(const RID &rid) const -> std::pair<TupleMeta, Tuple> {
+  auto [meta, tuple] = GetTupleRef(rid);
+  return std::make_pair(meta, tuple.ToTuple());
+}
+
+auto TablePage::GetTupleRef(const RID &rid) const -> std::pair<TupleMeta, TupleRef> {
   auto tuple_id = rid.GetSlotNum();
   if (tuple_id >= num_tuples_) {
     throw bustub::Exception("Tuple ID out of range");
   }
   auto &[offset, size, meta] = tuple_info_[tuple_id];
-  Tuple tuple;
-  tuple.data_.resize(size);
-  memmove(tuple.data_.data(), page_start_ + offset, size);
-  tuple.rid_ = rid;
-  return std::make_pair(meta, std::move(tuple));
+  return std::make_pair(meta, TupleRef(page_start_ + offset, size, rid));
 }
 
 auto TablePage::GetTupleMeta(const RID &rid) const -> TupleMeta {
@@ -0,0 +1,56 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_page.cpp
+//
+// Identification: src/storage/page/tmp_tuple_page.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/tmp_tuple_page.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace bustub {
+
+void TmpTuplePage::Init(page_id_t page_id, uint32_t page_size) {
+  page_id_ = page_id;
+  lsn_ = INVALID_LSN;
+  free_space_ = page_size;
+}
+
+auto TmpTuplePage::Insert(const Tuple &tuple, TmpTuple *out) -> bool {
+  size_t size = sizeof(uint32_t) + tuple.GetLength();
+  if (free_space_ < TMP_TUPLE_PAGE_HEADER_SIZE + size) {
+    return false;
+  }
+  free_space_ -= size;
+  tuple.SerializeTo(reinterpret_cast<char *>(this) + free_space_);
+  *out = TmpTuple(page_id_, free_space_);
+  return true;
+}
+
+auto TmpTuplePage::Get(size_t offset) const -> Tuple {
+  Tuple tuple;
+  tuple.DeserializeFrom(Bytes() + offset);
+  return tuple;
+}
+
+auto TmpTuplePage::GetTupleOffsets() const -> std::vector<size_t> {
+  // Tuples are found from the last inserted one, each followed by the one inserted before it.
+  std::vector<size_t> offsets;
+  for (size_t offset = free_space_; offset < BUSTUB_PAGE_SIZE;) {
+    offsets.push_back(offset);
+    uint32_t size;
+    memcpy(&size, Bytes() + offset, sizeof(uint32_t));
+    offset += sizeof(uint32_t) + size;
+  }
+  std::reverse(offsets.begin(), offsets.end());
+  return offsets;
+}
+
+}  // namespace bustub
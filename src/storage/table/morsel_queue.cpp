@@ -0,0 +1,54 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// morsel_queue.cpp
+//
+// Identification: src/storage/table/morsel_queue.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/morsel_queue.h"
+
+#include "storage/table/table_heap.h"
+
+namespace bustub {
+
+void MorselQueue::Reset() {
+  std::unique_lock<std::mutex> heap_guard(table_heap_->latch_);
+  auto last_page_id = table_heap_->last_page_id_;
+  heap_guard.unlock();
+
+  auto page_guard = table_heap_->bpm_->FetchPageRead(last_page_id);
+  stop_at_rid_ = {last_page_id, page_guard.As<TablePage>()->GetNumTuples()};
+  std::scoped_lock guard(latch_);
+  next_page_id_ = table_heap_->first_page_id_;
+  next_morsel_ = 0;
+}
+
+auto MorselQueue::Next(size_t *morsel) -> std::unique_ptr<TableIterator> {
+  std::scoped_lock guard(latch_);
+  if (next_page_id_ == INVALID_PAGE_ID) {
+    return nullptr;
+  }
+  // Follow the chain to the last page of the morsel; the scan goes on into the pages of its iterator.
+  page_id_t first_page_id = next_page_id_;
+  RID last_rid;
+  for (int i = 0; i < MORSEL_PAGES && next_page_id_ != INVALID_PAGE_ID; i++) {
+    if (next_page_id_ == stop_at_rid_.GetPageId()) {
+      last_rid = stop_at_rid_;
+      next_page_id_ = INVALID_PAGE_ID;
+      break;
+    }
+    auto page_guard = table_heap_->bpm_->FetchPageRead(next_page_id_, AccessType::Scan);
+    auto page = page_guard.As<TablePage>();
+    last_rid = {next_page_id_, page->GetNumTuples()};
+    next_page_id_ = page->GetNextPageId();
+  }
+  *morsel = next_morsel_++;
+  return std::make_unique<TableIterator>(table_heap_, RID{first_page_id, 0}, last_rid);
+}
+
+}  // namespace bustub
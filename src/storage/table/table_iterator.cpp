@@ -24,22 +24,52 @@ TableIterator::TableIterator(TableHeap *table_heap, RID rid, RID stop_at_rid)
     : table_heap_(table_heap), rid_(rid), stop_at_rid_(stop_at_rid) {
   // If the rid doesn't correspond to a tuple (i.e., the table has just been initialized), then
   // we set rid_ to invalid.
-  auto page_guard = table_heap_->bpm_->FetchPageRead(rid_.GetPageId());
+  auto page_guard = table_heap_->bpm_->FetchPageRead(rid_.GetPageId(), AccessType::Scan);
   auto page = page_guard.As<TablePage>();
   if (rid_.GetSlotNum() >= page->GetNumTuples()) {
     rid_ = RID{INVALID_PAGE_ID, 0};
   }
 }
 
-auto TableIterator::GetTuple() -> std::pair<TupleMeta, Tuple> { return table_heap_->GetTuple(rid_); }
+auto TableIterator::GetTuple() -> std::pair<TupleMeta, Tuple> {
+  if (page_id_ != INVALID_PAGE_ID && page_id_ == rid_.GetPageId()) {
+    auto [meta, tuple] = GetTupleRef();
+    return std::make_pair(meta, tuple.ToTuple());
+  }
+  // Same as TableHeap::GetTuple, but tagged as a scan access so that the page stays in the scan ring.
+  auto page_guard = table_heap_->bpm_->FetchPageRead(rid_.GetPageId(), AccessType::Scan);
+  auto page = page_guard.As<TablePage>();
+  auto [meta, tuple] = page->GetTuple(rid_);
+  tuple.rid_ = rid_;
+  return std::make_pair(meta, std::move(tuple));
+}
+
+auto TableIterator::GetTupleRef() -> std::pair<TupleMeta, TupleRef> {
+  if (page_id_ == INVALID_PAGE_ID || page_id_ != rid_.GetPageId()) {
+    page_guard_ = table_heap_->bpm_->FetchPageRead(rid_.GetPageId(), AccessType::Scan);
+    page_id_ = rid_.GetPageId();
+  }
+  return page_guard_.As<TablePage>()->GetTupleRef(rid_);
+}
+
+void TableIterator::DropPage() {
+  page_guard_.Drop();
+  page_id_ = INVALID_PAGE_ID;
+}
 
 auto TableIterator::GetRID() -> RID { return rid_; }
 
 auto TableIterator::IsEnd() -> bool { return rid_.GetPageId() == INVALID_PAGE_ID; }
 
 auto TableIterator::operator++() -> TableIterator & {
-  auto page_guard = table_heap_->bpm_->FetchPageRead(rid_.GetPageId());
-  auto page = page_guard.As<TablePage>();
+  ReadPageGuard page_guard;
+  const TablePage *page;
+  if (page_id_ != INVALID_PAGE_ID && page_id_ == rid_.GetPageId()) {
+    page = page_guard_.As<TablePage>();
+  } else {
+    page_guard = table_heap_->bpm_->FetchPageRead(rid_.GetPageId(), AccessType::Scan);
+    page = page_guard.As<TablePage>();
+  }
   auto next_tuple_id = rid_.GetSlotNum() + 1;
 
   if (stop_at_rid_.GetPageId() != INVALID_PAGE_ID) {
@@ -50,6 +80,7 @@ auto TableIterator::operator++() -> TableIterator & {
         "iterate out of bound");
   }
 
+  auto page_id = rid_.GetPageId();
   rid_ = RID{rid_.GetPageId(), next_tuple_id};
 
   if (rid_ == stop_at_rid_) {
@@ -63,8 +94,35 @@ auto TableIterator::operator++() -> TableIterator & {
   }
 
   page_guard.Drop();
+  if (rid_.GetPageId() != page_id_) {
+    DropPage();
+  }
+
+  if (rid_.GetPageId() != INVALID_PAGE_ID && rid_.GetPageId() != page_id) {
+    MaybeReadAhead(rid_.GetPageId());
+  }
 
   return *this;
 }
 
+void TableIterator::MaybeReadAhead(page_id_t page_id) {
+  // Crossing the second page boundary is our signal that this is a scan rather than a short lookup.
+  static constexpr size_t SEQUENTIAL_THRESHOLD = 2;
+
+  pages_crossed_++;
+  if (read_ahead_remaining_ > 0) {
+    read_ahead_remaining_--;
+  }
+  auto *bpm = table_heap_->bpm_;
+  size_t window = bpm->GetReadAheadWindow();
+  if (window == 0 || pages_crossed_ < SEQUENTIAL_THRESHOLD || read_ahead_remaining_ > window / 2) {
+    return;
+  }
+  // The chain starts at the page we are about to read; pages that are already resident are skipped cheaply.
+  bpm->ReadAhead(page_id, window + 1, [](const char *data) {
+    return reinterpret_cast<const TablePage *>(data)->GetNextPageId();
+  });
+  read_ahead_remaining_ = window;
+}
+
 }  // namespace bustub
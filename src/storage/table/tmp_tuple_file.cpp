@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_file.cpp
+//
+// Identification: src/storage/table/tmp_tuple_file.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/tmp_tuple_file.h"
+
+#include "common/exception.h"
+
+namespace bustub {
+
+TmpTupleFile::~TmpTupleFile() {
+  tail_.Drop();
+  for (auto page_id : page_ids_) {
+    bpm_->DeletePage(page_id);
+  }
+}
+
+auto TmpTupleFile::Append(const Tuple &tuple) -> TmpTuple {
+  BUSTUB_ASSERT(!finished_, "nothing is appended to a finished file");
+  TmpTuple out(INVALID_PAGE_ID, 0);
+  if (!page_ids_.empty() && tail_.AsMut<TmpTuplePage>()->Insert(tuple, &out)) {
+    num_tuples_++;
+    tuple_bytes_ += tuple.GetLength();
+    return out;
+  }
+  if (!TmpTuplePage::Fits(tuple)) {
+    throw ExecutionException("tuple too large to spill to a temp page");
+  }
+  page_id_t page_id;
+  Page *page = bpm_->NewPage(&page_id);
+  if (page == nullptr) {
+    throw ExecutionException("no buffer pool frame left to spill to");
+  }
+  tail_ = BasicPageGuard(bpm_, page);
+  page_ids_.push_back(page_id);
+  auto tmp_page = tail_.AsMut<TmpTuplePage>();
+  tmp_page->Init(page_id, BUSTUB_PAGE_SIZE);
+  BUSTUB_ENSURE(tmp_page->Insert(tuple, &out), "a tuple that fits a page fits an empty one");
+  num_tuples_++;
+  tuple_bytes_ += tuple.GetLength();
+  return out;
+}
+
+void TmpTupleFile::Finish() {
+  tail_.Drop();
+  finished_ = true;
+}
+
+auto TmpTupleFile::Read() -> Reader {
+  Finish();
+  return Reader(this);
+}
+
+auto TmpTupleFile::Reader::Next(Tuple *tuple) -> bool {
+  while (offset_index_ == offsets_.size()) {
+    if (page_index_ == file_->page_ids_.size()) {
+      guard_.Drop();
+      return false;
+    }
+    // Spilled pages are read once, like the pages of a sequential scan.
+    Page *page = file_->bpm_->FetchPage(file_->page_ids_[page_index_++], AccessType::Scan);
+    if (page == nullptr) {
+      throw ExecutionException("no buffer pool frame left to read spilled tuples into");
+    }
+    guard_ = BasicPageGuard(file_->bpm_, page);
+    offsets_ = guard_.As<TmpTuplePage>()->GetTupleOffsets();
+    offset_index_ = 0;
+  }
+  *tuple = guard_.As<TmpTuplePage>()->Get(offsets_[offset_index_++]);
+  return true;
+}
+
+}  // namespace bustub
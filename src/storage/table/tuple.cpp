@@ -79,17 +79,32 @@ auto Tuple::KeyFromTuple(const Schema &schema, const Schema &key_schema, const s
 }
 
 auto Tuple::GetDataPtr(const Schema *schema, const uint32_t column_idx) const -> const char * {
+  return TupleRef(*this).GetDataPtr(schema, column_idx);
+}
+
+auto TupleRef::GetValue(const Schema *schema, const uint32_t column_idx) const -> Value {
+  assert(schema);
+  return Value::DeserializeFrom(GetDataPtr(schema, column_idx), schema->GetColumn(column_idx).GetType());
+}
+
+auto TupleRef::GetDataPtr(const Schema *schema, const uint32_t column_idx) const -> const char * {
   assert(schema);
   const auto &col = schema->GetColumn(column_idx);
   bool is_inlined = col.IsInlined();
   // For inline type, data is stored where it is.
   if (is_inlined) {
-    return (data_.data() + col.GetOffset());
+    return (data_ + col.GetOffset());
   }
   // We read the relative offset from the tuple data.
-  int32_t offset = *reinterpret_cast<const int32_t *>(data_.data() + col.GetOffset());
+  int32_t offset = *reinterpret_cast<const int32_t *>(data_ + col.GetOffset());
   // And return the beginning address of the real data for the VARCHAR type.
-  return (data_.data() + offset);
+  return (data_ + offset);
+}
+
+auto TupleRef::ToTuple() const -> Tuple {
+  Tuple tuple{rid_};
+  tuple.data_.assign(data_, data_ + length_);
+  return tuple;
 }
 
 auto Tuple::ToString(const Schema *schema) const -> std::string {
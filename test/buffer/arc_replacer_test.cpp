@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arc_replacer_test.cpp
+//
+// Identification: test/buffer/arc_replacer_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/arc_replacer.h"
+
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+TEST(ARCReplacerTest, SampleTest) {
+  ARCReplacer replacer(4);
+  auto load = [&replacer](frame_id_t frame_id, page_id_t page_id) {
+    replacer.SetPageId(frame_id, page_id);
+    replacer.RecordAccess(frame_id);
+    replacer.SetEvictable(frame_id, true);
+  };
+
+  // Scenario: load four pages into T1. A second access moves page 0 to T2; a scan touching page 1 again does not.
+  for (frame_id_t fid = 0; fid < 4; fid++) {
+    load(fid, fid);
+  }
+  replacer.RecordAccess(0, AccessType::Get);
+  replacer.RecordAccess(1, AccessType::Scan);
+  ASSERT_EQ(4, replacer.Size());
+
+  // Scenario: the target size of T1 starts at 0, so T1 is evicted first, least recently used first.
+  frame_id_t value;
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(2, value);
+
+  // Scenario: page 2 comes back from B1, which grows T1's target to 1 and puts the page in T2.
+  load(2, 2);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(3, value);
+  // T1 is at its target now, so T2 gives up its least recently used page.
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(0, value);
+
+  // Scenario: page 0 comes back from B2, which shrinks T1's target back to 0.
+  load(0, 0);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(1, value);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(2, value);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(0, value);
+  ASSERT_FALSE(replacer.Evict(&value));
+  ASSERT_EQ(0, replacer.Size());
+}
+
+}  // namespace bustub
@@ -12,17 +12,53 @@
 
 #include "buffer/buffer_pool_manager.h"
 
+#include <atomic>
 #include <cstdio>
 #include <random>
 #include <string>
+#include <thread>  // NOLINT
+#include <vector>
 
+#include "fmt/format.h"
 #include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
 
 namespace bustub {
 
+namespace {
+
+/** An in-memory disk whose reads and writes can be made to fail, and whose writes can be held back. */
+class FailingDiskManager : public DiskManagerUnlimitedMemory {
+ public:
+  auto WritePage(page_id_t page_id, const char *page_data) -> bool override {
+    writes_started_++;
+    while (hold_writes_) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (writes_to_fail_ > 0) {
+      writes_to_fail_--;
+      return false;
+    }
+    return !fail_writes_ && DiskManagerUnlimitedMemory::WritePage(page_id, page_data);
+  }
+
+  auto ReadPage(page_id_t page_id, char *page_data) -> bool override {
+    return !fail_reads_ && DiskManagerUnlimitedMemory::ReadPage(page_id, page_data);
+  }
+
+  std::atomic<bool> fail_writes_{false};
+  std::atomic<bool> fail_reads_{false};
+  /** Writes to fail after those in flight, whatever fail_writes_ says. */
+  std::atomic<int> writes_to_fail_{0};
+  std::atomic<bool> hold_writes_{false};
+  std::atomic<int> writes_started_{0};
+};
+
+}  // namespace
+
 // NOLINTNEXTLINE
 // Check whether pages containing terminal characters can be recovered
-TEST(BufferPoolManagerTest, DISABLED_BinaryDataTest) {
+TEST(BufferPoolManagerTest, BinaryDataTest) {
   const std::string db_name = "test.db";
   const size_t buffer_pool_size = 10;
   const size_t k = 5;
@@ -88,7 +124,7 @@ TEST(BufferPoolManagerTest, DISABLED_BinaryDataTest) {
 }
 
 // NOLINTNEXTLINE
-TEST(BufferPoolManagerTest, DISABLED_SampleTest) {
+TEST(BufferPoolManagerTest, SampleTest) {
   const std::string db_name = "test.db";
   const size_t buffer_pool_size = 10;
   const size_t k = 5;
@@ -144,4 +180,419 @@ TEST(BufferPoolManagerTest, DISABLED_SampleTest) {
   delete disk_manager;
 }
 
+// NOLINTNEXTLINE
+TEST(BufferPoolManagerTest, ShardedTest) {
+  const size_t buffer_pool_size = 8;
+  const size_t num_instances = 4;
+  const size_t k = 2;
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager.get(), k, nullptr, num_instances);
+  ASSERT_EQ(num_instances, bpm->GetNumInstances());
+
+  // Scenario: new pages are spread round-robin over the instances, and every instance only hands out page ids that
+  // map back to itself.
+  std::vector<page_id_t> page_ids;
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    page_id_t page_id;
+    auto *page = bpm->NewPage(&page_id);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), BUSTUB_PAGE_SIZE, "page %d", page_id);
+    page_ids.push_back(page_id);
+  }
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    EXPECT_EQ(i % num_instances, static_cast<size_t>(page_ids[i]) % num_instances);
+  }
+
+  // Scenario: the pool is full and everything is pinned.
+  page_id_t page_id_temp;
+  EXPECT_EQ(nullptr, bpm->NewPage(&page_id_temp));
+
+  // Scenario: once a single frame is unpinned, NewPage finds it even if it lives in another instance.
+  EXPECT_TRUE(bpm->UnpinPage(page_ids[1], true));
+  auto *page = bpm->NewPage(&page_id_temp);
+  ASSERT_NE(nullptr, page);
+  EXPECT_EQ(page_ids[1] % num_instances, page_id_temp % num_instances);
+  EXPECT_TRUE(bpm->UnpinPage(page_id_temp, false));
+
+  // Scenario: the evicted page is read back with its content.
+  for (auto page_id : page_ids) {
+    if (page_id != page_ids[1]) {
+      EXPECT_TRUE(bpm->UnpinPage(page_id, true));
+    }
+  }
+  for (auto page_id : page_ids) {
+    auto guard = bpm->FetchPageRead(page_id);
+    EXPECT_EQ(0, strcmp(guard.GetData(), fmt::format("page {}", page_id).c_str()));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(BufferPoolManagerTest, ShardedConcurrencyTest) {
+  // Every instance has at least as many frames as there are threads, so a fetch can never fail.
+  const size_t buffer_pool_size = 32;
+  const size_t num_instances = 4;
+  const size_t num_pages = 64;
+  const size_t num_threads = 8;
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager.get(), 2, nullptr, num_instances);
+
+  std::vector<page_id_t> page_ids;
+  for (size_t i = 0; i < num_pages; i++) {
+    page_id_t page_id;
+    auto guard = bpm->NewPageGuarded(&page_id);
+    *guard.AsMut<page_id_t>() = page_id;
+    page_ids.push_back(page_id);
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t tid = 0; tid < num_threads; tid++) {
+    threads.emplace_back([&, tid] {
+      for (size_t round = 0; round < 50; round++) {
+        for (size_t i = tid; i < num_pages; i += num_threads) {
+          auto guard = bpm->FetchPageRead(page_ids[i]);
+          ASSERT_EQ(page_ids[i], *guard.As<page_id_t>());
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(BufferPoolManagerTest, ReadAheadTest) {
+  const size_t buffer_pool_size = 16;
+  const size_t chain_length = 8;
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager.get(), 2);
+  // Read-ahead never runs further ahead than the scan ring can hold.
+  bpm->SetScanRingSize(chain_length);
+
+  // Build a chain of pages, each storing the id of its successor, then write them out and drop them from the pool.
+  std::vector<page_id_t> chain(chain_length);
+  for (auto &page_id : chain) {
+    bpm->NewPageGuarded(&page_id);
+  }
+  for (size_t i = 0; i < chain_length; i++) {
+    {
+      auto guard = bpm->FetchPageWrite(chain[i]);
+      *guard.AsMut<page_id_t>() = i + 1 < chain_length ? chain[i + 1] : INVALID_PAGE_ID;
+    }
+    ASSERT_TRUE(bpm->FlushPage(chain[i]));
+    ASSERT_TRUE(bpm->DeletePage(chain[i]));
+  }
+
+  bpm->ReadAhead(chain[0], chain_length, [](const char *data) { return *reinterpret_cast<const page_id_t *>(data); });
+  for (int i = 0; i < 1000 && bpm->GetReadAheadStats().issued_ < chain_length; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(chain_length, bpm->GetReadAheadStats().issued_);
+
+  // Scenario: every page of the chain is now resident, so fetching them is a read-ahead hit each.
+  for (size_t i = 0; i < chain_length; i++) {
+    auto guard = bpm->FetchPageRead(chain[i]);
+    EXPECT_EQ(i + 1 < chain_length ? chain[i + 1] : INVALID_PAGE_ID, *guard.As<page_id_t>());
+  }
+  EXPECT_EQ(chain_length, bpm->GetReadAheadStats().hits_);
+  EXPECT_EQ(0, bpm->GetReadAheadStats().wasted_);
+
+  // Scenario: read-ahead pages that are pushed out before being used count as waste.
+  for (size_t i = 0; i < 2; i++) {
+    ASSERT_TRUE(bpm->DeletePage(chain[i]));
+  }
+  bpm->ReadAhead(chain[0], 2, [](const char *data) { return *reinterpret_cast<const page_id_t *>(data); });
+  for (int i = 0; i < 1000 && bpm->GetReadAheadStats().issued_ < chain_length + 2; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    page_id_t page_id;
+    bpm->NewPageGuarded(&page_id);
+  }
+  EXPECT_EQ(2, bpm->GetReadAheadStats().wasted_);
+}
+
+// NOLINTNEXTLINE
+TEST(BufferPoolManagerTest, ScanRingTest) {
+  const size_t buffer_pool_size = 16;
+  const size_t hot_pages = 8;
+  const size_t scan_pages = 64;
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager.get(), 2);
+  bpm->SetReadAheadWindow(0);
+  bpm->SetScanRingSize(4);
+
+  std::vector<page_id_t> page_ids(hot_pages + scan_pages);
+  for (auto &page_id : page_ids) {
+    bpm->NewPageGuarded(&page_id);
+  }
+
+  // Scenario: bring the hot set in with point accesses, then run a large scan. The hot pages have been accessed only
+  // once, so LRU-K alone would not protect them from the scan.
+  for (size_t i = 0; i < hot_pages; i++) {
+    ASSERT_NE(nullptr, bpm->FetchPage(page_ids[i], AccessType::Get));
+    ASSERT_TRUE(bpm->UnpinPage(page_ids[i], false, AccessType::Get));
+  }
+  auto before = bpm->GetAccessStats(AccessType::Get);
+  for (size_t i = hot_pages; i < page_ids.size(); i++) {
+    ASSERT_NE(nullptr, bpm->FetchPage(page_ids[i], AccessType::Scan));
+    ASSERT_TRUE(bpm->UnpinPage(page_ids[i], false, AccessType::Scan));
+  }
+
+  // The scan only recycled its ring, so the hot set is still fully resident.
+  for (size_t i = 0; i < hot_pages; i++) {
+    ASSERT_NE(nullptr, bpm->FetchPage(page_ids[i], AccessType::Get));
+    ASSERT_TRUE(bpm->UnpinPage(page_ids[i], false, AccessType::Get));
+  }
+  auto after = bpm->GetAccessStats(AccessType::Get);
+  EXPECT_EQ(before.misses_, after.misses_);
+  EXPECT_EQ(before.hits_ + hot_pages, after.hits_);
+
+  // Scenario: with the ring disabled, the same scan pushes the hot set out.
+  bpm->SetScanRingSize(0);
+  for (size_t i = 0; i < hot_pages; i++) {
+    ASSERT_TRUE(bpm->DeletePage(page_ids[i]));
+    ASSERT_NE(nullptr, bpm->FetchPage(page_ids[i], AccessType::Get));
+    ASSERT_TRUE(bpm->UnpinPage(page_ids[i], false, AccessType::Get));
+  }
+  after = bpm->GetAccessStats(AccessType::Get);
+  for (size_t i = hot_pages; i < page_ids.size(); i++) {
+    ASSERT_NE(nullptr, bpm->FetchPage(page_ids[i], AccessType::Scan));
+    ASSERT_TRUE(bpm->UnpinPage(page_ids[i], false, AccessType::Scan));
+  }
+  for (size_t i = 0; i < hot_pages; i++) {
+    ASSERT_NE(nullptr, bpm->FetchPage(page_ids[i], AccessType::Get));
+    ASSERT_TRUE(bpm->UnpinPage(page_ids[i], false, AccessType::Get));
+  }
+  EXPECT_LT(after.misses_, bpm->GetAccessStats(AccessType::Get).misses_);
+}
+
+// NOLINTNEXTLINE
+TEST(BufferPoolManagerTest, ReplacerPolicyTest) {
+  const size_t buffer_pool_size = 8;
+  const size_t num_pages = 32;
+
+  for (auto policy : {ReplacerPolicy::LRUK, ReplacerPolicy::LRU, ReplacerPolicy::Clock, ReplacerPolicy::ClockPro,
+                      ReplacerPolicy::TwoQ, ReplacerPolicy::ARC}) {
+    auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+    auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager.get(), 2, nullptr, 2, policy);
+    ASSERT_EQ(policy, bpm->GetReplacerPolicy());
+
+    // Scenario: write more pages than fit in the pool, then read them all back in a skewed order.
+    std::vector<page_id_t> page_ids;
+    for (size_t i = 0; i < num_pages; i++) {
+      page_id_t page_id;
+      auto guard = bpm->NewPageGuarded(&page_id);
+      ASSERT_NE(nullptr, guard.GetData()) << ReplacerPolicyToString(policy);
+      snprintf(guard.GetDataMut(), BUSTUB_PAGE_SIZE, "page %d", page_id);
+      page_ids.push_back(page_id);
+    }
+    std::mt19937 gen(15445);
+    std::uniform_int_distribution<size_t> dist(0, num_pages - 1);
+    for (int i = 0; i < 500; i++) {
+      auto idx = i % 3 == 0 ? dist(gen) : dist(gen) % 4;
+      auto guard = bpm->FetchPageRead(page_ids[idx], i % 2 == 0 ? AccessType::Get : AccessType::Scan);
+      ASSERT_EQ(fmt::format("page {}", page_ids[idx]), std::string(guard.GetData())) << ReplacerPolicyToString(policy);
+    }
+
+    // Scenario: with every frame pinned, no further page can be brought in.
+    std::vector<Page *> pinned;
+    for (size_t i = 0; i < buffer_pool_size; i++) {
+      pinned.push_back(bpm->FetchPage(page_ids[i]));
+      ASSERT_NE(nullptr, pinned.back()) << ReplacerPolicyToString(policy);
+    }
+    ASSERT_EQ(nullptr, bpm->FetchPage(page_ids[buffer_pool_size])) << ReplacerPolicyToString(policy);
+    for (auto *page : pinned) {
+      ASSERT_TRUE(bpm->UnpinPage(page->GetPageId(), false));
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(BufferPoolManagerTest, BackgroundWriterTest) {
+  const size_t buffer_pool_size = 8;
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager.get(), 2);
+  auto options = bpm->GetBackgroundWriterOptions();
+  options.interval_ = std::chrono::milliseconds(0);
+  bpm->SetBackgroundWriterOptions(options);
+
+  // Scenario: fill the pool with dirty pages while the writer is paused, then let it clean them up.
+  std::vector<page_id_t> page_ids(buffer_pool_size);
+  for (auto &page_id : page_ids) {
+    auto guard = bpm->NewPageGuarded(&page_id);
+    snprintf(guard.GetDataMut(), BUSTUB_PAGE_SIZE, "page %d", page_id);
+  }
+  EXPECT_EQ(0, bpm->GetBackgroundWriterStats().pages_written_);
+  options.interval_ = std::chrono::milliseconds(1);
+  bpm->SetBackgroundWriterOptions(options);
+  for (int i = 0; i < 1000 && bpm->GetBackgroundWriterStats().pages_written_ < buffer_pool_size; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(buffer_pool_size, bpm->GetBackgroundWriterStats().pages_written_);
+
+  // Every victim is now clean, so new pages never wait for a write-back.
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    page_id_t page_id;
+    ASSERT_NE(nullptr, bpm->NewPageGuarded(&page_id).GetData());
+  }
+  auto stats = bpm->GetBackgroundWriterStats();
+  EXPECT_EQ(buffer_pool_size, stats.clean_victims_);
+  EXPECT_EQ(0, stats.dirty_victims_);
+
+  // The pages written in the background read back intact.
+  for (auto page_id : page_ids) {
+    auto guard = bpm->FetchPageRead(page_id);
+    EXPECT_EQ(fmt::format("page {}", page_id), std::string(guard.GetData()));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(BufferPoolManagerTest, BackgroundWriterWALTest) {
+  const size_t buffer_pool_size = 4;
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto log_manager = std::make_unique<LogManager>(disk_manager.get());
+  auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager.get(), 2, log_manager.get());
+  auto options = bpm->GetBackgroundWriterOptions();
+  options.interval_ = std::chrono::milliseconds(1);
+  bpm->SetBackgroundWriterOptions(options);
+  enable_logging = true;
+  log_manager->SetPersistentLSN(5);
+
+  // Scenario: a page whose last change is not in the persistent log yet must not be written.
+  page_id_t unlogged;
+  page_id_t logged;
+  bpm->NewPage(&unlogged)->SetLSN(10);
+  ASSERT_TRUE(bpm->UnpinPage(unlogged, true));
+  bpm->NewPage(&logged)->SetLSN(3);
+  ASSERT_TRUE(bpm->UnpinPage(logged, true));
+  for (int i = 0; i < 1000 && bpm->GetBackgroundWriterStats().pages_written_ < 1; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(1, bpm->GetBackgroundWriterStats().pages_written_);
+  EXPECT_TRUE(bpm->FetchPage(unlogged)->IsDirty());
+  EXPECT_FALSE(bpm->FetchPage(logged)->IsDirty());
+  ASSERT_TRUE(bpm->UnpinPage(unlogged, false));
+  ASSERT_TRUE(bpm->UnpinPage(logged, false));
+
+  // Scenario: once the log catches up, the page is written too.
+  log_manager->SetPersistentLSN(10);
+  for (int i = 0; i < 1000 && bpm->GetBackgroundWriterStats().pages_written_ < 2; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(2, bpm->GetBackgroundWriterStats().pages_written_);
+  enable_logging = false;
+}
+
+// NOLINTNEXTLINE
+TEST(BufferPoolManagerTest, FailedIOTest) {
+  const size_t buffer_pool_size = 2;
+
+  auto disk_manager = std::make_unique<FailingDiskManager>();
+  auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager.get(), 2);
+  auto options = bpm->GetBackgroundWriterOptions();
+  options.interval_ = std::chrono::milliseconds(0);
+  bpm->SetBackgroundWriterOptions(options);
+
+  std::vector<page_id_t> page_ids(buffer_pool_size);
+  for (auto &page_id : page_ids) {
+    auto guard = bpm->NewPageGuarded(&page_id);
+    snprintf(guard.GetDataMut(), BUSTUB_PAGE_SIZE, "page %d", page_id);
+  }
+
+  // Scenario: a victim that cannot be written back stays in the pool, dirty, and the page it was taken for fails.
+  disk_manager->fail_writes_ = true;
+  page_id_t page_id;
+  EXPECT_EQ(nullptr, bpm->NewPage(&page_id));
+  for (auto id : page_ids) {
+    auto *page = bpm->FetchPage(id);
+    ASSERT_NE(nullptr, page);
+    EXPECT_TRUE(page->IsDirty());
+    EXPECT_EQ(fmt::format("page {}", id), std::string(page->GetData()));
+    ASSERT_TRUE(bpm->UnpinPage(id, false));
+  }
+  EXPECT_FALSE(bpm->FlushPage(page_ids[0]));
+  EXPECT_TRUE(bpm->FetchPage(page_ids[0])->IsDirty());
+  ASSERT_TRUE(bpm->UnpinPage(page_ids[0], false));
+
+  // Scenario: once writes succeed again, the victims are written back and read back intact.
+  disk_manager->fail_writes_ = false;
+  {
+    std::vector<BasicPageGuard> guards;
+    for (size_t i = 0; i < buffer_pool_size; i++) {
+      guards.push_back(bpm->NewPageGuarded(&page_id));
+      ASSERT_NE(nullptr, guards.back().GetData());
+    }
+  }
+
+  // Scenario: a page that cannot be read is not handed out, and its frame is reused.
+  disk_manager->fail_reads_ = true;
+  EXPECT_EQ(nullptr, bpm->FetchPage(page_ids[0]));
+  disk_manager->fail_reads_ = false;
+  for (auto id : page_ids) {
+    auto guard = bpm->FetchPageRead(id);
+    EXPECT_EQ(fmt::format("page {}", id), std::string(guard.GetData()));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(BufferPoolManagerTest, FailedBackgroundWriteTest) {
+  const size_t buffer_pool_size = 2;
+
+  auto disk_manager = std::make_unique<FailingDiskManager>();
+  auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager.get(), 2);
+  auto options = bpm->GetBackgroundWriterOptions();
+  options.interval_ = std::chrono::milliseconds(0);
+  bpm->SetBackgroundWriterOptions(options);
+
+  page_id_t page_id;
+  {
+    auto guard = bpm->NewPageGuarded(&page_id);
+    snprintf(guard.GetDataMut(), BUSTUB_PAGE_SIZE, "page %d", page_id);
+  }
+
+  // Scenario: the background writer cleans the page, and its write is held back until the page is evicted.
+  disk_manager->hold_writes_ = true;
+  disk_manager->writes_to_fail_ = 1;
+  options.interval_ = std::chrono::milliseconds(1);
+  bpm->SetBackgroundWriterOptions(options);
+  while (disk_manager->writes_started_ == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  options.interval_ = std::chrono::milliseconds(0);
+  bpm->SetBackgroundWriterOptions(options);
+
+  auto dirty_victims = bpm->GetBackgroundWriterStats().dirty_victims_;
+  std::vector<BasicPageGuard> guards;
+  std::atomic<bool> evicted{false};
+  std::thread evictor([&] {
+    page_id_t new_page_id;
+    for (size_t i = 0; i < buffer_pool_size; i++) {
+      guards.push_back(bpm->NewPageGuarded(&new_page_id));
+    }
+    evicted = true;
+  });
+  while (!evicted && bpm->GetBackgroundWriterStats().dirty_victims_ == dirty_victims) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // Scenario: the write of the background writer fails once the frame is evicted; the page is not lost.
+  disk_manager->hold_writes_ = false;
+  evictor.join();
+  EXPECT_EQ(0, disk_manager->writes_to_fail_);
+  for (auto &guard : guards) {
+    ASSERT_NE(nullptr, guard.GetData());
+  }
+  guards.clear();
+  auto guard = bpm->FetchPageRead(page_id);
+  EXPECT_EQ(fmt::format("page {}", page_id), std::string(guard.GetData()));
+}
+
 }  // namespace bustub
@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// clock_pro_replacer_test.cpp
+//
+// Identification: test/buffer/clock_pro_replacer_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/clock_pro_replacer.h"
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+TEST(ClockProReplacerTest, SampleTest) {
+  ClockProReplacer replacer(4);
+  auto load = [&replacer](frame_id_t frame_id, page_id_t page_id) {
+    replacer.SetPageId(frame_id, page_id);
+    replacer.RecordAccess(frame_id);
+    replacer.SetEvictable(frame_id, true);
+  };
+
+  // Scenario: load four cold pages. Page 1 is accessed again; page 3 only by a scan, which does not count.
+  for (frame_id_t fid = 0; fid < 4; fid++) {
+    load(fid, fid);
+  }
+  replacer.RecordAccess(1, AccessType::Get);
+  replacer.RecordAccess(3, AccessType::Scan);
+  ASSERT_EQ(4, replacer.Size());
+
+  // Scenario: HAND_cold evicts unreferenced cold pages, and promotes page 1 since it was accessed during its test.
+  frame_id_t value;
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(0, value);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(2, value);
+
+  // Scenario: page 0 is loaded again while still in its test period, so it becomes hot; page 3 is the only cold
+  // page left.
+  load(0, 0);
+  load(2, 4);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(3, value);
+
+  // Scenario: pinned frames are never evicted, and everything else eventually is.
+  replacer.SetEvictable(1, false);
+  std::vector<frame_id_t> victims;
+  while (replacer.Evict(&value)) {
+    victims.push_back(value);
+  }
+  ASSERT_EQ(2, victims.size());
+  ASSERT_EQ(0, replacer.Size());
+  replacer.SetEvictable(1, true);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(1, value);
+}
+
+TEST(ClockProReplacerTest, RandomizedTest) {
+  // Drives the replacer like a buffer pool of 16 frames over 64 pages, checking that every frame it evicts is an
+  // unpinned, resident one.
+  const size_t num_frames = 16;
+  ClockProReplacer replacer(num_frames);
+  std::unordered_map<page_id_t, frame_id_t> page_table;
+  std::vector<page_id_t> frame_pages(num_frames, INVALID_PAGE_ID);
+  std::vector<bool> pinned(num_frames, false);
+  std::deque<frame_id_t> pins;
+  std::mt19937 gen(15445);
+  std::uniform_int_distribution<page_id_t> page_dist(0, 63);
+
+  for (int i = 0; i < 20000; i++) {
+    auto page_id = page_dist(gen);
+    auto it = page_table.find(page_id);
+    frame_id_t fid;
+    if (it != page_table.end()) {
+      fid = it->second;
+      replacer.SetEvictable(fid, false);
+      replacer.RecordAccess(fid);
+    } else {
+      if (page_table.size() < num_frames) {
+        fid = static_cast<frame_id_t>(page_table.size());
+      } else {
+        ASSERT_TRUE(replacer.Evict(&fid));
+        ASSERT_FALSE(pinned[fid]);
+        page_table.erase(frame_pages[fid]);
+      }
+      page_table[page_id] = fid;
+      frame_pages[fid] = page_id;
+      replacer.SetPageId(fid, page_id);
+      replacer.RecordAccess(fid);
+    }
+    // Keep up to three frames pinned at any time.
+    if (pinned[fid] || i % 5 != 0) {
+      replacer.SetEvictable(fid, !pinned[fid]);
+    } else {
+      pinned[fid] = true;
+      pins.push_back(fid);
+      if (pins.size() > 3) {
+        pinned[pins.front()] = false;
+        replacer.SetEvictable(pins.front(), true);
+        pins.pop_front();
+      }
+    }
+    ASSERT_EQ(page_table.size() - std::count(pinned.begin(), pinned.end(), true), replacer.Size());
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,119 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// frame_arena_test.cpp
+//
+// Identification: test/buffer/frame_arena_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/frame_arena.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(FrameArenaTest, LayoutTest) {
+  const size_t num_frames = 600;
+
+  for (auto allocation : {FrameAllocation::Heap, FrameAllocation::Contiguous, FrameAllocation::HugePages}) {
+    FrameArenaOptions options;
+    options.allocation_ = allocation;
+    FrameArena arena(num_frames, options);
+    auto name = FrameAllocationToString(allocation);
+    ASSERT_EQ(allocation, FrameAllocationFromString(name));
+
+    // Frames start out zeroed, and writing one never touches another.
+    for (size_t i = 0; i < num_frames; i++) {
+      char *frame = arena.GetFrame(i);
+      ASSERT_EQ(0, frame[0]) << name;
+      ASSERT_EQ(0, frame[BUSTUB_PAGE_SIZE - 1]) << name;
+      memset(frame, static_cast<int>(i % 128), BUSTUB_PAGE_SIZE);
+    }
+    for (size_t i = 0; i < num_frames; i++) {
+      char *frame = arena.GetFrame(i);
+      ASSERT_EQ(static_cast<char>(i % 128), frame[0]) << name;
+      ASSERT_EQ(static_cast<char>(i % 128), frame[BUSTUB_PAGE_SIZE - 1]) << name;
+    }
+
+    if (allocation == FrameAllocation::Heap) {
+      EXPECT_FALSE(arena.UsesHugePages());
+      continue;
+    }
+    // The other allocations pack page-aligned frames back to back.
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(arena.GetFrame(0)) % BUSTUB_PAGE_SIZE) << name;
+    for (size_t i = 1; i < num_frames; i++) {
+      ASSERT_EQ(arena.GetFrame(i - 1) + BUSTUB_PAGE_SIZE, arena.GetFrame(i)) << name;
+    }
+    if (allocation == FrameAllocation::HugePages) {
+      EXPECT_EQ(0, reinterpret_cast<uintptr_t>(arena.GetFrame(0)) % (2 * 1024 * 1024)) << name;
+    } else {
+      EXPECT_FALSE(arena.UsesHugePages());
+    }
+  }
+  EXPECT_THROW(FrameAllocationFromString("stack"), Exception);
+}
+
+// NOLINTNEXTLINE
+TEST(FrameArenaTest, NumaTest) {
+  // Whether the machine has several nodes or none at all, asking for a placement must not break the arena.
+  for (auto policy : {NumaPolicy::Interleave, NumaPolicy::Bind}) {
+    FrameArenaOptions options;
+    options.numa_policy_ = policy;
+    FrameArena arena(16, options);
+    EXPECT_TRUE(arena.GetNumaPolicy() == policy || arena.GetNumaPolicy() == NumaPolicy::Default);
+    memset(arena.GetFrame(15), 1, BUSTUB_PAGE_SIZE);
+  }
+
+  // A node that cannot exist is refused, and the frames are placed as usual.
+  FrameArenaOptions options;
+  options.numa_policy_ = NumaPolicy::Bind;
+  options.numa_node_ = 1 << 20;
+  FrameArena arena(16, options);
+  EXPECT_EQ(NumaPolicy::Default, arena.GetNumaPolicy());
+}
+
+// NOLINTNEXTLINE
+TEST(FrameArenaTest, BufferPoolTest) {
+  const size_t buffer_pool_size = 8;
+  const size_t num_pages = 32;
+
+  for (auto allocation : {FrameAllocation::Heap, FrameAllocation::Contiguous, FrameAllocation::HugePages}) {
+    FrameArenaOptions options;
+    options.allocation_ = allocation;
+    auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+    auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager.get(), 2, nullptr, 2,
+                                                   ReplacerPolicy::LRUK, options);
+    ASSERT_EQ(allocation, bpm->GetFrameArena().GetOptions().allocation_);
+
+    // Scenario: the pages of the pool are backed by the arena, and survive eviction.
+    std::vector<page_id_t> page_ids(num_pages);
+    for (auto &page_id : page_ids) {
+      auto guard = bpm->NewPageGuarded(&page_id);
+      snprintf(guard.GetDataMut(), BUSTUB_PAGE_SIZE, "page %d", page_id);
+    }
+    for (size_t i = 0; i < buffer_pool_size; i++) {
+      EXPECT_EQ(bpm->GetFrameArena().GetFrame(i), bpm->GetPages()[i].GetData());
+    }
+    for (auto page_id : page_ids) {
+      auto guard = bpm->FetchPageRead(page_id);
+      ASSERT_EQ(fmt::format("page {}", page_id), std::string(guard.GetData()));
+    }
+  }
+}
+
+}  // namespace bustub
@@ -16,7 +16,7 @@
 
 namespace bustub {
 
-TEST(LRUKReplacerTest, DISABLED_SampleTest) {
+TEST(LRUKReplacerTest, SampleTest) {
   LRUKReplacer lru_replacer(7, 2);
 
   // Scenario: add six elements to the replacer. We have [1,2,3,4,5]. Frame 6 is non-evictable.
@@ -95,4 +95,106 @@ TEST(LRUKReplacerTest, DISABLED_SampleTest) {
   ASSERT_EQ(false, lru_replacer.Evict(&value));
   ASSERT_EQ(0, lru_replacer.Size());
 }
+
+TEST(LRUKReplacerTest, RandomizedTest) {
+  // Replays random operations against the replacer and against a brute-force model of LRU-K.
+  const size_t num_frames = 64;
+  const size_t k = 3;
+  LRUKReplacer lru_replacer(num_frames, k);
+  std::vector<std::vector<size_t>> history(num_frames);
+  std::vector<bool> evictable(num_frames, false);
+  size_t timestamp = 0;
+
+  auto expected_victim = [&]() -> frame_id_t {
+    frame_id_t victim = -1;
+    auto key = [&](frame_id_t fid) {
+      auto &h = history[fid];
+      bool inf = h.size() < k;
+      return std::make_pair(!inf, inf ? h.front() : h[h.size() - k]);
+    };
+    for (size_t fid = 0; fid < num_frames; fid++) {
+      if (evictable[fid] && (victim == -1 || key(fid) < key(victim))) {
+        victim = static_cast<frame_id_t>(fid);
+      }
+    }
+    return victim;
+  };
+
+  std::mt19937 gen(15445);
+  std::uniform_int_distribution<frame_id_t> frame_dist(0, num_frames - 1);
+  std::uniform_int_distribution<int> op_dist(0, 9);
+  for (int i = 0; i < 20000; i++) {
+    auto fid = frame_dist(gen);
+    auto op = op_dist(gen);
+    if (op < 5) {
+      lru_replacer.RecordAccess(fid);
+      history[fid].push_back(timestamp++);
+    } else if (op < 8) {
+      bool set_evictable = op == 5 || op == 6;
+      lru_replacer.SetEvictable(fid, set_evictable);
+      if (!history[fid].empty()) {
+        evictable[fid] = set_evictable;
+      }
+    } else if (op == 8) {
+      auto victim = expected_victim();
+      frame_id_t value;
+      ASSERT_EQ(victim != -1, lru_replacer.Evict(&value));
+      if (victim != -1) {
+        ASSERT_EQ(victim, value);
+        history[victim].clear();
+        evictable[victim] = false;
+      }
+    } else if (evictable[fid]) {
+      lru_replacer.Remove(fid);
+      history[fid].clear();
+      evictable[fid] = false;
+    }
+    ASSERT_EQ(std::count(evictable.begin(), evictable.end(), true), lru_replacer.Size());
+  }
+}
+
+TEST(LRUKReplacerTest, ConcurrentRecordAccessTest) {
+  // Threads record accesses on their own pinned frames without taking the latch, while one thread cycles frames
+  // through the eviction heaps.
+  const size_t num_threads = 4;
+  const size_t frames_per_thread = 16;
+  const size_t shared_frames = 16;
+  LRUKReplacer lru_replacer(num_threads * frames_per_thread + shared_frames, 2);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([&lru_replacer, t] {
+      for (int i = 0; i < 10000; i++) {
+        lru_replacer.RecordAccess(static_cast<frame_id_t>(t * frames_per_thread + i % frames_per_thread));
+      }
+    });
+  }
+  threads.emplace_back([&lru_replacer] {
+    auto first = static_cast<frame_id_t>(num_threads * frames_per_thread);
+    for (int i = 0; i < 10000; i++) {
+      auto fid = first + static_cast<frame_id_t>(i % shared_frames);
+      lru_replacer.RecordAccess(fid);
+      lru_replacer.SetEvictable(fid, true);
+      if (i % 3 == 0) {
+        frame_id_t value;
+        ASSERT_TRUE(lru_replacer.Evict(&value));
+        ASSERT_GE(value, first);
+      }
+    }
+  });
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // The pinned frames were never evictable; once they are, the least recently used ones go first.
+  frame_id_t value;
+  while (lru_replacer.Evict(&value)) {
+  }
+  for (size_t fid = 0; fid < num_threads * frames_per_thread; fid++) {
+    lru_replacer.SetEvictable(static_cast<frame_id_t>(fid), true);
+  }
+  ASSERT_EQ(num_threads * frames_per_thread, lru_replacer.Size());
+  ASSERT_TRUE(lru_replacer.Evict(&value));
+  ASSERT_EQ(0, value % frames_per_thread);
+}
+
 }  // namespace bustub
@@ -0,0 +1,71 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// two_q_replacer_test.cpp
+//
+// Identification: test/buffer/two_q_replacer_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer/two_q_replacer.h"
+
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+TEST(TwoQReplacerTest, SampleTest) {
+  // With 4 frames, A1in may hold 1 frame before Evict takes from it and A1out remembers 2 pages.
+  TwoQReplacer replacer(4);
+  auto load = [&replacer](frame_id_t frame_id, page_id_t page_id) {
+    replacer.SetPageId(frame_id, page_id);
+    replacer.RecordAccess(frame_id);
+    replacer.SetEvictable(frame_id, true);
+  };
+
+  // Scenario: pages loaded once are evicted in FIFO order, and re-accessing them does not change that.
+  for (frame_id_t fid = 0; fid < 4; fid++) {
+    load(fid, 10 + fid);
+  }
+  ASSERT_EQ(4, replacer.Size());
+  frame_id_t value;
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(0, value);
+
+  // Scenario: page 10 comes back while it is still in A1out, so it is now kept in Am.
+  load(0, 10);
+  replacer.RecordAccess(1);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(1, value);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(2, value);
+  // A1in is down to its share, so Am is next.
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(0, value);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(3, value);
+  ASSERT_FALSE(replacer.Evict(&value));
+
+  // Scenario: A1out remembers only pages 12 and 13 now, so page 11 starts over in A1in and page 12 goes to Am.
+  load(1, 11);
+  load(2, 12);
+  load(3, 20);
+  load(0, 21);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(1, value);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(3, value);
+  ASSERT_TRUE(replacer.Evict(&value));
+  ASSERT_EQ(2, value);
+
+  // Scenario: pinned frames are skipped, and removing a frame does not remember its page.
+  replacer.SetEvictable(0, false);
+  ASSERT_FALSE(replacer.Evict(&value));
+  replacer.SetEvictable(0, true);
+  replacer.Remove(0);
+  ASSERT_EQ(0, replacer.Size());
+}
+
+}  // namespace bustub
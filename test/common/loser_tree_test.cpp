@@ -0,0 +1,68 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// loser_tree_test.cpp
+//
+// Identification: test/common/loser_tree_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "common/util/loser_tree.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+/** Merge sorted runs of (key, run) pairs with a loser tree. */
+static auto Merge(const std::vector<std::vector<std::pair<int, size_t>>> &runs) -> std::vector<std::pair<int, size_t>> {
+  std::vector<size_t> next(runs.size(), 0);
+  auto less = [&](size_t a, size_t b) { return runs[a][next[a]].first < runs[b][next[b]].first; };
+  LoserTree<decltype(less)> tree(runs.size(), less);
+  for (size_t i = 0; i < runs.size(); i++) {
+    if (runs[i].empty()) {
+      tree.SetExhausted(i);
+    }
+  }
+  tree.Build();
+  std::vector<std::pair<int, size_t>> merged;
+  for (size_t top = tree.Top(); top < runs.size(); top = tree.Top()) {
+    merged.push_back(runs[top][next[top]++]);
+    if (next[top] == runs[top].size()) {
+      tree.SetExhausted(top);
+    }
+    tree.Replay();
+  }
+  return merged;
+}
+
+// NOLINTNEXTLINE
+TEST(LoserTreeTest, MergeTest) {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int> key_dist(0, 50);
+
+  // Scenario: any number of runs, empty or not, of keys repeated within and across runs, merge in order, equal keys
+  // in the order of their runs.
+  for (size_t num_runs : {0, 1, 2, 3, 5, 8, 13, 16, 17}) {
+    std::vector<std::vector<std::pair<int, size_t>>> runs(num_runs);
+    std::vector<std::pair<int, size_t>> expected;
+    for (size_t run = 0; run < num_runs; run++) {
+      size_t length = run % 4 == 1 ? 0 : gen() % 40;
+      for (size_t i = 0; i < length; i++) {
+        runs[run].emplace_back(key_dist(gen), run);
+      }
+      std::sort(runs[run].begin(), runs[run].end());
+      expected.insert(expected.end(), runs[run].begin(), runs[run].end());
+    }
+    std::stable_sort(expected.begin(), expected.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+    ASSERT_EQ(expected, Merge(runs)) << num_runs << " runs";
+  }
+}
+
+}  // namespace bustub
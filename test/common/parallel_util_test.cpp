@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parallel_util_test.cpp
+//
+// Identification: test/common/parallel_util_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <mutex>  // NOLINT
+#include <set>
+#include <stdexcept>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/util/parallel_util.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(ParallelUtilTest, WorkerPoolTest) {
+  WorkerPool pool(3);
+  ASSERT_EQ(3, pool.NumWorkers());
+
+  // Scenario: the same workers run one phase after the other, each task of a phase exactly once, whether there are
+  // fewer tasks than threads or more.
+  std::set<std::thread::id> threads;
+  std::mutex threads_latch;
+  for (size_t num_tasks : {size_t{1}, size_t{2}, size_t{4}, size_t{64}}) {
+    for (int round = 0; round < 50; round++) {
+      std::vector<std::atomic<int>> runs(num_tasks);
+      RunParallel(&pool, num_tasks, [&](size_t task) {
+        runs[task]++;
+        std::scoped_lock lock(threads_latch);
+        threads.insert(std::this_thread::get_id());
+      });
+      for (const auto &count : runs) {
+        ASSERT_EQ(1, count);
+      }
+    }
+  }
+  ASSERT_LE(threads.size(), 4);
+
+  // Scenario: a task may run a phase of its own, even with every worker busy.
+  std::atomic<int> inner{0};
+  RunParallel(&pool, 8, [&](size_t) { RunParallel(&pool, 8, [&](size_t) { inner++; }); });
+  ASSERT_EQ(64, inner);
+
+  // Scenario: the error of a task comes back to the caller once the other tasks are done, and the pool still works.
+  std::atomic<int> done{0};
+  ASSERT_THROW(RunParallel(&pool, 16,
+                           [&](size_t task) {
+                             if (task == 5) {
+                               throw std::runtime_error("task failed");
+                             }
+                             done++;
+                           }),
+               std::runtime_error);
+  ASSERT_EQ(15, done);
+  RunParallel(&pool, 4, [&](size_t) { done++; });
+  ASSERT_EQ(19, done);
+
+  // Scenario: without a pool, the tasks run on the calling thread.
+  std::vector<size_t> order;
+  RunParallel(nullptr, 3, [&](size_t task) { order.push_back(task); });
+  ASSERT_EQ((std::vector<size_t>{0, 1, 2}), order);
+}
+
+}  // namespace bustub
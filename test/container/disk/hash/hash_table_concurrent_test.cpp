@@ -0,0 +1,134 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hash_table_concurrent_test.cpp
+//
+// Identification: test/container/disk/hash/hash_table_concurrent_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/exception.h"
+#include "container/disk/hash/disk_extendible_hash_table.h"
+#include "gtest/gtest.h"
+#include "storage/index/extendible_hash_table_index.h"
+#include "test_util.h"  // NOLINT
+#include "type/value_factory.h"
+
+namespace bustub {
+
+using Table = DiskExtendibleHashTable<IntegerKey, RID, IntegerComparator>;
+
+// NOLINTNEXTLINE
+TEST(HashTableConcurrentTest, SplitMergeTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  TestBufferPool pool(50);
+  Table table("foo_pk", pool.Get(), IntegerComparator(key_schema.get()), HashFunction<IntegerKey>());
+
+  // Scenario: keys many buckets worth, each with two values, split the directory and are all found.
+  const int64_t num_keys = 5000;
+  for (int64_t key = 0; key < num_keys; key++) {
+    ASSERT_TRUE(table.Insert(nullptr, MakeKey(key), MakeRid(key)));
+    ASSERT_TRUE(table.Insert(nullptr, MakeKey(key), MakeRid(key + num_keys)));
+  }
+  ASSERT_FALSE(table.Insert(nullptr, MakeKey(7), MakeRid(7)));
+  ASSERT_GT(table.GetGlobalDepth(), 0);
+  table.VerifyIntegrity();
+  for (int64_t key = 0; key < num_keys; key++) {
+    std::vector<RID> result;
+    ASSERT_TRUE(table.GetValue(nullptr, MakeKey(key), &result));
+    ASSERT_EQ(2, result.size());
+  }
+
+  // Scenario: emptied buckets merge back, down to a directory of a single bucket.
+  for (int64_t key = 0; key < num_keys; key++) {
+    ASSERT_TRUE(table.Remove(nullptr, MakeKey(key), MakeRid(key)));
+    ASSERT_TRUE(table.Remove(nullptr, MakeKey(key), MakeRid(key + num_keys)));
+  }
+  ASSERT_FALSE(table.Remove(nullptr, MakeKey(7), MakeRid(7)));
+  ASSERT_EQ(0, table.GetGlobalDepth());
+  table.VerifyIntegrity();
+  std::vector<RID> result;
+  ASSERT_FALSE(table.GetValue(nullptr, MakeKey(7), &result));
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableConcurrentTest, ConcurrentTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  TestBufferPool pool(50);
+  Table table("foo_pk", pool.Get(), IntegerComparator(key_schema.get()), HashFunction<IntegerKey>());
+  const int num_threads = 4;
+  const int64_t keys_per_thread = 3000;
+
+  // Scenario: threads inserting, looking up and removing keys of their own, splitting and merging buckets under each
+  // other, each see their own keys, and leave exactly the keys they keep.
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < num_threads; thread++) {
+    threads.emplace_back([&, thread] {
+      int64_t begin = thread * keys_per_thread;
+      for (int64_t key = begin; key < begin + keys_per_thread; key++) {
+        ASSERT_TRUE(table.Insert(nullptr, MakeKey(key), MakeRid(key)));
+      }
+      for (int64_t key = begin; key < begin + keys_per_thread; key++) {
+        std::vector<RID> result;
+        ASSERT_TRUE(table.GetValue(nullptr, MakeKey(key), &result));
+        ASSERT_EQ(std::vector<RID>{MakeRid(key)}, result);
+        if (key % 3 != 0) {
+          ASSERT_TRUE(table.Remove(nullptr, MakeKey(key), MakeRid(key)));
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  table.VerifyIntegrity();
+  for (int64_t key = 0; key < num_threads * keys_per_thread; key++) {
+    std::vector<RID> result;
+    ASSERT_EQ(key % 3 == 0, table.GetValue(nullptr, MakeKey(key), &result)) << key;
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableConcurrentTest, IndexTest) {
+  TestBufferPool pool(50);
+  auto table_schema = ParseCreateStatement("a integer,b integer");
+  auto metadata = std::make_unique<IndexMetadata>("foo_pk", "foo", table_schema.get(), std::vector<uint32_t>{1});
+  const Schema *key_schema = metadata->GetKeySchema();
+  ExtendibleHashTableIndex<IntegerKey, RID, IntegerComparator> index(std::move(metadata), pool.Get(),
+                                                                      HashFunction<IntegerKey>());
+  auto make_key = [&](int32_t key) { return Tuple({ValueFactory::GetIntegerValue(key)}, key_schema); };
+  for (int32_t key = 0; key < 1000; key++) {
+    ASSERT_TRUE(index.InsertEntry(make_key(key % 100), MakeRid(key), nullptr));
+  }
+
+  // Scenario: a range of a single key is a lookup of it, any other range cannot be scanned.
+  IndexScanRange range;
+  range.low_ = make_key(42);
+  range.high_ = make_key(42);
+  auto cursor = index.ScanRange(range, nullptr);
+  std::vector<RID> rids;
+  RID rid;
+  while (cursor->Next(&rid)) {
+    rids.push_back(rid);
+  }
+  std::vector<RID> expected;
+  index.ScanKey(make_key(42), &expected, nullptr);
+  ASSERT_EQ(10, rids.size());
+  ASSERT_EQ(expected, rids);
+
+  range.high_ = make_key(43);
+  ASSERT_THROW(index.ScanRange(range, nullptr), NotImplementedException);
+  range.high_ = make_key(42);
+  range.low_inclusive_ = false;
+  ASSERT_THROW(index.ScanRange(range, nullptr), NotImplementedException);
+}
+
+}  // namespace bustub
@@ -23,7 +23,7 @@
 namespace bustub {
 
 // NOLINTNEXTLINE
-TEST(HashTablePageTest, DISABLED_DirectoryPageSampleTest) {
+TEST(HashTablePageTest, DirectoryPageSampleTest) {
   auto *disk_manager = new DiskManager("test.db");
   auto *bpm = new BufferPoolManager(5, disk_manager);
 
@@ -49,14 +49,16 @@ TEST(HashTablePageTest, DISABLED_DirectoryPageSampleTest) {
 
   // unpin the directory page now that we are done
   bpm->UnpinPage(directory_page_id, true);
+  // The pool writes dirty pages back until it is deleted, so it goes before the files.
+  delete bpm;
   disk_manager->ShutDown();
   remove("test.db");
+  remove("test.log");
   delete disk_manager;
-  delete bpm;
 }
 
 // NOLINTNEXTLINE
-TEST(HashTablePageTest, DISABLED_BucketPageSampleTest) {
+TEST(HashTablePageTest, BucketPageSampleTest) {
   auto *disk_manager = new DiskManager("test.db");
   auto *bpm = new BufferPoolManager(5, disk_manager);
 
@@ -107,10 +109,12 @@ TEST(HashTablePageTest, DISABLED_BucketPageSampleTest) {
 
   // unpin the directory page now that we are done
   bpm->UnpinPage(bucket_page_id, true);
+  // The pool writes dirty pages back until it is deleted, so it goes before the files.
+  delete bpm;
   disk_manager->ShutDown();
   remove("test.db");
+  remove("test.log");
   delete disk_manager;
-  delete bpm;
 }
 
 }  // namespace bustub
@@ -0,0 +1,149 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// compiled_expression_test.cpp
+//
+// Identification: test/execution/compiled_expression_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "execution/compiled_expression.h"
+#include "expression_test_util.h"  // NOLINT
+#include "execution/tuple_batch.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** Assert that two values are both null, or equal, of the same type. */
+void AssertSameValue(const Value &expected, const Value &actual, const std::string &what) {
+  ASSERT_EQ(expected.GetTypeId(), actual.GetTypeId()) << what;
+  ASSERT_EQ(expected.IsNull(), actual.IsNull()) << what;
+  if (!expected.IsNull()) {
+    ASSERT_EQ(CmpBool::CmpTrue, expected.CompareEquals(actual)) << what;
+  }
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(CompiledExpressionTest, MatchesInterpreterTest) {
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 16}, Column{"c", TypeId::BIGINT},
+                 Column{"d", TypeId::DECIMAL}, Column{"e", TypeId::BOOLEAN}});
+  std::vector<Tuple> tuples;
+  for (int32_t i = 0; i < 12; i++) {
+    // Every fourth row is all nulls.
+    if (i % 4 == 3) {
+      tuples.emplace_back(std::vector<Value>{ValueFactory::GetNullValueByType(TypeId::INTEGER),
+                                             ValueFactory::GetNullValueByType(TypeId::VARCHAR),
+                                             ValueFactory::GetNullValueByType(TypeId::BIGINT),
+                                             ValueFactory::GetNullValueByType(TypeId::DECIMAL),
+                                             ValueFactory::GetNullValueByType(TypeId::BOOLEAN)},
+                          &schema);
+      continue;
+    }
+    tuples.emplace_back(std::vector<Value>{ValueFactory::GetIntegerValue(i - 5),
+                                           ValueFactory::GetVarcharValue(std::string(i % 3, 'x') + std::to_string(i)),
+                                           ValueFactory::GetBigIntValue(int64_t{i} * 1000000000),
+                                           ValueFactory::GetDecimalValue(i * 0.5),
+                                           ValueFactory::GetBooleanValue(i % 2 == 0)},
+                        &schema);
+  }
+
+  auto a = Col(0, TypeId::INTEGER);
+  auto b = Col(1, TypeId::VARCHAR);
+  auto c = Col(2, TypeId::BIGINT);
+  auto d = Col(3, TypeId::DECIMAL);
+  auto e = Col(4, TypeId::BOOLEAN);
+  std::vector<AbstractExpressionRef> exprs{
+      a,
+      b,
+      Cmp(a, Const(ValueFactory::GetIntegerValue(0)), ComparisonType::LessThan),
+      Cmp(c, a, ComparisonType::GreaterThanOrEqual),
+      Cmp(d, Const(ValueFactory::GetDecimalValue(2.5)), ComparisonType::NotEqual),
+      Cmp(b, Const(ValueFactory::GetVarcharValue("x4")), ComparisonType::Equal),
+      Cmp(b, Const(ValueFactory::GetVarcharValue("x")), ComparisonType::LessThanOrEqual),
+      Cmp(e, Const(ValueFactory::GetBooleanValue(true)), ComparisonType::Equal),
+      Arith(Arith(a, Const(ValueFactory::GetIntegerValue(7)), ArithmeticType::Plus), a, ArithmeticType::Minus),
+      Logic(Cmp(a, Const(ValueFactory::GetIntegerValue(2)), ComparisonType::GreaterThan), e, LogicType::And),
+      Logic(Cmp(a, Const(ValueFactory::GetIntegerValue(-2)), ComparisonType::LessThan), e, LogicType::Or),
+      Logic(e, Cmp(a, Const(ValueFactory::GetNullValueByType(TypeId::INTEGER)), ComparisonType::Equal), LogicType::Or),
+      // Unsupported nodes, and operands of types that do not pair up, fall back to the interpreter.
+      Cmp(a, d, ComparisonType::LessThan),
+      Logic(Cmp(a, d, ComparisonType::GreaterThan), Cmp(b, Const(ValueFactory::GetVarcharValue("xx5")),
+                                                          ComparisonType::GreaterThan),
+            LogicType::Or),
+  };
+
+  TupleBatch batch;
+  batch.Reset(schema);
+  for (const auto &tuple : tuples) {
+    batch.AppendTuple(tuple, schema, RID{});
+  }
+  std::vector<Value> expected;
+  std::vector<Value> actual;
+  for (const auto &expr : exprs) {
+    CompiledExpression compiled(expr, schema);
+    ASSERT_GT(compiled.NumInstructions(), 0);
+
+    // Scenario: a compiled expression evaluates tuples to the values the tree interpreter gives, nulls included.
+    for (const auto &tuple : tuples) {
+      auto value = expr->Evaluate(&tuple, schema);
+      AssertSameValue(value, compiled.Evaluate(tuple), expr->ToString());
+      if (expr->GetReturnType() == TypeId::BOOLEAN) {
+        ASSERT_EQ(!value.IsNull() && value.GetAs<bool>(), compiled.EvaluatePredicate(tuple)) << expr->ToString();
+      }
+    }
+
+    // Scenario: and so it does for the selected rows of a batch.
+    expr->EvaluateBatch(batch, schema, &expected);
+    compiled.EvaluateBatch(batch, &actual);
+    ASSERT_EQ(expected.size(), actual.size());
+    for (auto row : batch.GetSelection()) {
+      AssertSameValue(expected[row], actual[row], expr->ToString());
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(CompiledExpressionTest, FallbackTest) {
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"d", TypeId::DECIMAL}});
+  auto a = Col(0, TypeId::INTEGER);
+  auto mixed = Cmp(a, Col(1, TypeId::DECIMAL), ComparisonType::LessThan);
+
+  // Scenario: a tree of supported nodes is compiled, one instruction per column and operator.
+  CompiledExpression compiled(
+      Logic(Cmp(a, Const(ValueFactory::GetIntegerValue(1)), ComparisonType::GreaterThan),
+            Cmp(a, Const(ValueFactory::GetIntegerValue(9)), ComparisonType::LessThan), LogicType::And),
+      schema);
+  ASSERT_TRUE(compiled.IsCompiled());
+  ASSERT_EQ(5, compiled.NumInstructions());
+
+  // Scenario: an unsupported node is one instruction of the program, and a tree of one is left to the interpreter.
+  CompiledExpression partly(
+      Logic(mixed, Cmp(a, Const(ValueFactory::GetIntegerValue(1)), ComparisonType::GreaterThan), LogicType::And),
+      schema);
+  ASSERT_TRUE(partly.IsCompiled());
+  ASSERT_EQ(4, partly.NumInstructions());
+  CompiledExpression interpreted(mixed, schema);
+  ASSERT_FALSE(interpreted.IsCompiled());
+
+  Tuple tuple({ValueFactory::GetIntegerValue(5), ValueFactory::GetDecimalValue(5.5)}, &schema);
+  ASSERT_TRUE(compiled.EvaluatePredicate(tuple));
+  ASSERT_TRUE(partly.EvaluatePredicate(tuple));
+  ASSERT_TRUE(interpreted.EvaluatePredicate(tuple));
+  tuple = Tuple({ValueFactory::GetIntegerValue(5), ValueFactory::GetDecimalValue(4.5)}, &schema);
+  ASSERT_FALSE(partly.EvaluatePredicate(tuple));
+  ASSERT_FALSE(interpreted.EvaluatePredicate(tuple));
+}
+
+}  // namespace bustub
@@ -0,0 +1,227 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// filter_kernels_test.cpp
+//
+// Identification: test/execution/filter_kernels_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "execution/batch_filter.h"
+#include "execution/compiled_expression.h"
+#include "execution/filter_kernels.h"
+#include "expression_test_util.h"  // NOLINT
+#include "gtest/gtest.h"
+#include "type/limits.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+const std::vector<ComparisonType> COMPARISONS{ComparisonType::Equal,           ComparisonType::NotEqual,
+                                              ComparisonType::LessThan,        ComparisonType::LessThanOrEqual,
+                                              ComparisonType::GreaterThan,     ComparisonType::GreaterThanOrEqual};
+
+/** @return whether a comparison of two values is true, as the interpreter compares them */
+auto ReferenceCompare(ComparisonType op, const Value &lhs, const Value &rhs) -> bool {
+  CmpBool result;
+  switch (op) {
+    case ComparisonType::Equal:
+      result = lhs.CompareEquals(rhs);
+      break;
+    case ComparisonType::NotEqual:
+      result = lhs.CompareNotEquals(rhs);
+      break;
+    case ComparisonType::LessThan:
+      result = lhs.CompareLessThan(rhs);
+      break;
+    case ComparisonType::LessThanOrEqual:
+      result = lhs.CompareLessThanEquals(rhs);
+      break;
+    case ComparisonType::GreaterThan:
+      result = lhs.CompareGreaterThan(rhs);
+      break;
+    default:
+      result = lhs.CompareGreaterThanEquals(rhs);
+      break;
+  }
+  return result == CmpBool::CmpTrue;
+}
+
+auto Bit(const SelectionBitmap &bitmap, size_t row) -> bool { return ((bitmap[row / 64] >> (row % 64)) & 1) != 0; }
+
+/** Check the kernels of a type on random values, a few of them null, for every comparison and kernel. */
+template <TypeId type>
+void CheckKernels(const std::vector<typename FilterKernelType<type>::Type> &lhs,
+                  const std::vector<typename FilterKernelType<type>::Type> &rhs) {
+  std::vector<FilterKernel> kernels{FilterKernel::Scalar, FilterKernel::AVX2};
+  for (auto kernel : kernels) {
+    if (!FilterKernelSupported(kernel)) {
+      continue;
+    }
+    for (auto op : COMPARISONS) {
+      // Scenario: every row, the ones of the ragged tail of a vector included, has the bit of its comparison.
+      for (size_t num_rows : {lhs.size(), lhs.size() - 1, size_t{5}}) {
+        SelectionBitmap columns(SelectionBitmapWords(num_rows), ~uint64_t{0});
+        SelectionBitmap constant(SelectionBitmapWords(num_rows), ~uint64_t{0});
+        CompareColumns<type>(op, lhs.data(), rhs.data(), num_rows, columns.data(), kernel);
+        CompareColumnConstant<type>(op, lhs.data(), rhs[0], num_rows, constant.data(), kernel);
+        for (size_t row = 0; row < num_rows; row++) {
+          auto l = Value(type, lhs[row]);
+          ASSERT_EQ(ReferenceCompare(op, l, Value(type, rhs[row])), Bit(columns, row))
+              << FilterKernelToString(kernel) << " row " << row;
+          ASSERT_EQ(ReferenceCompare(op, l, Value(type, rhs[0])), Bit(constant, row))
+              << FilterKernelToString(kernel) << " row " << row;
+        }
+        // Scenario: bits past the last row are cleared.
+        if (num_rows % 64 != 0) {
+          ASSERT_EQ(0, columns.back() >> (num_rows % 64));
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(FilterKernelsTest, CompareTest) {
+  std::mt19937 rng(15445);
+  constexpr size_t num_rows = 200;
+  std::vector<int8_t> booleans(num_rows);
+  std::vector<int32_t> integers(num_rows);
+  std::vector<int32_t> other_integers(num_rows);
+  std::vector<int64_t> bigints(num_rows);
+  std::vector<int64_t> other_bigints(num_rows);
+  std::vector<double> decimals(num_rows);
+  std::vector<double> other_decimals(num_rows);
+  for (size_t i = 0; i < num_rows; i++) {
+    // Few distinct values, so that many compare equal, and one in ten null.
+    bool null = rng() % 10 == 0;
+    booleans[i] = null ? BUSTUB_BOOLEAN_NULL : static_cast<int8_t>(rng() % 2);
+    integers[i] = null ? BUSTUB_INT32_NULL : static_cast<int32_t>(rng() % 9) - 4;
+    other_integers[i] = rng() % 10 == 0 ? BUSTUB_INT32_NULL : static_cast<int32_t>(rng() % 9) - 4;
+    bigints[i] = null ? BUSTUB_INT64_NULL : (static_cast<int64_t>(rng() % 5) - 2) << 40;
+    other_bigints[i] = rng() % 10 == 0 ? BUSTUB_INT64_NULL : (static_cast<int64_t>(rng() % 5) - 2) << 40;
+    decimals[i] = null ? BUSTUB_DECIMAL_NULL : (static_cast<int>(rng() % 7) - 3) * 0.5;
+    other_decimals[i] = rng() % 10 == 0 ? BUSTUB_DECIMAL_NULL : (static_cast<int>(rng() % 7) - 3) * 0.5;
+  }
+  std::vector<int8_t> other_booleans(booleans.rbegin(), booleans.rend());
+  other_integers[0] = 1;
+  other_bigints[0] = int64_t{1} << 40;
+  other_decimals[0] = 0.5;
+  other_booleans[0] = 1;
+
+  CheckKernels<TypeId::BOOLEAN>(booleans, other_booleans);
+  CheckKernels<TypeId::INTEGER>(integers, other_integers);
+  CheckKernels<TypeId::BIGINT>(bigints, other_bigints);
+  CheckKernels<TypeId::DECIMAL>(decimals, other_decimals);
+}
+
+// NOLINTNEXTLINE
+TEST(FilterKernelsTest, ArithmeticTest) {
+  constexpr int32_t null = BUSTUB_INT32_NULL;
+  constexpr int32_t max = BUSTUB_INT32_MAX;
+  std::vector<int32_t> lhs{1, max, null, -7, 0, 5, max, 3, -2, 9, 1};
+  std::vector<int32_t> rhs{2, 1, 4, null, 0, -5, -1, 3, -2, 1, max};
+  std::vector<int32_t> expected_sum{3, null, null, null, 0, 0, max - 1, 6, -4, 10, null};
+  std::vector<int32_t> expected_difference{-1, max - 1, null, null, 0, 10, null, 0, 0, 8, 1 - max};
+  for (auto kernel : {FilterKernel::Scalar, FilterKernel::AVX2}) {
+    if (!FilterKernelSupported(kernel)) {
+      continue;
+    }
+    // Scenario: integers add and subtract as ArithmeticExpression does: a null operand makes a null, and a result
+    // wraps around as 32-bit integers do, to the null integer included.
+    std::vector<int32_t> sum(lhs.size());
+    std::vector<int32_t> difference(lhs.size());
+    AddIntegers(lhs.data(), rhs.data(), lhs.size(), sum.data(), kernel);
+    SubtractIntegers(lhs.data(), rhs.data(), lhs.size(), difference.data(), kernel);
+    ASSERT_EQ(expected_sum, sum) << FilterKernelToString(kernel);
+    ASSERT_EQ(expected_difference, difference) << FilterKernelToString(kernel);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(FilterKernelsTest, BatchFilterTest) {
+  // Scenario: batch filters run with the AVX2 kernels wherever the CPU has them, whatever the build targets.
+  ASSERT_EQ(FilterKernelSupported(FilterKernel::AVX2) ? FilterKernel::AVX2 : FilterKernel::Scalar,
+            DefaultFilterKernel());
+
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::BIGINT}, Column{"c", TypeId::DECIMAL},
+                 Column{"d", TypeId::BOOLEAN}, Column{"e", TypeId::INTEGER}, Column{"f", TypeId::VARCHAR, 8}});
+  TupleBatch batch;
+  batch.Reset(schema);
+  for (int32_t i = 0; i < 300; i++) {
+    auto null = [&](TypeId type, const Value &value) {
+      return i % 11 == 5 ? ValueFactory::GetNullValueByType(type) : value;
+    };
+    batch.AppendTuple(Tuple({null(TypeId::INTEGER, ValueFactory::GetIntegerValue(i % 17 - 8)),
+                             ValueFactory::GetBigIntValue(int64_t{i} * 3000000000),
+                             null(TypeId::DECIMAL, ValueFactory::GetDecimalValue(i * 0.25)),
+                             null(TypeId::BOOLEAN, ValueFactory::GetBooleanValue(i % 3 == 0)),
+                             ValueFactory::GetIntegerValue(i % 5), ValueFactory::GetVarcharValue(std::to_string(i))},
+                            &schema),
+                      schema, RID(0, i));
+  }
+  auto a = Col(0, TypeId::INTEGER);
+  auto b = Col(1, TypeId::BIGINT);
+  auto c = Col(2, TypeId::DECIMAL);
+  auto d = Col(3, TypeId::BOOLEAN);
+  auto e = Col(4, TypeId::INTEGER);
+  auto plus = std::make_shared<ArithmeticExpression>(a, e, ArithmeticType::Plus);
+  auto minus =
+      std::make_shared<ArithmeticExpression>(Const(ValueFactory::GetIntegerValue(3)), e, ArithmeticType::Minus);
+
+  std::vector<AbstractExpressionRef> covered{
+      Logic(Cmp(a, Const(ValueFactory::GetIntegerValue(2)), ComparisonType::GreaterThan),
+            Cmp(e, Const(ValueFactory::GetIntegerValue(3)), ComparisonType::Equal), LogicType::And),
+      Logic(Cmp(Const(ValueFactory::GetIntegerValue(0)), a, ComparisonType::LessThan),
+            Cmp(d, Const(ValueFactory::GetBooleanValue(true)), ComparisonType::Equal), LogicType::Or),
+      Cmp(b, Const(ValueFactory::GetIntegerValue(5)), ComparisonType::GreaterThanOrEqual),
+      Cmp(b, Const(ValueFactory::GetBigIntValue(int64_t{150} * 3000000000)), ComparisonType::LessThan),
+      Cmp(c, Const(ValueFactory::GetIntegerValue(30)), ComparisonType::LessThanOrEqual),
+      Cmp(c, Const(ValueFactory::GetDecimalValue(12.5)), ComparisonType::NotEqual),
+      Cmp(plus, minus, ComparisonType::GreaterThan),
+      Cmp(a, e, ComparisonType::Equal),
+      Cmp(a, Const(ValueFactory::GetNullValueByType(TypeId::INTEGER)), ComparisonType::NotEqual),
+  };
+  std::vector<AbstractExpressionRef> not_covered{
+      Cmp(Col(5, TypeId::VARCHAR), Const(ValueFactory::GetVarcharValue("7")), ComparisonType::Equal),
+      Cmp(a, b, ComparisonType::LessThan),
+      Cmp(a, Const(ValueFactory::GetDecimalValue(2.5)), ComparisonType::LessThan),
+      Logic(Cmp(a, e, ComparisonType::Equal), Cmp(a, c, ComparisonType::Equal), LogicType::And),
+      d,
+  };
+
+  // Scenario: a filter selects the rows the predicate is true for, as the interpreter evaluates it, from the rows
+  // still selected.
+  std::vector<Value> values;
+  for (const auto &predicate : covered) {
+    ASSERT_NE(nullptr, BatchFilter::Create(predicate, schema)) << predicate->ToString();
+    auto copy = batch;
+    copy.Select(std::vector<uint64_t>(SelectionBitmapWords(copy.NumRows()), 0xAAAAAAAAAAAAAAAA));
+    auto expected = copy;
+    predicate->EvaluateBatch(expected, schema, &values);
+    expected.Select(values);
+    CompiledExpression compiled(predicate, schema);
+    ASSERT_TRUE(compiled.HasBatchFilter());
+    compiled.SelectBatch(&copy);
+    ASSERT_EQ(expected.GetSelection(), copy.GetSelection()) << predicate->ToString();
+  }
+
+  // Scenario: predicates the kernels do not cover are left to the compiled expression.
+  for (const auto &predicate : not_covered) {
+    ASSERT_EQ(nullptr, BatchFilter::Create(predicate, schema)) << predicate->ToString();
+  }
+}
+
+}  // namespace bustub
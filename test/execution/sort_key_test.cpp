@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key_test.cpp
+//
+// Identification: test/execution/sort_key_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/sort_key.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+/** @return -1, 0 or 1 as a sorts before, with or after b, nulls first, by comparing the values themselves */
+static auto ExpectedOrder(const Value &a, const Value &b) -> int {
+  if (a.IsNull() || b.IsNull()) {
+    return a.IsNull() == b.IsNull() ? 0 : (a.IsNull() ? -1 : 1);
+  }
+  if (a.CompareEquals(b) == CmpBool::CmpTrue) {
+    return 0;
+  }
+  return a.CompareLessThan(b) == CmpBool::CmpTrue ? -1 : 1;
+}
+
+static auto Encode(const Value &value, bool descending) -> std::string {
+  std::string key;
+  SortKeyEncoder::EncodeValue(value, descending, &key);
+  return key;
+}
+
+static auto Sign(int cmp) -> int { return cmp < 0 ? -1 : (cmp > 0 ? 1 : 0); }
+
+// NOLINTNEXTLINE
+TEST(SortKeyTest, ValueTest) {
+  std::vector<std::vector<Value>> values_by_type{
+      {ValueFactory::GetBooleanValue(true), ValueFactory::GetBooleanValue(false)},
+      {ValueFactory::GetTinyIntValue(-127), ValueFactory::GetTinyIntValue(-1), ValueFactory::GetTinyIntValue(0),
+       ValueFactory::GetTinyIntValue(1), ValueFactory::GetTinyIntValue(127)},
+      {ValueFactory::GetSmallIntValue(-32767), ValueFactory::GetSmallIntValue(-256), ValueFactory::GetSmallIntValue(-1),
+       ValueFactory::GetSmallIntValue(0), ValueFactory::GetSmallIntValue(255), ValueFactory::GetSmallIntValue(32767)},
+      {ValueFactory::GetIntegerValue(-2147483647), ValueFactory::GetIntegerValue(-65536),
+       ValueFactory::GetIntegerValue(-1), ValueFactory::GetIntegerValue(0), ValueFactory::GetIntegerValue(1),
+       ValueFactory::GetIntegerValue(256), ValueFactory::GetIntegerValue(2147483647)},
+      {ValueFactory::GetBigIntValue(-9223372036854775807LL), ValueFactory::GetBigIntValue(-4294967296LL),
+       ValueFactory::GetBigIntValue(-1), ValueFactory::GetBigIntValue(0), ValueFactory::GetBigIntValue(4294967296LL),
+       ValueFactory::GetBigIntValue(9223372036854775807LL)},
+      {ValueFactory::GetDecimalValue(-1e300), ValueFactory::GetDecimalValue(-2.5), ValueFactory::GetDecimalValue(-0.0),
+       ValueFactory::GetDecimalValue(0.0), ValueFactory::GetDecimalValue(1e-300), ValueFactory::GetDecimalValue(2.5),
+       ValueFactory::GetDecimalValue(1e300)},
+      {ValueFactory::GetVarcharValue(""), ValueFactory::GetVarcharValue("a"), ValueFactory::GetVarcharValue("ab"),
+       ValueFactory::GetVarcharValue("abc"), ValueFactory::GetVarcharValue("b"),
+       ValueFactory::GetVarcharValue("\xff\xfe"), ValueFactory::GetVarcharValue("a\0b", 4, true),
+       ValueFactory::GetVarcharValue("a\0", 3, true)},
+  };
+
+  // Scenario: keys of any two values of a type, nulls included, compare as the values do, whichever the direction.
+  for (auto &values : values_by_type) {
+    values.push_back(ValueFactory::GetNullValueByType(values[0].GetTypeId()));
+    for (const auto &a : values) {
+      for (const auto &b : values) {
+        int expected = ExpectedOrder(a, b);
+        ASSERT_EQ(expected, Sign(Encode(a, false).compare(Encode(b, false)))) << a.ToString() << " " << b.ToString();
+        ASSERT_EQ(-expected, Sign(Encode(a, true).compare(Encode(b, true)))) << a.ToString() << " " << b.ToString();
+      }
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(SortKeyTest, TupleTest) {
+  Schema schema({Column{"a", TypeId::VARCHAR, 16}, Column{"b", TypeId::INTEGER}});
+  std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys{
+      {OrderByType::DEFAULT, std::make_shared<ColumnValueExpression>(0, 0, TypeId::VARCHAR)},
+      {OrderByType::DESC, std::make_shared<ColumnValueExpression>(0, 1, TypeId::INTEGER)}};
+  SortKeyEncoder encoder(order_bys);
+  auto key = [&](const char *a, int32_t b) {
+    return encoder.Encode(Tuple({ValueFactory::GetVarcharValue(a), ValueFactory::GetIntegerValue(b)}, &schema), schema);
+  };
+
+  // Scenario: a column only breaks ties of the columns before it, even after a shorter string.
+  ASSERT_LT(key("a", 1), key("ab", 2));
+  ASSERT_LT(key("a", 2), key("ab", 1));
+  ASSERT_LT(key("ab", 2), key("ab", 1));
+  ASSERT_EQ(key("ab", 1), key("ab", 1));
+}
+
+}  // namespace bustub
@@ -0,0 +1,121 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_batch_test.cpp
+//
+// Identification: test/execution/tuple_batch_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/tuple_batch.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(TupleBatchTest, ColumnTest) {
+  ColumnVector ints(TypeId::INTEGER);
+  ints.Append(ValueFactory::GetIntegerValue(7));
+  ints.Append(ValueFactory::GetNullValueByType(TypeId::INTEGER));
+  ints.Append(ValueFactory::GetBigIntValue(-3));
+  ColumnVector strings(TypeId::VARCHAR);
+  strings.Append(ValueFactory::GetVarcharValue("bustub"));
+  strings.Append(ValueFactory::GetNullValueByType(TypeId::VARCHAR));
+
+  // Scenario: fixed-length values are packed as their type, nulls and values cast from other types included.
+  ASSERT_EQ(3, ints.Size());
+  ASSERT_EQ(7, ints.GetData<int32_t>()[0]);
+  ASSERT_TRUE(ints.GetValue(1).IsNull());
+  ASSERT_EQ(TypeId::INTEGER, ints.GetValue(2).GetTypeId());
+  ASSERT_EQ(-3, ints.GetData<int32_t>()[2]);
+
+  // Scenario: varchars are kept whole.
+  ASSERT_EQ("bustub", strings.GetValue(0).ToString());
+  ASSERT_TRUE(strings.GetValue(1).IsNull());
+}
+
+// NOLINTNEXTLINE
+TEST(TupleBatchTest, SelectTest) {
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 16}});
+  TupleBatch batch;
+  batch.Reset(schema);
+  for (int32_t i = 0; i < 10; i++) {
+    batch.AppendTuple(Tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::to_string(i))},
+                            &schema),
+                      schema, RID(1, i));
+  }
+  ASSERT_EQ(10, batch.Size());
+
+  // Scenario: a predicate narrows the selection to the rows it holds for, and a null is not true.
+  auto column = std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER);
+  auto less = std::make_shared<ComparisonExpression>(
+      column, std::make_shared<ConstantValueExpression>(ValueFactory::GetIntegerValue(6)), ComparisonType::LessThan);
+  std::vector<Value> result;
+  less->EvaluateBatch(batch, schema, &result);
+  ASSERT_EQ(10, result.size());
+  result[2] = ValueFactory::GetNullValueByType(TypeId::BOOLEAN);
+  batch.Select(result);
+  ASSERT_EQ((std::vector<uint32_t>{0, 1, 3, 4, 5}), batch.GetSelection());
+  ASSERT_EQ(10, batch.NumRows());
+
+  // Scenario: a second predicate only looks at the rows still selected, which keep their tuples and RIDs.
+  auto greater = std::make_shared<ComparisonExpression>(
+      column, std::make_shared<ConstantValueExpression>(ValueFactory::GetIntegerValue(2)), ComparisonType::GreaterThan);
+  greater->EvaluateBatch(batch, schema, &result);
+  batch.Select(result);
+  ASSERT_EQ((std::vector<uint32_t>{3, 4, 5}), batch.GetSelection());
+  auto tuple = batch.GetTuple(4, schema);
+  ASSERT_EQ(4, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+  ASSERT_EQ("4", tuple.GetValue(&schema, 1).ToString());
+  ASSERT_EQ(RID(1, 4), tuple.GetRid());
+}
+
+// NOLINTNEXTLINE
+TEST(TupleBatchTest, TupleTest) {
+  Schema schema({Column{"a", TypeId::VARCHAR, 16}, Column{"b", TypeId::INTEGER}, Column{"c", TypeId::VARCHAR, 16}});
+  std::vector<Tuple> tuples{
+      Tuple({ValueFactory::GetVarcharValue("left"), ValueFactory::GetIntegerValue(1),
+             ValueFactory::GetVarcharValue("right")},
+            &schema),
+      Tuple({ValueFactory::GetNullValueByType(TypeId::VARCHAR), ValueFactory::GetNullValueByType(TypeId::INTEGER),
+             ValueFactory::GetVarcharValue("")},
+            &schema)};
+  TupleBatch batch;
+  batch.Reset(schema);
+  for (const auto &tuple : tuples) {
+    batch.AppendTuple(tuple, schema, RID{});
+  }
+
+  // Scenario: a row read back from a batch is the tuple it was made from, byte for byte, nulls and varchars included.
+  for (uint32_t row = 0; row < tuples.size(); row++) {
+    auto tuple = batch.GetTuple(row, schema);
+    ASSERT_EQ(tuples[row].GetLength(), tuple.GetLength());
+    ASSERT_EQ(0, memcmp(tuples[row].GetData(), tuple.GetData(), tuple.GetLength()));
+  }
+  ASSERT_TRUE(batch.GetValue(1, 0).IsNull());
+  ASSERT_TRUE(batch.GetValue(1, 1).IsNull());
+  ASSERT_EQ("right", batch.GetValue(0, 2).ToString());
+
+  // Scenario: a row set value by value is laid out as the tuple of those values.
+  batch.Reset(schema);
+  batch.Resize(1);
+  batch.GetColumn(0).SetValue(0, ValueFactory::GetVarcharValue("left"));
+  batch.GetColumn(1).SetValue(0, ValueFactory::GetSmallIntValue(1));
+  batch.GetColumn(2).SetValue(0, ValueFactory::GetVarcharValue("right"));
+  auto tuple = batch.GetTuple(0, schema);
+  ASSERT_EQ(tuples[0].GetLength(), tuple.GetLength());
+  ASSERT_EQ(0, memcmp(tuples[0].GetData(), tuple.GetData(), tuple.GetLength()));
+}
+
+}  // namespace bustub
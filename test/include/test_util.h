@@ -18,12 +18,17 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "buffer/buffer_pool_manager.h"
 #include "catalog/schema.h"
 #include "common/exception.h"
 #include "common/logger.h"
+#include "common/rid.h"
 #include "common/util/string_util.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/index/generic_key.h"
 
 namespace bustub {
 
@@ -91,4 +96,42 @@ auto ParseCreateStatement(const std::string &sql_base) -> std::unique_ptr<Schema
   return std::make_unique<Schema>(v);
 }
 
+/** The 8-byte keys of a single integer column that index tests insert, and their comparator. */
+using IntegerKey = GenericKey<8>;
+using IntegerComparator = GenericComparator<8>;
+
+inline auto MakeKey(int64_t key) -> IntegerKey {
+  IntegerKey index_key;
+  index_key.SetFromInteger(key);
+  return index_key;
+}
+
+/** @return the value index tests store with a key: its high bits as the page id, its low bits as the slot */
+inline auto MakeRid(int64_t key) -> RID { return {static_cast<int32_t>(key >> 32), static_cast<uint32_t>(key)}; }
+
+/**
+ * A buffer pool over an in-memory disk, for the indexes a test builds in it. It has to outlive them, as a tree keeps
+ * its root pinned in optimistic mode: declare it first.
+ */
+class TestBufferPool {
+ public:
+  explicit TestBufferPool(size_t pool_size)
+      : disk_manager_(std::make_unique<DiskManagerUnlimitedMemory>()),
+        bpm_(std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get())) {}
+
+  auto Get() const -> BufferPoolManager * { return bpm_.get(); }
+
+  /** @return a new B+ tree named foo_pk, in a header page of its own, built with the rest of the arguments */
+  template <typename TreeType, typename... Args>
+  auto MakeTree(Args &&...args) -> std::unique_ptr<TreeType> {
+    page_id_t header_page_id;
+    bpm_->NewPageGuarded(&header_page_id);
+    return std::make_unique<TreeType>("foo_pk", header_page_id, bpm_.get(), std::forward<Args>(args)...);
+  }
+
+ private:
+  std::unique_ptr<DiskManagerUnlimitedMemory> disk_manager_;
+  std::unique_ptr<BufferPoolManager> bpm_;
+};
+
 }  // namespace bustub
@@ -0,0 +1,199 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_bulk_load_test.cpp
+//
+// Identification: test/storage/b_plus_tree_bulk_load_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+#include "storage/index/b_plus_tree.h"
+#include "test_util.h"  // NOLINT
+
+namespace bustub {
+
+using Tree = BPlusTree<IntegerKey, RID, IntegerComparator>;
+using LeafPage = BPlusTreeLeafPage<IntegerKey, RID, IntegerComparator>;
+using InternalPage = BPlusTreeInternalPage<IntegerKey, page_id_t, IntegerComparator>;
+using Entry = std::pair<IntegerKey, RID>;
+
+static auto MakeEntry(int64_t key) -> Entry { return {MakeKey(key), MakeRid(key)}; }
+
+struct TreeStats {
+  int leaf_depth_{-1};
+  int num_leaves_{0};
+  int64_t num_keys_{0};
+};
+
+/** Check that the pages under page_id keep their sizes in bounds and their keys in [low, high), and are balanced. */
+static void CheckSubtree(BufferPoolManager *bpm, page_id_t page_id, int depth, int64_t low, int64_t high,
+                         TreeStats *stats) {
+  auto guard = bpm->FetchPageRead(page_id);
+  const auto *page = guard.As<BPlusTreePage>();
+  if (depth > 0) {
+    ASSERT_GE(page->GetSize(), page->GetMinSize());
+  }
+  if (page->IsLeafPage()) {
+    const auto *leaf = guard.As<LeafPage>();
+    ASSERT_LT(leaf->GetSize(), leaf->GetMaxSize());
+    if (stats->leaf_depth_ == -1) {
+      stats->leaf_depth_ = depth;
+    }
+    ASSERT_EQ(stats->leaf_depth_, depth);
+    for (int i = 0; i < leaf->GetSize(); i++) {
+      int64_t key = leaf->KeyAt(i).ToString();
+      ASSERT_LE(low, key);
+      ASSERT_LT(key, high);
+      low = key + 1;
+    }
+    stats->num_leaves_++;
+    stats->num_keys_ += leaf->GetSize();
+    return;
+  }
+  const auto *inner = guard.As<InternalPage>();
+  ASSERT_LE(inner->GetSize(), inner->GetMaxSize());
+  ASSERT_GE(inner->GetSize(), 2);
+  for (int i = 0; i < inner->GetSize(); i++) {
+    int64_t child_low = i == 0 ? low : inner->KeyAt(i).ToString();
+    int64_t child_high = i + 1 < inner->GetSize() ? inner->KeyAt(i + 1).ToString() : high;
+    ASSERT_LT(child_low, child_high);
+    CheckSubtree(bpm, inner->ValueAt(i), depth + 1, child_low, child_high, stats);
+  }
+}
+
+static auto CheckTree(BufferPoolManager *bpm, Tree *tree) -> TreeStats {
+  TreeStats stats;
+  if (!tree->IsEmpty()) {
+    CheckSubtree(bpm, tree->GetRootPageId(), 0, std::numeric_limits<int64_t>::min(),
+                 std::numeric_limits<int64_t>::max(), &stats);
+  }
+  return stats;
+}
+
+/** Check that the tree holds exactly the keys 0, step, 2 * step, ... below end, by lookups and by a scan. */
+static void CheckKeys(Tree *tree, int64_t end, int64_t step) {
+  int64_t expected = 0;
+  for (auto it = tree->Begin(); it != tree->End(); ++it) {
+    ASSERT_EQ(expected, (*it).first.ToString());
+    ASSERT_EQ(MakeEntry(expected).second, (*it).second);
+    expected += step;
+  }
+  ASSERT_GE(expected, end);
+  for (int64_t key = 0; key < end; key++) {
+    std::vector<RID> rids;
+    ASSERT_EQ(key % step == 0, tree->GetValue(MakeEntry(key).first, &rids)) << key;
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeBulkLoadTest, SequentialTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  IntegerComparator comparator(key_schema.get());
+
+  // Scenario: whatever the number of entries and the fill factor, the loaded tree is balanced, its pages are within
+  // their size bounds, and it keeps working as a regular tree afterwards.
+  for (int64_t num_keys : {0, 1, 2, 7, 8, 100, 1001, 5000}) {
+    for (double fill_factor : {0.0, 0.5, 0.9, 1.0}) {
+      TestBufferPool pool(50);
+      auto tree = pool.MakeTree<Tree>(
+          comparator, 8, 6, num_keys % 2 == 0 ? BPlusTreeLatchMode::Crabbing : BPlusTreeLatchMode::Optimistic);
+
+      int64_t next_key = 0;
+      ASSERT_TRUE(tree->BulkLoad(
+          [&](Entry *entry) {
+            if (next_key == num_keys) {
+              return false;
+            }
+            *entry = MakeEntry(2 * next_key++);
+            return true;
+          },
+          fill_factor));
+      auto stats = CheckTree(pool.Get(), tree.get());
+      ASSERT_EQ(num_keys, stats.num_keys_);
+      // Leaves hold 4 to 7 entries.
+      if (num_keys > 0) {
+        int fill = std::clamp(static_cast<int>(fill_factor * 7), 4, 7);
+        ASSERT_LE(stats.num_leaves_, (num_keys + fill - 1) / fill);
+      }
+      CheckKeys(tree.get(), 2 * num_keys, 2);
+
+      for (int64_t key = 1; key < 2 * num_keys; key += 2) {
+        ASSERT_TRUE(tree->Insert(MakeEntry(key).first, MakeEntry(key).second));
+      }
+      ASSERT_EQ(2 * num_keys, CheckTree(pool.Get(), tree.get()).num_keys_);
+      CheckKeys(tree.get(), 2 * num_keys, 1);
+      for (int64_t key = 0; key < 2 * num_keys; key++) {
+        tree->Remove(MakeEntry(key).first, nullptr);
+      }
+      ASSERT_TRUE(tree->IsEmpty());
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeBulkLoadTest, ParallelTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  IntegerComparator comparator(key_schema.get());
+
+  // Scenario: subtrees built by separate threads form one balanced tree, whose leaves are linked across them.
+  for (int64_t num_keys : {100, 3000, 20001}) {
+    for (size_t num_threads : {1, 5}) {
+      TestBufferPool pool(64);
+      auto tree = pool.MakeTree<Tree>(comparator, 8, 5);
+
+      std::vector<Entry> entries;
+      for (int64_t key = 0; key < num_keys; key++) {
+        entries.push_back(MakeEntry(3 * key));
+      }
+      ASSERT_TRUE(tree->BulkLoadParallel(entries, num_threads));
+      ASSERT_EQ(num_keys, CheckTree(pool.Get(), tree.get()).num_keys_);
+      CheckKeys(tree.get(), 3 * num_keys, 3);
+      ASSERT_FALSE(tree->BulkLoadParallel(entries, num_threads));
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeBulkLoadTest, InvalidInputTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  IntegerComparator comparator(key_schema.get());
+  TestBufferPool pool(50);
+  auto tree = pool.MakeTree<Tree>(comparator, 4, 4);
+
+  // Scenario: out of order or repeated keys are refused, in one range or across the ranges of two threads, and the
+  // tree is left empty.
+  std::vector<Entry> entries;
+  for (int64_t key = 0; key < 2000; key++) {
+    entries.push_back(MakeEntry(key));
+  }
+  for (size_t broken : {size_t{1}, size_t{999}, size_t{1000}, size_t{1500}}) {
+    auto broken_entries = entries;
+    broken_entries[broken] = broken_entries[broken - 1];
+    EXPECT_THROW(tree->BulkLoadParallel(broken_entries, 2), Exception);
+    ASSERT_TRUE(tree->IsEmpty());
+    std::swap(broken_entries[broken], broken_entries[broken + 1]);
+    EXPECT_THROW(tree->BulkLoadParallel(broken_entries, 1), Exception);
+    ASSERT_TRUE(tree->IsEmpty());
+  }
+
+  // Scenario: a tree that already holds keys is left alone.
+  ASSERT_TRUE(tree->Insert(MakeEntry(-1).first, MakeEntry(-1).second));
+  ASSERT_FALSE(tree->BulkLoadParallel(entries, 2));
+  std::vector<RID> rids;
+  ASSERT_TRUE(tree->GetValue(MakeEntry(-1).first, &rids));
+  ASSERT_EQ(1, CheckTree(pool.Get(), tree.get()).num_keys_);
+}
+
+}  // namespace bustub
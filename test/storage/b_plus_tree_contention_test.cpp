@@ -2,12 +2,15 @@
  * b_plus_tree_contention_test.cpp
  */
 
+#include <atomic>
 #include <chrono>  // NOLINT
 #include <cstdio>
 #include <functional>
 #include <future>  // NOLINT
 #include <iostream>
+#include <memory>
 #include <thread>  // NOLINT
+#include <vector>
 
 #include "buffer/buffer_pool_manager.h"
 #include "gtest/gtest.h"
@@ -70,8 +73,8 @@ bool BPlusTreeLockBenchmarkCall(size_t num_threads, int leaf_node_size, bool wit
   }
 
   bpm->UnpinPage(HEADER_PAGE_ID, true);
-  delete disk_manager;
   delete bpm;
+  delete disk_manager;
 
   return success;
 }
@@ -168,4 +171,73 @@ TEST(BPlusTreeContentionTest, BPlusTreeContentionBenchmark2) {  // NOLINT
             << std::endl;
 }
 
+/**
+ * Fill a tree, then measure how many lookups per second num_threads threads get through for a while. Returns the
+ * rate, or 0 if a lookup gave a wrong answer.
+ */
+double BPlusTreeLookupBenchmarkCall(size_t num_threads, BPlusTreeLatchMode latch_mode, int duration_ms) {
+  const int64_t num_keys = 20000;
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  // Large enough to hold the whole tree: the benchmark is about latching, not about I/O.
+  auto bpm = std::make_unique<BufferPoolManager>(1024, disk_manager.get());
+  page_id_t page_id;
+  bpm->NewPageGuarded(&page_id);
+  auto tree = std::make_unique<BPlusTree<GenericKey<8>, RID, GenericComparator<8>>>("foo_pk", page_id, bpm.get(),
+                                                                                     comparator, 64, 64, latch_mode);
+  GenericKey<8> index_key;
+  for (int64_t key = 0; key < num_keys; key++) {
+    index_key.SetFromInteger(key);
+    tree->Insert(index_key, RID(key));
+  }
+
+  std::atomic<bool> stop{false};
+  std::atomic<bool> success{true};
+  std::atomic<size_t> total_lookups{0};
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; i++) {
+    threads.emplace_back([&, i] {
+      GenericKey<8> key;
+      std::vector<RID> result;
+      size_t lookups = 0;
+      for (int64_t k = i * 7919 % num_keys; !stop; k = (k + 7919) % num_keys) {
+        key.SetFromInteger(k);
+        result.clear();
+        if (!tree->GetValue(key, &result) || !(result[0] == RID(k))) {
+          success = false;
+        }
+        lookups++;
+      }
+      total_lookups += lookups;
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+  stop = true;
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  tree.reset();
+  bpm->UnpinPage(page_id, true);
+  return success ? total_lookups * 1000.0 / duration_ms : 0;
+}
+
+TEST(BPlusTreeContentionTest, BPlusTreeLookupBenchmark) {  // NOLINT
+  std::cout << "This test measures the lookup throughput of the B+ tree as the number of threads grows, with lock "
+               "crabbing and with optimistic lock coupling."
+            << std::endl;
+
+  std::cout << "<<< BEGIN3" << std::endl;
+  for (size_t num_threads = 1; num_threads <= 64; num_threads *= 2) {
+    double crabbing = BPlusTreeLookupBenchmarkCall(num_threads, BPlusTreeLatchMode::Crabbing, 200);
+    double optimistic = BPlusTreeLookupBenchmarkCall(num_threads, BPlusTreeLatchMode::Optimistic, 200);
+    ASSERT_GT(crabbing, 0);
+    ASSERT_GT(optimistic, 0);
+    std::cout << "threads=" << num_threads << " crabbing_lookups_per_sec=" << static_cast<size_t>(crabbing)
+              << " optimistic_lookups_per_sec=" << static_cast<size_t>(optimistic) << std::endl;
+  }
+  std::cout << ">>> END3" << std::endl;
+}
+
 }  // namespace bustub
@@ -0,0 +1,160 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_key_search_test.cpp
+//
+// Identification: test/storage/b_plus_tree_key_search_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/index/b_plus_tree.h"
+#include "storage/page/b_plus_tree_key_search.h"
+#include "test_util.h"  // NOLINT
+#include "type/value_factory.h"
+
+namespace bustub {
+
+using Key = GenericKey<8>;
+using Comparator = GenericComparator<8>;
+using LeafPage = BPlusTreeLeafPage<Key, RID, Comparator>;
+using InternalPage = BPlusTreeInternalPage<Key, page_id_t, Comparator>;
+
+static auto MakeKey(const Schema *key_schema, const std::vector<Value> &values) -> Key {
+  Key key;
+  key.SetFromKey(Tuple(values, key_schema));
+  return key;
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeKeySearchTest, KernelTest) {
+  std::mt19937_64 gen(0);
+  std::vector<KeySearchKernel> kernels;
+  for (auto kernel : {KeySearchKernel::Scalar, KeySearchKernel::SSE42, KeySearchKernel::AVX2}) {
+    if (KeySearchKernelSupported(kernel)) {
+      kernels.push_back(kernel);
+    }
+  }
+
+  // Scenario: pages search with the widest kernel this CPU supports, whatever instruction sets the build targets.
+  ASSERT_EQ(kernels.back(), DefaultKeySearchKernel());
+
+  // Scenario: every kernel finds the same bounds as std::lower_bound and std::upper_bound, for keys of every integer
+  // width, negative ones included, over ranges of any length and start.
+  for (int width : {1, 2, 4, 8}) {
+    int shift = 64 - 8 * width;
+    int64_t min_value = std::numeric_limits<int64_t>::min() >> shift;
+    int64_t max_value = std::numeric_limits<int64_t>::max() >> shift;
+    std::vector<int64_t> values;
+    std::uniform_int_distribution<int64_t> value_dist(min_value, max_value);
+    for (int i = 0; i < 300; i++) {
+      values.push_back(value_dist(gen));
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    // Keys are stored like GenericKey<8> stores them: the value in its first `width` bytes, zeroes after.
+    std::vector<char> keys(values.size() * sizeof(int64_t), 0);
+    for (size_t i = 0; i < values.size(); i++) {
+      memcpy(keys.data() + i * sizeof(int64_t), &values[i], width);
+    }
+
+    for (int size : {0, 1, 2, 3, 5, 16, 17, 64, static_cast<int>(values.size())}) {
+      for (int begin : {0, 1, 7}) {
+        int end = std::min(begin + size, static_cast<int>(values.size()));
+        if (begin > end) {
+          continue;
+        }
+        std::vector<int64_t> targets{min_value, max_value};
+        for (int i = begin; i < end; i++) {
+          targets.push_back(values[i]);
+          targets.push_back(std::max(values[i], min_value + 1) - 1);
+          targets.push_back(std::min(values[i], max_value - 1) + 1);
+        }
+        for (auto target : targets) {
+          int64_t normalized = static_cast<int64_t>(static_cast<uint64_t>(target) << shift);
+          int lower = std::lower_bound(values.begin() + begin, values.begin() + end, target) - values.begin();
+          int upper = std::upper_bound(values.begin() + begin, values.begin() + end, target) - values.begin();
+          for (auto kernel : kernels) {
+            ASSERT_EQ(lower, SearchIntegerKeys(keys.data(), begin, end, normalized, shift, false, kernel))
+                << KeySearchKernelToString(kernel) << " width " << width;
+            ASSERT_EQ(upper, SearchIntegerKeys(keys.data(), begin, end, normalized, shift, true, kernel))
+                << KeySearchKernelToString(kernel) << " width " << width;
+          }
+        }
+      }
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeKeySearchTest, PageTest) {
+  alignas(8) char data[BUSTUB_PAGE_SIZE];
+
+  // Scenario: a leaf of integer keys holds them in an array, as many as fit in the page, and finds each of them and
+  // the gaps between them.
+  auto key_schema = ParseCreateStatement("a integer");
+  Comparator comparator(key_schema.get());
+  ASSERT_EQ(32, comparator.GetIntegerShift());
+  auto *leaf = reinterpret_cast<LeafPage *>(data);
+  leaf->Init(1000);
+  int32_t next = -1000;
+  while (leaf->InsertAt(leaf->GetSize(), MakeKey(key_schema.get(), {ValueFactory::GetIntegerValue(next)}), {})) {
+    next += 10;
+  }
+  ASSERT_EQ((BUSTUB_PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / (sizeof(Key) + sizeof(RID)), leaf->GetSize());
+  for (int i = 0; i < leaf->GetSize(); i++) {
+    int32_t value = -1000 + 10 * i;
+    ASSERT_EQ(i, leaf->KeyIndex(MakeKey(key_schema.get(), {ValueFactory::GetIntegerValue(value)}), comparator));
+    ASSERT_EQ(i + 1, leaf->KeyIndex(MakeKey(key_schema.get(), {ValueFactory::GetIntegerValue(value + 1)}), comparator));
+  }
+
+  // Scenario: an internal page of SMALLINT keys finds the child of negative and positive keys alike.
+  auto small_schema = ParseCreateStatement("a smallint");
+  Comparator small_comparator(small_schema.get());
+  ASSERT_EQ(48, small_comparator.GetIntegerShift());
+  auto *inner = reinterpret_cast<InternalPage *>(data);
+  inner->Init(INTERNAL_PAGE_SIZE);
+  ASSERT_TRUE(inner->InsertAt(0, {}, 0));
+  for (int16_t value : {-300, -2, 0, 5, 700}) {
+    ASSERT_TRUE(
+        inner->InsertAt(inner->GetSize(), MakeKey(small_schema.get(), {ValueFactory::GetSmallIntValue(value)}), value));
+  }
+  auto child_of = [&](int16_t value) {
+    return inner->ValueAt(inner->ChildIndex(MakeKey(small_schema.get(), {ValueFactory::GetSmallIntValue(value)}),
+                                            small_comparator));
+  };
+  ASSERT_EQ(0, child_of(-301));
+  ASSERT_EQ(-300, child_of(-300));
+  ASSERT_EQ(-2, child_of(-1));
+  ASSERT_EQ(0, child_of(4));
+  ASSERT_EQ(700, child_of(32767));
+
+  // Scenario: keys of two columns are searched with the comparator, in the order of their columns.
+  auto pair_schema = ParseCreateStatement("a integer,b integer");
+  Comparator pair_comparator(pair_schema.get());
+  ASSERT_EQ(-1, pair_comparator.GetIntegerShift());
+  auto pair = [&](int32_t a, int32_t b) {
+    return MakeKey(pair_schema.get(), {ValueFactory::GetIntegerValue(a), ValueFactory::GetIntegerValue(b)});
+  };
+  leaf->Init(1000);
+  for (auto [a, b] : std::vector<std::pair<int32_t, int32_t>>{{-1, 5}, {0, -7}, {0, 3}, {2, -100}}) {
+    ASSERT_TRUE(leaf->InsertAt(leaf->GetSize(), pair(a, b), {}));
+  }
+  ASSERT_EQ(0, leaf->KeyIndex(pair(-1, 5), pair_comparator));
+  ASSERT_EQ(1, leaf->KeyIndex(pair(-1, 6), pair_comparator));
+  ASSERT_EQ(2, leaf->KeyIndex(pair(0, 0), pair_comparator));
+  ASSERT_EQ(3, leaf->KeyIndex(pair(1, 1000), pair_comparator));
+  ASSERT_EQ(4, leaf->KeyIndex(pair(2, -99), pair_comparator));
+}
+
+}  // namespace bustub
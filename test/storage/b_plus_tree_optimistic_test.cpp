@@ -0,0 +1,186 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_optimistic_test.cpp
+//
+// Identification: test/storage/b_plus_tree_optimistic_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/index/b_plus_tree.h"
+#include "test_util.h"  // NOLINT
+
+namespace bustub {
+
+using Tree = BPlusTree<IntegerKey, RID, IntegerComparator>;
+
+static auto Lookup(Tree *tree, int64_t key) -> bool {
+  std::vector<RID> rids;
+  bool found = tree->GetValue(MakeKey(key), &rids);
+  EXPECT_EQ(found, rids.size() == 1);
+  if (found) {
+    EXPECT_EQ(MakeRid(key), rids[0]);
+  }
+  return found;
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeOptimisticTest, SequentialTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  IntegerComparator comparator(key_schema.get());
+
+  // Scenario: both latch modes build the same tree, through every kind of split, merge and redistribution.
+  for (auto latch_mode : {BPlusTreeLatchMode::Crabbing, BPlusTreeLatchMode::Optimistic}) {
+    TestBufferPool pool(50);
+    auto tree = pool.MakeTree<Tree>(comparator, 4, 5, latch_mode);
+    ASSERT_EQ(latch_mode, tree->GetLatchMode());
+
+    std::vector<int64_t> keys(2000);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(0));
+    for (auto key : keys) {
+      ASSERT_TRUE(tree->Insert(MakeKey(key), MakeRid(key)));
+    }
+    for (auto key : keys) {
+      ASSERT_FALSE(tree->Insert(MakeKey(key), MakeRid(key)));
+      ASSERT_TRUE(Lookup(tree.get(), key));
+    }
+
+    // Remove the odd keys, then check what is left both by lookups and by a scan.
+    for (auto key : keys) {
+      if (key % 2 == 1) {
+        tree->Remove(MakeKey(key), nullptr);
+      }
+    }
+    int64_t expected = 0;
+    for (auto it = tree->Begin(); it != tree->End(); ++it) {
+      ASSERT_EQ(expected, (*it).first.ToString());
+      expected += 2;
+    }
+    ASSERT_EQ(2000, expected);
+    for (int64_t key = 0; key < 2000; key++) {
+      ASSERT_EQ(key % 2 == 0, Lookup(tree.get(), key));
+    }
+
+    // Emptying the tree and filling it again goes through a root that is created and dropped.
+    for (auto key : keys) {
+      tree->Remove(MakeKey(key), nullptr);
+    }
+    ASSERT_TRUE(tree->IsEmpty());
+    ASSERT_TRUE(tree->Begin() == tree->End());
+    ASSERT_FALSE(Lookup(tree.get(), 0));
+    for (int64_t key = 0; key < 100; key++) {
+      ASSERT_TRUE(tree->Insert(MakeKey(key), MakeRid(key)));
+    }
+    for (int64_t key = 0; key < 100; key++) {
+      ASSERT_TRUE(Lookup(tree.get(), key));
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeOptimisticTest, ConcurrentMixTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  IntegerComparator comparator(key_schema.get());
+
+  // Scenario: writers keep splitting and merging small pages under readers that never latch the inner pages. The
+  // readers must always find the keys that are never removed, and never find one that was never inserted.
+  for (auto latch_mode : {BPlusTreeLatchMode::Crabbing, BPlusTreeLatchMode::Optimistic}) {
+    TestBufferPool pool(128);
+    auto tree = pool.MakeTree<Tree>(comparator, 3, 4, latch_mode);
+
+    const int64_t num_keys = 3000;
+    for (int64_t key = 0; key < num_keys; key += 4) {
+      ASSERT_TRUE(tree->Insert(MakeKey(key), MakeRid(key)));
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> lookups{0};
+    std::vector<std::thread> threads;
+    for (int writer = 0; writer < 3; writer++) {
+      threads.emplace_back([&, writer] {
+        // Each writer owns the keys 4i + writer + 1, inserting them all and removing them again.
+        for (int round = 0; round < 3; round++) {
+          for (int64_t k = writer + 1; k < num_keys; k += 4) {
+            EXPECT_TRUE(tree->Insert(MakeKey(k), MakeRid(k)));
+          }
+          for (int64_t k = writer + 1; k < num_keys; k += 4) {
+            tree->Remove(MakeKey(k), nullptr);
+          }
+        }
+      });
+    }
+    for (int reader = 0; reader < 3; reader++) {
+      threads.emplace_back([&, reader] {
+        std::mt19937_64 gen(reader);
+        std::uniform_int_distribution<int64_t> dist(0, num_keys / 4 - 1);
+        while (!stop) {
+          int64_t key = dist(gen) * 4;
+          EXPECT_TRUE(Lookup(tree.get(), key)) << key;
+          EXPECT_FALSE(Lookup(tree.get(), num_keys + key)) << num_keys + key;
+          lookups++;
+        }
+      });
+    }
+    for (int i = 0; i < 3; i++) {
+      threads[i].join();
+    }
+    stop = true;
+    for (size_t i = 3; i < threads.size(); i++) {
+      threads[i].join();
+    }
+    EXPECT_GT(lookups.load(), 0);
+
+    int64_t expected = 0;
+    for (auto it = tree->Begin(); it != tree->End(); ++it) {
+      ASSERT_EQ(expected, (*it).first.ToString());
+      expected += 4;
+    }
+    ASSERT_EQ(num_keys, expected);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeOptimisticTest, VersionTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(2, disk_manager.get());
+
+  // Scenario: the version is odd exactly while the page is write latched, and read latches leave it alone.
+  page_id_t page_id;
+  Page *page = bpm->NewPage(&page_id);
+  uint64_t version = page->GetVersion();
+  ASSERT_EQ(0, version % 2);
+  page->RLatch();
+  page->RUnlatch();
+  ASSERT_TRUE(page->ValidateVersion(version));
+  page->WLatch();
+  ASSERT_EQ(version + 1, page->GetVersion());
+  page->WUnlatch();
+  ASSERT_FALSE(page->ValidateVersion(version));
+  version = page->GetVersion();
+  ASSERT_EQ(0, version % 2);
+
+  // Scenario: a frame that is given to another page invalidates what was read from it.
+  ASSERT_TRUE(bpm->UnpinPage(page_id, true));
+  page_id_t other_page_ids[2];
+  bpm->NewPageGuarded(&other_page_ids[0]);
+  bpm->NewPageGuarded(&other_page_ids[1]);
+  ASSERT_FALSE(page->ValidateVersion(version));
+  ASSERT_EQ(0, page->GetVersion() % 2);
+}
+
+}  // namespace bustub
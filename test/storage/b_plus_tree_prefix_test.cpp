@@ -0,0 +1,252 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_prefix_test.cpp
+//
+// Identification: test/storage/b_plus_tree_prefix_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+#include "storage/index/b_plus_tree.h"
+#include "test_util.h"  // NOLINT
+#include "type/value_factory.h"
+
+namespace bustub {
+
+using Key = GenericKey<32>;
+using Comparator = GenericComparator<32>;
+using Tree = BPlusTree<Key, RID, Comparator>;
+using LeafPage = BPlusTreeLeafPage<Key, RID, Comparator>;
+using InternalPage = BPlusTreeInternalPage<Key, page_id_t, Comparator>;
+
+static auto MakeKey(const Schema *key_schema, const std::vector<Value> &values) -> Key {
+  Key key;
+  key.SetFromKey(Tuple(values, key_schema));
+  return key;
+}
+
+static auto MakeStringKey(const Schema *key_schema, int64_t i) -> Key {
+  return MakeKey(key_schema, {ValueFactory::GetVarcharValue(fmt::format("cust#{:08}", i))});
+}
+
+static auto RawKey(const std::string &bytes) -> Key {
+  Key key;
+  memset(key.data_, 0, sizeof(key.data_));
+  memcpy(key.data_, bytes.data(), bytes.size());
+  return key;
+}
+
+static auto SameBytes(const Key &lhs, const Key &rhs) -> bool { return memcmp(lhs.data_, rhs.data_, 32) == 0; }
+
+/** Check the keys under page_id are in [low, high) and in order, and count them; a null bound is unbounded. */
+static void CheckSubtree(BufferPoolManager *bpm, const Comparator &comparator, page_id_t page_id, const Key *low,
+                         const Key *high, int64_t *num_keys, int64_t *num_leaves) {
+  auto guard = bpm->FetchPageRead(page_id);
+  auto in_bounds = [&](const Key &key) {
+    return (low == nullptr || comparator(*low, key) <= 0) && (high == nullptr || comparator(key, *high) < 0);
+  };
+  if (guard.As<BPlusTreePage>()->IsLeafPage()) {
+    const auto *leaf = guard.As<LeafPage>();
+    ASSERT_LE(leaf->GetUsedBytes(), leaf->GetCapacity());
+    for (int i = 0; i < leaf->GetSize(); i++) {
+      ASSERT_TRUE(in_bounds(leaf->KeyAt(i)));
+      if (i > 0) {
+        ASSERT_LT(comparator(leaf->KeyAt(i - 1), leaf->KeyAt(i)), 0);
+      }
+    }
+    *num_keys += leaf->GetSize();
+    (*num_leaves)++;
+    return;
+  }
+  const auto *inner = guard.As<InternalPage>();
+  ASSERT_LE(inner->GetUsedBytes(), inner->GetCapacity());
+  for (int i = 0; i < inner->GetSize(); i++) {
+    Key child_low = inner->KeyAt(i);
+    Key child_high = i + 1 < inner->GetSize() ? inner->KeyAt(i + 1) : Key{};
+    if (i > 0) {
+      ASSERT_TRUE(in_bounds(child_low));
+    }
+    CheckSubtree(bpm, comparator, inner->ValueAt(i), i == 0 ? low : &child_low,
+                 i + 1 < inner->GetSize() ? &child_high : high, num_keys, num_leaves);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreePrefixTest, PageTest) {
+  alignas(8) char data[BUSTUB_PAGE_SIZE];
+  auto *leaf = reinterpret_cast<LeafPage *>(data);
+  leaf->Init((BUSTUB_PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / (sizeof(RID) + 4));
+
+  // Scenario: keys sharing a long prefix store it once, and take far less room than their full size.
+  std::vector<Key> keys;
+  while (true) {
+    auto key = RawKey(fmt::format("user/profile/{:08}", keys.size()));
+    if (!leaf->InsertAt(leaf->GetSize(), key, MakeRid(keys.size()))) {
+      break;
+    }
+    keys.push_back(key);
+  }
+  ASSERT_EQ(std::string("user/profile/00000").size(), leaf->GetPrefixSize());
+  ASSERT_GT(leaf->GetSize(), leaf->GetCapacity() / static_cast<int>(sizeof(Key) + sizeof(RID) + 4) * 2);
+  ASSERT_LE(leaf->GetUsedBytes(), leaf->GetCapacity());
+  for (int i = 0; i < leaf->GetSize(); i++) {
+    ASSERT_TRUE(SameBytes(keys[i], leaf->KeyAt(i)));
+    ASSERT_EQ(MakeRid(i), leaf->ValueAt(i));
+  }
+
+  // Scenario: a key that does not share the prefix shortens it, which takes more room; the page refuses it whole.
+  auto other = RawKey("admin");
+  int size = leaf->GetSize();
+  ASSERT_FALSE(leaf->InsertAt(0, other, MakeRid(-1)));
+  ASSERT_EQ(size, leaf->GetSize());
+  ASSERT_EQ(std::string("user/profile/00000").size(), leaf->GetPrefixSize());
+  while (leaf->GetSize() > 40) {
+    leaf->RemoveAt(leaf->GetSize() / 2);
+    keys.erase(keys.begin() + keys.size() / 2);
+  }
+  ASSERT_TRUE(leaf->InsertAt(0, other, MakeRid(-1)));
+  keys.insert(keys.begin(), other);
+  ASSERT_EQ(0, leaf->GetPrefixSize());
+  ASSERT_FALSE(leaf->IsUnderflow());
+
+  // Scenario: keys replaced in place, or growing out of their slot, still decode whole; removing entries leaves
+  // garbage that later inserts reclaim.
+  ASSERT_TRUE(leaf->SetKeyAt(1, RawKey("user/profile/00000000/archived")));
+  keys[1] = RawKey("user/profile/00000000/archived");
+  ASSERT_TRUE(leaf->SetKeyAt(2, RawKey("user/p")));
+  keys[2] = RawKey("user/p");
+  for (int i = 0; i < leaf->GetSize(); i++) {
+    ASSERT_TRUE(SameBytes(keys[i], leaf->KeyAt(i))) << i;
+  }
+  int used = leaf->GetUsedBytes();
+  leaf->RemoveAt(1);
+  keys.erase(keys.begin() + 1);
+  ASSERT_LT(leaf->GetUsedBytes(), used);
+  for (int i = 0; i < leaf->GetSize(); i++) {
+    ASSERT_TRUE(SameBytes(keys[i], leaf->KeyAt(i))) << i;
+  }
+
+  // Scenario: the first key of an internal page is neither stored nor part of the prefix.
+  auto *inner = reinterpret_cast<InternalPage *>(data);
+  inner->Init(INTERNAL_PAGE_SIZE);
+  ASSERT_TRUE(inner->InsertAt(0, RawKey("zzz"), 1));
+  ASSERT_TRUE(inner->InsertAt(1, RawKey("order/0001"), 2));
+  ASSERT_TRUE(inner->InsertAt(2, RawKey("order/0002"), 3));
+  ASSERT_EQ(9, inner->GetPrefixSize());
+  ASSERT_TRUE(SameBytes(Key{}, inner->KeyAt(0)));
+  inner->RemoveAt(0);
+  ASSERT_EQ(2, inner->ValueAt(0));
+  ASSERT_TRUE(SameBytes(RawKey("order/0002"), inner->KeyAt(1)));
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreePrefixTest, SeparatorTest) {
+  auto key_schema = ParseCreateStatement("a varchar(20)");
+  Comparator comparator(key_schema.get());
+
+  // Scenario: the separator keeps just enough of the right key to sort between the two keys.
+  auto lhs = MakeKey(key_schema.get(), {ValueFactory::GetVarcharValue("apple pie")});
+  auto rhs = MakeKey(key_schema.get(), {ValueFactory::GetVarcharValue("banana split")});
+  auto separator = comparator.FindShortestSeparator(lhs, rhs);
+  ASSERT_LT(comparator(lhs, separator), 0);
+  ASSERT_LE(comparator(separator, rhs), 0);
+  ASSERT_EQ('b', separator.ToValue(key_schema.get(), 0).GetData()[0]);
+  ASSERT_EQ(0, separator.ToValue(key_schema.get(), 0).GetData()[1]);
+
+  // Scenario: keys that only differ at their end leave nothing to truncate.
+  lhs = MakeKey(key_schema.get(), {ValueFactory::GetVarcharValue("customer#1")});
+  rhs = MakeKey(key_schema.get(), {ValueFactory::GetVarcharValue("customer#2")});
+  ASSERT_TRUE(SameBytes(rhs, comparator.FindShortestSeparator(lhs, rhs)));
+
+  // Scenario: a composite key is only truncated within its last VARCHAR.
+  auto composite_schema = ParseCreateStatement("a integer,b varchar(10)");
+  Comparator composite_comparator(composite_schema.get());
+  lhs = MakeKey(composite_schema.get(), {ValueFactory::GetIntegerValue(7), ValueFactory::GetVarcharValue("abcdef")});
+  rhs = MakeKey(composite_schema.get(), {ValueFactory::GetIntegerValue(7), ValueFactory::GetVarcharValue("abdzzz")});
+  separator = composite_comparator.FindShortestSeparator(lhs, rhs);
+  ASSERT_LT(composite_comparator(lhs, separator), 0);
+  ASSERT_LE(composite_comparator(separator, rhs), 0);
+  ASSERT_EQ(7, separator.ToValue(composite_schema.get(), 0).GetAs<int32_t>());
+  ASSERT_EQ(0, strncmp("abd", separator.ToValue(composite_schema.get(), 1).GetData(), 4));
+
+  // Scenario: a key longer than the key type is refused.
+  auto long_schema = ParseCreateStatement("a varchar(64)");
+  ASSERT_THROW(MakeKey(long_schema.get(), {ValueFactory::GetVarcharValue(std::string(40, 'x'))}), Exception);
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreePrefixTest, VarcharTreeTest) {
+  auto key_schema = ParseCreateStatement("a varchar(20)");
+  Comparator comparator(key_schema.get());
+  const int leaf_max_size = (BUSTUB_PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / (sizeof(RID) + 4);
+
+  // Scenario: a tree of string keys splits, merges and bulk loads through pages that hold entries by their bytes, and
+  // every key stays reachable through the truncated separators.
+  for (auto latch_mode : {BPlusTreeLatchMode::Crabbing, BPlusTreeLatchMode::Optimistic}) {
+    TestBufferPool pool(64);
+    auto tree = pool.MakeTree<Tree>(comparator, leaf_max_size, INTERNAL_PAGE_SIZE, latch_mode);
+
+    const int64_t num_keys = 20000;
+    std::vector<int64_t> keys(num_keys);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(0));
+    for (auto i : keys) {
+      ASSERT_TRUE(tree->Insert(MakeStringKey(key_schema.get(), i), MakeRid(i)));
+    }
+    int64_t num_found = 0;
+    int64_t num_leaves = 0;
+    CheckSubtree(pool.Get(), comparator, tree->GetRootPageId(), nullptr, nullptr, &num_found, &num_leaves);
+    ASSERT_EQ(num_keys, num_found);
+    // The keys share most of their 30 bytes: leaves hold more of them than full ones would fit in a page.
+    ASSERT_GT(num_found / num_leaves, BUSTUB_PAGE_SIZE / static_cast<int64_t>(sizeof(Key) + sizeof(RID) + 4));
+
+    for (auto i : keys) {
+      if (i % 3 != 0) {
+        tree->Remove(MakeStringKey(key_schema.get(), i), nullptr);
+      }
+    }
+    int64_t expected = 0;
+    for (auto it = tree->Begin(); it != tree->End(); ++it) {
+      ASSERT_TRUE(SameBytes(MakeStringKey(key_schema.get(), expected), (*it).first));
+      ASSERT_EQ(MakeRid(expected), (*it).second);
+      expected += 3;
+    }
+    ASSERT_EQ(num_keys + 1, expected);
+    for (int64_t i = 0; i < num_keys; i++) {
+      std::vector<RID> rids;
+      ASSERT_EQ(i % 3 == 0, tree->GetValue(MakeStringKey(key_schema.get(), i), &rids)) << i;
+    }
+    num_found = 0;
+    CheckSubtree(pool.Get(), comparator, tree->GetRootPageId(), nullptr, nullptr, &num_found, &num_leaves);
+    ASSERT_EQ((num_keys + 2) / 3, num_found);
+    for (int64_t i = 0; i < num_keys; i += 3) {
+      tree->Remove(MakeStringKey(key_schema.get(), i), nullptr);
+    }
+    ASSERT_TRUE(tree->IsEmpty());
+
+    std::vector<std::pair<Key, RID>> entries;
+    for (int64_t i = 0; i < num_keys; i++) {
+      entries.emplace_back(MakeStringKey(key_schema.get(), i), MakeRid(i));
+    }
+    ASSERT_TRUE(tree->BulkLoadParallel(entries, 1));
+    num_found = 0;
+    CheckSubtree(pool.Get(), comparator, tree->GetRootPageId(), nullptr, nullptr, &num_found, &num_leaves);
+    ASSERT_EQ(num_keys, num_found);
+  }
+}
+
+}  // namespace bustub
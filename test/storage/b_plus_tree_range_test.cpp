@@ -0,0 +1,207 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_range_test.cpp
+//
+// Identification: test/storage/b_plus_tree_range_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <set>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+#include "storage/index/b_plus_tree_index.h"
+#include "test_util.h"  // NOLINT
+#include "type/value_factory.h"
+
+namespace bustub {
+
+using Tree = BPlusTree<IntegerKey, RID, IntegerComparator>;
+
+/** @return the keys from the iterator to the end, read back from their values */
+static auto Collect(IndexIterator<IntegerKey, RID, IntegerComparator> iter) -> std::vector<int64_t> {
+  std::vector<int64_t> keys;
+  for (; !iter.IsEnd(); ++iter) {
+    keys.push_back((*iter).second.GetSlotNum());
+  }
+  return keys;
+}
+
+/** @return the keys of the set within the range, in ascending order or descending */
+static auto Expected(const std::set<int64_t> &keys, const int64_t *low, bool low_inclusive, const int64_t *high,
+                     bool high_inclusive, bool reverse) -> std::vector<int64_t> {
+  std::vector<int64_t> expected;
+  for (auto key : keys) {
+    bool above = low == nullptr || key > *low || (low_inclusive && key == *low);
+    bool below = high == nullptr || key < *high || (high_inclusive && key == *high);
+    if (above && below) {
+      expected.push_back(key);
+    }
+  }
+  if (reverse) {
+    std::reverse(expected.begin(), expected.end());
+  }
+  return expected;
+}
+
+/** Check every range between a few bounds, inclusive or not, in both directions. */
+static void CheckRanges(Tree *tree, const std::set<int64_t> &keys, const std::vector<int64_t> &bounds) {
+  ASSERT_EQ(Expected(keys, nullptr, true, nullptr, true, false), Collect(tree->Begin()));
+  ASSERT_EQ(Expected(keys, nullptr, true, nullptr, true, true), Collect(tree->RBegin()));
+  for (bool reverse : {false, true}) {
+    for (size_t i = 0; i <= bounds.size(); i++) {
+      for (size_t j = 0; j <= bounds.size(); j++) {
+        // The last index stands for no bound.
+        const int64_t *low = i < bounds.size() ? &bounds[i] : nullptr;
+        const int64_t *high = j < bounds.size() ? &bounds[j] : nullptr;
+        IntegerKey low_key = MakeKey(low == nullptr ? 0 : *low);
+        IntegerKey high_key = MakeKey(high == nullptr ? 0 : *high);
+        for (bool low_inclusive : {false, true}) {
+          for (bool high_inclusive : {false, true}) {
+            auto iter = tree->Range(low == nullptr ? nullptr : &low_key, low_inclusive,
+                                    high == nullptr ? nullptr : &high_key, high_inclusive, reverse);
+            ASSERT_EQ(Expected(keys, low, low_inclusive, high, high_inclusive, reverse), Collect(std::move(iter)))
+                << "low " << (low == nullptr ? "none" : std::to_string(*low)) << (low_inclusive ? " incl" : "")
+                << ", high " << (high == nullptr ? "none" : std::to_string(*high)) << (high_inclusive ? " incl" : "")
+                << (reverse ? ", reverse" : "");
+          }
+        }
+      }
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeRangeTest, TreeTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  IntegerComparator comparator(key_schema.get());
+  std::vector<int64_t> bounds{-1, 0, 1, 41, 42, 43, 500, 998, 999, 1000};
+
+  for (auto latch_mode : {BPlusTreeLatchMode::Crabbing, BPlusTreeLatchMode::Optimistic}) {
+    TestBufferPool pool(50);
+    auto tree = pool.MakeTree<Tree>(comparator, 4, 4, latch_mode);
+    std::set<int64_t> keys;
+
+    // Scenario: an empty tree has no keys in any range.
+    ASSERT_TRUE(tree->RBegin().IsEnd());
+    CheckRanges(tree.get(), keys, {0, 1});
+
+    // Scenario: ranges over many small leaves, split in random order, read the same keys both ways.
+    std::vector<int64_t> inserts;
+    for (int64_t key = 0; key < 1000; key += 2) {
+      inserts.push_back(key);
+    }
+    std::shuffle(inserts.begin(), inserts.end(), std::mt19937(0));
+    for (auto key : inserts) {
+      ASSERT_TRUE(tree->Insert(MakeKey(key), MakeRid(key)));
+      keys.insert(key);
+    }
+    CheckRanges(tree.get(), keys, bounds);
+
+    // Scenario: the leaves left after merges still link back to each other.
+    for (int64_t key = 0; key < 1000; key += 6) {
+      tree->Remove(MakeKey(key), nullptr);
+      keys.erase(key);
+    }
+    CheckRanges(tree.get(), keys, bounds);
+  }
+
+  // Scenario: bulk loaded leaves, built by several threads, link back to each other as well.
+  TestBufferPool pool(100);
+  auto tree = pool.MakeTree<Tree>(comparator, 8, 8);
+  std::vector<std::pair<IntegerKey, RID>> entries;
+  std::set<int64_t> keys;
+  for (int64_t key = 1; key < 2000; key += 2) {
+    entries.emplace_back(MakeKey(key), MakeRid(key));
+    keys.insert(key);
+  }
+  ASSERT_TRUE(tree->BulkLoadParallel(entries, 4));
+  CheckRanges(tree.get(), keys, bounds);
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeRangeTest, ConcurrentReverseTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  IntegerComparator comparator(key_schema.get());
+  TestBufferPool pool(100);
+  auto tree = pool.MakeTree<Tree>(comparator, 4, 4);
+  const int64_t num_keys = 3000;
+  for (int64_t key = 0; key < num_keys; key += 2) {
+    ASSERT_TRUE(tree->Insert(MakeKey(key), MakeRid(key)));
+  }
+
+  // Scenario: backward scans racing with writers that split and merge the leaves around them still see every key the
+  // writers leave alone, each once and in descending order.
+  std::atomic<bool> done{false};
+  std::thread writer([&] {
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int64_t> dist(0, num_keys / 2 - 1);
+    while (!done) {
+      int64_t key = 2 * dist(gen) + 1;
+      tree->Insert(MakeKey(key), MakeRid(key));
+      tree->Remove(MakeKey(2 * dist(gen) + 1), nullptr);
+    }
+  });
+  for (int round = 0; round < 20; round++) {
+    std::vector<int64_t> even;
+    int64_t last = num_keys;
+    for (auto iter = tree->RBegin(); !iter.IsEnd(); ++iter) {
+      int64_t key = (*iter).second.GetSlotNum();
+      ASSERT_LT(key, last);
+      last = key;
+      if (key % 2 == 0) {
+        even.push_back(key);
+      }
+    }
+    ASSERT_EQ(num_keys / 2, even.size());
+  }
+  done = true;
+  writer.join();
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeRangeTest, IndexTest) {
+  TestBufferPool pool(50);
+  auto table_schema = ParseCreateStatement("a integer,b integer");
+  auto metadata = std::make_unique<IndexMetadata>("foo_pk", "foo", table_schema.get(), std::vector<uint32_t>{1});
+  const Schema *key_schema = metadata->GetKeySchema();
+  BPlusTreeIndex<IntegerKey, RID, IntegerComparator> index(std::move(metadata), pool.Get());
+  auto make_key = [&](int32_t key) { return Tuple({ValueFactory::GetIntegerValue(key)}, key_schema); };
+  for (int32_t key = 0; key < 3000; key++) {
+    ASSERT_TRUE(index.InsertEntry(make_key(key), MakeRid(key), nullptr));
+  }
+
+  // Scenario: a range longer than a batch comes back whole, in order both ways, and the cursor latches nothing
+  // between calls, so the index can be modified while it is open.
+  for (bool reverse : {false, true}) {
+    IndexScanRange range;
+    range.low_ = make_key(100);
+    range.low_inclusive_ = false;
+    range.high_ = make_key(2500);
+    range.reverse_ = reverse;
+    auto cursor = index.ScanRange(range, nullptr);
+    std::vector<int64_t> keys;
+    RID rid;
+    while (cursor->Next(&rid)) {
+      keys.push_back(rid.GetSlotNum());
+      index.DeleteEntry(make_key(static_cast<int32_t>(rid.GetSlotNum())), rid, nullptr);
+      index.InsertEntry(make_key(static_cast<int32_t>(rid.GetSlotNum())), rid, nullptr);
+    }
+    ASSERT_EQ(2400, keys.size());
+    ASSERT_EQ(reverse ? 2500 : 101, keys.front());
+    ASSERT_EQ(reverse ? 101 : 2500, keys.back());
+    ASSERT_TRUE(reverse ? std::is_sorted(keys.rbegin(), keys.rend()) : std::is_sorted(keys.begin(), keys.end()));
+  }
+}
+
+}  // namespace bustub
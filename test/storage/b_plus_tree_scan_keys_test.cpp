@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_scan_keys_test.cpp
+//
+// Identification: test/storage/b_plus_tree_scan_keys_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+#include "storage/index/b_plus_tree_index.h"
+#include "test_util.h"  // NOLINT
+#include "type/value_factory.h"
+
+namespace bustub {
+
+using Tree = BPlusTree<IntegerKey, RID, IntegerComparator>;
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeScanKeysTest, TreeTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  IntegerComparator comparator(key_schema.get());
+
+  // Scenario: sorted keys, repeated or missing, several to a leaf or far apart, are each found once with their value,
+  // or not at all, whichever way the tree is latched.
+  for (auto latch_mode : {BPlusTreeLatchMode::Crabbing, BPlusTreeLatchMode::Optimistic}) {
+    TestBufferPool pool(50);
+    auto tree = pool.MakeTree<Tree>(comparator, 5, 4, latch_mode);
+
+    std::vector<std::vector<RID>> results;
+    tree->GetValues({MakeKey(1), MakeKey(2)}, &results);
+    ASSERT_EQ(2, results.size());
+    ASSERT_TRUE(results[0].empty() && results[1].empty());
+
+    // Even keys only.
+    for (int64_t key = 0; key < 1000; key += 2) {
+      ASSERT_TRUE(tree->Insert(MakeKey(key), MakeRid(key)));
+    }
+    std::vector<int64_t> lookups{-5, 0, 0, 1, 2, 3, 4, 4, 10, 11, 12, 500, 501, 502, 998, 999, 1000};
+    std::vector<IntegerKey> keys;
+    for (auto key : lookups) {
+      keys.push_back(MakeKey(key));
+    }
+    tree->GetValues(keys, &results);
+    ASSERT_EQ(lookups.size(), results.size());
+    for (size_t i = 0; i < lookups.size(); i++) {
+      bool present = lookups[i] >= 0 && lookups[i] < 1000 && lookups[i] % 2 == 0;
+      ASSERT_EQ(present ? 1 : 0, results[i].size()) << lookups[i];
+      if (present) {
+        ASSERT_EQ(MakeRid(lookups[i]), results[i][0]);
+      }
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeScanKeysTest, IndexTest) {
+  TestBufferPool pool(50);
+  auto table_schema = ParseCreateStatement("a integer,b integer");
+  auto metadata = std::make_unique<IndexMetadata>("foo_pk", "foo", table_schema.get(), std::vector<uint32_t>{1});
+  const Schema *key_schema = metadata->GetKeySchema();
+  BPlusTreeIndex<IntegerKey, RID, IntegerComparator> index(std::move(metadata), pool.Get());
+  auto make_key = [&](int32_t key) { return Tuple({ValueFactory::GetIntegerValue(key)}, key_schema); };
+
+  // Scenario: keys come back in the order they were asked for, however the index sorts them to look them up.
+  for (int32_t key = 0; key < 3000; key++) {
+    ASSERT_TRUE(index.InsertEntry(make_key(key * 3), MakeRid(key), nullptr));
+  }
+  std::vector<int32_t> lookups;
+  for (int32_t key = -10; key < 9010; key += 7) {
+    lookups.push_back(key);
+  }
+  std::shuffle(lookups.begin(), lookups.end(), std::mt19937(0));
+  std::vector<Tuple> keys;
+  for (auto key : lookups) {
+    keys.push_back(make_key(key));
+  }
+  std::vector<std::vector<RID>> results;
+  index.ScanKeys(keys, &results, nullptr);
+  ASSERT_EQ(lookups.size(), results.size());
+  for (size_t i = 0; i < lookups.size(); i++) {
+    std::vector<RID> expected;
+    index.ScanKey(keys[i], &expected, nullptr);
+    ASSERT_EQ(expected, results[i]) << lookups[i];
+    ASSERT_EQ(lookups[i] >= 0 && lookups[i] < 9000 && lookups[i] % 3 == 0, !results[i].empty()) << lookups[i];
+  }
+}
+
+}  // namespace bustub
@@ -10,27 +10,31 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <memory>
 #include <vector>
 
+#include "buffer/buffer_pool_manager.h"
+#include "common/exception.h"
 #include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
 #include "storage/page/tmp_tuple_page.h"
+#include "storage/table/tmp_tuple_file.h"
 #include "type/value_factory.h"
 
 namespace bustub {
 
 // NOLINTNEXTLINE
-TEST(TmpTuplePageTest, DISABLED_BasicTest) {
-  // There are many ways to do this assignment, and this is only one of them.
-  // If you don't like the TmpTuplePage idea, please feel free to delete this test case entirely.
-  // You will get full credit as long as you are correctly using a linear probe hash table.
+TEST(TmpTuplePageTest, BasicTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(10, disk_manager.get());
+  page_id_t page_id;
+  auto guard = bpm->NewPageGuarded(&page_id);
+  auto *page = guard.AsMut<TmpTuplePage>();
+  page->Init(page_id, BUSTUB_PAGE_SIZE);
 
-  TmpTuplePage page{};
-  page_id_t page_id = 15445;
-  page.Init(page_id, BUSTUB_PAGE_SIZE);
-
-  char *data = page.GetData();
-  ASSERT_EQ(*reinterpret_cast<page_id_t *>(data), page_id);
-  ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + sizeof(page_id_t) + sizeof(lsn_t)), BUSTUB_PAGE_SIZE);
+  const char *data = guard.GetData();
+  ASSERT_EQ(*reinterpret_cast<const page_id_t *>(data), page_id);
+  ASSERT_EQ(*reinterpret_cast<const uint32_t *>(data + sizeof(page_id_t) + sizeof(lsn_t)), BUSTUB_PAGE_SIZE);
 
   std::vector<Column> columns;
   columns.emplace_back("A", TypeId::INTEGER);
@@ -41,11 +45,60 @@ TEST(TmpTuplePageTest, DISABLED_BasicTest) {
 
   Tuple tuple(values, &schema);
   TmpTuple tmp_tuple(INVALID_PAGE_ID, 0);
-  page.Insert(tuple, &tmp_tuple);
+  ASSERT_TRUE(page->Insert(tuple, &tmp_tuple));
+
+  ASSERT_EQ(*reinterpret_cast<const uint32_t *>(data + sizeof(page_id_t) + sizeof(lsn_t)), BUSTUB_PAGE_SIZE - 8);
+  ASSERT_EQ(*reinterpret_cast<const uint32_t *>(data + BUSTUB_PAGE_SIZE - 8), 4);
+  ASSERT_EQ(*reinterpret_cast<const uint32_t *>(data + BUSTUB_PAGE_SIZE - 4), 123);
+  ASSERT_EQ(TmpTuple(page_id, BUSTUB_PAGE_SIZE - 8), tmp_tuple);
+
+  // Scenario: the page fills up, and gives its tuples back in the order they were inserted.
+  int32_t inserted = 1;
+  while (page->Insert(Tuple({ValueFactory::GetIntegerValue(123 + inserted)}, &schema), &tmp_tuple)) {
+    inserted++;
+  }
+  ASSERT_EQ((BUSTUB_PAGE_SIZE - TMP_TUPLE_PAGE_HEADER_SIZE) / 8, inserted);
+  auto offsets = page->GetTupleOffsets();
+  ASSERT_EQ(inserted, offsets.size());
+  for (int32_t i = 0; i < inserted; i++) {
+    ASSERT_EQ(123 + i, page->Get(offsets[i]).GetValue(&schema, 0).GetAs<int32_t>());
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(TmpTuplePageTest, FileTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(5, disk_manager.get());
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 128}});
+  auto make_tuple = [&](int32_t i) {
+    return Tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::string(i % 100, 'x'))}, &schema);
+  };
+
+  // Scenario: a file of many more pages than the buffer pool holds reads back whole, in order, twice.
+  const int32_t num_tuples = 10000;
+  {
+    TmpTupleFile file(bpm.get());
+    for (int32_t i = 0; i < num_tuples; i++) {
+      file.Append(make_tuple(i));
+    }
+    ASSERT_EQ(num_tuples, file.GetNumTuples());
+    for (int round = 0; round < 2; round++) {
+      auto reader = file.Read();
+      Tuple tuple;
+      int32_t i = 0;
+      while (reader.Next(&tuple)) {
+        ASSERT_EQ(make_tuple(i).GetValue(&schema, 1).ToString(), tuple.GetValue(&schema, 1).ToString());
+        ASSERT_EQ(i++, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+      }
+      ASSERT_EQ(num_tuples, i);
+    }
+  }
 
-  ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + sizeof(page_id_t) + sizeof(lsn_t)), BUSTUB_PAGE_SIZE - 8);
-  ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + BUSTUB_PAGE_SIZE - 8), 4);
-  ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + BUSTUB_PAGE_SIZE - 4), 123);
+  // Scenario: deleted files leave the buffer pool free for others.
+  page_id_t page_id;
+  for (int i = 0; i < 5; i++) {
+    ASSERT_NE(nullptr, bpm->NewPage(&page_id));
+  }
 }
 
 }  // namespace bustub
@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// morsel_queue_test.cpp
+//
+// Identification: test/table/morsel_queue_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/table/morsel_queue.h"
+#include "storage/table/table_heap.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(MorselQueueTest, ScanTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(50, disk_manager.get());
+  auto table = std::make_unique<TableHeap>(bpm.get());
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 64}});
+  const int num_tuples = 10000;
+  std::vector<RID> rids;
+  for (int i = 0; i < num_tuples; i++) {
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::string(i % 64, 'x'))}, &schema);
+    rids.push_back(*table->InsertTuple(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, false}, tuple));
+  }
+  ASSERT_GT(rids.back().GetPageId() - rids.front().GetPageId(), 2 * MORSEL_PAGES);
+
+  // Scenario: threads taking morsels concurrently read every tuple once, and morsels in order read them in order.
+  MorselQueue queue(table.get());
+  for (int round = 0; round < 2; round++) {
+    queue.Reset();
+    const size_t num_threads = 4;
+    std::vector<std::vector<std::pair<size_t, std::vector<RID>>>> morsels(num_threads);
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < num_threads; thread++) {
+      threads.emplace_back([&, thread] {
+        size_t morsel;
+        for (auto iter = queue.Next(&morsel); iter != nullptr; iter = queue.Next(&morsel)) {
+          auto &morsel_rids = morsels[thread].emplace_back(morsel, std::vector<RID>{}).second;
+          for (; !iter->IsEnd(); ++*iter) {
+            morsel_rids.push_back(iter->GetRID());
+          }
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    std::vector<std::vector<RID>> by_morsel;
+    for (auto &thread_morsels : morsels) {
+      for (auto &[morsel, morsel_rids] : thread_morsels) {
+        by_morsel.resize(std::max(by_morsel.size(), morsel + 1));
+        by_morsel[morsel] = std::move(morsel_rids);
+      }
+    }
+    std::vector<RID> scanned;
+    for (const auto &morsel_rids : by_morsel) {
+      scanned.insert(scanned.end(), morsel_rids.begin(), morsel_rids.end());
+    }
+    ASSERT_EQ(rids, scanned);
+  }
+
+  // Scenario: tuples inserted after a reset are not part of the scan.
+  queue.Reset();
+  Tuple tuple({ValueFactory::GetIntegerValue(-1), ValueFactory::GetVarcharValue("")}, &schema);
+  table->InsertTuple(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, false}, tuple);
+  size_t num_scanned = 0;
+  size_t morsel;
+  for (auto iter = queue.Next(&morsel); iter != nullptr; iter = queue.Next(&morsel)) {
+    for (; !iter->IsEnd(); ++*iter) {
+      num_scanned++;
+    }
+  }
+  ASSERT_EQ(num_tuples, num_scanned);
+}
+
+}  // namespace bustub
@@ -12,15 +12,19 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "buffer/buffer_pool_manager.h"
 #include "gtest/gtest.h"
 #include "logging/common.h"
+#include "storage/disk/disk_manager_memory.h"
 #include "storage/table/table_heap.h"
 #include "storage/table/tuple.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 // NOLINTNEXTLINE
@@ -61,4 +65,50 @@ TEST(TupleTest, DISABLED_TableHeapTest) {
   delete disk_manager;
 }
 
+// NOLINTNEXTLINE
+TEST(TupleTest, TupleRefTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(10, disk_manager.get());
+  auto table = std::make_unique<TableHeap>(bpm.get());
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 64}, Column{"c", TypeId::BIGINT}});
+  std::vector<RID> rids;
+  for (int i = 0; i < 1000; i++) {
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::string(i % 64, 'x')),
+                 ValueFactory::GetBigIntValue(-i)},
+                &schema);
+    rids.push_back(*table->InsertTuple(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, false}, tuple));
+  }
+  ASSERT_GT(rids.back().GetPageId(), rids.front().GetPageId());
+
+  // Scenario: a tuple read in place has the bytes and values of the one read as a copy, until it is copied itself.
+  size_t num_scanned = 0;
+  for (auto iter = table->MakeIterator(); !iter.IsEnd(); ++iter) {
+    auto [meta, ref] = iter.GetTupleRef();
+    auto [copy_meta, copy] = table->GetTuple(iter.GetRID());
+    ASSERT_EQ(rids[num_scanned], ref.GetRid());
+    ASSERT_EQ(copy.GetLength(), ref.GetLength());
+    ASSERT_EQ(0, memcmp(copy.GetData(), ref.GetData(), ref.GetLength()));
+    for (uint32_t col = 0; col < schema.GetColumnCount(); col++) {
+      ASSERT_EQ(CmpBool::CmpTrue, copy.GetValue(&schema, col).CompareEquals(ref.GetValue(&schema, col)));
+    }
+    auto tuple = ref.ToTuple();
+    ASSERT_EQ(ref.GetRid(), tuple.GetRid());
+    ASSERT_EQ(0, memcmp(copy.GetData(), tuple.GetData(), tuple.GetLength()));
+    num_scanned++;
+  }
+  ASSERT_EQ(rids.size(), num_scanned);
+
+  // Scenario: once the iterator drops the page it reads in place, or leaves it, the page can be written.
+  auto iter = table->MakeIterator();
+  iter.GetTupleRef();
+  iter.DropPage();
+  table->UpdateTupleMeta(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, true}, rids[0]);
+  ASSERT_TRUE(iter.GetTupleRef().first.is_deleted_);
+  while (iter.GetRID().GetPageId() == rids[0].GetPageId()) {
+    ++iter;
+  }
+  table->UpdateTupleMeta(TupleMeta{INVALID_TXN_ID, INVALID_TXN_ID, true}, rids[1]);
+  ASSERT_TRUE(table->GetTupleMeta(rids[1]).is_deleted_);
+}
+
 }  // namespace bustub
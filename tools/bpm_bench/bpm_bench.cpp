@@ -1,7 +1,11 @@
+#include <algorithm>
 #include <chrono>
+#include <climits>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <mutex>  // NOLINT
+#include <optional>
 #include <random>
 #include <sstream>
 #include <string>
@@ -34,6 +38,8 @@ static const size_t BUSTUB_GET_THREAD = 8;
 static const size_t LRU_K_SIZE = 16;
 static const size_t BUSTUB_PAGE_CNT = 6400;
 static const size_t BUSTUB_BPM_SIZE = 64;
+/** Byte offset at which every benchmark page stores the id of the page a scan visits after it. */
+static const size_t NEXT_PAGE_ID_OFFSET = 2048;
 
 struct BpmTotalMetrics {
   uint64_t scan_cnt_{0};
@@ -53,15 +59,33 @@ struct BpmTotalMetrics {
     get_cnt_ += get_cnt;
   }
 
-  void Report() {
+  void Report(size_t num_instances, size_t scan_ring_size, size_t read_ahead_window,
+              const bustub::BufferPoolManager::AccessStats &get_stats,
+              const bustub::BufferPoolManager::ReadAheadStats &ra,
+              const bustub::BufferPoolManager::BackgroundWriterStats &bg) {
     auto now = ClockMs();
     auto elsped = now - start_time_;
     auto scan_per_sec = scan_cnt_ / static_cast<double>(elsped) * 1000;
     auto get_per_sec = get_cnt_ / static_cast<double>(elsped) * 1000;
+    auto get_accesses = get_stats.hits_ + get_stats.misses_;
+    auto get_hit_ratio = get_accesses == 0 ? 0.0 : get_stats.hits_ / static_cast<double>(get_accesses);
+    auto victims = bg.clean_victims_ + bg.dirty_victims_;
+    auto clean_victim_ratio = victims == 0 ? 0.0 : bg.clean_victims_ / static_cast<double>(victims);
 
     fmt::print("<<< BEGIN\n");
+    fmt::print("shards: {}\n", num_instances);
     fmt::print("scan: {}\n", scan_per_sec);
     fmt::print("get: {}\n", get_per_sec);
+    fmt::print("scan_ring: {}\n", scan_ring_size);
+    fmt::print("get_hit_ratio: {:.4f}\n", get_hit_ratio);
+    fmt::print("clean_victim_ratio: {:.4f}\n", clean_victim_ratio);
+    fmt::print("bg_writer_pages: {}\n", bg.pages_written_);
+    if (read_ahead_window > 0) {
+      fmt::print("read_ahead_window: {}\n", read_ahead_window);
+      fmt::print("read_ahead_issued: {}\n", ra.issued_);
+      fmt::print("read_ahead_hits: {}\n", ra.hits_);
+      fmt::print("read_ahead_wasted: {}\n", ra.wasted_);
+    }
     fmt::print(">>> END\n");
   }
 };
@@ -101,40 +125,36 @@ struct BpmMetrics {
 };
 
 // NOLINTNEXTLINE
-auto main(int argc, char **argv) -> int {
+void RunBench(size_t num_instances, std::optional<size_t> scan_ring_size, size_t read_ahead_window,
+              std::optional<uint64_t> bg_writer_interval_ms, double write_ratio, uint64_t duration_ms,
+              uint64_t latency_ms) {
   using bustub::AccessType;
   using bustub::BufferPoolManager;
   using bustub::DiskManagerUnlimitedMemory;
   using bustub::page_id_t;
 
-  argparse::ArgumentParser program("bustub-bpm-bench");
-  program.add_argument("--duration").help("run bpm bench for n milliseconds");
-  program.add_argument("--latency").help("set disk latency to n milliseconds");
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm =
+      std::make_unique<BufferPoolManager>(BUSTUB_BPM_SIZE, disk_manager.get(), LRU_K_SIZE, nullptr, num_instances);
+  std::vector<page_id_t> page_ids;
 
-  try {
-    program.parse_args(argc, argv);
-  } catch (const std::runtime_error &err) {
-    std::cerr << err.what() << std::endl;
-    std::cerr << program;
-    return 1;
+  // The benchmark drives read-ahead itself below, so that it also covers pages outside of a table heap.
+  bpm->SetReadAheadWindow(read_ahead_window);
+  if (scan_ring_size.has_value()) {
+    bpm->SetScanRingSize(*scan_ring_size);
   }
-
-  uint64_t duration_ms = 30000;
-  if (program.present("--duration")) {
-    duration_ms = std::stoi(program.get("--duration"));
+  if (bg_writer_interval_ms.has_value()) {
+    auto options = bpm->GetBackgroundWriterOptions();
+    options.interval_ = std::chrono::milliseconds(*bg_writer_interval_ms);
+    bpm->SetBackgroundWriterOptions(options);
   }
 
-  uint64_t latency_ms = 0;
-  if (program.present("--latency")) {
-    latency_ms = std::stoi(program.get("--latency"));
-  }
-
-  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
-  auto bpm = std::make_unique<BufferPoolManager>(BUSTUB_BPM_SIZE, disk_manager.get(), LRU_K_SIZE);
-  std::vector<page_id_t> page_ids;
-
-  fmt::print(stderr, "[info] total_page={}, duration_ms={}, latency_ms={}, lru_k_size={}, bpm_size={}\n",
-             BUSTUB_PAGE_CNT, duration_ms, latency_ms, LRU_K_SIZE, BUSTUB_BPM_SIZE);
+  fmt::print(stderr,
+             "[info] total_page={}, duration_ms={}, latency_ms={}, lru_k_size={}, bpm_size={}, shards={}, "
+             "scan_ring={}, read_ahead={}, bg_writer_interval_ms={}, write_ratio={}\n",
+             BUSTUB_PAGE_CNT, duration_ms, latency_ms, LRU_K_SIZE, BUSTUB_BPM_SIZE, num_instances,
+             bpm->GetScanRingSize(), read_ahead_window, bpm->GetBackgroundWriterOptions().interval_.count(),
+             write_ratio);
 
   for (size_t i = 0; i < BUSTUB_PAGE_CNT; i++) {
     page_id_t page_id;
@@ -149,6 +169,13 @@ auto main(int argc, char **argv) -> int {
     page_ids.push_back(page_id);
   }
 
+  // chain the pages in scan order so that read-ahead can follow them
+  for (size_t i = 0; i < BUSTUB_PAGE_CNT; i++) {
+    auto guard = bpm->FetchPageWrite(page_ids[i]);
+    auto next_page_id = page_ids[(i + 1) % BUSTUB_PAGE_CNT];
+    memcpy(guard.GetDataMut() + NEXT_PAGE_ID_OFFSET, &next_page_id, sizeof(page_id_t));
+  }
+
   // enable disk latency after creating all pages
   disk_manager->SetLatency(latency_ms);
 
@@ -160,13 +187,22 @@ auto main(int argc, char **argv) -> int {
   std::vector<std::thread> threads;
 
   for (size_t thread_id = 0; thread_id < BUSTUB_SCAN_THREAD; thread_id++) {
-    threads.emplace_back(std::thread([thread_id, &page_ids, &bpm, duration_ms, &total_metrics] {
+    threads.emplace_back(std::thread([thread_id, &page_ids, &bpm, duration_ms, read_ahead_window, &total_metrics] {
       BpmMetrics metrics(fmt::format("scan {:>2}", thread_id), duration_ms);
       metrics.Begin();
 
       size_t page_idx = BUSTUB_PAGE_CNT * thread_id / BUSTUB_SCAN_THREAD;
+      size_t read_ahead_stride = std::max<size_t>(read_ahead_window / 2, 1);
 
       while (!metrics.ShouldFinish()) {
+        if (read_ahead_window > 0 && page_idx % read_ahead_stride == 0) {
+          bpm->ReadAhead(page_ids[(page_idx + 1) % BUSTUB_PAGE_CNT], read_ahead_window, [](const char *data) {
+            page_id_t next_page_id;
+            memcpy(&next_page_id, data + NEXT_PAGE_ID_OFFSET, sizeof(page_id_t));
+            return next_page_id;
+          });
+        }
+
         auto *page = bpm->FetchPage(page_ids[page_idx], AccessType::Scan);
         if (page == nullptr) {
           continue;
@@ -191,10 +227,11 @@ auto main(int argc, char **argv) -> int {
   }
 
   for (size_t thread_id = 0; thread_id < BUSTUB_GET_THREAD; thread_id++) {
-    threads.emplace_back(std::thread([thread_id, &page_ids, &bpm, duration_ms, &total_metrics] {
+    threads.emplace_back(std::thread([thread_id, &page_ids, &bpm, duration_ms, write_ratio, &total_metrics] {
       std::random_device r;
       std::default_random_engine gen(r());
       zipfian_int_distribution<size_t> dist(0, BUSTUB_PAGE_CNT - 1, 0.8);
+      std::uniform_real_distribution<double> write_dist(0.0, 1.0);
 
       BpmMetrics metrics(fmt::format("get  {:>2}", thread_id), duration_ms);
       metrics.Begin();
@@ -206,14 +243,23 @@ auto main(int argc, char **argv) -> int {
           continue;
         }
 
-        page->RLatch();
-        char ch = page->GetData()[page_idx % 1024];
-        page->RUnlatch();
+        bool is_write = write_dist(gen) < write_ratio;
+        char ch;
+        if (is_write) {
+          page->WLatch();
+          ch = page->GetData()[page_idx % 1024];
+          page->GetData()[page_idx % 1024] = ch == CHAR_MAX ? 1 : ch + 1;
+          page->WUnlatch();
+        } else {
+          page->RLatch();
+          ch = page->GetData()[page_idx % 1024];
+          page->RUnlatch();
+        }
         if (ch == 0) {
           throw std::runtime_error("invalid data");
         }
 
-        bpm->UnpinPage(page->GetPageId(), false, AccessType::Get);
+        bpm->UnpinPage(page->GetPageId(), is_write, AccessType::Get);
         metrics.Tick();
         metrics.Report();
       }
@@ -226,7 +272,72 @@ auto main(int argc, char **argv) -> int {
     thread.join();
   }
 
-  total_metrics.Report();
+  total_metrics.Report(num_instances, bpm->GetScanRingSize(), read_ahead_window,
+                       bpm->GetAccessStats(AccessType::Get), bpm->GetReadAheadStats(),
+                       bpm->GetBackgroundWriterStats());
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-bpm-bench");
+  program.add_argument("--duration").help("run bpm bench for n milliseconds");
+  program.add_argument("--latency").help("set disk latency to n milliseconds");
+  program.add_argument("--shards").help("comma-separated list of buffer pool instance counts to sweep, e.g. 1,2,4,8");
+  program.add_argument("--read-ahead").help("let scan threads read n pages ahead (0 = disabled)");
+  program.add_argument("--scan-ring").help("size of the buffer ring used by scans, in pages (0 = disabled)");
+  program.add_argument("--bg-writer-interval").help("run the background writer every n milliseconds (0 = paused)");
+  program.add_argument("--write-ratio").help("fraction of get operations that modify the page, e.g. 0.2");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  uint64_t duration_ms = 30000;
+  if (program.present("--duration")) {
+    duration_ms = std::stoi(program.get("--duration"));
+  }
+
+  uint64_t latency_ms = 0;
+  if (program.present("--latency")) {
+    latency_ms = std::stoi(program.get("--latency"));
+  }
+
+  size_t read_ahead_window = 0;
+  if (program.present("--read-ahead")) {
+    read_ahead_window = std::stoul(program.get("--read-ahead"));
+  }
+
+  std::optional<size_t> scan_ring_size;
+  if (program.present("--scan-ring")) {
+    scan_ring_size = std::stoul(program.get("--scan-ring"));
+  }
+
+  std::optional<uint64_t> bg_writer_interval_ms;
+  if (program.present("--bg-writer-interval")) {
+    bg_writer_interval_ms = std::stoul(program.get("--bg-writer-interval"));
+  }
+
+  double write_ratio = 0.0;
+  if (program.present("--write-ratio")) {
+    write_ratio = std::stod(program.get("--write-ratio"));
+  }
+
+  std::vector<size_t> shard_counts{1};
+  if (program.present("--shards")) {
+    shard_counts.clear();
+    for (const auto &shards : bustub::StringUtil::Split(program.get("--shards"), ',')) {
+      shard_counts.push_back(std::stoul(shards));
+    }
+  }
+
+  for (auto num_instances : shard_counts) {
+    RunBench(num_instances, scan_ring_size, read_ahead_window, bg_writer_interval_ms, write_ratio, duration_ms,
+             latency_ms);
+  }
 
   return 0;
 }
@@ -32,7 +32,6 @@ auto ClockMs() -> uint64_t {
   return static_cast<uint64_t>(tm.tv_sec * 1000) + static_cast<uint64_t>(tm.tv_usec / 1000);
 }
 
-static const size_t BUSTUB_READ_THREAD = 4;
 static const size_t BUSTUB_WRITE_THREAD = 2;
 static const size_t LRU_K_SIZE = 4;
 static const size_t BUSTUB_BPM_SIZE = 256;
@@ -57,15 +56,18 @@ struct BTreeTotalMetrics {
     read_cnt_ += get_cnt;
   }
 
-  void Report() {
+  void Report(const std::string &latch_mode, size_t read_threads) {
     auto now = ClockMs();
     auto elsped = now - start_time_;
     auto write_per_sec = write_cnt_ / static_cast<double>(elsped) * 1000;
     auto read_per_sec = read_cnt_ / static_cast<double>(elsped) * 1000;
 
     fmt::print("<<< BEGIN\n");
+    fmt::print("latch_mode: {}\n", latch_mode);
+    fmt::print("read_threads: {}\n", read_threads);
     fmt::print("write: {}\n", write_per_sec);
     fmt::print("read: {}\n", read_per_sec);
+    fmt::print("lookups_per_sec: {:.0f}\n", read_per_sec);
     fmt::print(">>> END\n");
   }
 };
@@ -111,33 +113,21 @@ auto KeyWillVanish(size_t key) -> bool { return key % 7 == 0; }
 auto KeyWillChange(size_t key) -> bool { return key % 5 == 0; }
 
 // NOLINTNEXTLINE
-auto main(int argc, char **argv) -> int {
-  using bustub::AccessType;
+void RunBench(bustub::BPlusTreeLatchMode latch_mode, const std::string &latch_mode_name, size_t read_threads,
+              uint64_t duration_ms) {
   using bustub::BufferPoolManager;
   using bustub::DiskManagerUnlimitedMemory;
   using bustub::page_id_t;
-
-  argparse::ArgumentParser program("bustub-btree-bench");
-  program.add_argument("--duration").help("run btree bench for n milliseconds");
-
-  try {
-    program.parse_args(argc, argv);
-  } catch (const std::runtime_error &err) {
-    std::cerr << err.what() << std::endl;
-    std::cerr << program;
-    return 1;
-  }
-
-  uint64_t duration_ms = 30000;
-  if (program.present("--duration")) {
-    duration_ms = std::stoi(program.get("--duration"));
-  }
+  // The default page sizes, LEAF_PAGE_SIZE and INTERNAL_PAGE_SIZE, are macros written in terms of these names.
+  using bustub::BUSTUB_PAGE_SIZE;
+  using KeyType = bustub::GenericKey<8>;
+  using ValueType = bustub::RID;
 
   auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
   auto bpm = std::make_unique<BufferPoolManager>(BUSTUB_BPM_SIZE, disk_manager.get(), LRU_K_SIZE);
 
-  fmt::print(stderr, "[info] total_keys={}, duration_ms={}, lru_k_size={}, bpm_size={}\n", TOTAL_KEYS, duration_ms,
-             LRU_K_SIZE, BUSTUB_BPM_SIZE);
+  fmt::print(stderr, "[info] total_keys={}, duration_ms={}, lru_k_size={}, bpm_size={}, latch_mode={}, threads={}\n",
+             TOTAL_KEYS, duration_ms, LRU_K_SIZE, BUSTUB_BPM_SIZE, latch_mode_name, read_threads);
 
   auto key_schema = bustub::ParseCreateStatement("a bigint");
   bustub::GenericComparator<8> comparator(key_schema.get());
@@ -145,8 +135,9 @@ auto main(int argc, char **argv) -> int {
   page_id_t page_id;
   auto header_page = bpm->NewPageGuarded(&page_id);
 
-  bustub::BPlusTree<bustub::GenericKey<8>, bustub::RID, bustub::GenericComparator<8>> index("foo_pk", page_id,
-                                                                                            bpm.get(), comparator);
+  // Destroyed before the buffer pool: an optimistic tree keeps its root pinned.
+  bustub::BPlusTree<KeyType, ValueType, bustub::GenericComparator<8>> index(
+      "foo_pk", page_id, bpm.get(), comparator, LEAF_PAGE_SIZE, INTERNAL_PAGE_SIZE, latch_mode);
 
   for (size_t key = 0; key < TOTAL_KEYS; key++) {
     bustub::GenericKey<8> index_key;
@@ -164,13 +155,13 @@ auto main(int argc, char **argv) -> int {
 
   std::vector<std::thread> threads;
 
-  for (size_t thread_id = 0; thread_id < BUSTUB_READ_THREAD; thread_id++) {
-    threads.emplace_back(std::thread([thread_id, &index, duration_ms, &total_metrics] {
+  for (size_t thread_id = 0; thread_id < read_threads; thread_id++) {
+    threads.emplace_back(std::thread([thread_id, read_threads, &index, duration_ms, &total_metrics] {
       BTreeMetrics metrics(fmt::format("read  {:>2}", thread_id), duration_ms);
       metrics.Begin();
 
-      size_t key_start = TOTAL_KEYS / BUSTUB_READ_THREAD * thread_id;
-      size_t key_end = TOTAL_KEYS / BUSTUB_READ_THREAD * (thread_id + 1);
+      size_t key_start = TOTAL_KEYS / read_threads * thread_id;
+      size_t key_end = TOTAL_KEYS / read_threads * (thread_id + 1);
       std::random_device r;
       std::default_random_engine gen(r());
       std::uniform_int_distribution<size_t> dis(key_start, key_end - 1);
@@ -261,7 +252,56 @@ auto main(int argc, char **argv) -> int {
     thread.join();
   }
 
-  total_metrics.Report();
+  total_metrics.Report(latch_mode_name, read_threads);
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-btree-bench");
+  program.add_argument("--duration").help("run each configuration of the btree bench for n milliseconds");
+  program.add_argument("--threads").help("comma-separated list of read thread counts, e.g. 1,2,4,8,16,32,64");
+  program.add_argument("--latch-mode").help("comma-separated list of latch modes: crabbing, optimistic");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  uint64_t duration_ms = 30000;
+  if (program.present("--duration")) {
+    duration_ms = std::stoi(program.get("--duration"));
+  }
+
+  std::vector<size_t> read_threads{4};
+  if (program.present("--threads")) {
+    read_threads.clear();
+    for (const auto &count : bustub::StringUtil::Split(program.get("--threads"), ',')) {
+      read_threads.push_back(std::stoul(count));
+    }
+  }
+
+  std::vector<std::string> latch_modes{"crabbing", "optimistic"};
+  if (program.present("--latch-mode")) {
+    latch_modes = bustub::StringUtil::Split(program.get("--latch-mode"), ',');
+  }
+
+  for (const auto &latch_mode : latch_modes) {
+    bustub::BPlusTreeLatchMode mode;
+    if (latch_mode == "crabbing") {
+      mode = bustub::BPlusTreeLatchMode::Crabbing;
+    } else if (latch_mode == "optimistic") {
+      mode = bustub::BPlusTreeLatchMode::Optimistic;
+    } else {
+      std::cerr << "unknown latch mode: " << latch_mode << std::endl;
+      return 1;
+    }
+    for (auto threads : read_threads) {
+      RunBench(mode, latch_mode, threads, duration_ms);
+    }
+  }
 
   return 0;
 }
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "common/bustub_instance.h"
+#include "common/exception.h"
+#include "fmt/core.h"
+#include "parser.h"
+
+/** @return the result of a query as the sqllogictest runner prints it, running it in an execution mode */
+auto RunQuery(bustub::BustubInstance *bustub, const std::string &mode, const std::string &sql) -> std::string {
+  auto noop_writer = bustub::NoopWriter();
+  bustub->ExecuteSql(fmt::format("set execution_mode = {};", mode), noop_writer);
+  std::stringstream result;
+  auto writer = bustub::SimpleStreamWriter(result, true, " ");
+  bustub->ExecuteSql(sql, writer);
+  return result.str();
+}
+
+/**
+ * Runs the statements of a sqllogictest file, then runs each of its queries a tuple at a time and a batch at a time,
+ * checks that both give the same result, and reports the fastest of a number of runs in each mode.
+ */
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-exec-bench");
+  program.add_argument("file").help("the sqllogictest file whose queries to run");
+  program.add_argument("--repeat").help("run each query n times in each mode");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  size_t repeat = 5;
+  if (program.present("--repeat")) {
+    repeat = std::stoul(program.get("--repeat"));
+  }
+  auto filename = program.get<std::string>("file");
+  std::ifstream file(filename);
+  if (!file) {
+    std::cerr << "Failed to open " << filename << std::endl;
+    return 1;
+  }
+  std::string script((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  auto records = bustub::SQLLogicTestParser::Parse(script);
+
+  auto bustub = std::make_unique<bustub::BustubInstance>();
+  bustub->GenerateMockTable();
+  if (bustub->buffer_pool_manager_ != nullptr) {
+    bustub->GenerateTestTable();
+  }
+
+  auto num_queries = std::count_if(records.begin(), records.end(),
+                                   [](const auto &record) { return record->type_ == bustub::RecordType::QUERY; });
+  fmt::print(stderr, "[info] {} queries of {}, repeat={}\n", num_queries, filename, repeat);
+  fmt::print("<<< BEGIN\n");
+  size_t query_id = 0;
+  for (const auto &record : records) {
+    if (record->type_ == bustub::RecordType::STATEMENT) {
+      const auto &statement = dynamic_cast<const bustub::StatementRecord &>(*record);
+      try {
+        auto writer = bustub::NoopWriter();
+        bustub->ExecuteSql(statement.sql_, writer);
+      } catch (bustub::Exception &ex) {
+        if (!statement.is_error_) {
+          fmt::print(stderr, "{}: unexpected error: {}\n", record->loc_, ex.what());
+          return 1;
+        }
+      }
+      continue;
+    }
+    if (record->type_ != bustub::RecordType::QUERY) {
+      continue;
+    }
+    const auto &query = dynamic_cast<const bustub::QueryRecord &>(*record);
+    std::string results[2];
+    double best_ms[2];
+    const char *modes[2] = {"tuple", "batch"};
+    try {
+      for (size_t m = 0; m < 2; m++) {
+        best_ms[m] = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < repeat; i++) {
+          auto start = std::chrono::steady_clock::now();
+          results[m] = RunQuery(bustub.get(), modes[m], query.sql_);
+          best_ms[m] = std::min(
+              best_ms[m], std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+      }
+    } catch (bustub::Exception &ex) {
+      fmt::print(stderr, "{}: unexpected error: {}\n", record->loc_, ex.what());
+      return 1;
+    }
+    if (results[0] != results[1]) {
+      fmt::print(stderr, "{}: tuple and batch execution disagree\n--- TUPLE ---\n{}--- BATCH ---\n{}", record->loc_,
+                 results[0], results[1]);
+      return 1;
+    }
+    fmt::print("q{}_tuple_ms: {:.2f}\nq{}_batch_ms: {:.2f}\n", query_id, best_ms[0], query_id, best_ms[1]);
+    query_id++;
+  }
+  fmt::print(">>> END\n");
+
+  return 0;
+}
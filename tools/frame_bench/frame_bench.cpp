@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "buffer/buffer_pool_manager.h"
+#include "buffer/frame_arena.h"
+#include "common/config.h"
+#include "common/util/string_util.h"
+#include "fmt/core.h"
+#include "storage/disk/disk_manager_memory.h"
+
+/** One in this many fetches is timed individually, to estimate the latency distribution. */
+static const size_t BUSTUB_SAMPLE_EVERY = 64;
+/** Bytes read from each fetched page, at a random offset. */
+static const size_t BUSTUB_READ_SIZE = 64;
+
+/**
+ * Fetches random resident pages of a pool large enough for TLB reach and memory placement to matter, so that the
+ * measured latency mostly reflects how the frames are laid out in memory.
+ */
+// NOLINTNEXTLINE
+void RunBench(const bustub::FrameArenaOptions &frame_options, size_t pool_size, size_t num_threads,
+              uint64_t duration_ms) {
+  using bustub::AccessType;
+  using bustub::BufferPoolManager;
+  using bustub::page_id_t;
+  using Clock = std::chrono::steady_clock;
+
+  auto disk_manager = std::make_unique<bustub::DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager.get(), bustub::LRUK_REPLACER_K, nullptr,
+                                                 num_threads, bustub::ReplacerPolicy::LRUK, frame_options);
+  // Every page stays resident, there is nothing for the background writer to do.
+  auto bg_options = bpm->GetBackgroundWriterOptions();
+  bg_options.interval_ = std::chrono::milliseconds(0);
+  bpm->SetBackgroundWriterOptions(bg_options);
+
+  const auto &arena = bpm->GetFrameArena();
+  const char *numa_names[] = {"default", "interleave", "bind"};
+  fmt::print(stderr, "[info] frames={}, huge_pages={}, numa={}, pool_size={}, threads={}, duration_ms={}\n",
+             bustub::FrameAllocationToString(frame_options.allocation_), arena.UsesHugePages(),
+             numa_names[static_cast<int>(arena.GetNumaPolicy())], pool_size, num_threads, duration_ms);
+
+  std::vector<page_id_t> page_ids(pool_size);
+  for (size_t i = 0; i < pool_size; i++) {
+    auto guard = bpm->NewPageGuarded(&page_ids[i]);
+    if (guard.GetData() == nullptr) {
+      throw std::runtime_error("new page failed");
+    }
+    guard.GetDataMut()[0] = 1;
+  }
+
+  std::atomic<uint64_t> total_ops{0};
+  // Keeps the compiler from optimizing the page reads away.
+  std::atomic<uint64_t> checksum_sink{0};
+  std::vector<std::vector<uint64_t>> samples(num_threads);
+  std::vector<std::thread> threads;
+  auto deadline = Clock::now() + std::chrono::milliseconds(duration_ms);
+  for (size_t thread_id = 0; thread_id < num_threads; thread_id++) {
+    threads.emplace_back([&, thread_id] {
+      std::mt19937_64 gen(thread_id);
+      std::uniform_int_distribution<size_t> page_dist(0, pool_size - 1);
+      std::uniform_int_distribution<size_t> offset_dist(0, bustub::BUSTUB_PAGE_SIZE / BUSTUB_READ_SIZE - 1);
+      uint64_t ops = 0;
+      uint64_t checksum = 0;
+      while (Clock::now() < deadline) {
+        for (size_t i = 0; i < BUSTUB_SAMPLE_EVERY; i++) {
+          auto start = i == 0 ? Clock::now() : Clock::time_point{};
+          auto guard = bpm->FetchPageRead(page_ids[page_dist(gen)], AccessType::Get);
+          const char *data = guard.GetData() + offset_dist(gen) * BUSTUB_READ_SIZE;
+          for (size_t j = 0; j < BUSTUB_READ_SIZE; j += sizeof(uint64_t)) {
+            checksum += *reinterpret_cast<const uint64_t *>(data + j);
+          }
+          guard.Drop();
+          if (i == 0) {
+            samples[thread_id].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start)
+                                             .count());
+          }
+        }
+        ops += BUSTUB_SAMPLE_EVERY;
+      }
+      total_ops += ops;
+      checksum_sink += checksum;
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  std::vector<uint64_t> latencies;
+  for (auto &thread_samples : samples) {
+    latencies.insert(latencies.end(), thread_samples.begin(), thread_samples.end());
+  }
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double p) {
+    return latencies.empty() ? 0 : latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))];
+  };
+
+  fmt::print("<<< BEGIN\n");
+  fmt::print("frames: {}\n", bustub::FrameAllocationToString(frame_options.allocation_));
+  fmt::print("huge_pages: {}\n", arena.UsesHugePages());
+  fmt::print("fetch_per_sec: {:.0f}\n", total_ops.load() / (duration_ms / 1000.0));
+  fmt::print("fetch_p50_ns: {}\n", percentile(0.5));
+  fmt::print("fetch_p99_ns: {}\n", percentile(0.99));
+  fmt::print(">>> END\n");
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-frame-bench");
+  program.add_argument("--duration").help("run each configuration for n milliseconds");
+  program.add_argument("--pool-size").help("number of frames in the buffer pool");
+  program.add_argument("--threads").help("number of fetching threads, also the number of buffer pool instances");
+  program.add_argument("--frames").help("comma-separated list of frame allocations, e.g. heap,contiguous,huge_pages");
+  program.add_argument("--numa").help("interleave the frames over all nodes, or bind them to the given node");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  uint64_t duration_ms = 5000;
+  if (program.present("--duration")) {
+    duration_ms = std::stoul(program.get("--duration"));
+  }
+
+  // 1 GiB of frames by default, far beyond what the TLB covers with 4 KiB pages.
+  size_t pool_size = 262144;
+  if (program.present("--pool-size")) {
+    pool_size = std::stoul(program.get("--pool-size"));
+  }
+
+  size_t num_threads = 8;
+  if (program.present("--threads")) {
+    num_threads = std::stoul(program.get("--threads"));
+  }
+
+  std::vector<bustub::FrameAllocation> allocations{bustub::FrameAllocation::Heap, bustub::FrameAllocation::Contiguous,
+                                                   bustub::FrameAllocation::HugePages};
+  if (program.present("--frames")) {
+    allocations.clear();
+    for (const auto &name : bustub::StringUtil::Split(program.get("--frames"), ',')) {
+      allocations.push_back(bustub::FrameAllocationFromString(name));
+    }
+  }
+
+  bustub::FrameArenaOptions frame_options;
+  if (program.present("--numa")) {
+    auto numa = program.get("--numa");
+    if (numa == "interleave") {
+      frame_options.numa_policy_ = bustub::NumaPolicy::Interleave;
+    } else {
+      frame_options.numa_policy_ = bustub::NumaPolicy::Bind;
+      frame_options.numa_node_ = std::stoi(numa);
+    }
+  }
+
+  for (auto allocation : allocations) {
+    frame_options.allocation_ = allocation;
+    RunBench(frame_options, pool_size, num_threads, duration_ms);
+  }
+
+  return 0;
+}
@@ -0,0 +1,126 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "common/config.h"
+#include "common/util/string_util.h"
+#include "fmt/core.h"
+#include "storage/index/generic_key.h"
+#include "storage/page/b_plus_tree_key_search.h"
+#include "storage/page/b_plus_tree_leaf_page.h"
+#include "test_util.h"
+
+/** Lookups run between two reads of the clock. */
+static const size_t BUSTUB_LOOKUPS_PER_ROUND = 1024;
+
+/**
+ * Searches a page worth of BIGINT keys for random keys, once with the comparator that pages of other keys search
+ * with, then with each search kernel this CPU runs, and reports the lookups per second of each.
+ */
+// NOLINTNEXTLINE
+void RunBench(size_t num_keys, uint64_t duration_ms) {
+  using Clock = std::chrono::steady_clock;
+  auto key_schema = bustub::ParseCreateStatement("a bigint");
+  bustub::GenericComparator<8> comparator(key_schema.get());
+  int shift = comparator.GetIntegerShift();
+
+  // Keys are as a page stores them, contiguously; lookups hit keys and the gaps between them alike.
+  std::vector<bustub::GenericKey<8>> keys(num_keys);
+  for (size_t i = 0; i < num_keys; i++) {
+    keys[i].SetFromInteger(static_cast<int64_t>(2 * i));
+  }
+  std::mt19937_64 gen(0);
+  std::uniform_int_distribution<int64_t> key_dist(-1, static_cast<int64_t>(2 * num_keys));
+  std::vector<bustub::GenericKey<8>> lookups(BUSTUB_LOOKUPS_PER_ROUND);
+  for (auto &lookup : lookups) {
+    lookup.SetFromInteger(key_dist(gen));
+  }
+  const char *key_bytes = reinterpret_cast<const char *>(keys.data());
+
+  auto measure = [&](const std::string &name, const auto &search) {
+    // Keeps the compiler from optimizing the searches away.
+    uint64_t checksum = 0;
+    uint64_t ops = 0;
+    auto start = Clock::now();
+    auto deadline = start + std::chrono::milliseconds(duration_ms);
+    while (Clock::now() < deadline) {
+      for (const auto &lookup : lookups) {
+        checksum += search(lookup);
+      }
+      ops += lookups.size();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    fmt::print("{}_{}_lookups_per_sec: {:.0f}\n", name, num_keys, ops / seconds);
+    if (checksum == 0) {
+      fmt::print(stderr, "[info] checksum is zero\n");
+    }
+  };
+
+  fmt::print("<<< BEGIN\n");
+  measure("comparator", [&](const bustub::GenericKey<8> &key) {
+    int left = 0;
+    int right = static_cast<int>(num_keys);
+    while (left < right) {
+      int mid = left + (right - left) / 2;
+      if (comparator(keys[mid], key) < 0) {
+        left = mid + 1;
+      } else {
+        right = mid;
+      }
+    }
+    return left;
+  });
+  for (auto kernel : {bustub::KeySearchKernel::Scalar, bustub::KeySearchKernel::SSE42, bustub::KeySearchKernel::AVX2}) {
+    if (!bustub::KeySearchKernelSupported(kernel)) {
+      continue;
+    }
+    measure(bustub::KeySearchKernelToString(kernel), [&](const bustub::GenericKey<8> &key) {
+      int64_t normalized = bustub::NormalizeIntegerKey(reinterpret_cast<const char *>(&key), shift);
+      return bustub::SearchIntegerKeys(key_bytes, 0, static_cast<int>(num_keys), normalized, shift, false, kernel);
+    });
+  }
+  fmt::print(">>> END\n");
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-page-search-bench");
+  program.add_argument("--duration").help("run each kernel for n milliseconds");
+  program.add_argument("--keys").help("comma-separated list of page sizes, in keys, e.g. 16,64,254");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  uint64_t duration_ms = 1000;
+  if (program.present("--duration")) {
+    duration_ms = std::stoul(program.get("--duration"));
+  }
+
+  // Up to a full leaf of BIGINT keys and RIDs.
+  std::vector<size_t> page_sizes{8, 32, 128, (bustub::BUSTUB_PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / 16};
+  if (program.present("--keys")) {
+    page_sizes.clear();
+    for (const auto &size : bustub::StringUtil::Split(program.get("--keys"), ',')) {
+      page_sizes.push_back(std::stoul(size));
+    }
+  }
+
+  fmt::print(stderr, "[info] pages search with the {} kernel, duration_ms={}\n",
+             bustub::KeySearchKernelToString(bustub::DefaultKeySearchKernel()), duration_ms);
+  for (auto num_keys : page_sizes) {
+    RunBench(num_keys, duration_ms);
+  }
+
+  return 0;
+}
@@ -0,0 +1,207 @@
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cpp_random_distributions/zipfian_int_distribution.h>
+
+#include "argparse/argparse.hpp"
+#include "buffer/replacer.h"
+#include "common/config.h"
+#include "common/exception.h"
+#include "common/util/string_util.h"
+#include "fmt/core.h"
+
+/** Point accesses go to the first BUSTUB_HOT_PAGE_CNT pages, scans to the BUSTUB_SCAN_PAGE_CNT pages after them. */
+static const size_t BUSTUB_HOT_PAGE_CNT = 16384;
+static const size_t BUSTUB_SCAN_PAGE_CNT = 65536;
+static const size_t BUSTUB_SCAN_LENGTH = 512;
+/** Fraction of the trace made of scans. */
+static const double BUSTUB_SCAN_SHARE = 0.3;
+
+struct TraceEntry {
+  bustub::page_id_t page_id_;
+  bustub::AccessType access_type_;
+};
+
+/**
+ * Read a trace with one access per line: a page id, optionally followed by the access type (G for Get, S for Scan,
+ * anything else for Unknown). Empty lines and lines starting with '#' are skipped.
+ */
+auto LoadTrace(const std::string &path) -> std::vector<TraceEntry> {
+  std::ifstream in(path);
+  if (!in) {
+    throw bustub::Exception("cannot open trace " + path);
+  }
+  std::vector<TraceEntry> trace;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream fields(line);
+    bustub::page_id_t page_id;
+    std::string type;
+    fields >> page_id >> type;
+    auto access_type = type == "G" ? bustub::AccessType::Get
+                       : type == "S" ? bustub::AccessType::Scan
+                                     : bustub::AccessType::Unknown;
+    trace.push_back({page_id, access_type});
+  }
+  return trace;
+}
+
+void DumpTrace(const std::string &path, const std::vector<TraceEntry> &trace) {
+  std::ofstream out(path);
+  for (const auto &entry : trace) {
+    out << entry.page_id_ << (entry.access_type_ == bustub::AccessType::Scan ? " S" : " G") << '\n';
+  }
+}
+
+/** Generate a mix of zipfian point accesses over a hot set and sequential scans over a larger set of pages. */
+auto GenerateTrace(size_t length) -> std::vector<TraceEntry> {
+  std::mt19937_64 gen(15445);
+  std::uniform_real_distribution<double> op_dist(0.0, 1.0);
+  std::uniform_int_distribution<size_t> scan_start_dist(0, BUSTUB_SCAN_PAGE_CNT - BUSTUB_SCAN_LENGTH);
+  zipfian_int_distribution<size_t> hot_dist(0, BUSTUB_HOT_PAGE_CNT - 1, 0.99);
+
+  std::vector<TraceEntry> trace;
+  trace.reserve(length + BUSTUB_SCAN_LENGTH);
+  while (trace.size() < length) {
+    if (op_dist(gen) < BUSTUB_SCAN_SHARE / BUSTUB_SCAN_LENGTH) {
+      auto start = BUSTUB_HOT_PAGE_CNT + scan_start_dist(gen);
+      for (size_t i = 0; i < BUSTUB_SCAN_LENGTH; i++) {
+        trace.push_back({static_cast<bustub::page_id_t>(start + i), bustub::AccessType::Scan});
+      }
+    } else {
+      trace.push_back({static_cast<bustub::page_id_t>(hot_dist(gen)), bustub::AccessType::Get});
+    }
+  }
+  return trace;
+}
+
+/**
+ * Replays a trace through one replacer, the way a buffer pool of `num_frames` frames would drive it: a hit pins the
+ * frame, records the access and unpins it; a miss takes a free frame or evicts one, and loads the page into it.
+ */
+// NOLINTNEXTLINE
+void RunBench(bustub::ReplacerPolicy policy, size_t num_frames, size_t k, const std::vector<TraceEntry> &trace) {
+  using bustub::frame_id_t;
+  using bustub::page_id_t;
+  using Clock = std::chrono::steady_clock;
+
+  auto replacer = bustub::MakeReplacer(policy, num_frames, k);
+  std::unordered_map<page_id_t, frame_id_t> page_table;
+  std::vector<page_id_t> frame_pages(num_frames, bustub::INVALID_PAGE_ID);
+  std::vector<frame_id_t> free_list;
+  for (size_t i = num_frames; i > 0; i--) {
+    free_list.push_back(static_cast<frame_id_t>(i - 1));
+  }
+
+  uint64_t hits = 0;
+  auto start = Clock::now();
+  for (const auto &[page_id, access_type] : trace) {
+    auto it = page_table.find(page_id);
+    if (it != page_table.end()) {
+      replacer->SetEvictable(it->second, false);
+      replacer->RecordAccess(it->second, access_type);
+      replacer->SetEvictable(it->second, true);
+      hits++;
+      continue;
+    }
+    frame_id_t frame_id;
+    if (!free_list.empty()) {
+      frame_id = free_list.back();
+      free_list.pop_back();
+    } else if (replacer->Evict(&frame_id)) {
+      page_table.erase(frame_pages[frame_id]);
+    } else {
+      fmt::print(stderr, "nothing to evict\n");
+      return;
+    }
+    replacer->SetPageId(frame_id, page_id);
+    replacer->RecordAccess(frame_id, access_type);
+    replacer->SetEvictable(frame_id, true);
+    page_table[page_id] = frame_id;
+    frame_pages[frame_id] = page_id;
+  }
+  auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+  fmt::print("<<< BEGIN\n");
+  fmt::print("policy: {}\n", bustub::ReplacerPolicyToString(policy));
+  fmt::print("frames: {}\n", num_frames);
+  fmt::print("accesses: {}\n", trace.size());
+  fmt::print("hit_ratio: {:.4f}\n", trace.empty() ? 0.0 : hits / static_cast<double>(trace.size()));
+  fmt::print("ns_per_op: {:.1f}\n", trace.empty() ? 0.0 : elapsed / static_cast<double>(trace.size()));
+  fmt::print(">>> END\n");
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-replacer-bench");
+  program.add_argument("--trace").help("replay the page accesses in this file instead of a generated trace");
+  program.add_argument("--dump-trace").help("write the generated trace to this file, in the format of --trace");
+  program.add_argument("--trace-size").help("number of accesses in the generated trace");
+  program.add_argument("--policies").help("comma-separated list of policies, e.g. lru_k,lru,clock,clock_pro,2q,arc");
+  program.add_argument("--frames").help("comma-separated list of buffer pool sizes to sweep, e.g. 1024,4096");
+  program.add_argument("--k").help("k of the LRU-K replacer");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  size_t trace_size = 1000000;
+  if (program.present("--trace-size")) {
+    trace_size = std::stoul(program.get("--trace-size"));
+  }
+
+  std::vector<TraceEntry> trace;
+  if (program.present("--trace")) {
+    trace = LoadTrace(program.get("--trace"));
+  } else {
+    trace = GenerateTrace(trace_size);
+  }
+  if (program.present("--dump-trace")) {
+    DumpTrace(program.get("--dump-trace"), trace);
+  }
+
+  std::vector<bustub::ReplacerPolicy> policies{bustub::ReplacerPolicy::LRUK,  bustub::ReplacerPolicy::LRU,
+                                               bustub::ReplacerPolicy::Clock, bustub::ReplacerPolicy::ClockPro,
+                                               bustub::ReplacerPolicy::TwoQ,  bustub::ReplacerPolicy::ARC};
+  if (program.present("--policies")) {
+    policies.clear();
+    for (const auto &name : bustub::StringUtil::Split(program.get("--policies"), ',')) {
+      policies.push_back(bustub::ReplacerPolicyFromString(name));
+    }
+  }
+
+  std::vector<size_t> frame_counts{1024, 4096};
+  if (program.present("--frames")) {
+    frame_counts.clear();
+    for (const auto &frames : bustub::StringUtil::Split(program.get("--frames"), ',')) {
+      frame_counts.push_back(std::stoul(frames));
+    }
+  }
+
+  size_t k = bustub::LRUK_REPLACER_K;
+  if (program.present("--k")) {
+    k = std::stoul(program.get("--k"));
+  }
+
+  for (auto num_frames : frame_counts) {
+    for (auto policy : policies) {
+      RunBench(policy, num_frames, k, trace);
+    }
+  }
+
+  return 0;
+}
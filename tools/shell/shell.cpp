@@ -27,12 +27,12 @@ auto GetWidthOfUtf8(const void *beg, const void *end, size_t *width) -> int {
 auto main(int argc, char **argv) -> int {
   ft_set_u8strwid_func(&GetWidthOfUtf8);
 
-  auto bustub = std::make_unique<bustub::BustubInstance>("test.db");
-
   auto default_prompt = "bustub> ";
   auto emoji_prompt = "\U0001f6c1> ";  // the bathtub emoji
   bool use_emoji_prompt = false;
   bool disable_tty = false;
+  auto replacer_policy = bustub::ReplacerPolicy::LRUK;
+  bustub::FrameArenaOptions frame_options;
 
   for (int i = 1; i < argc; i++) {
     if (strcmp(argv[i], "--emoji-prompt") == 0) {
@@ -43,8 +43,26 @@ auto main(int argc, char **argv) -> int {
       disable_tty = true;
       break;
     }
+    if (strcmp(argv[i], "--replacer") == 0 && i + 1 < argc) {
+      replacer_policy = bustub::ReplacerPolicyFromString(argv[++i]);
+    }
+    if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+      frame_options.allocation_ = bustub::FrameAllocationFromString(argv[++i]);
+    }
+    // --numa interleave spreads the frames over all nodes, --numa <node> binds them to one.
+    if (strcmp(argv[i], "--numa") == 0 && i + 1 < argc) {
+      std::string numa = argv[++i];
+      if (numa == "interleave") {
+        frame_options.numa_policy_ = bustub::NumaPolicy::Interleave;
+      } else {
+        frame_options.numa_policy_ = bustub::NumaPolicy::Bind;
+        frame_options.numa_node_ = std::stoi(numa);
+      }
+    }
   }
 
+  auto bustub = std::make_unique<bustub::BustubInstance>("test.db", replacer_policy, frame_options);
+
   bustub->GenerateMockTable();
 
   if (bustub->buffer_pool_manager_ != nullptr) {